@@ -0,0 +1,122 @@
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <gtc/matrix_transform.hpp>
+#include "ecs.h"
+#include "ecs-render.h"
+
+#define ENTITY_GRID			1024		//ENTITY_GRID^2ʵ
+#define FRAME_COUNT			20
+
+static double _elapsed_ms(std::chrono::steady_clock::time_point begin) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+static void _populate(ecs_world_t* world, const ecs_render_components_t* c, const opengl_mesh_t* mesh) {
+	ecs_mask_t mask = ecs_render_mask(c) | ECS_BIT(c->animation);
+	uint32_t seed = 1;
+	for (uint32_t z = 0; z < ENTITY_GRID; z++) {
+		for (uint32_t x = 0; x < ENTITY_GRID; x++) {
+			ecs_entity_t entity = ecs_create(world, mask);
+			float r[4];
+			for (uint32_t i = 0; i < 4; i++) {
+				seed = seed * 1664525u + 1013904223u;
+				r[i] = (float)(seed >> 8) / (float)(1u << 24);
+			}
+			ecs_transform_t* transform = (ecs_transform_t*)ecs_get(world, entity, c->transform);
+			transform->position = glm::vec3(x * 3.0f - ENTITY_GRID * 1.5f, -2.0f, -(float)z * 3.0f);
+			transform->scale = 0.5f + r[0];
+			transform->rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+			ecs_animation_t* animation = (ecs_animation_t*)ecs_get(world, entity, c->animation);
+			animation->axis = glm::normalize(glm::vec3(r[1] - 0.5f, 1.0f, r[2] - 0.5f));
+			animation->speed = 0.5f + 2.0f * r[3];
+			ecs_render_mesh_t* render_mesh = (ecs_render_mesh_t*)ecs_get(world, entity, c->render_mesh);
+			render_mesh->center = mesh->bounds_center;
+			render_mesh->radius = mesh->bounds_radius;
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	uint32_t hardware = std::thread::hardware_concurrency();
+	uint32_t max_threads = argc > 1 ? (uint32_t)atoi(argv[1]) : hardware;
+	if (max_threads < 1) {
+		max_threads = 1;
+	}
+	if (max_threads > JOB_POOL_MAX_WORKERS + 1) {
+		max_threads = JOB_POOL_MAX_WORKERS + 1;
+	}
+
+	opengl_mesh_t mesh;
+	opengl_lod_chain_t chain;
+	opengl_mesh_create_sphere(&mesh, 128, 64);
+	opengl_lod_chain_generate(&chain, &mesh, 6, 0.5f);
+	opengl_lod_selector_t selector;
+	opengl_lod_selector_init(&selector, 45.0f, 1080);
+
+	//ϷбſȥԶʵ䵽LODı׶޵
+	glm::vec3 camera(0.0f, 40.0f, 20.0f);
+	glm::mat4 view = glm::lookAt(camera, glm::vec3(0.0f, -2.0f, -200.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1920.0f / 1080.0f, 0.1f, 1000.0f);
+	opengl_frustum_t frustum;
+	opengl_frustum_from_matrix(&frustum, projection * view);
+
+	printf("ecs: %u entities (transform, animation, bounds, render mesh), %u byte chunks, %d frames averaged\n",
+		ENTITY_GRID * ENTITY_GRID, ECS_CHUNK_SIZE, FRAME_COUNT);
+	printf("%7s %10s %8s %10s %10s %10s %9s\n", "threads", "create_ms", "chunks", "animate_ms", "cull_ms", "frame_ms", "visible");
+
+	for (uint32_t threads = 1; threads <= max_threads; threads++) {
+		job_pool_t pool = {};
+		job_pool_t* jobs = NULL;
+		if (threads > 1) {
+			job_pool_create(&pool, threads - 1, 0);
+			jobs = &pool;
+		}
+		frame_arena_t arena;
+		frame_arena_init(&arena, FRAME_ARENA_DEFAULT_SIZE, jobs);
+		ecs_world_t world;
+		ecs_render_components_t components;
+		ecs_world_init(&world, jobs);
+		ecs_render_register(&world, &components);
+
+		auto begin = std::chrono::steady_clock::now();
+		_populate(&world, &components, &mesh);
+		double create_ms = _elapsed_ms(begin);
+		uint32_t chunk_count;
+		ecs_query(&world, ecs_render_mask(&components), &chunk_count);
+
+		//ǰ֡֡ȶʱ
+		double animate_ms = 0.0;
+		double cull_ms = 0.0;
+		ecs_render_output_t output = {};
+		for (int frame = -FRAME_ARENA_FRAMES; frame < FRAME_COUNT; frame++) {
+			frame_arena_begin_frame(&arena);
+			float time = frame / 120.0f;
+			begin = std::chrono::steady_clock::now();
+			ecs_render_animate(&world, &components, time);
+			double a = _elapsed_ms(begin);
+			begin = std::chrono::steady_clock::now();
+			ecs_render_cull(&world, &components, &arena, &frustum, camera, &chain, &selector, &output);
+			double c = _elapsed_ms(begin);
+			if (frame >= 0) {
+				animate_ms += a;
+				cull_ms += c;
+			}
+		}
+		animate_ms /= FRAME_COUNT;
+		cull_ms /= FRAME_COUNT;
+		printf("%7u %10.1f %8u %10.2f %10.2f %10.2f %9u\n",
+			threads, create_ms, chunk_count, animate_ms, cull_ms, animate_ms + cull_ms, output.visible_count);
+
+		ecs_world_destroy(&world);
+		frame_arena_destroy(&arena);
+		if (jobs) {
+			job_pool_destroy(&pool);
+		}
+	}
+
+	opengl_lod_chain_destroy(&chain);
+	opengl_mesh_destroy(&mesh);
+	return 0;
+}
@@ -0,0 +1,120 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include "gl-capture.h"
+
+#define REPLAY_WIDTH	1280
+#define REPLAY_HEIGHT	720
+
+static double _now_ms() {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void _usage(const char* program) {
+	printf("usage: %s TRACE [--frames N]\n", program);
+	printf("  replays a trace recorded with GL_CAPTURE or glfw-demo-bench --capture as fast as possible\n");
+	printf("  --frames stops after N frames; setup calls before the first frame are timed separately\n");
+}
+
+int main(int argc, char** argv) {
+	const char* path = NULL;
+	uint64_t max_frames = 0;
+	for (int i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+			max_frames = strtoull(argv[++i], NULL, 10);
+		} else if (path == NULL && argv[i][0] != '-') {
+			path = argv[i];
+		} else {
+			_usage(argv[0]);
+			return 2;
+		}
+	}
+	if (path == NULL) {
+		_usage(argv[0]);
+		return 2;
+	}
+
+	gl_replay_t replay;
+	if (!gl_replay_open(&replay, path)) {
+		return 2;
+	}
+
+	//¼ʱһ3.3ģڲʾ¼֡ճִ
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	GLFWwindow* window = glfwCreateWindow(REPLAY_WIDTH, REPLAY_HEIGHT, "GLFW-Demo-Replay", NULL, NULL);
+	if (window == NULL) {
+		printf("Failed to create GLFW window\n");
+		glfwTerminate();
+		abort();
+	}
+	glfwMakeContextCurrent(window);
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+		printf("Failed to initialize GLAD\n");
+		abort();
+	}
+	glfwSwapInterval(0);
+
+	printf("%s %s\n", (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION));
+	printf("%s: %llu calls, %llu frames, %.1f MB of data\n", path, (unsigned long long)replay.header.call_count,
+		(unsigned long long)replay.header.frame_count, replay.header.blob_bytes / (1024.0 * 1024.0));
+
+	//һ֮֡ǰǴԴĵãϴݵĿÿ֡ύֿͳ
+	uint64_t frames = 0;
+	uint64_t setup_calls = 0;
+	uint64_t frame_calls = 0;
+	double setup_ms = 0.0;
+	double frame_ms = 0.0;
+	double frame_max_ms = 0.0;
+	double begin = _now_ms();
+	while (max_frames == 0 || frames < max_frames) {
+		uint64_t calls = 0;
+		double frame_begin = _now_ms();
+		if (!gl_replay_frame(&replay, &calls)) {
+			break;
+		}
+		double elapsed = _now_ms() - frame_begin;
+		if (frames == 0) {
+			setup_calls = calls;
+			setup_ms = elapsed;
+		} else {
+			frame_calls += calls;
+			frame_ms += elapsed;
+			if (elapsed > frame_max_ms) {
+				frame_max_ms = elapsed;
+			}
+		}
+		frames++;
+	}
+	//ύʱֻCPUGPUʱ
+	double submit_ms = _now_ms() - begin;
+	glFinish();
+	double total_ms = _now_ms() - begin;
+	bool ok = replay.ok;
+
+	uint64_t calls = replay.calls;
+	uint64_t measured = frames > 0 ? frames - 1 : 0;
+	printf("%-10s %12s %12s %14s\n", "", "calls", "ms", "calls/s");
+	printf("%-10s %12llu %12.3f %14.0f\n", "setup", (unsigned long long)setup_calls, setup_ms, setup_ms > 0.0 ? setup_calls / (setup_ms / 1000.0) : 0.0);
+	printf("%-10s %12llu %12.3f %14.0f\n", "frames", (unsigned long long)frame_calls, frame_ms, frame_ms > 0.0 ? frame_calls / (frame_ms / 1000.0) : 0.0);
+	printf("%-10s %12llu %12.3f %14.0f\n", "submit", (unsigned long long)calls, submit_ms, submit_ms > 0.0 ? calls / (submit_ms / 1000.0) : 0.0);
+	printf("%-10s %12llu %12.3f %14.0f\n", "finish", (unsigned long long)calls, total_ms, total_ms > 0.0 ? calls / (total_ms / 1000.0) : 0.0);
+	if (measured > 0) {
+		printf("%llu frames, %.3f ms avg, %.3f ms max, %.1f calls per frame\n", (unsigned long long)measured,
+			frame_ms / measured, frame_max_ms, (double)frame_calls / measured);
+	}
+
+	gl_replay_close(&replay);
+	glfwTerminate();
+	if (!ok) {
+		printf("ERROR::GL_REPLAY::TRUNCATED: stopped after %llu calls\n", (unsigned long long)calls);
+		return 1;
+	}
+	return 0;
+}
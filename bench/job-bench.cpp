@@ -0,0 +1,129 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <glm.hpp>
+#include <gtc/matrix_transform.hpp>
+#include "job-pool.h"
+#include "image-mip.h"
+
+#define TRANSFORM_COUNT		(1u << 20)
+#define FORK_DEPTH			14				//ȣҶΪ2^FORK_DEPTH
+#define IMAGE_SIZE			4096
+
+typedef struct _transform_job_s {
+	const glm::vec4* params;	//xyz:λ w:ת
+	glm::mat4* models;
+}_transform_job_t;
+
+static void _transform_rows(void* user, uint32_t begin, uint32_t end) {
+	const _transform_job_t* job = (const _transform_job_t*)user;
+	for (uint32_t i = begin; i < end; i++) {
+		const glm::vec4& p = job->params[i];
+		glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(p));
+		job->models[i] = glm::rotate(model, p.w, glm::vec3(0.0f, 1.0f, 0.0f));
+	}
+}
+
+//ÿڵ񲢵ȴϸύ͵ȡȴ
+typedef struct _fork_job_s {
+	job_pool_t* pool;
+	float* leaves;
+}_fork_job_t;
+
+static void _fork_node(void* user, uint32_t begin, uint32_t end) {
+	const _fork_job_t* job = (const _fork_job_t*)user;
+	if (end - begin == 1) {
+		float x = (float)begin;
+		for (int i = 0; i < 256; i++) {
+			x = sinf(x) * 0.5f + 1.0f;
+		}
+		job->leaves[begin] = x;
+		return;
+	}
+	uint32_t middle = begin + (end - begin) / 2;
+	job_counter_t counter;
+	job_counter_init(&counter);
+	job_pool_submit(job->pool, _fork_node, user, begin, middle, &counter);
+	_fork_node(user, middle, end);
+	job_pool_wait(job->pool, &counter);
+}
+
+template<typename F>
+static double _time_ms(int iterations, F fn) {
+	fn();
+	auto begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++) {
+		fn();
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(end - begin).count() / iterations;
+}
+
+int main(int argc, char** argv) {
+	uint32_t hardware = std::thread::hardware_concurrency();
+	uint32_t max_threads = argc > 1 ? (uint32_t)atoi(argv[1]) : hardware;
+	if (max_threads < 1) {
+		max_threads = 1;
+	}
+	if (max_threads > JOB_POOL_MAX_WORKERS + 1) {
+		max_threads = JOB_POOL_MAX_WORKERS + 1;
+	}
+
+	glm::vec4* params = (glm::vec4*)malloc(TRANSFORM_COUNT * sizeof(glm::vec4));
+	glm::mat4* models = (glm::mat4*)malloc(TRANSFORM_COUNT * sizeof(glm::mat4));
+	for (uint32_t i = 0; i < TRANSFORM_COUNT; i++) {
+		params[i] = glm::vec4((float)(i % 1024), (float)(i / 1024), 0.0f, i * 0.001f);
+	}
+	float* leaves = (float*)malloc((1u << FORK_DEPTH) * sizeof(float));
+	unsigned char* pixels = (unsigned char*)malloc((size_t)IMAGE_SIZE * IMAGE_SIZE * 3);
+	for (size_t i = 0; i < (size_t)IMAGE_SIZE * IMAGE_SIZE * 3; i++) {
+		pixels[i] = (unsigned char)(i * 2654435761u >> 24);
+	}
+
+	printf("job pool scaling, %u hardware threads\n", hardware);
+	printf("transform: %u model matrices, fork: %u leaf jobs (binary tree), mip: %dx%d sRGB chain\n",
+		TRANSFORM_COUNT, 1u << FORK_DEPTH, IMAGE_SIZE, IMAGE_SIZE);
+	printf("%7s %12s %8s %12s %8s %12s %8s\n", "threads", "transform_ms", "speedup", "fork_ms", "speedup", "mip_ms", "speedup");
+
+	double base[3] = { 0.0, 0.0, 0.0 };
+	for (uint32_t threads = 1; threads <= max_threads; threads++) {
+		//һ߳ʱأнӿڶڵֱִ߳
+		job_pool_t pool = {};
+		job_pool_t* jobs = NULL;
+		if (threads > 1) {
+			job_pool_create(&pool, threads - 1, JOB_POOL_PIN_THREADS);
+			jobs = &pool;
+		}
+
+		_transform_job_t transform = { params, models };
+		double transform_ms = _time_ms(10, [&] {
+			job_pool_parallel_for(jobs, TRANSFORM_COUNT, 4096, _transform_rows, &transform);
+		});
+		_fork_job_t fork = { jobs, leaves };
+		double fork_ms = _time_ms(10, [&] {
+			_fork_node(&fork, 0, 1u << FORK_DEPTH);
+		});
+		double mip_ms = _time_ms(3, [&] {
+			image_mip_chain_t chain;
+			image_mip_chain_build(&chain, pixels, IMAGE_SIZE, IMAGE_SIZE, 3, IMAGE_MIP_SRGB, jobs);
+			image_mip_chain_destroy(&chain);
+		});
+
+		if (threads == 1) {
+			base[0] = transform_ms;
+			base[1] = fork_ms;
+			base[2] = mip_ms;
+		}
+		printf("%7u %12.2f %8.2f %12.2f %8.2f %12.2f %8.2f\n", threads,
+			transform_ms, base[0] / transform_ms, fork_ms, base[1] / fork_ms, mip_ms, base[2] / mip_ms);
+		job_pool_destroy(&pool);
+	}
+
+	free(params);
+	free(models);
+	free(leaves);
+	free(pixels);
+	return 0;
+}
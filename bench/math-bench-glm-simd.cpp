@@ -0,0 +1,6 @@
+//glmSIMD·Ͱ16ֽڶ룬vec4/mat4SSEʵ
+#define GLM_FORCE_INTRINSICS
+#define GLM_FORCE_DEFAULT_ALIGNED_GENTYPES
+#define MATH_BENCH_KERNELS		math_bench_glm_simd
+#define MATH_BENCH_KERNELS_NAME	"glm_simd"
+#include "math-bench-kernels.h"
@@ -0,0 +1,3 @@
+#define MATH_BENCH_KERNELS		math_bench_glm
+#define MATH_BENCH_KERNELS_NAME	"glm"
+#include "math-bench-kernels.h"
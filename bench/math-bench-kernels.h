@@ -0,0 +1,111 @@
+//glmʵֵںˣmath-bench-glm.cppmath-bench-glm-simd.cppòͬglmøһ
+//֮ǰҪMATH_BENCH_KERNELS()MATH_BENCH_KERNELS_NAME
+
+#include <cmath>
+#include <cstring>
+#include <glm.hpp>
+#include <gtc/matrix_transform.hpp>
+#include <gtc/type_ptr.hpp>
+#include "math-bench.h"
+
+static inline void _store(float* out, const glm::mat4& m) {
+	memcpy(out, glm::value_ptr(m), sizeof(float) * 16);
+}
+
+//mylookAtͬһдõǰõglm±һ
+static inline glm::mat4 _look_at(const glm::vec3& position, const glm::vec3& target, const glm::vec3& world_up) {
+	glm::vec3 front = glm::normalize(target - position);
+	glm::vec3 right = glm::normalize(glm::cross(front, world_up));
+	glm::vec3 up = glm::normalize(glm::cross(right, front));
+
+	glm::mat4 translation = glm::mat4(1.0f);
+	translation[3][0] = -position.x;
+	translation[3][1] = -position.y;
+	translation[3][2] = -position.z;
+
+	glm::mat4 rotation = glm::mat4(1.0f);
+	rotation[0][0] = right.x;
+	rotation[1][0] = right.y;
+	rotation[2][0] = right.z;
+	rotation[0][1] = up.x;
+	rotation[1][1] = up.y;
+	rotation[2][1] = up.z;
+	rotation[0][2] = -front.x;
+	rotation[1][2] = -front.y;
+	rotation[2][2] = -front.z;
+	return rotation * translation;
+}
+
+static void _kernel_look_at(const float* eyes, const float* targets, float* out, uint32_t count) {
+	const glm::vec3 world_up(0.0f, 1.0f, 0.0f);
+	for (uint32_t i = 0; i < count; i++) {
+		_store(&out[i * 16], _look_at(glm::make_vec3(&eyes[i * 3]), glm::make_vec3(&targets[i * 3]), world_up));
+	}
+}
+
+static void _kernel_camera(const float* poses, float* view_projections, float* planes, uint32_t count) {
+	const glm::vec3 world_up(0.0f, 1.0f, 0.0f);
+	for (uint32_t i = 0; i < count; i++) {
+		const float* pose = &poses[i * MATH_BENCH_CAMERA_STRIDE];
+		glm::vec3 pos = glm::make_vec3(pose);
+		float yaw = glm::radians(pose[3]);
+		float pitch = glm::radians(pose[4]);
+		glm::vec3 front = glm::normalize(glm::vec3(cosf(yaw) * cosf(pitch), sinf(pitch), sinf(yaw) * cosf(pitch)));
+		glm::mat4 view = _look_at(pos, pos + front, world_up);
+		glm::mat4 projection = glm::perspective(glm::radians(MATH_BENCH_FOVY), MATH_BENCH_ASPECT, 0.1f, 100.0f);
+		glm::mat4 m = projection * view;
+		_store(&view_projections[i * 16], m);
+
+		glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+		glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+		glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+		glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+		glm::vec4 p[6] = { row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2 };
+		for (int j = 0; j < 6; j++) {
+			p[j] /= glm::length(glm::vec3(p[j]));
+			memcpy(&planes[i * 24 + j * 4], glm::value_ptr(p[j]), sizeof(float) * 4);
+		}
+	}
+}
+
+static void _kernel_compose(const float* params, float* out, uint32_t count) {
+	const glm::vec3 axis(1.0f, 0.3f, 0.5f);
+	for (uint32_t i = 0; i < count; i++) {
+		const float* p = &params[i * 4];
+		glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::make_vec3(p));
+		model = glm::rotate(model, p[3], axis);
+		_store(&out[i * 16], model);
+	}
+}
+
+static void _kernel_multiply(const float* a, const float* b, float* out, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		_store(&out[i * 16], glm::make_mat4(&a[i * 16]) * glm::make_mat4(&b[i * 16]));
+	}
+}
+
+static void _kernel_transform(const float* m, const float* in, float* out, uint32_t count) {
+	glm::mat4 matrix = glm::make_mat4(m);
+	for (uint32_t i = 0; i < count; i++) {
+		glm::vec4 v = matrix * glm::make_vec4(&in[i * 4]);
+		memcpy(&out[i * 4], glm::value_ptr(v), sizeof(float) * 4);
+	}
+}
+
+//glmûзרõ棬ֱͨõglm::inverse
+static void _kernel_inverse(const float* in, float* out, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		_store(&out[i * 16], glm::inverse(glm::make_mat4(&in[i * 16])));
+	}
+}
+
+const math_bench_kernels_t MATH_BENCH_KERNELS = {
+	MATH_BENCH_KERNELS_NAME,
+	true,
+	_kernel_look_at,
+	_kernel_camera,
+	_kernel_compose,
+	_kernel_multiply,
+	_kernel_transform,
+	_kernel_inverse,
+};
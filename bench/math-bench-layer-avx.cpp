@@ -0,0 +1,20 @@
+#include <cstddef>
+#include "math-bench.h"
+
+//CMakeڱ֧ʱֻļ-mavx(/arch:AVX)ǰҪCPU
+#if defined(__AVX__)
+#define MATH_BACKEND			MATH_BACKEND_AVX
+#define MATH_BENCH_KERNELS		math_bench_layer_avx
+#include "math-bench-layer.h"
+#else
+const math_bench_kernels_t math_bench_layer_avx = {
+	"math_avx",
+	false,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+};
+#endif
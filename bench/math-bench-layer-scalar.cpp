@@ -0,0 +1,3 @@
+#define MATH_BACKEND			MATH_BACKEND_SCALAR
+#define MATH_BENCH_KERNELS		math_bench_layer_scalar
+#include "math-bench-layer.h"
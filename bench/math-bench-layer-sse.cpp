@@ -0,0 +1,19 @@
+#include <cstddef>
+#include "math-bench.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_BACKEND			MATH_BACKEND_SSE
+#define MATH_BENCH_KERNELS		math_bench_layer_sse
+#include "math-bench-layer.h"
+#else
+const math_bench_kernels_t math_bench_layer_sse = {
+	"math_sse",
+	false,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+};
+#endif
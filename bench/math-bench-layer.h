@@ -0,0 +1,93 @@
+//main/math-simd.hʵֵںˣmath-bench-layer-*.cppòͬMATH_BACKENDһ
+//֮ǰҪMATH_BACKENDMATH_BENCH_KERNELS()
+//AVXһ-mavx룬ֻmath-simd.hstaticC⺯glm<cmath>ģÿĿļһݣAVXǷ
+//glm::vec3/mat4ָֻתãҲóԱopengl_frustum_from_matrixopengl-camera.cppӰ
+
+#include <cmath>
+#include <cstring>
+#include "math-bench.h"
+#include "math-simd.h"
+#include "opengl-camera.h"
+
+#define _MATH_BENCH_RADIANS		0.01745329251994329576923690768489f
+
+static const float _world_up[3] = { 0.0f, 1.0f, 0.0f };
+
+static inline const glm::vec3& _vec3(const float* v) {
+	return *(const glm::vec3*)v;
+}
+
+static void _kernel_look_at(const float* eyes, const float* targets, float* out, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		math_look_at((math_mat4_t*)&out[i * 16], _vec3(&eyes[i * 3]), _vec3(&targets[i * 3]), _vec3(_world_up));
+	}
+}
+
+//glm::perspectiveͬ(֣-11)
+static void _perspective(math_mat4_t* out, float fovy, float aspect, float z_near, float z_far) {
+	float tan_half_fovy = tanf(fovy / 2.0f);
+	memset(out->m, 0, sizeof(out->m));
+	out->m[0] = 1.0f / (aspect * tan_half_fovy);
+	out->m[5] = 1.0f / tan_half_fovy;
+	out->m[10] = -(z_far + z_near) / (z_far - z_near);
+	out->m[11] = -1.0f;
+	out->m[14] = -(2.0f * z_far * z_near) / (z_far - z_near);
+}
+
+//opengl_cameraؽ·ͬmath_look_atͶӰͼٴӾȡ׶ƽ
+static void _kernel_camera(const float* poses, float* view_projections, float* planes, uint32_t count) {
+	math_mat4_t projection;
+	_perspective(&projection, MATH_BENCH_FOVY * _MATH_BENCH_RADIANS, MATH_BENCH_ASPECT, 0.1f, 100.0f);
+	for (uint32_t i = 0; i < count; i++) {
+		const float* pose = &poses[i * MATH_BENCH_CAMERA_STRIDE];
+		float yaw = pose[3] * _MATH_BENCH_RADIANS;
+		float pitch = pose[4] * _MATH_BENCH_RADIANS;
+		float front[3] = { cosf(yaw) * cosf(pitch), sinf(pitch), sinf(yaw) * cosf(pitch) };
+		float scale = 1.0f / sqrtf(front[0] * front[0] + front[1] * front[1] + front[2] * front[2]);
+		float target[3] = { pose[0] + front[0] * scale, pose[1] + front[1] * scale, pose[2] + front[2] * scale };
+		math_mat4_t view;
+		math_look_at(&view, _vec3(pose), _vec3(target), _vec3(_world_up));
+		math_mat4_t* m = (math_mat4_t*)&view_projections[i * 16];
+		math_mat4_mul(m, &projection, &view);
+		//planesÿ24floatopengl_frustum_tĲͬ
+		opengl_frustum_from_matrix((opengl_frustum_t*)&planes[i * 24], *(const glm::mat4*)m);
+	}
+}
+
+static void _kernel_compose(const float* params, float* out, uint32_t count) {
+	const float axis[3] = { 1.0f, 0.3f, 0.5f };
+	const float scale[3] = { 1.0f, 1.0f, 1.0f };
+	for (uint32_t i = 0; i < count; i++) {
+		const float* p = &params[i * 4];
+		math_quat_t rotation;
+		math_quat_from_axis_angle(&rotation, _vec3(axis), p[3]);
+		math_mat4_from_trs((math_mat4_t*)&out[i * 16], _vec3(p), &rotation, _vec3(scale));
+	}
+}
+
+static void _kernel_multiply(const float* a, const float* b, float* out, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		math_mat4_mul((math_mat4_t*)&out[i * 16], (const math_mat4_t*)&a[i * 16], (const math_mat4_t*)&b[i * 16]);
+	}
+}
+
+static void _kernel_transform(const float* m, const float* in, float* out, uint32_t count) {
+	math_mat4_mul_vec4_batch((const math_mat4_t*)m, (const math_vec4_t*)in, (math_vec4_t*)out, count);
+}
+
+static void _kernel_inverse(const float* in, float* out, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		math_mat4_inverse_affine((math_mat4_t*)&out[i * 16], (const math_mat4_t*)&in[i * 16]);
+	}
+}
+
+const math_bench_kernels_t MATH_BENCH_KERNELS = {
+	"math_" MATH_BACKEND_NAME,
+	true,
+	_kernel_look_at,
+	_kernel_camera,
+	_kernel_compose,
+	_kernel_multiply,
+	_kernel_transform,
+	_kernel_inverse,
+};
@@ -0,0 +1,185 @@
+#include <cstddef>
+#include <cmath>
+#include "math-bench.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_BENCH_SSE 1
+#include <emmintrin.h>
+#endif
+
+#if defined(MATH_BENCH_SSE)
+//wΪ0Ͳֻxyz
+static inline __m128 _load3(const float* p) {
+	return _mm_setr_ps(p[0], p[1], p[2], 0.0f);
+}
+
+static inline __m128 _dot3(__m128 a, __m128 b) {
+	__m128 m = _mm_mul_ps(a, b);
+	__m128 y = _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1));
+	__m128 z = _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 2, 2, 2));
+	__m128 x = _mm_shuffle_ps(m, m, _MM_SHUFFLE(0, 0, 0, 0));
+	return _mm_add_ps(_mm_add_ps(x, y), z);
+}
+
+static inline __m128 _cross3(__m128 a, __m128 b) {
+	__m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+	__m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+	__m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+	return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+//þȷĿͳglmnormalizeڼulp֮
+static inline __m128 _normalize3(__m128 v) {
+	return _mm_div_ps(v, _mm_sqrt_ps(_dot3(v, v)));
+}
+
+//mylookAtͬľǰright/up/-frontתúĽǺ-eyeĵ
+static inline void _look_at(__m128 eye, __m128 target, __m128 world_up, __m128* columns) {
+	__m128 front = _normalize3(_mm_sub_ps(target, eye));
+	__m128 right = _normalize3(_cross3(front, world_up));
+	__m128 up = _normalize3(_cross3(right, front));
+	__m128 back = _mm_sub_ps(_mm_setzero_ps(), front);
+	__m128 last = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+	_MM_TRANSPOSE4_PS(right, up, back, last);
+	columns[0] = right;
+	columns[1] = up;
+	columns[2] = back;
+	__m128 ex = _mm_shuffle_ps(eye, eye, _MM_SHUFFLE(0, 0, 0, 0));
+	__m128 ey = _mm_shuffle_ps(eye, eye, _MM_SHUFFLE(1, 1, 1, 1));
+	__m128 ez = _mm_shuffle_ps(eye, eye, _MM_SHUFFLE(2, 2, 2, 2));
+	__m128 t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(right, ex), _mm_mul_ps(up, ey)), _mm_mul_ps(back, ez));
+	columns[3] = _mm_sub_ps(last, t);
+}
+
+//򣺽ĵjaаbjеķ
+static inline void _multiply(const __m128* a, const __m128* b, __m128* out) {
+	for (int j = 0; j < 4; j++) {
+		__m128 x = _mm_shuffle_ps(b[j], b[j], _MM_SHUFFLE(0, 0, 0, 0));
+		__m128 y = _mm_shuffle_ps(b[j], b[j], _MM_SHUFFLE(1, 1, 1, 1));
+		__m128 z = _mm_shuffle_ps(b[j], b[j], _MM_SHUFFLE(2, 2, 2, 2));
+		__m128 w = _mm_shuffle_ps(b[j], b[j], _MM_SHUFFLE(3, 3, 3, 3));
+		out[j] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], x), _mm_mul_ps(a[1], y)), _mm_add_ps(_mm_mul_ps(a[2], z), _mm_mul_ps(a[3], w)));
+	}
+}
+
+static inline void _store(float* out, const __m128* columns) {
+	_mm_storeu_ps(out, columns[0]);
+	_mm_storeu_ps(out + 4, columns[1]);
+	_mm_storeu_ps(out + 8, columns[2]);
+	_mm_storeu_ps(out + 12, columns[3]);
+}
+
+static void _kernel_look_at(const float* eyes, const float* targets, float* out, uint32_t count) {
+	const __m128 world_up = _mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f);
+	for (uint32_t i = 0; i < count; i++) {
+		__m128 columns[4];
+		_look_at(_load3(&eyes[i * 3]), _load3(&targets[i * 3]), world_up, columns);
+		_store(&out[i * 16], columns);
+	}
+}
+
+static void _kernel_camera(const float* poses, float* view_projections, float* planes, uint32_t count) {
+	const __m128 world_up = _mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f);
+	//ͶӰֻӽǡ߱йأglm::perspectiveĽͬ
+	const float near_plane = 0.1f;
+	const float far_plane = 100.0f;
+	float f = 1.0f / tanf(MATH_BENCH_FOVY * 0.5f * 0.017453292f);
+	__m128 projection[4] = {
+		_mm_setr_ps(f / MATH_BENCH_ASPECT, 0.0f, 0.0f, 0.0f),
+		_mm_setr_ps(0.0f, f, 0.0f, 0.0f),
+		_mm_setr_ps(0.0f, 0.0f, -(far_plane + near_plane) / (far_plane - near_plane), -1.0f),
+		_mm_setr_ps(0.0f, 0.0f, -(2.0f * far_plane * near_plane) / (far_plane - near_plane), 0.0f),
+	};
+	for (uint32_t i = 0; i < count; i++) {
+		const float* pose = &poses[i * MATH_BENCH_CAMERA_STRIDE];
+		float yaw = pose[3] * 0.017453292f;
+		float pitch = pose[4] * 0.017453292f;
+		__m128 eye = _load3(pose);
+		__m128 front = _normalize3(_mm_setr_ps(cosf(yaw) * cosf(pitch), sinf(pitch), sinf(yaw) * cosf(pitch), 0.0f));
+		__m128 view[4];
+		_look_at(eye, _mm_add_ps(eye, front), world_up, view);
+		__m128 m[4];
+		_multiply(projection, view, m);
+		_store(&view_projections[i * 16], m);
+
+		//ת֮оǾУֱϳƽ
+		__m128 r0 = m[0], r1 = m[1], r2 = m[2], r3 = m[3];
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		__m128 p[6] = {
+			_mm_add_ps(r3, r0), _mm_sub_ps(r3, r0),
+			_mm_add_ps(r3, r1), _mm_sub_ps(r3, r1),
+			_mm_add_ps(r3, r2), _mm_sub_ps(r3, r2),
+		};
+		for (int j = 0; j < 6; j++) {
+			_mm_storeu_ps(&planes[i * 24 + j * 4], _mm_div_ps(p[j], _mm_sqrt_ps(_dot3(p[j], p[j]))));
+		}
+	}
+}
+
+static void _kernel_compose(const float* params, float* out, uint32_t count) {
+	const __m128 axis = _normalize3(_mm_setr_ps(1.0f, 0.3f, 0.5f, 0.0f));
+	float a[4];
+	_mm_storeu_ps(a, axis);
+	for (uint32_t i = 0; i < count; i++) {
+		const float* p = &params[i * 4];
+		float c = cosf(p[3]);
+		float s = sinf(p[3]);
+		//glm::rotateͬRodriguesչk = (1-c)*axis[k]*axis + c*e_k + s*(axis x e_k)
+		__m128 temp = _mm_mul_ps(_mm_set1_ps(1.0f - c), axis);
+		float t[4];
+		_mm_storeu_ps(t, temp);
+		__m128 columns[4];
+		columns[0] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t[0]), axis), _mm_setr_ps(c, s * a[2], -s * a[1], 0.0f));
+		columns[1] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t[1]), axis), _mm_setr_ps(-s * a[2], c, s * a[0], 0.0f));
+		columns[2] = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t[2]), axis), _mm_setr_ps(s * a[1], -s * a[0], c, 0.0f));
+		columns[3] = _mm_setr_ps(p[0], p[1], p[2], 1.0f);
+		_store(&out[i * 16], columns);
+	}
+}
+
+static void _kernel_multiply(const float* a, const float* b, float* out, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		const float* pa = &a[i * 16];
+		const float* pb = &b[i * 16];
+		__m128 ma[4] = { _mm_loadu_ps(pa), _mm_loadu_ps(pa + 4), _mm_loadu_ps(pa + 8), _mm_loadu_ps(pa + 12) };
+		__m128 mb[4] = { _mm_loadu_ps(pb), _mm_loadu_ps(pb + 4), _mm_loadu_ps(pb + 8), _mm_loadu_ps(pb + 12) };
+		__m128 m[4];
+		_multiply(ma, mb, m);
+		_store(&out[i * 16], m);
+	}
+}
+
+static void _kernel_transform(const float* m, const float* in, float* out, uint32_t count) {
+	__m128 columns[4] = { _mm_loadu_ps(m), _mm_loadu_ps(m + 4), _mm_loadu_ps(m + 8), _mm_loadu_ps(m + 12) };
+	for (uint32_t i = 0; i < count; i++) {
+		__m128 v = _mm_loadu_ps(&in[i * 4]);
+		__m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+		__m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+		__m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+		__m128 w = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+		_mm_storeu_ps(&out[i * 4], _mm_add_ps(_mm_add_ps(_mm_mul_ps(columns[0], x), _mm_mul_ps(columns[1], y)), _mm_add_ps(_mm_mul_ps(columns[2], z), _mm_mul_ps(columns[3], w))));
+	}
+}
+
+const math_bench_kernels_t math_bench_sse = {
+	"sse",
+	true,
+	_kernel_look_at,
+	_kernel_camera,
+	_kernel_compose,
+	_kernel_multiply,
+	_kernel_transform,
+	NULL,
+};
+#else
+const math_bench_kernels_t math_bench_sse = {
+	"sse",
+	false,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+	NULL,
+};
+#endif
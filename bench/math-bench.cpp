@@ -0,0 +1,316 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <chrono>
+#include <gtc/type_ptr.hpp>
+#include "math-bench.h"
+#include "opengl-camera.h"
+#include "math-simd.h"
+
+#define ITEM_COUNT		1024			//ÿL2
+#define MIN_BATCH_MS	20.0			//ÿμʱô
+#define TRIALS			5				//ȡһ
+
+typedef struct _bench_data_s {
+	float* eyes;
+	float* targets;
+	float* poses;
+	float* params;
+	float* a;
+	float* b;
+	float* affine;
+	float* out;
+	float* planes;
+}_bench_data_t;
+
+enum {
+	KERNEL_LOOK_AT,
+	KERNEL_CAMERA,
+	KERNEL_COMPOSE,
+	KERNEL_MULTIPLY,
+	KERNEL_TRANSFORM,
+	KERNEL_INVERSE,
+	KERNEL_COUNT,
+};
+
+static const char* _kernel_names[KERNEL_COUNT] = { "look_at", "camera", "compose", "multiply", "transform", "inverse" };
+//glmȽϵݲmax(1, |ֵ|)ţ׶ƽڹһʱŴԶƽߵһ㷨ſһЩ
+static const float _kernel_tolerances[KERNEL_COUNT] = { 1e-5f, 1e-4f, 1e-5f, 1e-5f, 1e-5f, 1e-4f };
+
+static float _random(uint32_t* seed, float lo, float hi) {
+	*seed = *seed * 1664525u + 1013904223u;
+	return lo + (hi - lo) * (float)(*seed >> 8) / (float)(1u << 24);
+}
+
+static void _run_kernel(const math_bench_kernels_t* k, int kernel, _bench_data_t* d) {
+	if (kernel == KERNEL_LOOK_AT) {
+		k->look_at(d->eyes, d->targets, d->out, ITEM_COUNT);
+	}
+	if (kernel == KERNEL_CAMERA) {
+		k->camera(d->poses, d->out, d->planes, ITEM_COUNT);
+	}
+	if (kernel == KERNEL_COMPOSE) {
+		k->compose(d->params, d->out, ITEM_COUNT);
+	}
+	if (kernel == KERNEL_MULTIPLY) {
+		k->multiply(d->a, d->b, d->out, ITEM_COUNT);
+	}
+	if (kernel == KERNEL_TRANSFORM) {
+		k->transform(d->a, d->b, d->out, ITEM_COUNT);
+	}
+	if (kernel == KERNEL_INVERSE) {
+		k->inverse(d->affine, d->out, ITEM_COUNT);
+	}
+}
+
+static bool _has_kernel(const math_bench_kernels_t* k, int kernel) {
+	if (!k->available) {
+		return false;
+	}
+	if (kernel == KERNEL_TRANSFORM) {
+		return k->transform != NULL;
+	}
+	if (kernel == KERNEL_INVERSE) {
+		return k->inverse != NULL;
+	}
+	return true;
+}
+
+//AVXķ뵥Ԫڱ֧ʱܻCPU֧ʱܵ
+static bool _cpu_supports(const math_bench_kernels_t* k) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	if (k == &math_bench_layer_avx) {
+		return __builtin_cpu_supports("avx");
+	}
+#endif
+	return true;
+}
+
+//ʵʵõ·ֻglmĬһ
+static void _run_project(int kernel, _bench_data_t* d) {
+	if (kernel == KERNEL_LOOK_AT) {
+		const glm::vec3 world_up(0.0f, 1.0f, 0.0f);
+		for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+			glm::mat4 m = mylookAt(glm::make_vec3(&d->eyes[i * 3]), glm::make_vec3(&d->targets[i * 3]), world_up);
+			memcpy(&d->out[i * 16], glm::value_ptr(m), sizeof(float) * 16);
+		}
+	}
+	if (kernel == KERNEL_CAMERA) {
+		//ÿζȡʱؽÿһ̬൱ÿ֡ڶ
+		static opengl_camera_t camera;
+		opengl_camera_init(&camera, glm::vec3(0.0f), 0.0f, -90.0f, MATH_BENCH_ASPECT);
+		for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+			const float* pose = &d->poses[i * MATH_BENCH_CAMERA_STRIDE];
+			opengl_camera_set_pose(&camera, glm::make_vec3(pose), pose[3], pose[4], MATH_BENCH_FOVY);
+			const opengl_frustum_t* frustum = opengl_camera_frustum(&camera);
+			memcpy(&d->out[i * 16], glm::value_ptr(camera.view_projection), sizeof(float) * 16);
+			memcpy(&d->planes[i * 24], frustum->planes, sizeof(float) * 24);
+		}
+	}
+	if (kernel == KERNEL_COMPOSE) {
+		for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+			const float* p = &d->params[i * 4];
+			glm::mat4 model = glm::mat4(1.0f);
+			model = glm::translate(model, glm::make_vec3(p));
+			model = glm::rotate(model, p[3], glm::vec3(1.0f, 0.3f, 0.5f));
+			memcpy(&d->out[i * 16], glm::value_ptr(model), sizeof(float) * 16);
+		}
+	}
+	if (kernel == KERNEL_MULTIPLY) {
+		for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+			glm::mat4 m = glm::make_mat4(&d->a[i * 16]) * glm::make_mat4(&d->b[i * 16]);
+			memcpy(&d->out[i * 16], glm::value_ptr(m), sizeof(float) * 16);
+		}
+	}
+	if (kernel == KERNEL_TRANSFORM) {
+		glm::mat4 m = glm::make_mat4(d->a);
+		for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+			glm::vec4 v = m * glm::make_vec4(&d->b[i * 4]);
+			memcpy(&d->out[i * 4], glm::value_ptr(v), sizeof(float) * 4);
+		}
+	}
+	if (kernel == KERNEL_INVERSE) {
+		for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+			glm::mat4 m = glm::inverse(glm::make_mat4(&d->affine[i * 16]));
+			memcpy(&d->out[i * 16], glm::value_ptr(m), sizeof(float) * 16);
+		}
+	}
+}
+
+//ÿ
+static double _time_ns(const math_bench_kernels_t* k, int kernel, _bench_data_t* d) {
+	double best = 1e30;
+	for (int trial = 0; trial < TRIALS; trial++) {
+		uint32_t batches = 0;
+		auto begin = std::chrono::steady_clock::now();
+		double elapsed;
+		do {
+			if (k) {
+				_run_kernel(k, kernel, d);
+			} else {
+				_run_project(kernel, d);
+			}
+			batches++;
+			elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+		} while (elapsed < MIN_BATCH_MS);
+		double ns = elapsed * 1.0e6 / ((double)batches * ITEM_COUNT);
+		if (ns < best) {
+			best = ns;
+		}
+	}
+	return best;
+}
+
+static float _max_diff(const float* a, const float* b, uint32_t count) {
+	float diff = 0.0f;
+	for (uint32_t i = 0; i < count; i++) {
+		diff = fmaxf(diff, fabsf(a[i] - b[i]));
+	}
+	return diff;
+}
+
+static float _max_relative_diff(const float* reference, const float* b, uint32_t count) {
+	float diff = 0.0f;
+	for (uint32_t i = 0; i < count; i++) {
+		diff = fmaxf(diff, fabsf(reference[i] - b[i]) / fmaxf(1.0f, fabsf(reference[i])));
+	}
+	return diff;
+}
+
+//ں˱Ƚ׶ƽ棬Ƚ
+static uint32_t _output_floats(int kernel) {
+	if (kernel == KERNEL_CAMERA) {
+		return ITEM_COUNT * 24;
+	}
+	if (kernel == KERNEL_TRANSFORM) {
+		return ITEM_COUNT * 4;
+	}
+	return ITEM_COUNT * 16;
+}
+
+static const float* _output(int kernel, const _bench_data_t* d) {
+	return kernel == KERNEL_CAMERA ? d->planes : d->out;
+}
+
+//math-simd.hSIMDںҪ16ֽڶ
+static float* _alloc(size_t floats) {
+	float* p = (float*)malloc(floats * sizeof(float));
+	if (p == NULL || ((uintptr_t)p & 15) != 0) {
+		printf("ERROR::MATH_BENCH::ALLOC: buffer is not 16-byte aligned\n");
+		abort();
+	}
+	return p;
+}
+
+int main(void) {
+	_bench_data_t d;
+	d.eyes = _alloc(ITEM_COUNT * 3);
+	d.targets = _alloc(ITEM_COUNT * 3);
+	d.poses = _alloc(ITEM_COUNT * MATH_BENCH_CAMERA_STRIDE);
+	d.params = _alloc(ITEM_COUNT * 4);
+	d.a = _alloc(ITEM_COUNT * 16);
+	d.b = _alloc(ITEM_COUNT * 16);
+	d.affine = _alloc(ITEM_COUNT * 16);
+	d.out = _alloc(ITEM_COUNT * 16);
+	d.planes = _alloc(ITEM_COUNT * 24);
+	float* reference = _alloc(ITEM_COUNT * 24);
+
+	uint32_t seed = 1;
+	for (uint32_t i = 0; i < ITEM_COUNT * 3; i++) {
+		d.eyes[i] = _random(&seed, -20.0f, 20.0f);
+		d.targets[i] = _random(&seed, -20.0f, 20.0f);
+	}
+	for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+		float* pose = &d.poses[i * MATH_BENCH_CAMERA_STRIDE];
+		pose[0] = _random(&seed, -20.0f, 20.0f);
+		pose[1] = _random(&seed, -20.0f, 20.0f);
+		pose[2] = _random(&seed, -20.0f, 20.0f);
+		pose[3] = _random(&seed, -180.0f, 180.0f);
+		pose[4] = _random(&seed, -89.0f, 89.0f);
+		float* p = &d.params[i * 4];
+		p[0] = _random(&seed, -20.0f, 20.0f);
+		p[1] = _random(&seed, -20.0f, 20.0f);
+		p[2] = _random(&seed, -20.0f, 20.0f);
+		p[3] = _random(&seed, -3.14159f, 3.14159f);
+	}
+	for (uint32_t i = 0; i < ITEM_COUNT * 16; i++) {
+		d.a[i] = _random(&seed, -2.0f, 2.0f);
+		d.b[i] = _random(&seed, -2.0f, 2.0f);
+	}
+	//ģ;ƽơתϲȱ
+	for (uint32_t i = 0; i < ITEM_COUNT; i++) {
+		const float* p = &d.params[i * 4];
+		glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::make_vec3(p));
+		model = glm::rotate(model, p[3], glm::vec3(1.0f, 0.3f, 0.5f));
+		model = glm::scale(model, glm::vec3(_random(&seed, 0.5f, 2.0f), _random(&seed, 0.5f, 2.0f), _random(&seed, 0.5f, 2.0f)));
+		memcpy(&d.affine[i * 16], glm::value_ptr(model), sizeof(float) * 16);
+	}
+
+	const math_bench_kernels_t* backends[] = {
+		&math_bench_glm, &math_bench_glm_simd, &math_bench_sse,
+		&math_bench_layer_scalar, &math_bench_layer_sse, &math_bench_layer_avx,
+	};
+	const uint32_t backend_count = sizeof(backends) / sizeof(backends[0]);
+
+	printf("math kernels, %u items per batch, best of %d trials; max_diff is against the project path (default glm)\n", ITEM_COUNT, TRIALS);
+	printf("project path: mylookAt, opengl_camera set_pose + frustum (math-simd.h %s), glm::translate/rotate per object, glm mat4 *, glm::inverse\n", MATH_BACKEND_NAME);
+	printf("%-10s %-10s %10s %10s %10s %10s\n", "kernel", "backend", "ns/op", "Mops/s", "speedup", "max_diff");
+	for (int kernel = 0; kernel < KERNEL_COUNT; kernel++) {
+		//·ĽΪ
+		double base = _time_ns(NULL, kernel, &d);
+		memcpy(reference, _output(kernel, &d), _output_floats(kernel) * sizeof(float));
+		printf("%-10s %-10s %10.2f %10.1f %10.2f %10s\n", _kernel_names[kernel], "project", base, 1000.0 / base, 1.0, "-");
+		for (uint32_t b = 0; b < backend_count; b++) {
+			const math_bench_kernels_t* k = backends[b];
+			if (!_has_kernel(k, kernel) || !_cpu_supports(k)) {
+				printf("%-10s %-10s %10s\n", _kernel_names[kernel], k->name, "n/a");
+				continue;
+			}
+			double ns = _time_ns(k, kernel, &d);
+			//׶ƽȾУں˱Ƚƽ
+			float diff = _max_diff(reference, _output(kernel, &d), _output_floats(kernel));
+			printf("%-10s %-10s %10.2f %10.1f %10.2f %10.2e\n", _kernel_names[kernel], k->name, ns, 1000.0 / ns, base / ns, diff);
+		}
+	}
+
+	//һԼ飺math-simd.hÿ˶ҪglmĬõĽһ£򷵻1
+	const math_bench_kernels_t* layers[] = { &math_bench_layer_scalar, &math_bench_layer_sse, &math_bench_layer_avx };
+	int failures = 0;
+	printf("\nconformance of math-simd.h against glm, relative error\n");
+	printf("%-10s %-10s %10s %10s %6s\n", "kernel", "backend", "error", "tolerance", "");
+	for (int kernel = 0; kernel < KERNEL_COUNT; kernel++) {
+		_run_kernel(&math_bench_glm, kernel, &d);
+		memcpy(reference, _output(kernel, &d), _output_floats(kernel) * sizeof(float));
+		for (uint32_t l = 0; l < sizeof(layers) / sizeof(layers[0]); l++) {
+			const math_bench_kernels_t* k = layers[l];
+			if (!_has_kernel(k, kernel) || !_cpu_supports(k)) {
+				printf("%-10s %-10s %10s\n", _kernel_names[kernel], k->name, "n/a");
+				continue;
+			}
+			memset(d.out, 0, ITEM_COUNT * 16 * sizeof(float));
+			memset(d.planes, 0, ITEM_COUNT * 24 * sizeof(float));
+			_run_kernel(k, kernel, &d);
+			float error = _max_relative_diff(reference, _output(kernel, &d), _output_floats(kernel));
+			bool ok = error <= _kernel_tolerances[kernel];
+			failures += ok ? 0 : 1;
+			printf("%-10s %-10s %10.2e %10.2e %6s\n", _kernel_names[kernel], k->name, error, _kernel_tolerances[kernel], ok ? "ok" : "FAIL");
+		}
+	}
+
+	free(d.eyes);
+	free(d.targets);
+	free(d.poses);
+	free(d.params);
+	free(d.a);
+	free(d.b);
+	free(d.affine);
+	free(d.out);
+	free(d.planes);
+	free(reference);
+	if (failures > 0) {
+		printf("ERROR::MATH_BENCH::CONFORMANCE: %d checks failed\n", failures);
+		return 1;
+	}
+	return 0;
+}
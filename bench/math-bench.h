@@ -0,0 +1,33 @@
+_Pragma("once")
+
+#include <cstdint>
+
+//һѧں˵Ĳͬʵ֣ǽеfloat͸ʵڲͲ޹
+//16floatƽ水xyzw
+#define MATH_BENCH_CAMERA_STRIDE	5			//x y z yaw pitch
+#define MATH_BENCH_FOVY				45.0f
+#define MATH_BENCH_ASPECT			(16.0f / 9.0f)
+
+typedef struct math_bench_kernels_s {
+	const char* name;
+	bool available;		//Ŀ겻֧ʱΪfalseָΪNULL
+	//mylookAtͬeyestargetsÿ3floatϷ̶Ϊ+Y
+	void (*look_at)(const float* eyes, const float* targets, float* out, uint32_t count);
+	//opengl_camera̬õview_projection׶ͬposesÿMATH_BENCH_CAMERA_STRIDEfloatplanesÿ24float
+	void (*camera)(const float* poses, float* view_projections, float* planes, uint32_t count);
+	//translate(pos) * rotate(angle, (1, 0.3, 0.5))ʾÿģ;ͬparamsÿxyz+angle
+	void (*compose)(const float* params, float* out, uint32_t count);
+	void (*multiply)(const float* a, const float* b, float* out, uint32_t count);
+	//ͬһ任countvec4m16floatin/outÿ4float
+	void (*transform)(const float* m, const float* in, float* out, uint32_t count);
+	//(һ0 0 0 1)棻ĳʵûںʱΪNULL
+	void (*inverse)(const float* in, float* out, uint32_t count);
+}math_bench_kernels_t;
+
+extern const math_bench_kernels_t math_bench_glm;			//glmĬ
+extern const math_bench_kernels_t math_bench_glm_simd;		//GLM_FORCE_INTRINSICS + 
+extern const math_bench_kernels_t math_bench_sse;			//дSSE2
+//main/math-simd.hˣҪ16ֽڶ
+extern const math_bench_kernels_t math_bench_layer_scalar;
+extern const math_bench_kernels_t math_bench_layer_sse;
+extern const math_bench_kernels_t math_bench_layer_avx;
@@ -0,0 +1,90 @@
+#include <cstdio>
+#include <chrono>
+#include <gtc/matrix_transform.hpp>
+#include <gtc/type_ptr.hpp>
+#include "opengl-meshlet.h"
+#include "opengl-culling.h"
+
+//ͳһӽɼ(沢׶)Ϊ޳ЧĲ
+static uint32_t _count_visible_triangles(const opengl_mesh_t* mesh, const opengl_frustum_t* frustum, const glm::vec3& camera) {
+	uint32_t visible = 0;
+	for (uint32_t i = 0; i < mesh->index_count; i += 3) {
+		glm::vec3 a = glm::make_vec3(&mesh->positions[mesh->indices[i] * 3]);
+		glm::vec3 b = glm::make_vec3(&mesh->positions[mesh->indices[i + 1] * 3]);
+		glm::vec3 c = glm::make_vec3(&mesh->positions[mesh->indices[i + 2] * 3]);
+		if (glm::dot(glm::cross(b - a, c - a), a - camera) >= 0.0f) {
+			continue;
+		}
+		glm::vec3 center = (a + b + c) / 3.0f;
+		float radius = glm::sqrt(glm::max(glm::dot(a - center, a - center), glm::max(glm::dot(b - center, b - center), glm::dot(c - center, c - center))));
+		if (opengl_frustum_test_sphere(frustum, glm::vec4(center, radius))) {
+			visible++;
+		}
+	}
+	return visible;
+}
+
+static double _cull_time_us(opengl_meshlet_cull_t* cull, bool simd, const glm::mat4& model, const glm::mat4& vp, const glm::vec3& camera) {
+	const int iterations = 200;
+	cull->simd = simd;
+	auto begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++) {
+		opengl_meshlet_cull_run(cull, model, vp, camera);
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::micro>(end - begin).count() / iterations;
+}
+
+static void _bench_mesh(uint32_t slices, uint32_t stacks) {
+	opengl_mesh_t mesh;
+	opengl_mesh_create_sphere(&mesh, slices, stacks);
+
+	auto begin = std::chrono::steady_clock::now();
+	opengl_mesh_build_meshlets(&mesh, OPENGL_MESHLET_MAX_VERTICES, OPENGL_MESHLET_MAX_TRIANGLES);
+	auto end = std::chrono::steady_clock::now();
+
+	opengl_meshlet_cull_t cull;
+	opengl_meshlet_cull_create(&cull, &mesh);
+
+	uint32_t triangle_count = mesh.index_count / 3;
+	printf("\nsphere %ux%u: %u triangles, %u meshlets (%.1f tris/meshlet), build %.1f ms\n",
+		slices, stacks, triangle_count, mesh.meshlet_count, (float)triangle_count / mesh.meshlet_count,
+		std::chrono::duration<double, std::milli>(end - begin).count());
+	printf("%8s %6s %10s %10s %10s %8s %10s %10s %6s\n",
+		"distance", "angle", "total", "submitted", "visible", "ratio", "scalar_us", "sse_us", "draws");
+
+	const float distances[] = { 1.5f, 3.0f, 10.0f };
+	const float angles[] = { 0.0f, 90.0f, 180.0f, 270.0f };
+	glm::mat4 model = glm::mat4(1.0f);
+	glm::mat4 projection = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 100.0f);
+
+	for (float distance : distances) {
+		for (float angle : angles) {
+			//ת΢ƫģһִ׶
+			glm::vec3 camera(distance * sinf(glm::radians(angle)), 0.3f, distance * cosf(glm::radians(angle)));
+			glm::mat4 view = glm::lookAt(camera, glm::vec3(0.4f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+			glm::mat4 vp = projection * view;
+
+			opengl_frustum_t frustum;
+			opengl_frustum_from_matrix(&frustum, vp);
+			uint32_t visible = _count_visible_triangles(&mesh, &frustum, camera);
+
+			double scalar_us = _cull_time_us(&cull, false, model, vp, camera);
+			double sse_us = _cull_time_us(&cull, true, model, vp, camera);
+			printf("%8.1f %6.0f %10u %10u %10u %8.2f %10.2f %10.2f %6u\n",
+				distance, angle, triangle_count, cull.triangles_submitted, visible,
+				cull.triangles_submitted ? (float)visible / cull.triangles_submitted : 0.0f,
+				scalar_us, sse_us, cull.draw_count);
+		}
+	}
+	opengl_meshlet_cull_destroy(&cull);
+	opengl_mesh_destroy(&mesh);
+}
+
+int main(void) {
+	printf("meshlet culling: submitted = triangles left after cluster culling, visible = front-facing triangles inside the frustum\n");
+	_bench_mesh(256, 128);
+	_bench_mesh(512, 256);
+	_bench_mesh(1024, 512);
+	return 0;
+}
@@ -0,0 +1,128 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <gtc/matrix_transform.hpp>
+#include "opengl-particles.h"
+#include "math-simd.h"
+
+//ͬһȪֱñ任CPU SIMDģ⣬Ƚϲͬÿ֡ĸºͻʱ
+//ÿ׶κ涼glFinishʱGPUִУCPUģĸʱϴ
+#define PARTICLE_BENCH_WIDTH	1280
+#define PARTICLE_BENCH_HEIGHT	720
+#define PARTICLE_BENCH_WARMUP	30
+#define PARTICLE_BENCH_FRAMES	120
+#define PARTICLE_BENCH_LIFETIME	2.0f
+#define PARTICLE_BENCH_DT		(1.0f / 60.0f)
+
+typedef struct _bench_timing_s {
+	double update_ms;
+	double draw_ms;
+}_bench_timing_t;
+
+static double _now_ms() {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void _run(uint32_t capacity, opengl_particles_mode_t mode, job_pool_t* jobs, const glm::mat4& view_projection, float point_scale, _bench_timing_t* timing) {
+	opengl_particles_t particles;
+	opengl_particles_init(&particles, capacity, mode, jobs);
+	opengl_particle_emitter_t emitter;
+	emitter.position = glm::vec3(0.0f, -1.0f, 0.0f);
+	emitter.velocity = glm::vec3(0.0f, 3.0f, 0.0f);
+	emitter.spread = 0.6f;
+	emitter.lifetime = PARTICLE_BENCH_LIFETIME;
+	//һʼͷӶŵ֮ȶʲ
+	opengl_particles_emit(&particles, &emitter, capacity);
+	uint32_t per_frame = (uint32_t)(capacity / PARTICLE_BENCH_LIFETIME * PARTICLE_BENCH_DT);
+	glm::vec3 gravity(0.0f, -2.5f, 0.0f);
+	glFinish();
+
+	timing->update_ms = 0.0;
+	timing->draw_ms = 0.0;
+	for (uint32_t frame = 0; frame < PARTICLE_BENCH_WARMUP + PARTICLE_BENCH_FRAMES; frame++) {
+		double begin = _now_ms();
+		opengl_particles_emit(&particles, &emitter, per_frame);
+		opengl_particles_update(&particles, PARTICLE_BENCH_DT, gravity);
+		glFinish();
+		double middle = _now_ms();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		opengl_particles_draw(&particles, view_projection, point_scale);
+		glFinish();
+		double end = _now_ms();
+		if (frame >= PARTICLE_BENCH_WARMUP) {
+			timing->update_ms += middle - begin;
+			timing->draw_ms += end - middle;
+		}
+	}
+	timing->update_ms /= PARTICLE_BENCH_FRAMES;
+	timing->draw_ms /= PARTICLE_BENCH_FRAMES;
+	opengl_particles_destroy(&particles);
+}
+
+int main() {
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	GLFWwindow* window = glfwCreateWindow(PARTICLE_BENCH_WIDTH, PARTICLE_BENCH_HEIGHT, "GLFW-Demo-Particle-Bench", NULL, NULL);
+	if (window == NULL) {
+		printf("Failed to create GLFW window\n");
+		glfwTerminate();
+		abort();
+	}
+	glfwMakeContextCurrent(window);
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+		printf("Failed to initialize GLAD\n");
+		abort();
+	}
+
+	unsigned int framebuffer, color, depth;
+	glGenFramebuffers(1, &framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glGenTextures(1, &color);
+	glBindTexture(GL_TEXTURE_2D, color);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, PARTICLE_BENCH_WIDTH, PARTICLE_BENCH_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);//ѡֹ޸
+	glGenRenderbuffers(1, &depth);
+	glBindRenderbuffer(GL_RENDERBUFFER, depth);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, PARTICLE_BENCH_WIDTH, PARTICLE_BENCH_HEIGHT);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depth);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		printf("ERROR::BENCH::FRAMEBUFFER_INCOMPLETE\n");
+		abort();
+	}
+	glViewport(0, 0, PARTICLE_BENCH_WIDTH, PARTICLE_BENCH_HEIGHT);
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glfwSwapInterval(0);
+
+	job_pool_t jobs;
+	job_pool_create(&jobs, 0, 0);
+	glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)PARTICLE_BENCH_WIDTH / PARTICLE_BENCH_HEIGHT, 0.1f, 100.0f);
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.5f, 4.0f), glm::vec3(0.0f, 0.5f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	float point_scale = projection[1][1] * 0.5f * PARTICLE_BENCH_HEIGHT * 0.02f;
+
+	printf("%s %s, %dx%d offscreen, %u workers, cpu backend %s, %u frames after %u warmup\n", (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION),
+		PARTICLE_BENCH_WIDTH, PARTICLE_BENCH_HEIGHT, jobs.worker_count, MATH_BACKEND_NAME, PARTICLE_BENCH_FRAMES, PARTICLE_BENCH_WARMUP);
+	printf("%10s %12s %10s %12s %10s %10s\n", "particles", "gpu_update", "gpu_draw", "cpu_update", "cpu_draw", "speedup");
+	const uint32_t counts[] = { 16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024 };
+	for (uint32_t capacity : counts) {
+		_bench_timing_t gpu, cpu;
+		_run(capacity, OPENGL_PARTICLES_GPU, &jobs, projection * view, point_scale, &gpu);
+		_run(capacity, OPENGL_PARTICLES_CPU, &jobs, projection * view, point_scale, &cpu);
+		//֡ʱ֮ȣ1ʾ任
+		printf("%10u %12.3f %10.3f %12.3f %10.3f %10.2f\n", capacity, gpu.update_ms, gpu.draw_ms, cpu.update_ms, cpu.draw_ms,
+			(cpu.update_ms + cpu.draw_ms) / (gpu.update_ms + gpu.draw_ms));
+	}
+
+	job_pool_destroy(&jobs);
+	glDeleteFramebuffers(1, &framebuffer);
+	glDeleteTextures(1, &color);
+	glDeleteRenderbuffers(1, &depth);
+	glfwTerminate();
+	return 0;
+}
@@ -0,0 +1,450 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include "opengl-examples.h"
+#include "alloc-counter.h"
+#include "gl-draw-counter.h"
+#include "camera-path.h"
+#include "gl-capture.h"
+#include "opengl-hud.h"
+
+//ÿͬһ·Ⱦ̶֡JSON/CSVԺͱĻCSVȽ
+#define BENCH_WIDTH				1280
+#define BENCH_HEIGHT			720
+#define BENCH_DEFAULT_FRAMES	300
+#define BENCH_DEFAULT_WARMUP	30
+#define BENCH_DEFAULT_THRESHOLD	10.0		//ٷֱȣô˻
+#define BENCH_QUERY_COUNT		4			//ʱѯĻϼ֡Ľÿ֡GPU
+#define BENCH_MAX_LINE			1024
+
+typedef struct _bench_options_s {
+	uint32_t frames;
+	uint32_t warmup;
+	const char* scene;			//ֻĳNULLʾȫ
+	const char* json_path;
+	const char* csv_path;
+	const char* baseline_path;
+	double threshold;
+	camera_path_t* camera;		//¼Ƶ·NULLʱõ·
+	gl_capture_t* capture;		//GL¼glfw-demo-replayNULLʾ¼
+	opengl_hud_t* hud;			//ÿ֡ڳ滭ͳ壬cpuʱ
+}_bench_options_t;
+
+typedef struct _bench_result_s {
+	const char* scene;
+	uint32_t frames;
+	double cpu_avg_ms;			//֡ʼύʱ
+	double cpu_p95_ms;
+	double cpu_max_ms;
+	double gpu_avg_ms;			//GL_TIME_ELAPSED
+	double gpu_p95_ms;
+	double draw_calls;			//ÿ֡
+	double heap_allocs;			//ÿ֡
+	double rss_mb;				//֮ĳפڴ
+}_bench_result_t;
+
+static opengl_ctx_t opengl_ctx;
+
+static double _now_ms() {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//ȷ·һߺһҰͷ·֡޹
+static void _camera_path(opengl_camera_t* camera, uint32_t frame, uint32_t frames) {
+	float t = frames > 1 ? (float)frame / (float)(frames - 1) : 0.0f;
+	float phase = t * 6.2831853f;
+	glm::vec3 pos(2.0f * sinf(phase), 0.5f + 0.5f * sinf(2.0f * phase), 3.0f + 6.0f * t);
+	opengl_camera_set_pose(camera, pos, -90.0f + 25.0f * sinf(phase), -10.0f * t, 45.0f);
+}
+
+static double _percentile(double* values, uint32_t count, double p) {
+	if (count == 0) {
+		return 0.0;
+	}
+	std::sort(values, values + count);
+	uint32_t index = (uint32_t)(p * (count - 1) + 0.5);
+	return values[index];
+}
+
+static void _run_scene(opengl_scene_type_t type, const _bench_options_t* options, unsigned int framebuffer, _bench_result_t* result) {
+	//ÿӸɾĿʼһµ״̬Ӱ
+	memset(&opengl_ctx, 0, sizeof(opengl_ctx));
+	opengl_ctx.viewport_width = BENCH_WIDTH;
+	opengl_ctx.viewport_height = BENCH_HEIGHT;
+	opengl_camera_init(&opengl_ctx.camera, glm::vec3(0.0f, 0.0f, 3.0f), 0.0f, -90.0f, (float)BENCH_WIDTH / (float)BENCH_HEIGHT);
+	job_pool_create(&opengl_ctx.jobs, 0, 0);
+	frame_arena_init(&opengl_ctx.frame_arena, FRAME_ARENA_DEFAULT_SIZE, &opengl_ctx.jobs);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glViewport(0, 0, BENCH_WIDTH, BENCH_HEIGHT);
+	glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+	opengl_shader_program_create(&opengl_ctx, type);
+	opengl_scene_create(&opengl_ctx, type);
+	opengl_shader_program_use(&opengl_ctx);
+
+	unsigned int queries[BENCH_QUERY_COUNT];
+	glGenQueries(BENCH_QUERY_COUNT, queries);
+	double* cpu = (double*)malloc(options->frames * sizeof(double));
+	double* gpu = (double*)malloc(options->frames * sizeof(double));
+	uint32_t gpu_count = 0;
+	uint64_t draw_calls = 0;
+	uint64_t allocs = 0;
+	double last_ms = 0.0;
+
+	uint32_t total = options->warmup + options->frames;
+	for (uint32_t frame = 0; frame < total; frame++) {
+		bool measured = frame >= options->warmup;
+		uint32_t index = measured ? frame - options->warmup : 0;
+		//λõĲѯBENCH_QUERY_COUNT֮֡ǰģȡõ
+		if (frame >= BENCH_QUERY_COUNT && frame - BENCH_QUERY_COUNT >= options->warmup) {
+			GLuint64 elapsed = 0;
+			glGetQueryObjectui64v(queries[frame % BENCH_QUERY_COUNT], GL_QUERY_RESULT, &elapsed);
+			gpu[gpu_count++] = elapsed / 1.0e6;
+		}
+		if (options->camera) {
+			//ÿ֡ƽһģⲽ¼ʱ֡޹
+			camera_path_apply(options->camera, index, &opengl_ctx.camera, &opengl_ctx.time);
+		} else {
+			_camera_path(&opengl_ctx.camera, index, options->frames);
+			opengl_ctx.time = (measured ? index : 0) / 60.0;
+		}
+
+		uint64_t draws_before = gl_draw_counter_get();
+		uint64_t allocs_before = alloc_counter_app();
+		double begin = _now_ms();
+		glBeginQuery(GL_TIME_ELAPSED, queries[frame % BENCH_QUERY_COUNT]);
+		frame_arena_begin_frame(&opengl_ctx.frame_arena);
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		opengl_scene_draw(&opengl_ctx, type);
+		if (options->hud) {
+			opengl_hud_stats_t stats;
+			stats.frame_ms = last_ms;
+			stats.draw_calls = gl_draw_counter_get() - draws_before;
+			stats.heap_allocs = alloc_counter_app() - allocs_before;
+			frame_arena_stats_t arena;
+			frame_arena_get_stats(&opengl_ctx.frame_arena, &arena);
+			stats.arena_bytes = arena.used;
+			stats.resident_mb = 0.0;
+			opengl_hud_draw(options->hud, &stats, BENCH_WIDTH, BENCH_HEIGHT);
+		}
+		glEndQuery(GL_TIME_ELAPSED);
+		glFlush();
+		double end = _now_ms();
+		last_ms = end - begin;
+		if (options->capture) {
+			gl_capture_frame(options->capture);
+		}
+		if (measured) {
+			cpu[index] = end - begin;
+			draw_calls += gl_draw_counter_get() - draws_before;
+			allocs += alloc_counter_app() - allocs_before;
+		}
+	}
+	for (uint32_t frame = total; frame < total + BENCH_QUERY_COUNT; frame++) {
+		if (frame >= BENCH_QUERY_COUNT && frame - BENCH_QUERY_COUNT >= options->warmup) {
+			GLuint64 elapsed = 0;
+			glGetQueryObjectui64v(queries[frame % BENCH_QUERY_COUNT], GL_QUERY_RESULT, &elapsed);
+			gpu[gpu_count++] = elapsed / 1.0e6;
+		}
+	}
+	glDeleteQueries(BENCH_QUERY_COUNT, queries);
+
+	memset(result, 0, sizeof(*result));
+	result->scene = opengl_scene_name(type);
+	result->frames = options->frames;
+	for (uint32_t i = 0; i < options->frames; i++) {
+		result->cpu_avg_ms += cpu[i] / options->frames;
+		result->cpu_max_ms = std::max(result->cpu_max_ms, cpu[i]);
+	}
+	result->cpu_p95_ms = _percentile(cpu, options->frames, 0.95);
+	for (uint32_t i = 0; i < gpu_count; i++) {
+		result->gpu_avg_ms += gpu[i] / gpu_count;
+	}
+	result->gpu_p95_ms = _percentile(gpu, gpu_count, 0.95);
+	result->draw_calls = (double)draw_calls / options->frames;
+	result->heap_allocs = (double)allocs / options->frames;
+	result->rss_mb = alloc_counter_resident_mb();
+	free(cpu);
+	free(gpu);
+
+	opengl_scene_destroy(&opengl_ctx);
+	opengl_shader_program_destroy(&opengl_ctx);
+	frame_arena_destroy(&opengl_ctx.frame_arena);
+	job_pool_destroy(&opengl_ctx.jobs);
+}
+
+static void _write_json(const char* path, const _bench_result_t* results, uint32_t count, const _bench_options_t* options) {
+	FILE* file = fopen(path, "w");
+	if (file == NULL) {
+		printf("ERROR::BENCH::OPEN_FAILED: %s\n", path);
+		return;
+	}
+	fprintf(file, "{\n  \"width\": %d,\n  \"height\": %d,\n  \"frames\": %u,\n  \"warmup\": %u,\n  \"scenes\": [\n",
+		BENCH_WIDTH, BENCH_HEIGHT, options->frames, options->warmup);
+	for (uint32_t i = 0; i < count; i++) {
+		const _bench_result_t* r = &results[i];
+		fprintf(file, "    {\"scene\": \"%s\", \"frames\": %u, \"cpu_avg_ms\": %.4f, \"cpu_p95_ms\": %.4f, \"cpu_max_ms\": %.4f, "
+			"\"gpu_avg_ms\": %.4f, \"gpu_p95_ms\": %.4f, \"draw_calls\": %.2f, \"heap_allocs\": %.2f, \"rss_mb\": %.2f}%s\n",
+			r->scene, r->frames, r->cpu_avg_ms, r->cpu_p95_ms, r->cpu_max_ms, r->gpu_avg_ms, r->gpu_p95_ms,
+			r->draw_calls, r->heap_allocs, r->rss_mb, i + 1 < count ? "," : "");
+	}
+	fprintf(file, "  ]\n}\n");
+	fclose(file);
+}
+
+static const char* _csv_header = "scene,frames,cpu_avg_ms,cpu_p95_ms,cpu_max_ms,gpu_avg_ms,gpu_p95_ms,draw_calls,heap_allocs,rss_mb";
+
+static void _write_csv(const char* path, const _bench_result_t* results, uint32_t count) {
+	FILE* file = fopen(path, "w");
+	if (file == NULL) {
+		printf("ERROR::BENCH::OPEN_FAILED: %s\n", path);
+		return;
+	}
+	fprintf(file, "%s\n", _csv_header);
+	for (uint32_t i = 0; i < count; i++) {
+		const _bench_result_t* r = &results[i];
+		fprintf(file, "%s,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.2f,%.2f,%.2f\n", r->scene, r->frames, r->cpu_avg_ms, r->cpu_p95_ms,
+			r->cpu_max_ms, r->gpu_avg_ms, r->gpu_p95_ms, r->draw_calls, r->heap_allocs, r->rss_mb);
+	}
+	fclose(file);
+}
+
+//һָͻ߱ȽϣֵҾԲֵ޲˻
+static bool _regressed(const char* scene, const char* metric, double current, double baseline, double threshold, double floor) {
+	if (current <= baseline * (1.0 + threshold / 100.0) || current - baseline <= floor) {
+		return false;
+	}
+	printf("  REGRESSION %-18s %-12s %10.3f -> %10.3f (%+.1f%%)\n", scene, metric, baseline, current,
+		baseline > 0.0 ? (current / baseline - 1.0) * 100.0 : 100.0);
+	return true;
+}
+
+//֮ǰ--csvļ򲻿ûһܽûһԵʱfalseregressions˻ָ
+static bool _compare_baseline(const char* path, const _bench_result_t* results, uint32_t count, double threshold, uint32_t* regressions) {
+	*regressions = 0;
+	FILE* file = fopen(path, "r");
+	if (file == NULL) {
+		printf("ERROR::BENCH::BASELINE_NOT_FOUND: %s\n", path);
+		return false;
+	}
+	printf("\nbaseline %s, threshold %.1f%%\n", path, threshold);
+	uint32_t rows = 0;
+	uint32_t matched = 0;
+	char line[BENCH_MAX_LINE];
+	while (fgets(line, sizeof(line), file)) {
+		char scene[64];
+		_bench_result_t b;
+		if (sscanf(line, "%63[^,],%u,%lf,%lf,%lf,%lf,%lf,%lf,%lf,%lf", scene, &b.frames, &b.cpu_avg_ms, &b.cpu_p95_ms, &b.cpu_max_ms,
+			&b.gpu_avg_ms, &b.gpu_p95_ms, &b.draw_calls, &b.heap_allocs, &b.rss_mb) != 10) {
+			continue;	//ͷ߸ʽԵ
+		}
+		rows++;
+		for (uint32_t i = 0; i < count; i++) {
+			const _bench_result_t* r = &results[i];
+			if (strcmp(r->scene, scene) != 0) {
+				continue;
+			}
+			matched++;
+			*regressions += _regressed(scene, "cpu_avg_ms", r->cpu_avg_ms, b.cpu_avg_ms, threshold, 0.05);
+			*regressions += _regressed(scene, "cpu_p95_ms", r->cpu_p95_ms, b.cpu_p95_ms, threshold, 0.05);
+			*regressions += _regressed(scene, "gpu_avg_ms", r->gpu_avg_ms, b.gpu_avg_ms, threshold, 0.05);
+			*regressions += _regressed(scene, "gpu_p95_ms", r->gpu_p95_ms, b.gpu_p95_ms, threshold, 0.05);
+			//ôͷȷģ˻
+			*regressions += _regressed(scene, "draw_calls", r->draw_calls, b.draw_calls, 0.0, 0.5);
+			*regressions += _regressed(scene, "heap_allocs", r->heap_allocs, b.heap_allocs, 0.0, 0.5);
+			*regressions += _regressed(scene, "rss_mb", r->rss_mb, b.rss_mb, threshold, 8.0);
+		}
+	}
+	fclose(file);
+	if (rows == 0) {
+		printf("ERROR::BENCH::BASELINE_PARSE_FAILED: %s\n", path);
+		return false;
+	}
+	if (matched == 0) {
+		printf("ERROR::BENCH::BASELINE_NO_MATCHING_SCENE: %s\n", path);
+		return false;
+	}
+	printf("%u of %u scenes matched the baseline, %u regressions\n", matched, count, *regressions);
+	return true;
+}
+
+static void _usage(const char* program) {
+	printf("usage: %s [--frames N] [--warmup N] [--scene NAME] [--json PATH] [--csv PATH] [--baseline PATH] [--threshold PERCENT] [--camera PATH] [--capture PATH] [--hud]\n", program);
+	printf("  --camera replays a path recorded by glfw-demo, one simulation tick per frame; --frames defaults to its length\n");
+	printf("  --capture records every GL call to PATH for glfw-demo-replay; cpu times include the recording overhead\n");
+	printf("  --hud draws the stats overlay on every frame, its cost shows up in cpu times and as one extra draw\n");
+}
+
+int main(int argc, char** argv) {
+	_bench_options_t options;
+	options.frames = BENCH_DEFAULT_FRAMES;
+	options.warmup = BENCH_DEFAULT_WARMUP;
+	options.scene = NULL;
+	options.json_path = NULL;
+	options.csv_path = NULL;
+	options.baseline_path = NULL;
+	options.threshold = BENCH_DEFAULT_THRESHOLD;
+	options.camera = NULL;
+	options.capture = NULL;
+	options.hud = NULL;
+	bool hud = false;
+	const char* camera_path = NULL;
+	const char* capture_path = NULL;
+	bool frames_set = false;
+	for (int i = 1; i < argc; i++) {
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+		//Ŀ
+		if (strcmp(arg, "--hud") == 0) {
+			hud = true;
+			continue;
+		}
+		if (value == NULL) {
+			_usage(argv[0]);
+			return 2;
+		}
+		if (strcmp(arg, "--frames") == 0) {
+			options.frames = (uint32_t)atoi(value);
+			frames_set = true;
+		} else if (strcmp(arg, "--warmup") == 0) {
+			options.warmup = (uint32_t)atoi(value);
+		} else if (strcmp(arg, "--scene") == 0) {
+			options.scene = value;
+		} else if (strcmp(arg, "--json") == 0) {
+			options.json_path = value;
+		} else if (strcmp(arg, "--csv") == 0) {
+			options.csv_path = value;
+		} else if (strcmp(arg, "--baseline") == 0) {
+			options.baseline_path = value;
+		} else if (strcmp(arg, "--threshold") == 0) {
+			options.threshold = atof(value);
+		} else if (strcmp(arg, "--camera") == 0) {
+			camera_path = value;
+		} else if (strcmp(arg, "--capture") == 0) {
+			capture_path = value;
+		} else {
+			_usage(argv[0]);
+			return 2;
+		}
+		i++;
+	}
+	camera_path_t camera;
+	if (camera_path) {
+		if (!camera_path_load(&camera, camera_path)) {
+			return 2;
+		}
+		options.camera = &camera;
+		if (!frames_set) {
+			options.frames = (uint32_t)camera.header.tick_count + 1;
+		}
+	}
+	if (options.frames == 0) {
+		options.frames = 1;
+	}
+
+	//ڲʾֻģг̶С֡ϣʹڴС޹
+	glfwInit();
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	GLFWwindow* window = glfwCreateWindow(BENCH_WIDTH, BENCH_HEIGHT, "GLFW-Demo-Bench", NULL, NULL);
+	if (window == NULL) {
+		printf("Failed to create GLFW window\n");
+		glfwTerminate();
+		abort();
+	}
+	glfwMakeContextCurrent(window);
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+		printf("Failed to initialize GLAD\n");
+		abort();
+	}
+	gl_draw_counter_hook();
+	//֡ĴҲ¼ȥطʱͬȾĿ
+	gl_capture_t capture;
+	if (capture_path) {
+		if (!gl_capture_begin(&capture, capture_path)) {
+			abort();
+		}
+		options.capture = &capture;
+	}
+	opengl_hud_t overlay;
+	if (hud) {
+		opengl_hud_init(&overlay);
+		options.hud = &overlay;
+	}
+
+	unsigned int framebuffer, color, depth;
+	glGenFramebuffers(1, &framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glGenTextures(1, &color);
+	glBindTexture(GL_TEXTURE_2D, color);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, BENCH_WIDTH, BENCH_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);//ѡֹ޸
+	glGenRenderbuffers(1, &depth);
+	glBindRenderbuffer(GL_RENDERBUFFER, depth);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, BENCH_WIDTH, BENCH_HEIGHT);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depth);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		printf("ERROR::BENCH::FRAMEBUFFER_INCOMPLETE\n");
+		abort();
+	}
+	glfwSwapInterval(0);
+
+	printf("%s %s, %dx%d offscreen, %u frames after %u warmup\n", (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION),
+		BENCH_WIDTH, BENCH_HEIGHT, options.frames, options.warmup);
+	printf("%-18s %9s %9s %9s %9s %9s %8s %8s %8s\n", "scene", "cpu_avg", "cpu_p95", "cpu_max", "gpu_avg", "gpu_p95", "draws", "allocs", "rss_mb");
+
+	_bench_result_t results[TYPE_SCENE_COUNT];
+	uint32_t count = 0;
+	uint32_t allocating = 0;
+	for (int type = 0; type < TYPE_SCENE_COUNT; type++) {
+		const char* name = opengl_scene_name((opengl_scene_type_t)type);
+		if (options.scene && strstr(name, options.scene) == NULL) {
+			continue;
+		}
+		_bench_result_t* r = &results[count++];
+		_run_scene((opengl_scene_type_t)type, &options, framebuffer, r);
+		printf("%-18s %9.3f %9.3f %9.3f %9.3f %9.3f %8.1f %8.1f %8.1f\n", r->scene, r->cpu_avg_ms, r->cpu_p95_ms, r->cpu_max_ms,
+			r->gpu_avg_ms, r->gpu_p95_ms, r->draw_calls, r->heap_allocs, r->rss_mb);
+		//Ԥ֮֡Ӧжѷ䣬ֻһ֡ƽֵҲ0
+		if (r->heap_allocs > 0.0) {
+			printf("ERROR::BENCH::STEADY_STATE_ALLOCATIONS: %s %.2f per frame\n", r->scene, r->heap_allocs);
+			allocating++;
+		}
+	}
+
+	glDeleteFramebuffers(1, &framebuffer);
+	glDeleteTextures(1, &color);
+	glDeleteRenderbuffers(1, &depth);
+	if (options.hud) {
+		opengl_hud_destroy(options.hud);
+	}
+	if (options.capture) {
+		gl_capture_end(options.capture);
+	}
+	glfwTerminate();
+	if (options.camera) {
+		camera_path_destroy(options.camera);
+	}
+
+	if (options.json_path) {
+		_write_json(options.json_path, results, count, &options);
+	}
+	if (options.csv_path) {
+		_write_csv(options.csv_path, results, count);
+	}
+	uint32_t regressions = 0;
+	if (options.baseline_path && !_compare_baseline(options.baseline_path, results, count, options.threshold, &regressions)) {
+		return 1;	//Ҫ˶ԱȴûԱȣܵû˻
+	}
+	return regressions > 0 || allocating > 0 ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <gtc/matrix_transform.hpp>
+#include "scene-graph.h"
+
+//1000ÿ10ӽڵ㣬4㣬Լ111ڵ
+#define ROOT_COUNT		1000
+#define BRANCHING		10
+#define DEPTH			3
+#define ITERATIONS		10
+
+static double _elapsed_ms(std::chrono::steady_clock::time_point begin) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+static glm::mat4 _local(uint32_t i, float angle) {
+	glm::mat4 local = glm::translate(glm::mat4(1.0f), glm::vec3((float)(i % 7), 1.0f, (float)(i % 5)));
+	return glm::rotate(local, angle + i * 0.1f, glm::vec3(0.0f, 1.0f, 0.0f));
+}
+
+static void _add_subtree(scene_graph_t* graph, uint32_t parent, uint32_t depth) {
+	uint32_t node = scene_graph_add(graph, parent, _local(graph->count, 0.0f));
+	if (depth == 0) {
+		return;
+	}
+	for (uint32_t i = 0; i < BRANCHING; i++) {
+		_add_subtree(graph, node, depth - 1);
+	}
+}
+
+int main(void) {
+	scene_graph_t graph;
+	scene_graph_init(&graph, 0);
+	auto begin = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < ROOT_COUNT; i++) {
+		_add_subtree(&graph, SCENE_GRAPH_NONE, DEPTH);
+	}
+	double build_ms = _elapsed_ms(begin);
+	scene_graph_update_all(&graph);
+
+	begin = std::chrono::steady_clock::now();
+	for (int i = 0; i < ITERATIONS; i++) {
+		scene_graph_update_all(&graph);
+	}
+	double full_ms = _elapsed_ms(begin) / ITERATIONS;
+
+	printf("scene graph: %u nodes, depth %u, build %.1f ms, full update %.2f ms\n", graph.count, DEPTH + 1, build_ms, full_ms);
+	printf("%6s %8s %10s %10s %10s %10s %10s\n", "nodes", "changed", "changed_%", "updated", "updated_%", "update_ms", "vs_full_%");
+
+	//any: ڵľֲڲڵʱһ㣻leaf: ֻҶӣ൱ֻĩڶ
+	const float fractions[] = { 0.001f, 0.01f, 0.1f };
+	uint32_t seed = 1;
+	for (uint32_t run = 0; run < 6; run++) {
+		uint32_t mode = run / 3;
+		float fraction = fractions[run % 3];
+		uint32_t changes = (uint32_t)(graph.count * fraction);
+		uint64_t updated = 0;
+		double update_ms = 0.0;
+		for (int it = 0; it < ITERATIONS; it++) {
+			for (uint32_t i = 0; i < changes; i++) {
+				seed = seed * 1664525u + 1013904223u;
+				uint32_t node = (seed >> 4) % graph.count;
+				if (mode == 1) {
+					node = graph.subtree_ends[node] - 1;
+				}
+				scene_graph_set_local(&graph, node, _local(node, (float)it));
+			}
+			begin = std::chrono::steady_clock::now();
+			updated += scene_graph_update(&graph);
+			update_ms += _elapsed_ms(begin);
+		}
+		update_ms /= ITERATIONS;
+		updated /= ITERATIONS;
+		printf("%6s %8u %10.1f %10llu %10.1f %10.3f %10.1f\n", mode == 0 ? "any" : "leaf", changes, fraction * 100.0f,
+			(unsigned long long)updated, 100.0 * updated / graph.count, update_ms, 100.0 * update_ms / full_ms);
+	}
+
+	scene_graph_destroy(&graph);
+	return 0;
+}
@@ -0,0 +1,162 @@
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+#include <cstdio>
+#include "alloc-counter.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+static std::atomic<uint64_t> _alloc_total(0);
+static std::atomic<uint64_t> _alloc_app(0);
+static thread_local uint64_t _alloc_thread = 0;
+
+#if defined(__GLIBC__)
+//Ŀִļεֹصַ˵ǹ̴õ
+extern "C" char __executable_start;
+extern "C" char etext;
+#define _ALLOC_CALLER()		__builtin_return_address(0)
+
+static bool _alloc_from_app(void* caller) {
+	return (char*)caller >= &__executable_start && (char*)caller < &etext;
+}
+#else
+#define _ALLOC_CALLER()		NULL
+
+static bool _alloc_from_app(void* caller) {
+	return true;
+}
+#endif
+
+static void _alloc_count(void* caller) {
+	_alloc_thread++;
+	_alloc_total.fetch_add(1, std::memory_order_relaxed);
+	if (_alloc_from_app(caller)) {
+		_alloc_app.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+uint64_t alloc_counter_thread() {
+	return _alloc_thread;
+}
+
+uint64_t alloc_counter_total() {
+	return _alloc_total.load(std::memory_order_relaxed);
+}
+
+uint64_t alloc_counter_app() {
+	return _alloc_app.load(std::memory_order_relaxed);
+}
+
+double alloc_counter_resident_mb() {
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return 0.0;
+	}
+	return counters.WorkingSetSize / (1024.0 * 1024.0);
+#else
+	FILE* file = fopen("/proc/self/statm", "r");
+	if (file == NULL) {
+		return 0.0;
+	}
+	long size = 0;
+	long resident = 0;
+	if (fscanf(file, "%ld %ld", &size, &resident) != 2) {
+		resident = 0;
+	}
+	fclose(file);
+	return resident * (double)sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+#endif
+}
+
+#if defined(__GLIBC__)
+//ִļﶨmallocḲlibcģķ佻glibc__libc_*operator newҲ
+extern "C" {
+	void* __libc_malloc(size_t size);
+	void* __libc_calloc(size_t count, size_t size);
+	void* __libc_realloc(void* p, size_t size);
+	void* __libc_memalign(size_t align, size_t size);
+
+	void* malloc(size_t size) {
+		_alloc_count(_ALLOC_CALLER());
+		return __libc_malloc(size);
+	}
+
+	void* calloc(size_t count, size_t size) {
+		_alloc_count(_ALLOC_CALLER());
+		return __libc_calloc(count, size);
+	}
+
+	void* realloc(void* p, size_t size) {
+		_alloc_count(_ALLOC_CALLER());
+		return __libc_realloc(p, size);
+	}
+
+	void* aligned_alloc(size_t align, size_t size) {
+		_alloc_count(_ALLOC_CALLER());
+		return __libc_memalign(align, size);
+	}
+
+	int posix_memalign(void** out, size_t align, size_t size) {
+		_alloc_count(_ALLOC_CALLER());
+		*out = __libc_memalign(align, size);
+		return *out ? 0 : ENOMEM;
+	}
+}
+
+//libstdc++operator newmallocʱصַlibstdc++Ҳ滻ܰnewĵ
+void* operator new(size_t size) {
+	_alloc_count(_ALLOC_CALLER());
+	void* p = __libc_malloc(size ? size : 1);
+	if (p == NULL) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](size_t size) {
+	_alloc_count(_ALLOC_CALLER());
+	void* p = __libc_malloc(size ? size : 1);
+	if (p == NULL) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+#else
+void* operator new(size_t size) {
+	_alloc_count(_ALLOC_CALLER());
+	void* p = malloc(size ? size : 1);
+	if (p == NULL) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new[](size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+	free(p);
+}
+
+void operator delete[](void* p) noexcept {
+	free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+	free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+	free(p);
+}
+#endif
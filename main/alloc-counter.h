@@ -0,0 +1,17 @@
+_Pragma("once")
+
+#include <cstdint>
+
+//ͳƶѷȷȶʱÿ֡ûжѷ
+//glibc滻malloc/calloc/reallocͳƵCC++з䣻ƽֻ̨ͳoperator new
+//GLڵ߳ϵķҲᱻͳƽȥ
+
+//ǰ߳ۼƵķ
+extern uint64_t alloc_counter_thread();
+//߳ۼƵķ
+extern uint64_t alloc_counter_total();
+//߳ɿִļԼĴֱӷķ䣬GLlibcȶ̬ڲķ䲻㣬ÿ֡ķ
+//ֻglibc֣ƽ̨alloc_counter_totalͬ
+extern uint64_t alloc_counter_app();
+//̵ĳפڴ棬/procڴ棬Ҫÿ֡
+extern double alloc_counter_resident_mb();
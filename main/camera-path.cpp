@@ -0,0 +1,136 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "camera-path.h"
+
+static void _pack_state(float* out, const sim_state_t* state) {
+	out[0] = state->camera_pos.x;
+	out[1] = state->camera_pos.y;
+	out[2] = state->camera_pos.z;
+	out[3] = state->camera_yaw;
+	out[4] = state->camera_pitch;
+	out[5] = state->camera_zoom;
+}
+
+static void _unpack_state(const float* in, sim_state_t* state) {
+	state->camera_pos = glm::vec3(in[0], in[1], in[2]);
+	state->camera_yaw = in[3];
+	state->camera_pitch = in[4];
+	state->camera_zoom = in[5];
+}
+
+void camera_path_init(camera_path_t* path, double dt, const sim_state_t* initial) {
+	memset(path, 0, sizeof(*path));
+	path->header.magic = CAMERA_PATH_MAGIC;
+	path->header.version = CAMERA_PATH_VERSION;
+	path->header.dt = dt;
+	_pack_state(path->header.initial, initial);
+}
+
+void camera_path_destroy(camera_path_t* path) {
+	if (path->record_capacity) {
+		free(path->records);
+	}
+	file_map_close(&path->map);
+	memset(path, 0, sizeof(*path));
+}
+
+void camera_path_record(camera_path_t* path, uint64_t tick, const sim_input_t* input, const sim_state_t* state) {
+	path->header.tick_count = tick;
+	if (input->mouse_dx == 0.0f && input->mouse_dy == 0.0f && input->scroll == 0.0f && input->moves == 0) {
+		return;
+	}
+	if (path->header.record_count == path->record_capacity) {
+		path->record_capacity = path->record_capacity ? path->record_capacity * 2 : 1024;
+		path->records = (camera_path_record_t*)realloc(path->records, path->record_capacity * sizeof(camera_path_record_t));
+	}
+	camera_path_record_t* record = &path->records[path->header.record_count++];
+	record->tick = (uint32_t)tick;
+	record->moves = input->moves;
+	record->mouse_dx = input->mouse_dx;
+	record->mouse_dy = input->mouse_dy;
+	record->scroll = input->scroll;
+	_pack_state(record->camera, state);
+}
+
+bool camera_path_write(const camera_path_t* path, const char* file) {
+	FILE* fp = fopen(file, "wb");
+	if (fp == NULL) {
+		printf("ERROR::CAMERA_PATH::WRITE_FAILED: %s\n", file);
+		return false;
+	}
+	bool ok = fwrite(&path->header, sizeof(path->header), 1, fp) == 1
+		&& (path->header.record_count == 0 || fwrite(path->records, sizeof(camera_path_record_t), path->header.record_count, fp) == path->header.record_count);
+	ok = (fclose(fp) == 0) && ok;
+	if (!ok) {
+		printf("ERROR::CAMERA_PATH::WRITE_FAILED: %s\n", file);
+	}
+	return ok;
+}
+
+bool camera_path_load(camera_path_t* path, const char* file) {
+	memset(path, 0, sizeof(*path));
+	if (!file_map_open(&path->map, file)) {
+		printf("ERROR::CAMERA_PATH::OPEN_FAILED: %s\n", file);
+		return false;
+	}
+	if (path->map.size < sizeof(camera_path_header_t)) {
+		printf("ERROR::CAMERA_PATH::INVALID_FILE: %s\n", file);
+		file_map_close(&path->map);
+		return false;
+	}
+	memcpy(&path->header, path->map.data, sizeof(path->header));
+	const camera_path_header_t* header = &path->header;
+	if (header->magic != CAMERA_PATH_MAGIC
+		|| header->version != CAMERA_PATH_VERSION
+		|| header->dt <= 0.0
+		|| path->map.size < sizeof(camera_path_header_t) + (uint64_t)header->record_count * sizeof(camera_path_record_t)) {
+		printf("ERROR::CAMERA_PATH::INVALID_FILE: %s\n", file);
+		file_map_close(&path->map);
+		return false;
+	}
+	path->records = (camera_path_record_t*)(path->map.data + sizeof(camera_path_header_t));
+	return true;
+}
+
+bool camera_path_state(camera_path_t* path, uint64_t tick, sim_state_t* state) {
+	bool in_range = tick <= path->header.tick_count;
+	if (!in_range) {
+		tick = path->header.tick_count;
+	}
+	//һtickҪļ¼˳طʱϴελһ͵
+	uint32_t count = path->header.record_count;
+	uint32_t i = path->cursor;
+	if (i > count || (i > 0 && path->records[i - 1].tick > tick)) {
+		uint32_t lo = 0;
+		uint32_t hi = count;
+		while (lo < hi) {
+			uint32_t mid = (lo + hi) / 2;
+			if (path->records[mid].tick <= tick) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		i = lo;
+	} else {
+		while (i < count && path->records[i].tick <= tick) {
+			i++;
+		}
+	}
+	path->cursor = i;
+	//iǵһtickļ¼
+	_unpack_state(i > 0 ? path->records[i - 1].camera : path->header.initial, state);
+	state->time = (double)tick * path->header.dt;
+	return in_range;
+}
+
+bool camera_path_apply(camera_path_t* path, uint64_t tick, opengl_camera_t* camera, double* time) {
+	sim_state_t state;
+	bool in_range = camera_path_state(path, tick, &state);
+	opengl_camera_set_pose(camera, state.camera_pos, state.camera_yaw, state.camera_pitch, state.camera_zoom);
+	if (time) {
+		*time = state.time;
+	}
+	return in_range;
+}
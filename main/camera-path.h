@@ -0,0 +1,50 @@
+_Pragma("once")
+
+#include <cstdint>
+#include "sim-loop.h"
+#include "opengl-camera.h"
+#include "file-map.h"
+
+#define CAMERA_PATH_MAGIC		0x48544150	//"PATH"
+#define CAMERA_PATH_VERSION		1
+
+//ļͷrecord_count¼
+typedef struct camera_path_header_s {
+	uint32_t magic;
+	uint32_t version;
+	double dt;					//¼ʱģⲽ
+	uint64_t tick_count;		//¼Ƶܲ
+	uint32_t record_count;
+	uint32_t reserved;
+	float initial[6];			//0λxyzyawpitchzoom
+}camera_path_header_t;
+
+//ֻ¼ĲûĲ䣬ֹʱռռ
+typedef struct camera_path_record_s {
+	uint32_t tick;				//ִһ֮ܲ1ʼһʱ(tick * dt)
+	uint32_t moves;
+	float mouse_dx;				//һԭʼ룬طŲãŲ¼
+	float mouse_dy;
+	float scroll;
+	float camera[6];			//һ֮initialͬ
+}camera_path_record_t;
+
+//¼ʱ¼ڴУ˳ʱһдطʱ¼ֱָֻӳ
+typedef struct camera_path_s {
+	camera_path_header_t header;
+	camera_path_record_t* records;
+	uint32_t record_capacity;	//Ϊ0ʱrecordsָӳ
+	uint32_t cursor;			//һβѯļ¼˳طʱÿζ
+	file_map_t map;
+}camera_path_t;
+
+extern void camera_path_init(camera_path_t* path, double dt, const sim_state_t* initial);
+extern void camera_path_destroy(camera_path_t* path);
+//tickִһ֮ܲҪ
+extern void camera_path_record(camera_path_t* path, uint64_t tick, const sim_input_t* input, const sim_state_t* state);
+extern bool camera_path_write(const camera_path_t* path, const char* file);
+extern bool camera_path_load(camera_path_t* path, const char* file);
+
+//tick֮״̬ʱtick * dt¼ƷΧʱ״̬false
+extern bool camera_path_state(camera_path_t* path, uint64_t tick, sim_state_t* state);
+extern bool camera_path_apply(camera_path_t* path, uint64_t tick, opengl_camera_t* camera, double* time);
@@ -0,0 +1,343 @@
+#include "debug-draw.h"
+
+#if DEBUG_DRAW
+#include <glad/glad.h>
+#include <atomic>
+#include <mutex>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstddef>
+#include <gtc/type_ptr.hpp>
+
+#define _MESH_VERTEX_COUNT	(2 + 24 + 3 * DEBUG_DRAW_SPHERE_SEGMENTS * 2)
+
+//ǼǱһ߳˳ownedбûһȡ߳
+typedef struct _debug_draw_slot_s {
+	debug_draw_list_t list;
+	std::mutex mutex;			//Ӻflush֮
+	bool owned;
+	struct _debug_draw_slot_s* next;
+}_debug_draw_slot_t;
+
+//̻߳бgeneration_ctxĲͬʱ˵мdestroyҪȡ
+typedef struct _debug_draw_thread_s {
+	_debug_draw_slot_t* slot;
+	uint32_t generation;
+	~_debug_draw_thread_s();
+}_debug_draw_thread_t;
+
+typedef struct _debug_draw_s {
+	std::mutex registry_mutex;	//slotsownedgeneration
+	_debug_draw_slot_t* slots;
+	std::atomic<uint32_t> generation;
+	std::atomic<bool> enabled;
+	unsigned int program;
+	int view_projection_location;
+	unsigned int vao;
+	unsigned int mesh_vbo;
+	unsigned int instance_vbo;
+	uint32_t mesh_first[DEBUG_DRAW_SHAPE_COUNT];	//λmesh_vboλãGL_LINES
+	uint32_t mesh_count[DEBUG_DRAW_SHAPE_COUNT];
+}_debug_draw_t;
+
+static _debug_draw_t _ctx;
+static thread_local _debug_draw_thread_t _thread;
+
+_debug_draw_thread_s::~_debug_draw_thread_s() {
+	std::lock_guard<std::mutex> lock(_ctx.registry_mutex);
+	if (slot && generation == _ctx.generation.load(std::memory_order_relaxed)) {
+		slot->owned = false;
+	}
+}
+
+static const char* _vertex_shader_source = "#version 330 core\n"
+	"layout (location = 0) in vec3 aPos;\n"
+	"layout (location = 1) in vec3 aOrigin;\n"
+	"layout (location = 2) in vec3 aAxes;\n"
+	"layout (location = 3) in vec4 aColor;\n"
+	"uniform mat4 uViewProjection;\n"
+	"out vec4 vColor;\n"
+	"void main()\n"
+	"{\n"
+	"	gl_Position = uViewProjection * vec4(aOrigin + aPos * aAxes, 1.0);\n"
+	"	vColor = aColor;\n"
+	"}\n";
+
+static const char* _frag_shader_source = "#version 330 core\n"
+	"out vec4 FragColor;\n"
+	"in vec4 vColor;\n"
+	"void main()\n"
+	"{\n"
+	"	FragColor = vColor;\n"
+	"}\n";
+
+static unsigned int _compile(GLenum type, const char* source) {
+	int success;
+	char info[512];
+	unsigned int shader = glCreateShader(type);
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success) {
+		glGetShaderInfoLog(shader, sizeof(info), NULL, info);
+		printf("ERROR::DEBUG_DRAW::SHADER_COMPILATION_FAILED: %s\n", info);
+	}
+	return shader;
+}
+
+//߶Ρʮ⡢Բһ
+static uint32_t _build_mesh(glm::vec3* vertices) {
+	uint32_t count = 0;
+	_ctx.mesh_first[DEBUG_DRAW_SHAPE_LINE] = count;
+	vertices[count++] = glm::vec3(0.0f);
+	vertices[count++] = glm::vec3(1.0f);
+	_ctx.mesh_count[DEBUG_DRAW_SHAPE_LINE] = count - _ctx.mesh_first[DEBUG_DRAW_SHAPE_LINE];
+
+	_ctx.mesh_first[DEBUG_DRAW_SHAPE_BOX] = count;
+	for (int axis = 0; axis < 3; axis++) {
+		//axis⣬ȡ1
+		for (int corner = 0; corner < 4; corner++) {
+			glm::vec3 a(0.0f);
+			a[(axis + 1) % 3] = (corner & 1) ? 1.0f : -1.0f;
+			a[(axis + 2) % 3] = (corner & 2) ? 1.0f : -1.0f;
+			glm::vec3 b = a;
+			a[axis] = -1.0f;
+			b[axis] = 1.0f;
+			vertices[count++] = a;
+			vertices[count++] = b;
+		}
+	}
+	_ctx.mesh_count[DEBUG_DRAW_SHAPE_BOX] = count - _ctx.mesh_first[DEBUG_DRAW_SHAPE_BOX];
+
+	_ctx.mesh_first[DEBUG_DRAW_SHAPE_SPHERE] = count;
+	for (int axis = 0; axis < 3; axis++) {
+		for (int i = 0; i < DEBUG_DRAW_SPHERE_SEGMENTS; i++) {
+			for (int j = i; j <= i + 1; j++) {
+				float angle = 6.2831853f * j / DEBUG_DRAW_SPHERE_SEGMENTS;
+				glm::vec3 p(0.0f);
+				p[(axis + 1) % 3] = cosf(angle);
+				p[(axis + 2) % 3] = sinf(angle);
+				vertices[count++] = p;
+			}
+		}
+	}
+	_ctx.mesh_count[DEBUG_DRAW_SHAPE_SPHERE] = count - _ctx.mesh_first[DEBUG_DRAW_SHAPE_SPHERE];
+	return count;
+}
+
+void debug_draw_init() {
+	unsigned int vertex_shader = _compile(GL_VERTEX_SHADER, _vertex_shader_source);
+	unsigned int frag_shader = _compile(GL_FRAGMENT_SHADER, _frag_shader_source);
+	_ctx.program = glCreateProgram();
+	glAttachShader(_ctx.program, vertex_shader);
+	glAttachShader(_ctx.program, frag_shader);
+	glLinkProgram(_ctx.program);
+	int success;
+	glGetProgramiv(_ctx.program, GL_LINK_STATUS, &success);
+	if (!success) {
+		char info[512];
+		glGetProgramInfoLog(_ctx.program, sizeof(info), NULL, info);
+		printf("ERROR::DEBUG_DRAW::LINK_FAILED: %s\n", info);
+	}
+	glDeleteShader(vertex_shader);
+	glDeleteShader(frag_shader);
+	_ctx.view_projection_location = glGetUniformLocation(_ctx.program, "uViewProjection");
+
+	glm::vec3 vertices[_MESH_VERTEX_COUNT];
+	uint32_t vertex_count = _build_mesh(vertices);
+	glGenVertexArrays(1, &_ctx.vao);
+	glGenBuffers(1, &_ctx.mesh_vbo);
+	glGenBuffers(1, &_ctx.instance_vbo);
+	glBindVertexArray(_ctx.vao);
+	glBindBuffer(GL_ARRAY_BUFFER, _ctx.mesh_vbo);
+	glBufferData(GL_ARRAY_BUFFER, vertex_count * sizeof(glm::vec3), vertices, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+	glEnableVertexAttribArray(0);
+	//ʵԵƫÿλʱ״
+	for (unsigned int i = 1; i <= 3; i++) {
+		glEnableVertexAttribArray(i);
+		glVertexAttribDivisor(i, 1);
+	}
+	glBindVertexArray(0);//ѡֹ޸
+	glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+}
+
+void debug_draw_destroy() {
+	_ctx.enabled.store(false, std::memory_order_relaxed);
+	{
+		//һžб߳´ʱȡ˳ʱҲѾͷŵб
+		std::lock_guard<std::mutex> lock(_ctx.registry_mutex);
+		_ctx.generation.store(_ctx.generation.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		while (_ctx.slots) {
+			_debug_draw_slot_t* slot = _ctx.slots;
+			_ctx.slots = slot->next;
+			for (int s = 0; s < DEBUG_DRAW_SHAPE_COUNT; s++) {
+				free(slot->list.instances[s]);
+			}
+			delete slot;
+		}
+	}
+	glDeleteProgram(_ctx.program);
+	glDeleteVertexArrays(1, &_ctx.vao);
+	glDeleteBuffers(1, &_ctx.mesh_vbo);
+	glDeleteBuffers(1, &_ctx.instance_vbo);
+	_ctx.program = 0;
+	_ctx.vao = 0;
+	_ctx.mesh_vbo = 0;
+	_ctx.instance_vbo = 0;
+}
+
+void debug_draw_set_enabled(bool enabled) {
+	_ctx.enabled.store(enabled && _ctx.program != 0, std::memory_order_relaxed);
+}
+
+bool debug_draw_enabled() {
+	return _ctx.enabled.load(std::memory_order_relaxed);
+}
+
+//̵߳һʱȡһб˳߳µģû½
+static _debug_draw_slot_t* _thread_slot() {
+	uint32_t generation = _ctx.generation.load(std::memory_order_relaxed);
+	if (_thread.slot && _thread.generation == generation) {
+		return _thread.slot;
+	}
+	std::lock_guard<std::mutex> lock(_ctx.registry_mutex);
+	_debug_draw_slot_t* slot = _ctx.slots;
+	while (slot && slot->owned) {
+		slot = slot->next;
+	}
+	if (slot == NULL) {
+		//ж룬̵߳ļụʧЧ
+		slot = new _debug_draw_slot_t();
+		slot->next = _ctx.slots;
+		_ctx.slots = slot;
+	}
+	slot->owned = true;
+	_thread.slot = slot;
+	_thread.generation = generation;
+	return slot;
+}
+
+static void _push(debug_draw_shape_t shape, const glm::vec3& origin, const glm::vec3& axes, uint32_t color) {
+	if (!_ctx.enabled.load(std::memory_order_relaxed)) {
+		return;
+	}
+	_debug_draw_slot_t* slot = _thread_slot();
+	std::lock_guard<std::mutex> lock(slot->mutex);
+	debug_draw_list_t* list = &slot->list;
+	if (list->counts[shape] == list->capacities[shape]) {
+		list->capacities[shape] = list->capacities[shape] ? list->capacities[shape] * 2 : 256;
+		list->instances[shape] = (debug_draw_instance_t*)realloc(list->instances[shape], list->capacities[shape] * sizeof(debug_draw_instance_t));
+	}
+	debug_draw_instance_t* instance = &list->instances[shape][list->counts[shape]++];
+	instance->origin[0] = origin.x;
+	instance->origin[1] = origin.y;
+	instance->origin[2] = origin.z;
+	instance->axes[0] = axes.x;
+	instance->axes[1] = axes.y;
+	instance->axes[2] = axes.z;
+	instance->color = color;
+}
+
+void debug_draw_line(const glm::vec3& a, const glm::vec3& b, uint32_t color) {
+	_push(DEBUG_DRAW_SHAPE_LINE, a, b - a, color);
+}
+
+void debug_draw_box(const glm::vec3& min, const glm::vec3& max, uint32_t color) {
+	_push(DEBUG_DRAW_SHAPE_BOX, (min + max) * 0.5f, (max - min) * 0.5f, color);
+}
+
+void debug_draw_sphere(const glm::vec3& center, float radius, uint32_t color) {
+	_push(DEBUG_DRAW_SHAPE_SPHERE, center, glm::vec3(radius), color);
+}
+
+void debug_draw_axes(const glm::mat4& transform, float size) {
+	if (!debug_draw_enabled()) {
+		return;
+	}
+	glm::vec3 origin(transform[3]);
+	debug_draw_line(origin, origin + glm::vec3(transform[0]) * size, DEBUG_DRAW_RGBA(255, 0, 0, 255));
+	debug_draw_line(origin, origin + glm::vec3(transform[1]) * size, DEBUG_DRAW_RGBA(0, 255, 0, 255));
+	debug_draw_line(origin, origin + glm::vec3(transform[2]) * size, DEBUG_DRAW_RGBA(0, 0, 255, 255));
+}
+
+void debug_draw_frustum(const glm::mat4& view_projection, uint32_t color) {
+	if (!debug_draw_enabled()) {
+		return;
+	}
+	glm::mat4 inverse = glm::inverse(view_projection);
+	glm::vec3 corners[8];
+	for (int i = 0; i < 8; i++) {
+		glm::vec4 p = inverse * glm::vec4((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f, 1.0f);
+		corners[i] = glm::vec3(p) / p.w;
+	}
+	//ŵλֱxyzֻһλ֮һ
+	for (int i = 0; i < 8; i++) {
+		for (int bit = 1; bit < 8; bit <<= 1) {
+			if ((i & bit) == 0) {
+				debug_draw_line(corners[i], corners[i | bit], color);
+			}
+		}
+	}
+}
+
+void debug_draw_flush(const glm::mat4& view_projection) {
+	//flushڼסǼǱбͳƺͿͬһݣӵ̵߳ȿ
+	std::lock_guard<std::mutex> registry_lock(_ctx.registry_mutex);
+	uint32_t counts[DEBUG_DRAW_SHAPE_COUNT] = {};
+	uint32_t total = 0;
+	for (_debug_draw_slot_t* slot = _ctx.slots; slot; slot = slot->next) {
+		slot->mutex.lock();
+		for (int s = 0; s < DEBUG_DRAW_SHAPE_COUNT; s++) {
+			counts[s] += slot->list.counts[s];
+			total += slot->list.counts[s];
+		}
+	}
+	if (total == 0) {
+		for (_debug_draw_slot_t* slot = _ctx.slots; slot; slot = slot->next) {
+			slot->mutex.unlock();
+		}
+		return;
+	}
+
+	//ÿ֡鶪д̵߳б״οӦλãCPUϲ
+	glBindBuffer(GL_ARRAY_BUFFER, _ctx.instance_vbo);
+	glBufferData(GL_ARRAY_BUFFER, total * sizeof(debug_draw_instance_t), NULL, GL_STREAM_DRAW);
+	uint32_t first[DEBUG_DRAW_SHAPE_COUNT];
+	uint32_t offset = 0;
+	for (int s = 0; s < DEBUG_DRAW_SHAPE_COUNT; s++) {
+		first[s] = offset;
+		for (_debug_draw_slot_t* slot = _ctx.slots; slot; slot = slot->next) {
+			debug_draw_list_t* list = &slot->list;
+			if (list->counts[s]) {
+				glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(debug_draw_instance_t), list->counts[s] * sizeof(debug_draw_instance_t), list->instances[s]);
+				offset += list->counts[s];
+				list->counts[s] = 0;
+			}
+		}
+	}
+	for (_debug_draw_slot_t* slot = _ctx.slots; slot; slot = slot->next) {
+		slot->mutex.unlock();
+	}
+
+	GLint current;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+	glUseProgram(_ctx.program);
+	glUniformMatrix4fv(_ctx.view_projection_location, 1, GL_FALSE, glm::value_ptr(view_projection));
+	glBindVertexArray(_ctx.vao);
+	for (int s = 0; s < DEBUG_DRAW_SHAPE_COUNT; s++) {
+		if (counts[s] == 0) {
+			continue;
+		}
+		size_t base = first[s] * sizeof(debug_draw_instance_t);
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(debug_draw_instance_t), (void*)(base + offsetof(debug_draw_instance_t, origin)));
+		glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(debug_draw_instance_t), (void*)(base + offsetof(debug_draw_instance_t, axes)));
+		glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(debug_draw_instance_t), (void*)(base + offsetof(debug_draw_instance_t, color)));
+		glDrawArraysInstanced(GL_LINES, _ctx.mesh_first[s], _ctx.mesh_count[s], counts[s]);
+	}
+	glBindVertexArray(0);//ѡֹ޸
+	glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+	glUseProgram(current);
+}
+#endif
@@ -0,0 +1,71 @@
+_Pragma("once")
+
+#include <cstdint>
+#include <glm.hpp>
+
+//assertһĬֻڵ԰汾룬-DDEBUG_DRAW=0/1ǿ
+#if !defined(DEBUG_DRAW)
+#if defined(NDEBUG)
+#define DEBUG_DRAW	0
+#else
+#define DEBUG_DRAW	1
+#endif
+#endif
+
+#define DEBUG_DRAW_SPHERE_SEGMENTS	32		//ÿԲ߶
+#define DEBUG_DRAW_RGBA(r, g, b, a)	((uint32_t)(r) | ((uint32_t)(g) << 8) | ((uint32_t)(b) << 16) | ((uint32_t)(a) << 24))
+
+typedef enum debug_draw_shape_e {
+	DEBUG_DRAW_SHAPE_LINE,
+	DEBUG_DRAW_SHAPE_BOX,
+	DEBUG_DRAW_SHAPE_SPHERE,
+	DEBUG_DRAW_SHAPE_COUNT,
+}debug_draw_shape_t;
+
+//״ǵλһʵworld = origin + position * axes
+//߶ε(0,0,0)-(1,1,1)axesյ㣻[-1,1]壬axesǰ߳Բaxesǰ뾶
+typedef struct debug_draw_instance_s {
+	float origin[3];
+	float axes[3];
+	uint32_t color;		//DEBUG_DRAW_RGBA
+}debug_draw_instance_t;
+
+//ÿ߳һݣһʱӵǼǱȡʱֻԼбֻflushʱŻ
+typedef struct alignas(64) debug_draw_list_s {
+	debug_draw_instance_t* instances[DEBUG_DRAW_SHAPE_COUNT];
+	uint32_t counts[DEBUG_DRAW_SHAPE_COUNT];
+	uint32_t capacities[DEBUG_DRAW_SHAPE_COUNT];
+}debug_draw_list_t;
+
+#if DEBUG_DRAW
+//Իȫֵģκģ鶼ֱӵãҪĴȥ
+//κ̶߳ӣflushͬʱҲȫ߳˳б̸߳
+//initdestroyflushGL̵߳ãdestroyʱ߳
+extern void debug_draw_init();
+extern void debug_draw_destroy();
+//رʱӵĵֱӷأĬϹر
+extern void debug_draw_set_enabled(bool enabled);
+extern bool debug_draw_enabled();
+
+extern void debug_draw_line(const glm::vec3& a, const glm::vec3& b, uint32_t color);
+extern void debug_draw_box(const glm::vec3& min, const glm::vec3& max, uint32_t color);
+extern void debug_draw_sphere(const glm::vec3& center, float radius, uint32_t color);
+//transformǰлɺ
+extern void debug_draw_axes(const glm::mat4& transform, float size);
+//view_projectionNDCİ˸Ǳռ䣬ʮ
+extern void debug_draw_frustum(const glm::mat4& view_projection, uint32_t color);
+//̵߳б״ƴһʽÿ״һʵƣȻб
+extern void debug_draw_flush(const glm::mat4& view_projection);
+#else
+//ʱչɿ䣬Ҳֵ
+#define debug_draw_init()						((void)0)
+#define debug_draw_destroy()					((void)0)
+#define debug_draw_set_enabled(enabled)			((void)0)
+#define debug_draw_enabled()					false
+#define debug_draw_line(a, b, color)			((void)0)
+#define debug_draw_box(min, max, color)			((void)0)
+#define debug_draw_sphere(center, radius, color)	((void)0)
+#define debug_draw_axes(transform, size)		((void)0)
+#define debug_draw_frustum(view_projection, color)	((void)0)
+#define debug_draw_flush(view_projection)		((void)0)
+#endif
@@ -0,0 +1,151 @@
+#include <cstring>
+#include "ecs-render.h"
+#include "debug-draw.h"
+
+//һ޳ڶ鰴ѾдLOD
+typedef struct _chunk_visible_s {
+	uint16_t* rows;
+	uint8_t* lods;
+	uint32_t count;
+	uint32_t lod_counts[OPENGL_LOD_MAX];
+	uint32_t lod_offsets[OPENGL_LOD_MAX];
+}_chunk_visible_t;
+
+typedef struct _cull_job_s {
+	ecs_chunk_t** chunks;
+	_chunk_visible_t* visible;
+	const ecs_render_components_t* components;
+	frame_arena_t* arena;
+	const opengl_frustum_t* frustum;
+	glm::vec3 camera_pos;
+	const opengl_lod_chain_t* chain;
+	const opengl_lod_selector_t* selector;
+	glm::mat4* packed;
+}_cull_job_t;
+
+typedef struct _animate_job_s {
+	const ecs_render_components_t* components;
+	float time;
+}_animate_job_t;
+
+static void _animate_chunk(void* user, ecs_chunk_t* chunk) {
+	const _animate_job_t* job = (const _animate_job_t*)user;
+	ecs_transform_t* transforms = (ecs_transform_t*)ecs_chunk_column(chunk, job->components->transform);
+	const ecs_animation_t* animations = (const ecs_animation_t*)ecs_chunk_column(chunk, job->components->animation);
+	for (uint32_t i = 0; i < chunk->count; i++) {
+		const ecs_animation_t* animation = &animations[i];
+		transforms[i].rotation = glm::angleAxis(animation->phase + job->time * animation->speed, animation->axis);
+	}
+}
+
+#if DEBUG_DRAW
+static const uint32_t _lod_colors[4] = {
+	DEBUG_DRAW_RGBA(0, 255, 0, 255),
+	DEBUG_DRAW_RGBA(255, 255, 0, 255),
+	DEBUG_DRAW_RGBA(255, 128, 0, 255),
+	DEBUG_DRAW_RGBA(255, 0, 0, 255),
+};
+#endif
+
+static void _cull_chunks(void* user, uint32_t begin, uint32_t end) {
+	const _cull_job_t* job = (const _cull_job_t*)user;
+	for (uint32_t c = begin; c < end; c++) {
+		ecs_chunk_t* chunk = job->chunks[c];
+		const ecs_transform_t* transforms = (const ecs_transform_t*)ecs_chunk_column(chunk, job->components->transform);
+		ecs_bounds_t* bounds = (ecs_bounds_t*)ecs_chunk_column(chunk, job->components->bounds);
+		ecs_render_mesh_t* meshes = (ecs_render_mesh_t*)ecs_chunk_column(chunk, job->components->render_mesh);
+
+		_chunk_visible_t* visible = &job->visible[c];
+		memset(visible->lod_counts, 0, sizeof(visible->lod_counts));
+		visible->rows = FRAME_ARENA_NEW(job->arena, uint16_t, chunk->count);
+		visible->lods = FRAME_ARENA_NEW(job->arena, uint8_t, chunk->count);
+		visible->count = 0;
+		for (uint32_t i = 0; i < chunk->count; i++) {
+			const ecs_transform_t* transform = &transforms[i];
+			ecs_render_mesh_t* mesh = &meshes[i];
+			glm::vec3 center = transform->position + transform->rotation * (mesh->center * transform->scale);
+			glm::vec4 sphere(center, mesh->radius * transform->scale);
+			bounds[i].sphere = sphere;
+			if (!opengl_frustum_test_sphere(job->frustum, sphere)) {
+				continue;
+			}
+			float distance = glm::length(center - job->camera_pos) - sphere.w;
+			uint8_t lod = opengl_lod_select(job->chain, job->selector, distance, transform->scale, (uint8_t)mesh->lod);
+			mesh->lod = lod;
+			//ΧLODɫڹֱ߳
+			debug_draw_sphere(center, sphere.w, _lod_colors[lod % 4]);
+			visible->rows[visible->count] = (uint16_t)i;
+			visible->lods[visible->count] = lod;
+			visible->lod_counts[lod]++;
+			visible->count++;
+		}
+	}
+}
+
+static void _pack_chunks(void* user, uint32_t begin, uint32_t end) {
+	const _cull_job_t* job = (const _cull_job_t*)user;
+	for (uint32_t c = begin; c < end; c++) {
+		const ecs_transform_t* transforms = (const ecs_transform_t*)ecs_chunk_column(job->chunks[c], job->components->transform);
+		const _chunk_visible_t* visible = &job->visible[c];
+		uint32_t cursors[OPENGL_LOD_MAX];
+		memcpy(cursors, visible->lod_offsets, sizeof(cursors));
+		for (uint32_t i = 0; i < visible->count; i++) {
+			const ecs_transform_t* transform = &transforms[visible->rows[i]];
+			glm::mat4 model = glm::mat4_cast(transform->rotation);
+			model[0] *= transform->scale;
+			model[1] *= transform->scale;
+			model[2] *= transform->scale;
+			model[3] = glm::vec4(transform->position, 1.0f);
+			job->packed[cursors[visible->lods[i]]++] = model;
+		}
+	}
+}
+
+void ecs_render_register(ecs_world_t* world, ecs_render_components_t* components) {
+	components->transform = ecs_register_component(world, sizeof(ecs_transform_t));
+	components->animation = ecs_register_component(world, sizeof(ecs_animation_t));
+	components->bounds = ecs_register_component(world, sizeof(ecs_bounds_t));
+	components->render_mesh = ecs_register_component(world, sizeof(ecs_render_mesh_t));
+}
+
+ecs_mask_t ecs_render_mask(const ecs_render_components_t* components) {
+	return ECS_BIT(components->transform) | ECS_BIT(components->bounds) | ECS_BIT(components->render_mesh);
+}
+
+void ecs_render_animate(ecs_world_t* world, const ecs_render_components_t* components, float time) {
+	_animate_job_t job;
+	job.components = components;
+	job.time = time;
+	ecs_run(world, ECS_BIT(components->transform) | ECS_BIT(components->animation), _animate_chunk, &job);
+}
+
+void ecs_render_cull(ecs_world_t* world, const ecs_render_components_t* components, frame_arena_t* arena,
+	const opengl_frustum_t* frustum, const glm::vec3& camera_pos, const opengl_lod_chain_t* chain, const opengl_lod_selector_t* selector,
+	ecs_render_output_t* output) {
+	uint32_t chunk_count;
+	_cull_job_t job;
+	job.chunks = ecs_query(world, ecs_render_mask(components), &chunk_count);
+	job.visible = FRAME_ARENA_NEW(arena, _chunk_visible_t, chunk_count);
+	job.components = components;
+	job.arena = arena;
+	job.frustum = frustum;
+	job.camera_pos = camera_pos;
+	job.chain = chain;
+	job.selector = selector;
+	job_pool_parallel_for(world->jobs, chunk_count, 1, _cull_chunks, &job);
+
+	//Ŀɼǰ׺ͣõÿÿLODдλ
+	uint32_t offset = 0;
+	for (uint32_t lod = 0; lod < OPENGL_LOD_MAX; lod++) {
+		output->lod_offsets[lod] = offset;
+		for (uint32_t c = 0; c < chunk_count; c++) {
+			job.visible[c].lod_offsets[lod] = offset;
+			offset += job.visible[c].lod_counts[lod];
+		}
+		output->lod_counts[lod] = offset - output->lod_offsets[lod];
+	}
+	output->visible_count = offset;
+	output->packed = FRAME_ARENA_NEW(arena, glm::mat4, offset);
+	job.packed = output->packed;
+	job_pool_parallel_for(world->jobs, chunk_count, 4, _pack_chunks, &job);
+}
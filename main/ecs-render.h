@@ -0,0 +1,57 @@
+_Pragma("once")
+
+#include <cstdint>
+#include <glm.hpp>
+#include <gtc/quaternion.hpp>
+#include "ecs.h"
+#include "frame-arena.h"
+#include "opengl-camera.h"
+#include "opengl-lod.h"
+
+typedef struct ecs_transform_s {
+	glm::vec3 position;
+	float scale;			//ֵֻ֧ȱţΧLOD
+	glm::quat rotation;
+}ecs_transform_t;
+
+//ƹ̶ת
+typedef struct ecs_animation_s {
+	glm::vec3 axis;			//λ
+	float speed;			//ÿ
+	float phase;
+}ecs_animation_t;
+
+//ռΧ޳ʱ˳
+typedef struct ecs_bounds_s {
+	glm::vec4 sphere;		//xyz: w:뾶
+}ecs_bounds_t;
+
+typedef struct ecs_render_mesh_s {
+	glm::vec3 center;		//ľֲΧ
+	float radius;
+	uint32_t lod;			//ǰLOD֡ͺж
+}ecs_render_mesh_t;
+
+typedef struct ecs_render_components_s {
+	uint32_t transform;
+	uint32_t animation;
+	uint32_t bounds;
+	uint32_t render_mesh;
+}ecs_render_components_t;
+
+//ɼʵģ;LODֶΣÿһʵ
+typedef struct ecs_render_output_s {
+	glm::mat4* packed;		//֡Ϸ䣬ֻڵǰ֡Ч
+	uint32_t visible_count;
+	uint32_t lod_offsets[OPENGL_LOD_MAX];
+	uint32_t lod_counts[OPENGL_LOD_MAX];
+}ecs_render_output_t;
+
+extern void ecs_render_register(ecs_world_t* world, ecs_render_components_t* components);
+extern ecs_mask_t ecs_render_mask(const ecs_render_components_t* components);
+//ϵͳģʱôʵת
+extern void ecs_render_animate(ecs_world_t* world, const ecs_render_components_t* components, float time);
+//鲢У°Χ׶޳ѡLODȻLODֶβдģ;
+extern void ecs_render_cull(ecs_world_t* world, const ecs_render_components_t* components, frame_arena_t* arena,
+	const opengl_frustum_t* frustum, const glm::vec3& camera_pos, const opengl_lod_chain_t* chain, const opengl_lod_selector_t* selector,
+	ecs_render_output_t* output);
@@ -0,0 +1,325 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "ecs.h"
+
+#define ECS_RECORD_NONE		0xffffffffu
+#define ECS_CHUNKS_PER_JOB	4
+
+typedef struct _ecs_run_s {
+	ecs_chunk_t** chunks;
+	ecs_system_fn fn;
+	void* user;
+}_ecs_run_t;
+
+static uint32_t _align_up(uint32_t value, uint32_t align) {
+	return (value + align - 1) & ~(align - 1);
+}
+
+//ÿһаECS_COLUMN_ALIGN룬capacityʵҪֽ
+static uint32_t _archetype_layout(const ecs_world_t* world, ecs_archetype_t* archetype, uint32_t capacity) {
+	uint32_t offset = 0;
+	archetype->entity_offset = offset;
+	offset = _align_up(offset + capacity * (uint32_t)sizeof(ecs_entity_t), ECS_COLUMN_ALIGN);
+	for (uint32_t i = 0; i < world->component_count; i++) {
+		if (archetype->mask & ECS_BIT(i)) {
+			archetype->offsets[i] = offset;
+			offset = _align_up(offset + capacity * world->components[i].size, ECS_COLUMN_ALIGN);
+		}
+	}
+	return offset;
+}
+
+static ecs_archetype_t* _archetype_get(ecs_world_t* world, ecs_mask_t mask) {
+	for (uint32_t i = 0; i < world->archetype_count; i++) {
+		if (world->archetypes[i]->mask == mask) {
+			return world->archetypes[i];
+		}
+	}
+	ecs_archetype_t* archetype = (ecs_archetype_t*)calloc(1, sizeof(ecs_archetype_t));
+	archetype->mask = mask;
+	uint32_t row_size = sizeof(ecs_entity_t);
+	for (uint32_t i = 0; i < world->component_count; i++) {
+		if (mask & ECS_BIT(i)) {
+			row_size += world->components[i].size;
+		}
+	}
+	//ȰǶдС㣬ټ֮Ҳŵ
+	uint32_t capacity = ECS_CHUNK_SIZE / row_size;
+	while (capacity > 1 && _archetype_layout(world, archetype, capacity) > ECS_CHUNK_SIZE) {
+		capacity--;
+	}
+	if (_archetype_layout(world, archetype, capacity) > ECS_CHUNK_SIZE) {
+		printf("ERROR::ECS::ROW_TOO_LARGE: %u\n", row_size);
+		abort();
+	}
+	archetype->capacity = capacity;
+
+	if (world->archetype_count == world->archetype_capacity) {
+		world->archetype_capacity = world->archetype_capacity ? world->archetype_capacity * 2 : 16;
+		world->archetypes = (ecs_archetype_t**)realloc(world->archetypes, world->archetype_capacity * sizeof(ecs_archetype_t*));
+	}
+	world->archetypes[world->archetype_count++] = archetype;
+	return archetype;
+}
+
+static ecs_chunk_t* _chunk_create(ecs_archetype_t* archetype) {
+	ecs_chunk_t* chunk = (ecs_chunk_t*)malloc(sizeof(ecs_chunk_t));
+	chunk->archetype = archetype;
+	chunk->allocation = malloc(ECS_CHUNK_SIZE + 64);
+	chunk->data = (unsigned char*)(((uintptr_t)chunk->allocation + 63) & ~(uintptr_t)63);
+	chunk->count = 0;
+	if (archetype->chunk_count == archetype->chunk_capacity) {
+		archetype->chunk_capacity = archetype->chunk_capacity ? archetype->chunk_capacity * 2 : 16;
+		archetype->chunks = (ecs_chunk_t**)realloc(archetype->chunks, archetype->chunk_capacity * sizeof(ecs_chunk_t*));
+	}
+	archetype->chunks[archetype->chunk_count++] = chunk;
+	return chunk;
+}
+
+static void _chunk_destroy(ecs_chunk_t* chunk) {
+	free(chunk->allocation);
+	free(chunk);
+}
+
+static ecs_entity_t* _chunk_entities(const ecs_chunk_t* chunk) {
+	return (ecs_entity_t*)(chunk->data + chunk->archetype->entity_offset);
+}
+
+static unsigned char* _chunk_component(const ecs_world_t* world, const ecs_chunk_t* chunk, uint32_t component, uint32_t row) {
+	return chunk->data + chunk->archetype->offsets[component] + (size_t)row * world->components[component].size;
+}
+
+//ԭ͵һĩβ׷һУ
+static void _archetype_push(ecs_world_t* world, ecs_archetype_t* archetype, ecs_entity_t entity, ecs_chunk_t** out_chunk, uint32_t* out_row) {
+	ecs_chunk_t* chunk = archetype->chunk_count ? archetype->chunks[archetype->chunk_count - 1] : NULL;
+	if (chunk == NULL || chunk->count == archetype->capacity) {
+		chunk = _chunk_create(archetype);
+	}
+	uint32_t row = chunk->count++;
+	_chunk_entities(chunk)[row] = entity;
+	for (uint32_t i = 0; i < world->component_count; i++) {
+		if (archetype->mask & ECS_BIT(i)) {
+			memset(_chunk_component(world, chunk, i, row), 0, world->components[i].size);
+		}
+	}
+	archetype->entity_count++;
+	*out_chunk = chunk;
+	*out_row = row;
+}
+
+//ɾһУԭ͵һʵֻ֤һ鲻
+static void _archetype_remove(ecs_world_t* world, ecs_chunk_t* chunk, uint32_t row) {
+	ecs_archetype_t* archetype = chunk->archetype;
+	ecs_chunk_t* last_chunk = archetype->chunks[archetype->chunk_count - 1];
+	uint32_t last_row = last_chunk->count - 1;
+	if (last_chunk != chunk || last_row != row) {
+		ecs_entity_t moved = _chunk_entities(last_chunk)[last_row];
+		_chunk_entities(chunk)[row] = moved;
+		for (uint32_t i = 0; i < world->component_count; i++) {
+			if (archetype->mask & ECS_BIT(i)) {
+				memcpy(_chunk_component(world, chunk, i, row), _chunk_component(world, last_chunk, i, last_row), world->components[i].size);
+			}
+		}
+		ecs_record_t* record = &world->records[moved & ECS_ENTITY_INDEX_MASK];
+		record->chunk = chunk;
+		record->row = row;
+	}
+	last_chunk->count--;
+	archetype->entity_count--;
+	if (last_chunk->count == 0) {
+		_chunk_destroy(last_chunk);
+		archetype->chunk_count--;
+	}
+}
+
+static ecs_record_t* _record_get(const ecs_world_t* world, ecs_entity_t entity) {
+	uint32_t index = entity & ECS_ENTITY_INDEX_MASK;
+	uint32_t generation = entity >> ECS_ENTITY_INDEX_BITS;
+	if (entity == 0 || index >= world->record_count || world->generations[index] != generation || world->records[index].chunk == NULL) {
+		return NULL;
+	}
+	return &world->records[index];
+}
+
+//ᵽһԭͣ߶еԭ
+static void _entity_move(ecs_world_t* world, ecs_entity_t entity, ecs_mask_t mask) {
+	ecs_record_t* record = _record_get(world, entity);
+	if (record == NULL || record->chunk->archetype->mask == mask) {
+		return;
+	}
+	ecs_chunk_t* old_chunk = record->chunk;
+	uint32_t old_row = record->row;
+	ecs_archetype_t* archetype = _archetype_get(world, mask);
+	ecs_chunk_t* chunk;
+	uint32_t row;
+	_archetype_push(world, archetype, entity, &chunk, &row);
+	ecs_mask_t shared = mask & old_chunk->archetype->mask;
+	for (uint32_t i = 0; i < world->component_count; i++) {
+		if (shared & ECS_BIT(i)) {
+			memcpy(_chunk_component(world, chunk, i, row), _chunk_component(world, old_chunk, i, old_row), world->components[i].size);
+		}
+	}
+	_archetype_remove(world, old_chunk, old_row);
+	record->chunk = chunk;
+	record->row = row;
+}
+
+static void _ecs_run_chunks(void* user, uint32_t begin, uint32_t end) {
+	const _ecs_run_t* run = (const _ecs_run_t*)user;
+	for (uint32_t i = begin; i < end; i++) {
+		run->fn(run->user, run->chunks[i]);
+	}
+}
+
+void ecs_world_init(ecs_world_t* world, job_pool_t* jobs) {
+	memset(world, 0, sizeof(*world));
+	world->jobs = jobs;
+	world->free_head = ECS_RECORD_NONE;
+	//λ0֤ʵŲΪ0
+	world->record_capacity = 1024;
+	world->records = (ecs_record_t*)calloc(world->record_capacity, sizeof(ecs_record_t));
+	world->generations = (uint16_t*)calloc(world->record_capacity, sizeof(uint16_t));
+	world->record_count = 1;
+}
+
+void ecs_world_destroy(ecs_world_t* world) {
+	for (uint32_t i = 0; i < world->archetype_count; i++) {
+		ecs_archetype_t* archetype = world->archetypes[i];
+		for (uint32_t j = 0; j < archetype->chunk_count; j++) {
+			_chunk_destroy(archetype->chunks[j]);
+		}
+		free(archetype->chunks);
+		free(archetype);
+	}
+	free(world->archetypes);
+	free(world->records);
+	free(world->generations);
+	free(world->query);
+	memset(world, 0, sizeof(*world));
+}
+
+uint32_t ecs_register_component(ecs_world_t* world, uint32_t size) {
+	if (world->component_count == ECS_MAX_COMPONENTS || world->entity_count > 0) {
+		printf("ERROR::ECS::REGISTER_COMPONENT_FAILED: %u\n", world->component_count);
+		abort();
+	}
+	world->components[world->component_count].size = size;
+	return world->component_count++;
+}
+
+ecs_entity_t ecs_create(ecs_world_t* world, ecs_mask_t mask) {
+	uint32_t index = world->free_head;
+	if (index != ECS_RECORD_NONE) {
+		world->free_head = world->records[index].row;
+	}
+	else {
+		if (world->record_count > ECS_ENTITY_INDEX_MASK) {
+			printf("ERROR::ECS::TOO_MANY_ENTITIES: %u\n", world->record_count);
+			abort();
+		}
+		if (world->record_count == world->record_capacity) {
+			world->record_capacity *= 2;
+			world->records = (ecs_record_t*)realloc(world->records, world->record_capacity * sizeof(ecs_record_t));
+			world->generations = (uint16_t*)realloc(world->generations, world->record_capacity * sizeof(uint16_t));
+		}
+		index = world->record_count++;
+		world->generations[index] = 1;
+	}
+	ecs_entity_t entity = ((ecs_entity_t)world->generations[index] << ECS_ENTITY_INDEX_BITS) | index;
+	ecs_record_t* record = &world->records[index];
+	_archetype_push(world, _archetype_get(world, mask), entity, &record->chunk, &record->row);
+	world->entity_count++;
+	return entity;
+}
+
+void ecs_destroy(ecs_world_t* world, ecs_entity_t entity) {
+	ecs_record_t* record = _record_get(world, entity);
+	if (record == NULL) {
+		return;
+	}
+	_archetype_remove(world, record->chunk, record->row);
+	uint32_t index = entity & ECS_ENTITY_INDEX_MASK;
+	uint16_t generation = (uint16_t)((world->generations[index] + 1) & ECS_ENTITY_GENERATION_MASK);
+	world->generations[index] = generation ? generation : 1;
+	record->chunk = NULL;
+	record->row = world->free_head;
+	world->free_head = index;
+	world->entity_count--;
+}
+
+bool ecs_alive(const ecs_world_t* world, ecs_entity_t entity) {
+	return _record_get(world, entity) != NULL;
+}
+
+void* ecs_get(const ecs_world_t* world, ecs_entity_t entity, uint32_t component) {
+	const ecs_record_t* record = _record_get(world, entity);
+	if (record == NULL || !(record->chunk->archetype->mask & ECS_BIT(component))) {
+		return NULL;
+	}
+	return _chunk_component(world, record->chunk, component, record->row);
+}
+
+void ecs_add_component(ecs_world_t* world, ecs_entity_t entity, uint32_t component) {
+	const ecs_record_t* record = _record_get(world, entity);
+	if (record) {
+		_entity_move(world, entity, record->chunk->archetype->mask | ECS_BIT(component));
+	}
+}
+
+void ecs_remove_component(ecs_world_t* world, ecs_entity_t entity, uint32_t component) {
+	const ecs_record_t* record = _record_get(world, entity);
+	if (record) {
+		_entity_move(world, entity, record->chunk->archetype->mask & ~ECS_BIT(component));
+	}
+}
+
+void* ecs_chunk_column(const ecs_chunk_t* chunk, uint32_t component) {
+	if (!(chunk->archetype->mask & ECS_BIT(component))) {
+		return NULL;
+	}
+	return chunk->data + chunk->archetype->offsets[component];
+}
+
+const ecs_entity_t* ecs_chunk_entities(const ecs_chunk_t* chunk) {
+	return _chunk_entities(chunk);
+}
+
+ecs_chunk_t** ecs_query(ecs_world_t* world, ecs_mask_t mask, uint32_t* count) {
+	world->query_count = 0;
+	for (uint32_t i = 0; i < world->archetype_count; i++) {
+		const ecs_archetype_t* archetype = world->archetypes[i];
+		if ((archetype->mask & mask) != mask) {
+			continue;
+		}
+		if (world->query_count + archetype->chunk_count > world->query_capacity) {
+			while (world->query_count + archetype->chunk_count > world->query_capacity) {
+				world->query_capacity = world->query_capacity ? world->query_capacity * 2 : 256;
+			}
+			world->query = (ecs_chunk_t**)realloc(world->query, world->query_capacity * sizeof(ecs_chunk_t*));
+		}
+		memcpy(world->query + world->query_count, archetype->chunks, archetype->chunk_count * sizeof(ecs_chunk_t*));
+		world->query_count += archetype->chunk_count;
+	}
+	*count = world->query_count;
+	return world->query;
+}
+
+uint32_t ecs_count(const ecs_world_t* world, ecs_mask_t mask) {
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < world->archetype_count; i++) {
+		if ((world->archetypes[i]->mask & mask) == mask) {
+			count += world->archetypes[i]->entity_count;
+		}
+	}
+	return count;
+}
+
+void ecs_run(ecs_world_t* world, ecs_mask_t mask, ecs_system_fn fn, void* user) {
+	_ecs_run_t run;
+	uint32_t count;
+	run.chunks = ecs_query(world, mask, &count);
+	run.fn = fn;
+	run.user = user;
+	job_pool_parallel_for(world->jobs, count, ECS_CHUNKS_PER_JOB, _ecs_run_chunks, &run);
+}
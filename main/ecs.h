@@ -0,0 +1,96 @@
+_Pragma("once")
+
+#include <cstddef>
+#include <cstdint>
+#include "job-pool.h"
+
+#define ECS_MAX_COMPONENTS			32
+#define ECS_CHUNK_SIZE				(16 * 1024)
+#define ECS_COLUMN_ALIGN			16			//ÿһеʼַ룬SIMDд
+//ʵ壺22λǲλ10λǴ0Чʵ
+#define ECS_ENTITY_INDEX_BITS		22
+#define ECS_ENTITY_INDEX_MASK		((1u << ECS_ENTITY_INDEX_BITS) - 1)
+#define ECS_ENTITY_GENERATION_MASK	((1u << (32 - ECS_ENTITY_INDEX_BITS)) - 1)
+
+typedef uint32_t ecs_entity_t;
+typedef uint32_t ecs_mask_t;	//ϣiλӦΪi
+
+#define ECS_BIT(component)	((ecs_mask_t)1 << (component))
+
+typedef struct ecs_archetype_s ecs_archetype_t;
+
+//һ16KBĿͬһϵʵ壬ÿһ(SoA)ʵ
+typedef struct ecs_chunk_s {
+	ecs_archetype_t* archetype;
+	unsigned char* data;		//ECS_CHUNK_SIZEֽڣ64ֽڶ
+	void* allocation;
+	uint32_t count;
+}ecs_chunk_t;
+
+//ͬһϵʵ壬һ֮п鶼
+struct ecs_archetype_s {
+	ecs_mask_t mask;
+	uint32_t capacity;						//ÿܷŵʵ
+	uint32_t offsets[ECS_MAX_COMPONENTS];	//ÿһڿڵƫ
+	uint32_t entity_offset;					//ʵһеƫ
+	ecs_chunk_t** chunks;
+	uint32_t chunk_count;
+	uint32_t chunk_capacity;
+	uint32_t entity_count;
+};
+
+typedef struct ecs_component_s {
+	uint32_t size;
+}ecs_component_t;
+
+typedef struct ecs_record_s {
+	ecs_chunk_t* chunk;			//ΪNULLʱλУrowһвλ
+	uint32_t row;
+}ecs_record_t;
+
+typedef struct ecs_world_s {
+	ecs_component_t components[ECS_MAX_COMPONENTS];
+	uint32_t component_count;
+	ecs_archetype_t** archetypes;
+	uint32_t archetype_count;
+	uint32_t archetype_capacity;
+	ecs_record_t* records;
+	uint16_t* generations;
+	uint32_t record_count;
+	uint32_t record_capacity;
+	uint32_t free_head;
+	uint32_t entity_count;
+	ecs_chunk_t** query;		//һβѯĽֻ
+	uint32_t query_count;
+	uint32_t query_capacity;
+	job_pool_t* jobs;
+}ecs_world_t;
+
+//һִеϵͳͬһecs_runвͬĿڲͬ߳ͬʱִ
+typedef void (*ecs_system_fn)(void* user, ecs_chunk_t* chunk);
+
+//jobsΪNULLʱϵͳڵִ߳
+extern void ecs_world_init(ecs_world_t* world, job_pool_t* jobs);
+extern void ecs_world_destroy(ecs_world_t* world);
+//ţҪڴʵ֮ǰע
+extern uint32_t ecs_register_component(ecs_world_t* world, uint32_t size);
+
+//ݳʼΪ0
+extern ecs_entity_t ecs_create(ecs_world_t* world, ecs_mask_t mask);
+extern void ecs_destroy(ecs_world_t* world, ecs_entity_t entity);
+extern bool ecs_alive(const ecs_world_t* world, ecs_entity_t entity);
+//ʵûѾʱNULLָһδ//ɾ֮ǰЧ
+extern void* ecs_get(const ecs_world_t* world, ecs_entity_t entity, uint32_t component);
+//ɾʵᵽһԭ
+extern void ecs_add_component(ecs_world_t* world, ecs_entity_t entity, uint32_t component);
+extern void ecs_remove_component(ecs_world_t* world, ecs_entity_t entity, uint32_t component);
+
+//еһУԭûʱNULL
+extern void* ecs_chunk_column(const ecs_chunk_t* chunk, uint32_t component);
+extern const ecs_entity_t* ecs_chunk_entities(const ecs_chunk_t* chunk);
+
+//maskĿ飬һβѯ֮ǰЧ
+extern ecs_chunk_t** ecs_query(ecs_world_t* world, ecs_mask_t mask, uint32_t* count);
+extern uint32_t ecs_count(const ecs_world_t* world, ecs_mask_t mask);
+//ƥĿ鲢ִϵͳʱȫɣϵͳﲻܲѯʵ
+extern void ecs_run(ecs_world_t* world, ecs_mask_t mask, ecs_system_fn fn, void* user);
@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <cstring>
+#include "file-map.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+bool file_map_open(file_map_t* map, const char* path) {
+	memset(map, 0, sizeof(*map));
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL) {
+		CloseHandle(file);
+		return false;
+	}
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == NULL) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+	map->file = file;
+	map->mapping = mapping;
+	map->data = (const unsigned char*)data;
+	map->size = (size_t)size.QuadPart;
+#else
+	int fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		close(fd);
+		return false;
+	}
+	void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED) {
+		close(fd);
+		return false;
+	}
+	map->fd = fd;
+	map->data = (const unsigned char*)data;
+	map->size = (size_t)st.st_size;
+#endif
+	return true;
+}
+
+void file_map_close(file_map_t* map) {
+	if (map->data == NULL) {
+		return;
+	}
+#if defined(_WIN32)
+	UnmapViewOfFile(map->data);
+	CloseHandle(map->mapping);
+	CloseHandle(map->file);
+#else
+	munmap((void*)map->data, map->size);
+	close(map->fd);
+#endif
+	memset(map, 0, sizeof(*map));
+}
+
+uint64_t file_hash_bytes(const void* data, size_t size) {
+	const unsigned char* p = (const unsigned char*)data;
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (size_t i = 0; i < size; i++) {
+		hash ^= p[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+bool file_hash(const char* path, uint64_t* hash) {
+	file_map_t map;
+	if (!file_map_open(&map, path)) {
+		return false;
+	}
+	*hash = file_hash_bytes(map.data, map.size);
+	file_map_close(&map);
+	return true;
+}
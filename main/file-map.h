@@ -0,0 +1,23 @@
+_Pragma("once")
+
+#include <cstddef>
+#include <cstdint>
+
+//ֻļڴӳ䣬ֱҳ棬м俽
+typedef struct file_map_s {
+	const unsigned char* data;
+	size_t size;
+#if defined(_WIN32)
+	void* file;
+	void* mapping;
+#else
+	int fd;
+#endif
+}file_map_t;
+
+extern bool file_map_open(file_map_t* map, const char* path);
+extern void file_map_close(file_map_t* map);
+
+//FNV-1a 64λϣڼԴļǷ仯
+extern uint64_t file_hash_bytes(const void* data, size_t size);
+extern bool file_hash(const char* path, uint64_t* hash);
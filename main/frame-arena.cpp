@@ -0,0 +1,138 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "frame-arena.h"
+
+typedef struct _overflow_block_s {
+	struct _overflow_block_s* next;
+}_overflow_block_t;
+
+static frame_arena_block_t* _arena_block(const frame_arena_t* arena, uint32_t index, uint32_t thread) {
+	return &arena->blocks[index * arena->thread_count + thread];
+}
+
+static unsigned char* _align_up(unsigned char* p, size_t align) {
+	return (unsigned char*)(((uintptr_t)p + align - 1) & ~(uintptr_t)(align - 1));
+}
+
+//߲鷵ֵòڴֱֻ˳
+static void* _arena_malloc(size_t size) {
+	void* p = malloc(size);
+	if (!p) {
+		printf("ERROR::FRAME_ARENA::OUT_OF_MEMORY: %zu\n", size);
+		abort();
+	}
+	return p;
+}
+
+//ַŲµķӶϵ룬֤һõڴ棬һֿʼǰ
+static void* _arena_overflow(frame_arena_block_t* block, size_t size, size_t align) {
+	_overflow_block_t* overflow = (_overflow_block_t*)_arena_malloc(sizeof(_overflow_block_t) + align + size);
+	overflow->next = (_overflow_block_t*)block->overflow;
+	block->overflow = overflow;
+	block->overflow_bytes += size + align;
+	block->overflow_count++;
+	return _align_up((unsigned char*)(overflow + 1), align);
+}
+
+static void _arena_free_overflow(frame_arena_block_t* block) {
+	_overflow_block_t* overflow = (_overflow_block_t*)block->overflow;
+	while (overflow) {
+		_overflow_block_t* next = overflow->next;
+		free(overflow);
+		overflow = next;
+	}
+	block->overflow = NULL;
+}
+
+static void _arena_reset(frame_arena_block_t* block) {
+	if (block->overflow) {
+		_arena_free_overflow(block);
+		size_t needed = block->used + block->overflow_bytes;
+		size_t capacity = block->capacity;
+		while (capacity < needed) {
+			capacity *= 2;
+		}
+		//ʧܾͼþɵĿ飬ŲµĲһֻ
+		unsigned char* base = (unsigned char*)malloc(capacity);
+		if (base) {
+			free(block->base);
+			block->base = base;
+			block->capacity = capacity;
+		}
+	}
+	block->used = 0;
+	block->overflow_bytes = 0;
+}
+
+void frame_arena_init(frame_arena_t* arena, size_t size, job_pool_t* jobs) {
+	memset(arena, 0, sizeof(*arena));
+	arena->jobs = jobs;
+	arena->thread_count = jobs ? jobs->worker_count + 1 : 1;
+	arena->blocks = (frame_arena_block_t*)calloc(FRAME_ARENA_FRAMES * arena->thread_count, sizeof(frame_arena_block_t));
+	if (!arena->blocks) {
+		printf("ERROR::FRAME_ARENA::OUT_OF_MEMORY: %u blocks\n", FRAME_ARENA_FRAMES * arena->thread_count);
+		abort();
+	}
+	if (size < FRAME_ARENA_ALIGN) {
+		size = FRAME_ARENA_ALIGN;
+	}
+	for (uint32_t i = 0; i < FRAME_ARENA_FRAMES * arena->thread_count; i++) {
+		arena->blocks[i].base = (unsigned char*)_arena_malloc(size);
+		arena->blocks[i].capacity = size;
+	}
+}
+
+void frame_arena_destroy(frame_arena_t* arena) {
+	for (uint32_t i = 0; i < FRAME_ARENA_FRAMES * arena->thread_count; i++) {
+		_arena_free_overflow(&arena->blocks[i]);
+		free(arena->blocks[i].base);
+	}
+	free(arena->blocks);
+	memset(arena, 0, sizeof(*arena));
+}
+
+void frame_arena_begin_frame(frame_arena_t* arena) {
+	arena->frame++;
+	arena->index = (arena->index + 1) % FRAME_ARENA_FRAMES;
+	for (uint32_t i = 0; i < arena->thread_count; i++) {
+		frame_arena_block_t* block = _arena_block(arena, arena->index, i);
+		arena->overflows += block->overflow_count;
+		block->overflow_count = 0;
+		_arena_reset(block);
+	}
+}
+
+void* frame_arena_alloc(frame_arena_t* arena, size_t size, size_t align) {
+	uint32_t thread = job_pool_thread_index(arena->jobs);
+	frame_arena_block_t* block = _arena_block(arena, arena->index, thread);
+	unsigned char* p = _align_up(block->base + block->used, align);
+	size_t end = (size_t)(p - block->base) + size;
+	if (end > block->capacity) {
+		return _arena_overflow(block, size, align);
+	}
+	block->used = end;
+	if (end + block->overflow_bytes > block->peak) {
+		block->peak = end + block->overflow_bytes;
+	}
+	return p;
+}
+
+void frame_arena_get_stats(const frame_arena_t* arena, frame_arena_stats_t* stats) {
+	memset(stats, 0, sizeof(*stats));
+	stats->overflows = arena->overflows;
+	stats->frame = arena->frame;
+	for (uint32_t f = 0; f < FRAME_ARENA_FRAMES; f++) {
+		for (uint32_t i = 0; i < arena->thread_count; i++) {
+			const frame_arena_block_t* block = _arena_block(arena, f, i);
+			stats->capacity += block->capacity;
+			if (block->peak > stats->peak) {
+				stats->peak = block->peak;
+			}
+			if (f == arena->index) {
+				stats->used += block->used + block->overflow_bytes;
+				stats->overflows += block->overflow_count;
+			}
+		}
+	}
+}
@@ -0,0 +1,50 @@
+_Pragma("once")
+
+#include <cstddef>
+#include <cstdint>
+#include "job-pool.h"
+
+#define FRAME_ARENA_FRAMES			3					//һ֮֡֡ȻЧ
+#define FRAME_ARENA_ALIGN			16
+#define FRAME_ARENA_DEFAULT_SIZE	(1u << 20)			//ÿ߳ÿ֡ĳʼ
+
+//һ߳һ֡ʹõһڴ
+typedef struct frame_arena_block_s {
+	unsigned char* base;
+	size_t capacity;
+	size_t used;
+	size_t peak;
+	void* overflow;				//ʱӶϷĿ飬ʱϲһֵ
+	size_t overflow_bytes;
+	uint32_t overflow_count;
+}frame_arena_block_t;
+
+typedef struct frame_arena_stats_s {
+	size_t capacity;			//̵֡߳
+	size_t used;				//ǰ֡Ѿֽ
+	size_t peak;
+	uint32_t overflows;			//ۼϵĴȶ֮Ӧ
+	uint64_t frame;
+}frame_arena_stats_t;
+
+//ÿ֡ʱݰָ䣬֡ʼʱգͷ
+//job_pool_thread_indexֳ֮߳䲻Ҫͬǹ̹߳һֻɵbegin_frame߳ʹ
+typedef struct frame_arena_s {
+	frame_arena_block_t* blocks;	//[FRAME_ARENA_FRAMES][thread_count]
+	uint32_t thread_count;
+	uint32_t index;					//ǰ֡ʹõһ
+	uint64_t frame;
+	job_pool_t* jobs;
+	uint32_t overflows;
+}frame_arena_t;
+
+//jobsΪNULLʱֻһ
+extern void frame_arena_init(frame_arena_t* arena, size_t size, job_pool_t* jobs);
+extern void frame_arena_destroy(frame_arena_t* arena);
+//лһ鲢FRAME_ARENA_FRAMES֮֡ǰķ䣬һ֡
+extern void frame_arena_begin_frame(frame_arena_t* arena);
+//صڴûгʼalign2ݣ64
+extern void* frame_arena_alloc(frame_arena_t* arena, size_t size, size_t align);
+extern void frame_arena_get_stats(const frame_arena_t* arena, frame_arena_stats_t* stats);
+
+#define FRAME_ARENA_NEW(arena, type, count) ((type*)frame_arena_alloc((arena), sizeof(type) * (count), alignof(type) > FRAME_ARENA_ALIGN ? alignof(type) : FRAME_ARENA_ALIGN))
@@ -0,0 +1,80 @@
+#include <cstdio>
+#include "frame-queue.h"
+#include "alloc-counter.h"
+
+#define FRAME_STATS_PERIOD	2.0
+
+void frame_queue_init(frame_queue_t* queue) {
+	queue->head.store(0);
+	queue->tail.store(0);
+}
+
+bool frame_queue_push(frame_queue_t* queue, const frame_packet_t* packet) {
+	uint32_t tail = queue->tail.load(std::memory_order_relaxed);
+	if (tail - queue->head.load(std::memory_order_acquire) == FRAME_QUEUE_SIZE) {
+		return false;
+	}
+	queue->packets[tail % FRAME_QUEUE_SIZE] = *packet;
+	queue->tail.store(tail + 1, std::memory_order_release);
+	queue->tail.notify_one();
+	return true;
+}
+
+bool frame_queue_pop(frame_queue_t* queue, frame_packet_t* packet) {
+	uint32_t head = queue->head.load(std::memory_order_relaxed);
+	if (head == queue->tail.load(std::memory_order_acquire)) {
+		return false;
+	}
+	*packet = queue->packets[head % FRAME_QUEUE_SIZE];
+	queue->head.store(head + 1, std::memory_order_release);
+	queue->head.notify_one();
+	return true;
+}
+
+bool frame_queue_full(frame_queue_t* queue) {
+	return queue->tail.load(std::memory_order_relaxed) - queue->head.load(std::memory_order_acquire) == FRAME_QUEUE_SIZE;
+}
+
+//tail/headֻᱻԷı䣬ֵͿľֵͬʱwaitأ©
+void frame_queue_wait_pop(frame_queue_t* queue, frame_packet_t* packet) {
+	uint32_t head = queue->head.load(std::memory_order_relaxed);
+	while (!frame_queue_pop(queue, packet)) {
+		queue->tail.wait(head, std::memory_order_acquire);
+	}
+}
+
+void frame_queue_wait_space(frame_queue_t* queue) {
+	uint32_t tail = queue->tail.load(std::memory_order_relaxed);
+	while (frame_queue_full(queue)) {
+		queue->head.wait(tail - FRAME_QUEUE_SIZE, std::memory_order_acquire);
+	}
+}
+
+void frame_stats_init(frame_stats_t* stats, const char* mode) {
+	stats->mode = mode;
+	stats->period_start = sim_loop_now();
+	stats->frames = 0;
+	stats->latency_sum = 0.0;
+	stats->latency_max = 0.0;
+	stats->allocs = alloc_counter_app();
+}
+
+void frame_stats_record(frame_stats_t* stats, double latency, double now) {
+	stats->frames++;
+	stats->latency_sum += latency;
+	if (latency > stats->latency_max) {
+		stats->latency_max = latency;
+	}
+	double elapsed = now - stats->period_start;
+	if (elapsed >= FRAME_STATS_PERIOD) {
+		uint64_t allocs = alloc_counter_app() - stats->allocs;
+		printf("%s: %.1f fps, latency avg %.2f ms, max %.2f ms, heap allocs %.2f/frame\n", stats->mode, stats->frames / elapsed,
+			stats->latency_sum / stats->frames * 1000.0, stats->latency_max * 1000.0, (double)allocs / stats->frames);
+		stats->period_start = now;
+		stats->frames = 0;
+		stats->latency_sum = 0.0;
+		stats->latency_max = 0.0;
+		//printfԼķ䲻һ
+		stats->allocs = alloc_counter_app();
+	}
+}
@@ -0,0 +1,49 @@
+_Pragma("once")
+
+#include <atomic>
+#include <cstdint>
+#include "sim-loop.h"
+
+#define FRAME_QUEUE_SIZE	2	//Ⱦ֡ٶֻӳ
+
+//߳׼õһ֡Ⱦֻ߳
+typedef struct frame_packet_s {
+	uint64_t index;
+	double created;			//̲߳ģʱ̣ڼӳ
+	sim_state_t state;
+	unsigned int viewport_width;
+	unsigned int viewport_height;
+	bool hud;				//Ƿͳ
+	bool debug_draw;		//Ƿ񻭵߿򣬱ʱû
+	bool quit;				//һȾ߳յ˳
+}frame_packet_t;
+
+//ߵߵнУջʱȴҪѯ
+typedef struct frame_queue_s {
+	frame_packet_t packets[FRAME_QUEUE_SIZE];
+	std::atomic<uint32_t> head;		//д
+	std::atomic<uint32_t> tail;		//д
+}frame_queue_t;
+
+//ºӳͳƣÿڴӡһ
+typedef struct frame_stats_s {
+	const char* mode;
+	double period_start;
+	uint32_t frames;
+	double latency_sum;
+	double latency_max;
+	uint64_t allocs;		//ڿʼʱalloc_counter_appֵ߳
+}frame_stats_t;
+
+extern void frame_queue_init(frame_queue_t* queue);
+extern bool frame_queue_push(frame_queue_t* queue, const frame_packet_t* packet);
+extern bool frame_queue_pop(frame_queue_t* queue, frame_packet_t* packet);
+extern bool frame_queue_full(frame_queue_t* queue);
+//аȡֻߵ
+extern void frame_queue_wait_pop(frame_queue_t* queue, frame_packet_t* packet);
+//пλֻߵ
+extern void frame_queue_wait_space(frame_queue_t* queue);
+
+extern void frame_stats_init(frame_stats_t* stats, const char* mode);
+//latencyǴ߳һ֡Ⱦ֮߳̽ʱ
+extern void frame_stats_record(frame_stats_t* stats, double latency, double now);
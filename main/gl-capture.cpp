@@ -0,0 +1,1652 @@
+#include <glad/glad.h>
+#include <cstdlib>
+#include <cstring>
+#include "gl-capture.h"
+
+//صĺֺgladPFNGL...PROC˳ǲ룬Ķ֮ҪGL_CAPTURE_VERSION
+#define GL_CAPTURE_FUNCTIONS(X) \
+	X(ActiveTexture, ACTIVETEXTURE) \
+	X(AttachShader, ATTACHSHADER) \
+	X(BeginQuery, BEGINQUERY) \
+	X(BeginTransformFeedback, BEGINTRANSFORMFEEDBACK) \
+	X(BindBuffer, BINDBUFFER) \
+	X(BindBufferBase, BINDBUFFERBASE) \
+	X(BindFramebuffer, BINDFRAMEBUFFER) \
+	X(BindRenderbuffer, BINDRENDERBUFFER) \
+	X(BindTexture, BINDTEXTURE) \
+	X(BindVertexArray, BINDVERTEXARRAY) \
+	X(BlendFunc, BLENDFUNC) \
+	X(BlitFramebuffer, BLITFRAMEBUFFER) \
+	X(BufferData, BUFFERDATA) \
+	X(BufferSubData, BUFFERSUBDATA) \
+	X(CheckFramebufferStatus, CHECKFRAMEBUFFERSTATUS) \
+	X(Clear, CLEAR) \
+	X(ClearColor, CLEARCOLOR) \
+	X(ClientWaitSync, CLIENTWAITSYNC) \
+	X(CompileShader, COMPILESHADER) \
+	X(CreateProgram, CREATEPROGRAM) \
+	X(CreateShader, CREATESHADER) \
+	X(DeleteBuffers, DELETEBUFFERS) \
+	X(DeleteFramebuffers, DELETEFRAMEBUFFERS) \
+	X(DeleteProgram, DELETEPROGRAM) \
+	X(DeleteQueries, DELETEQUERIES) \
+	X(DeleteRenderbuffers, DELETERENDERBUFFERS) \
+	X(DeleteShader, DELETESHADER) \
+	X(DeleteSync, DELETESYNC) \
+	X(DeleteTextures, DELETETEXTURES) \
+	X(DeleteVertexArrays, DELETEVERTEXARRAYS) \
+	X(DepthMask, DEPTHMASK) \
+	X(Disable, DISABLE) \
+	X(DrawArrays, DRAWARRAYS) \
+	X(DrawArraysInstanced, DRAWARRAYSINSTANCED) \
+	X(DrawElements, DRAWELEMENTS) \
+	X(DrawElementsBaseVertex, DRAWELEMENTSBASEVERTEX) \
+	X(DrawElementsInstanced, DRAWELEMENTSINSTANCED) \
+	X(Enable, ENABLE) \
+	X(EnableVertexAttribArray, ENABLEVERTEXATTRIBARRAY) \
+	X(EndQuery, ENDQUERY) \
+	X(EndTransformFeedback, ENDTRANSFORMFEEDBACK) \
+	X(FenceSync, FENCESYNC) \
+	X(Finish, FINISH) \
+	X(Flush, FLUSH) \
+	X(FramebufferRenderbuffer, FRAMEBUFFERRENDERBUFFER) \
+	X(FramebufferTexture2D, FRAMEBUFFERTEXTURE2D) \
+	X(GenBuffers, GENBUFFERS) \
+	X(GenFramebuffers, GENFRAMEBUFFERS) \
+	X(GenQueries, GENQUERIES) \
+	X(GenRenderbuffers, GENRENDERBUFFERS) \
+	X(GenTextures, GENTEXTURES) \
+	X(GenVertexArrays, GENVERTEXARRAYS) \
+	X(GenerateMipmap, GENERATEMIPMAP) \
+	X(GetIntegerv, GETINTEGERV) \
+	X(GetProgramInfoLog, GETPROGRAMINFOLOG) \
+	X(GetProgramiv, GETPROGRAMIV) \
+	X(GetQueryObjectui64v, GETQUERYOBJECTUI64V) \
+	X(GetShaderInfoLog, GETSHADERINFOLOG) \
+	X(GetShaderiv, GETSHADERIV) \
+	X(GetTexImage, GETTEXIMAGE) \
+	X(GetUniformLocation, GETUNIFORMLOCATION) \
+	X(LinkProgram, LINKPROGRAM) \
+	X(MapBufferRange, MAPBUFFERRANGE) \
+	X(MultiDrawArrays, MULTIDRAWARRAYS) \
+	X(MultiDrawElements, MULTIDRAWELEMENTS) \
+	X(PixelStorei, PIXELSTOREI) \
+	X(RenderbufferStorage, RENDERBUFFERSTORAGE) \
+	X(ShaderSource, SHADERSOURCE) \
+	X(TexBuffer, TEXBUFFER) \
+	X(TexImage2D, TEXIMAGE2D) \
+	X(TexImage3D, TEXIMAGE3D) \
+	X(TexParameteri, TEXPARAMETERI) \
+	X(TexSubImage2D, TEXSUBIMAGE2D) \
+	X(TexSubImage3D, TEXSUBIMAGE3D) \
+	X(TransformFeedbackVaryings, TRANSFORMFEEDBACKVARYINGS) \
+	X(Uniform1f, UNIFORM1F) \
+	X(Uniform1i, UNIFORM1I) \
+	X(Uniform2f, UNIFORM2F) \
+	X(Uniform3f, UNIFORM3F) \
+	X(Uniform3fv, UNIFORM3FV) \
+	X(Uniform4f, UNIFORM4F) \
+	X(UniformMatrix4fv, UNIFORMMATRIX4FV) \
+	X(UnmapBuffer, UNMAPBUFFER) \
+	X(UseProgram, USEPROGRAM) \
+	X(VertexAttribDivisor, VERTEXATTRIBDIVISOR) \
+	X(VertexAttribPointer, VERTEXATTRIBPOINTER) \
+	X(Viewport, VIEWPORT)
+
+#define GL_CAPTURE_OP_ENUM(name, upper) GL_CAPTURE_OP_##upper,
+typedef enum gl_capture_op_e {
+	GL_CAPTURE_OP_FRAME,
+	GL_CAPTURE_FUNCTIONS(GL_CAPTURE_OP_ENUM)
+	GL_CAPTURE_OP_COUNT,
+}gl_capture_op_t;
+#undef GL_CAPTURE_OP_ENUM
+
+//طʱռ䣬ɫͳһ
+typedef enum gl_name_space_e {
+	GL_NAME_BUFFER = 1,
+	GL_NAME_TEXTURE,
+	GL_NAME_VERTEX_ARRAY,
+	GL_NAME_FRAMEBUFFER,
+	GL_NAME_RENDERBUFFER,
+	GL_NAME_PROGRAM,
+	GL_NAME_QUERY,
+	GL_NAME_SYNC,
+	GL_NAME_LOCATION,
+}gl_name_space_t;
+
+static struct {
+#define GL_CAPTURE_REAL(name, upper) PFNGL##upper##PROC name;
+	GL_CAPTURE_FUNCTIONS(GL_CAPTURE_REAL)
+#undef GL_CAPTURE_REAL
+}_real;
+
+static gl_capture_t* _capture;
+
+static size_t _pixel_size(GLenum format, GLenum type) {
+	if (type == GL_UNSIGNED_INT_24_8 || type == GL_UNSIGNED_INT_2_10_10_10_REV || type == GL_UNSIGNED_INT_8_8_8_8 || type == GL_UNSIGNED_INT_8_8_8_8_REV) {
+		return 4;
+	}
+	if (type == GL_UNSIGNED_SHORT_5_6_5 || type == GL_UNSIGNED_SHORT_4_4_4_4 || type == GL_UNSIGNED_SHORT_5_5_5_1) {
+		return 2;
+	}
+	size_t components = 4;
+	if (format == GL_RED || format == GL_RED_INTEGER || format == GL_DEPTH_COMPONENT || format == GL_STENCIL_INDEX) {
+		components = 1;
+	} else if (format == GL_RG || format == GL_RG_INTEGER) {
+		components = 2;
+	} else if (format == GL_RGB || format == GL_BGR || format == GL_RGB_INTEGER) {
+		components = 3;
+	}
+	size_t bytes = 1;
+	if (type == GL_UNSIGNED_SHORT || type == GL_SHORT || type == GL_HALF_FLOAT) {
+		bytes = 2;
+	} else if (type == GL_UNSIGNED_INT || type == GL_INT || type == GL_FLOAT) {
+		bytes = 4;
+	}
+	return components * bytes;
+}
+
+//ÿа벹룬һвGLʵʶȡֽͬ
+static size_t _image_size(GLenum format, GLenum type, GLsizei width, GLsizei height, GLsizei depth, int alignment) {
+	if (width <= 0 || height <= 0 || depth <= 0) {
+		return 0;
+	}
+	size_t row = (size_t)width * _pixel_size(format, type);
+	size_t pitch = (row + alignment - 1) / alignment * alignment;
+	return pitch * ((size_t)height * depth - 1) + row;
+}
+
+static void _flush() {
+	if (_capture->size && fwrite(_capture->buffer, 1, _capture->size, _capture->fp) != _capture->size) {
+		_capture->ok = false;
+	}
+	_capture->size = 0;
+}
+
+static void _put(const void* data, size_t size) {
+	if (_capture->size + size > GL_CAPTURE_BUFFER_SIZE) {
+		_flush();
+		//ݿ鲻壬ֱд
+		if (size > GL_CAPTURE_BUFFER_SIZE / 2) {
+			if (fwrite(data, 1, size, _capture->fp) != size) {
+				_capture->ok = false;
+			}
+			return;
+		}
+	}
+	memcpy(_capture->buffer + _capture->size, data, size);
+	_capture->size += size;
+}
+
+#define _put_value(v) _put(&(v), sizeof(v))
+
+static void _begin(gl_capture_op_t op) {
+	uint8_t code = (uint8_t)op;
+	_put_value(code);
+	_capture->header.call_count++;
+}
+
+//dataΪNULLʱֻд0
+static void _put_blob(const void* data, size_t size) {
+	uint32_t length = data ? (uint32_t)size : 0;
+	_put_value(length);
+	if (length) {
+		_put(data, length);
+		_capture->header.blob_bytes += length;
+	}
+}
+
+//ƫơָఴ
+static void _put_pointer(const void* pointer) {
+	uint64_t value = (uint64_t)(uintptr_t)pointer;
+	_put_value(value);
+}
+
+static void _put_names(gl_capture_op_t op, GLsizei n, const GLuint* names) {
+	_begin(op);
+	_put_value(n);
+	_put(names, (size_t)n * sizeof(GLuint));
+}
+
+static void APIENTRY _capture_ActiveTexture(GLenum texture) {
+	_begin(GL_CAPTURE_OP_ACTIVETEXTURE);
+	_put_value(texture);
+	_real.ActiveTexture(texture);
+}
+
+static void APIENTRY _capture_AttachShader(GLuint program, GLuint shader) {
+	_begin(GL_CAPTURE_OP_ATTACHSHADER);
+	_put_value(program);
+	_put_value(shader);
+	_real.AttachShader(program, shader);
+}
+
+static void APIENTRY _capture_BeginQuery(GLenum target, GLuint id) {
+	_begin(GL_CAPTURE_OP_BEGINQUERY);
+	_put_value(target);
+	_put_value(id);
+	_real.BeginQuery(target, id);
+}
+
+static void APIENTRY _capture_BeginTransformFeedback(GLenum primitiveMode) {
+	_begin(GL_CAPTURE_OP_BEGINTRANSFORMFEEDBACK);
+	_put_value(primitiveMode);
+	_real.BeginTransformFeedback(primitiveMode);
+}
+
+static void APIENTRY _capture_BindBuffer(GLenum target, GLuint buffer) {
+	_begin(GL_CAPTURE_OP_BINDBUFFER);
+	_put_value(target);
+	_put_value(buffer);
+	_real.BindBuffer(target, buffer);
+}
+
+static void APIENTRY _capture_BindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+	_begin(GL_CAPTURE_OP_BINDBUFFERBASE);
+	_put_value(target);
+	_put_value(index);
+	_put_value(buffer);
+	_real.BindBufferBase(target, index, buffer);
+}
+
+static void APIENTRY _capture_BindFramebuffer(GLenum target, GLuint framebuffer) {
+	_begin(GL_CAPTURE_OP_BINDFRAMEBUFFER);
+	_put_value(target);
+	_put_value(framebuffer);
+	_real.BindFramebuffer(target, framebuffer);
+}
+
+static void APIENTRY _capture_BindRenderbuffer(GLenum target, GLuint renderbuffer) {
+	_begin(GL_CAPTURE_OP_BINDRENDERBUFFER);
+	_put_value(target);
+	_put_value(renderbuffer);
+	_real.BindRenderbuffer(target, renderbuffer);
+}
+
+static void APIENTRY _capture_BindTexture(GLenum target, GLuint texture) {
+	_begin(GL_CAPTURE_OP_BINDTEXTURE);
+	_put_value(target);
+	_put_value(texture);
+	_real.BindTexture(target, texture);
+}
+
+static void APIENTRY _capture_BindVertexArray(GLuint array) {
+	_begin(GL_CAPTURE_OP_BINDVERTEXARRAY);
+	_put_value(array);
+	_real.BindVertexArray(array);
+}
+
+static void APIENTRY _capture_BlendFunc(GLenum sfactor, GLenum dfactor) {
+	_begin(GL_CAPTURE_OP_BLENDFUNC);
+	_put_value(sfactor);
+	_put_value(dfactor);
+	_real.BlendFunc(sfactor, dfactor);
+}
+
+static void APIENTRY _capture_BlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) {
+	GLint rect[8] = { srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1 };
+	_begin(GL_CAPTURE_OP_BLITFRAMEBUFFER);
+	_put(rect, sizeof(rect));
+	_put_value(mask);
+	_put_value(filter);
+	_real.BlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+}
+
+static void APIENTRY _capture_BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+	int64_t length = (int64_t)size;
+	_begin(GL_CAPTURE_OP_BUFFERDATA);
+	_put_value(target);
+	_put_value(length);
+	_put_blob(data, (size_t)size);
+	_put_value(usage);
+	_real.BufferData(target, size, data, usage);
+}
+
+static void APIENTRY _capture_BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+	int64_t start = (int64_t)offset;
+	_begin(GL_CAPTURE_OP_BUFFERSUBDATA);
+	_put_value(target);
+	_put_value(start);
+	_put_blob(data, (size_t)size);
+	_real.BufferSubData(target, offset, size, data);
+}
+
+static GLenum APIENTRY _capture_CheckFramebufferStatus(GLenum target) {
+	_begin(GL_CAPTURE_OP_CHECKFRAMEBUFFERSTATUS);
+	_put_value(target);
+	return _real.CheckFramebufferStatus(target);
+}
+
+static void APIENTRY _capture_Clear(GLbitfield mask) {
+	_begin(GL_CAPTURE_OP_CLEAR);
+	_put_value(mask);
+	_real.Clear(mask);
+}
+
+static void APIENTRY _capture_ClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+	GLfloat color[4] = { red, green, blue, alpha };
+	_begin(GL_CAPTURE_OP_CLEARCOLOR);
+	_put(color, sizeof(color));
+	_real.ClearColor(red, green, blue, alpha);
+}
+
+static GLenum APIENTRY _capture_ClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+	_begin(GL_CAPTURE_OP_CLIENTWAITSYNC);
+	_put_pointer(sync);
+	_put_value(flags);
+	_put_value(timeout);
+	return _real.ClientWaitSync(sync, flags, timeout);
+}
+
+static void APIENTRY _capture_CompileShader(GLuint shader) {
+	_begin(GL_CAPTURE_OP_COMPILESHADER);
+	_put_value(shader);
+	_real.CompileShader(shader);
+}
+
+static GLuint APIENTRY _capture_CreateProgram() {
+	GLuint program = _real.CreateProgram();
+	_begin(GL_CAPTURE_OP_CREATEPROGRAM);
+	_put_value(program);
+	return program;
+}
+
+static GLuint APIENTRY _capture_CreateShader(GLenum type) {
+	GLuint shader = _real.CreateShader(type);
+	_begin(GL_CAPTURE_OP_CREATESHADER);
+	_put_value(type);
+	_put_value(shader);
+	return shader;
+}
+
+static void APIENTRY _capture_DeleteBuffers(GLsizei n, const GLuint* buffers) {
+	_put_names(GL_CAPTURE_OP_DELETEBUFFERS, n, buffers);
+	_real.DeleteBuffers(n, buffers);
+}
+
+static void APIENTRY _capture_DeleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
+	_put_names(GL_CAPTURE_OP_DELETEFRAMEBUFFERS, n, framebuffers);
+	_real.DeleteFramebuffers(n, framebuffers);
+}
+
+static void APIENTRY _capture_DeleteProgram(GLuint program) {
+	_begin(GL_CAPTURE_OP_DELETEPROGRAM);
+	_put_value(program);
+	_real.DeleteProgram(program);
+}
+
+static void APIENTRY _capture_DeleteQueries(GLsizei n, const GLuint* ids) {
+	_put_names(GL_CAPTURE_OP_DELETEQUERIES, n, ids);
+	_real.DeleteQueries(n, ids);
+}
+
+static void APIENTRY _capture_DeleteRenderbuffers(GLsizei n, const GLuint* renderbuffers) {
+	_put_names(GL_CAPTURE_OP_DELETERENDERBUFFERS, n, renderbuffers);
+	_real.DeleteRenderbuffers(n, renderbuffers);
+}
+
+static void APIENTRY _capture_DeleteShader(GLuint shader) {
+	_begin(GL_CAPTURE_OP_DELETESHADER);
+	_put_value(shader);
+	_real.DeleteShader(shader);
+}
+
+static void APIENTRY _capture_DeleteSync(GLsync sync) {
+	_begin(GL_CAPTURE_OP_DELETESYNC);
+	_put_pointer(sync);
+	_real.DeleteSync(sync);
+}
+
+static void APIENTRY _capture_DeleteTextures(GLsizei n, const GLuint* textures) {
+	_put_names(GL_CAPTURE_OP_DELETETEXTURES, n, textures);
+	_real.DeleteTextures(n, textures);
+}
+
+static void APIENTRY _capture_DeleteVertexArrays(GLsizei n, const GLuint* arrays) {
+	_put_names(GL_CAPTURE_OP_DELETEVERTEXARRAYS, n, arrays);
+	_real.DeleteVertexArrays(n, arrays);
+}
+
+static void APIENTRY _capture_DepthMask(GLboolean flag) {
+	_begin(GL_CAPTURE_OP_DEPTHMASK);
+	_put_value(flag);
+	_real.DepthMask(flag);
+}
+
+static void APIENTRY _capture_Disable(GLenum cap) {
+	_begin(GL_CAPTURE_OP_DISABLE);
+	_put_value(cap);
+	_real.Disable(cap);
+}
+
+static void APIENTRY _capture_DrawArrays(GLenum mode, GLint first, GLsizei count) {
+	_begin(GL_CAPTURE_OP_DRAWARRAYS);
+	_put_value(mode);
+	_put_value(first);
+	_put_value(count);
+	_real.DrawArrays(mode, first, count);
+}
+
+static void APIENTRY _capture_DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount) {
+	_begin(GL_CAPTURE_OP_DRAWARRAYSINSTANCED);
+	_put_value(mode);
+	_put_value(first);
+	_put_value(count);
+	_put_value(instancecount);
+	_real.DrawArraysInstanced(mode, first, count, instancecount);
+}
+
+//԰󶨵Ԫػ壬indicesǻڵƫ
+static void APIENTRY _capture_DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+	_begin(GL_CAPTURE_OP_DRAWELEMENTS);
+	_put_value(mode);
+	_put_value(count);
+	_put_value(type);
+	_put_pointer(indices);
+	_real.DrawElements(mode, count, type, indices);
+}
+
+static void APIENTRY _capture_DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex) {
+	_begin(GL_CAPTURE_OP_DRAWELEMENTSBASEVERTEX);
+	_put_value(mode);
+	_put_value(count);
+	_put_value(type);
+	_put_pointer(indices);
+	_put_value(basevertex);
+	_real.DrawElementsBaseVertex(mode, count, type, indices, basevertex);
+}
+
+static void APIENTRY _capture_DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount) {
+	_begin(GL_CAPTURE_OP_DRAWELEMENTSINSTANCED);
+	_put_value(mode);
+	_put_value(count);
+	_put_value(type);
+	_put_pointer(indices);
+	_put_value(instancecount);
+	_real.DrawElementsInstanced(mode, count, type, indices, instancecount);
+}
+
+static void APIENTRY _capture_Enable(GLenum cap) {
+	_begin(GL_CAPTURE_OP_ENABLE);
+	_put_value(cap);
+	_real.Enable(cap);
+}
+
+static void APIENTRY _capture_EnableVertexAttribArray(GLuint index) {
+	_begin(GL_CAPTURE_OP_ENABLEVERTEXATTRIBARRAY);
+	_put_value(index);
+	_real.EnableVertexAttribArray(index);
+}
+
+static void APIENTRY _capture_EndQuery(GLenum target) {
+	_begin(GL_CAPTURE_OP_ENDQUERY);
+	_put_value(target);
+	_real.EndQuery(target);
+}
+
+static void APIENTRY _capture_EndTransformFeedback() {
+	_begin(GL_CAPTURE_OP_ENDTRANSFORMFEEDBACK);
+	_real.EndTransformFeedback();
+}
+
+static GLsync APIENTRY _capture_FenceSync(GLenum condition, GLbitfield flags) {
+	GLsync sync = _real.FenceSync(condition, flags);
+	_begin(GL_CAPTURE_OP_FENCESYNC);
+	_put_value(condition);
+	_put_value(flags);
+	_put_pointer(sync);
+	return sync;
+}
+
+static void APIENTRY _capture_Finish() {
+	_begin(GL_CAPTURE_OP_FINISH);
+	_real.Finish();
+}
+
+static void APIENTRY _capture_Flush() {
+	_begin(GL_CAPTURE_OP_FLUSH);
+	_real.Flush();
+}
+
+static void APIENTRY _capture_FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) {
+	_begin(GL_CAPTURE_OP_FRAMEBUFFERRENDERBUFFER);
+	_put_value(target);
+	_put_value(attachment);
+	_put_value(renderbuffertarget);
+	_put_value(renderbuffer);
+	_real.FramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+}
+
+static void APIENTRY _capture_FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) {
+	_begin(GL_CAPTURE_OP_FRAMEBUFFERTEXTURE2D);
+	_put_value(target);
+	_put_value(attachment);
+	_put_value(textarget);
+	_put_value(texture);
+	_put_value(level);
+	_real.FramebufferTexture2D(target, attachment, textarget, texture, level);
+}
+
+//ɵڵ֪֮
+static void APIENTRY _capture_GenBuffers(GLsizei n, GLuint* buffers) {
+	_real.GenBuffers(n, buffers);
+	_put_names(GL_CAPTURE_OP_GENBUFFERS, n, buffers);
+}
+
+static void APIENTRY _capture_GenFramebuffers(GLsizei n, GLuint* framebuffers) {
+	_real.GenFramebuffers(n, framebuffers);
+	_put_names(GL_CAPTURE_OP_GENFRAMEBUFFERS, n, framebuffers);
+}
+
+static void APIENTRY _capture_GenQueries(GLsizei n, GLuint* ids) {
+	_real.GenQueries(n, ids);
+	_put_names(GL_CAPTURE_OP_GENQUERIES, n, ids);
+}
+
+static void APIENTRY _capture_GenRenderbuffers(GLsizei n, GLuint* renderbuffers) {
+	_real.GenRenderbuffers(n, renderbuffers);
+	_put_names(GL_CAPTURE_OP_GENRENDERBUFFERS, n, renderbuffers);
+}
+
+static void APIENTRY _capture_GenTextures(GLsizei n, GLuint* textures) {
+	_real.GenTextures(n, textures);
+	_put_names(GL_CAPTURE_OP_GENTEXTURES, n, textures);
+}
+
+static void APIENTRY _capture_GenVertexArrays(GLsizei n, GLuint* arrays) {
+	_real.GenVertexArrays(n, arrays);
+	_put_names(GL_CAPTURE_OP_GENVERTEXARRAYS, n, arrays);
+}
+
+static void APIENTRY _capture_GenerateMipmap(GLenum target) {
+	_begin(GL_CAPTURE_OP_GENERATEMIPMAP);
+	_put_value(target);
+	_real.GenerateMipmap(target);
+}
+
+//ѯֻ¼طʱȥصĽ
+static void APIENTRY _capture_GetIntegerv(GLenum pname, GLint* data) {
+	_begin(GL_CAPTURE_OP_GETINTEGERV);
+	_put_value(pname);
+	_real.GetIntegerv(pname, data);
+}
+
+static void APIENTRY _capture_GetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+	_begin(GL_CAPTURE_OP_GETPROGRAMINFOLOG);
+	_put_value(program);
+	_put_value(bufSize);
+	_real.GetProgramInfoLog(program, bufSize, length, infoLog);
+}
+
+static void APIENTRY _capture_GetProgramiv(GLuint program, GLenum pname, GLint* params) {
+	_begin(GL_CAPTURE_OP_GETPROGRAMIV);
+	_put_value(program);
+	_put_value(pname);
+	_real.GetProgramiv(program, pname, params);
+}
+
+static void APIENTRY _capture_GetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params) {
+	_begin(GL_CAPTURE_OP_GETQUERYOBJECTUI64V);
+	_put_value(id);
+	_put_value(pname);
+	_real.GetQueryObjectui64v(id, pname, params);
+}
+
+static void APIENTRY _capture_GetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog) {
+	_begin(GL_CAPTURE_OP_GETSHADERINFOLOG);
+	_put_value(shader);
+	_put_value(bufSize);
+	_real.GetShaderInfoLog(shader, bufSize, length, infoLog);
+}
+
+static void APIENTRY _capture_GetShaderiv(GLuint shader, GLenum pname, GLint* params) {
+	_begin(GL_CAPTURE_OP_GETSHADERIV);
+	_put_value(shader);
+	_put_value(pname);
+	_real.GetShaderiv(shader, pname, params);
+}
+
+//طҪ֪ضֽڣһĴС
+static void APIENTRY _capture_GetTexImage(GLenum target, GLint level, GLenum format, GLenum type, void* pixels) {
+	GLint width = 0, height = 0, depth = 0;
+	glGetTexLevelParameteriv(target, level, GL_TEXTURE_WIDTH, &width);
+	glGetTexLevelParameteriv(target, level, GL_TEXTURE_HEIGHT, &height);
+	glGetTexLevelParameteriv(target, level, GL_TEXTURE_DEPTH, &depth);
+	uint64_t size = _image_size(format, type, width, height, depth, _capture->pack_alignment);
+	_begin(GL_CAPTURE_OP_GETTEXIMAGE);
+	_put_value(target);
+	_put_value(level);
+	_put_value(format);
+	_put_value(type);
+	_put_value(size);
+	_real.GetTexImage(target, level, format, type, pixels);
+}
+
+static GLint APIENTRY _capture_GetUniformLocation(GLuint program, const GLchar* name) {
+	GLint location = _real.GetUniformLocation(program, name);
+	_begin(GL_CAPTURE_OP_GETUNIFORMLOCATION);
+	_put_value(program);
+	_put_blob(name, strlen(name) + 1);
+	_put_value(location);
+	return location;
+}
+
+static void APIENTRY _capture_LinkProgram(GLuint program) {
+	_begin(GL_CAPTURE_OP_LINKPROGRAM);
+	_put_value(program);
+	_real.LinkProgram(program);
+}
+
+//дӳڽӳʱ֪ʱд
+static void* APIENTRY _capture_MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) {
+	int64_t start = (int64_t)offset;
+	int64_t size = (int64_t)length;
+	_begin(GL_CAPTURE_OP_MAPBUFFERRANGE);
+	_put_value(target);
+	_put_value(start);
+	_put_value(size);
+	_put_value(access);
+	void* pointer = _real.MapBufferRange(target, offset, length, access);
+	_capture->mapped = pointer;
+	_capture->mapped_size = (access & GL_MAP_WRITE_BIT) ? (size_t)length : 0;
+	return pointer;
+}
+
+static void APIENTRY _capture_MultiDrawArrays(GLenum mode, const GLint* first, const GLsizei* count, GLsizei drawcount) {
+	_begin(GL_CAPTURE_OP_MULTIDRAWARRAYS);
+	_put_value(mode);
+	_put_value(drawcount);
+	_put(first, (size_t)drawcount * sizeof(GLint));
+	_put(count, (size_t)drawcount * sizeof(GLsizei));
+	_real.MultiDrawArrays(mode, first, count, drawcount);
+}
+
+static void APIENTRY _capture_MultiDrawElements(GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawcount) {
+	_begin(GL_CAPTURE_OP_MULTIDRAWELEMENTS);
+	_put_value(mode);
+	_put_value(type);
+	_put_value(drawcount);
+	_put(count, (size_t)drawcount * sizeof(GLsizei));
+	for (GLsizei i = 0; i < drawcount; i++) {
+		_put_pointer(indices[i]);
+	}
+	_real.MultiDrawElements(mode, count, type, indices, drawcount);
+}
+
+static void APIENTRY _capture_PixelStorei(GLenum pname, GLint param) {
+	if (pname == GL_UNPACK_ALIGNMENT) {
+		_capture->unpack_alignment = param;
+	}
+	if (pname == GL_PACK_ALIGNMENT) {
+		_capture->pack_alignment = param;
+	}
+	_begin(GL_CAPTURE_OP_PIXELSTOREI);
+	_put_value(pname);
+	_put_value(param);
+	_real.PixelStorei(pname, param);
+}
+
+static void APIENTRY _capture_RenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) {
+	_begin(GL_CAPTURE_OP_RENDERBUFFERSTORAGE);
+	_put_value(target);
+	_put_value(internalformat);
+	_put_value(width);
+	_put_value(height);
+	_real.RenderbufferStorage(target, internalformat, width, height);
+}
+
+//ÿԴ뵥Ϊһݿ飬طʱȴȥ
+static void APIENTRY _capture_ShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length) {
+	_begin(GL_CAPTURE_OP_SHADERSOURCE);
+	_put_value(shader);
+	_put_value(count);
+	for (GLsizei i = 0; i < count; i++) {
+		size_t size = (length && length[i] >= 0) ? (size_t)length[i] : strlen(string[i]);
+		_put_blob(string[i], size);
+	}
+	_real.ShaderSource(shader, count, string, length);
+}
+
+static void APIENTRY _capture_TexBuffer(GLenum target, GLenum internalformat, GLuint buffer) {
+	_begin(GL_CAPTURE_OP_TEXBUFFER);
+	_put_value(target);
+	_put_value(internalformat);
+	_put_value(buffer);
+	_real.TexBuffer(target, internalformat, buffer);
+}
+
+static void APIENTRY _capture_TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels) {
+	_begin(GL_CAPTURE_OP_TEXIMAGE2D);
+	_put_value(target);
+	_put_value(level);
+	_put_value(internalformat);
+	_put_value(width);
+	_put_value(height);
+	_put_value(border);
+	_put_value(format);
+	_put_value(type);
+	_put_blob(pixels, _image_size(format, type, width, height, 1, _capture->unpack_alignment));
+	_real.TexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+}
+
+static void APIENTRY _capture_TexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels) {
+	_begin(GL_CAPTURE_OP_TEXIMAGE3D);
+	_put_value(target);
+	_put_value(level);
+	_put_value(internalformat);
+	_put_value(width);
+	_put_value(height);
+	_put_value(depth);
+	_put_value(border);
+	_put_value(format);
+	_put_value(type);
+	_put_blob(pixels, _image_size(format, type, width, height, depth, _capture->unpack_alignment));
+	_real.TexImage3D(target, level, internalformat, width, height, depth, border, format, type, pixels);
+}
+
+static void APIENTRY _capture_TexParameteri(GLenum target, GLenum pname, GLint param) {
+	_begin(GL_CAPTURE_OP_TEXPARAMETERI);
+	_put_value(target);
+	_put_value(pname);
+	_put_value(param);
+	_real.TexParameteri(target, pname, param);
+}
+
+static void APIENTRY _capture_TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels) {
+	_begin(GL_CAPTURE_OP_TEXSUBIMAGE2D);
+	_put_value(target);
+	_put_value(level);
+	_put_value(xoffset);
+	_put_value(yoffset);
+	_put_value(width);
+	_put_value(height);
+	_put_value(format);
+	_put_value(type);
+	_put_blob(pixels, _image_size(format, type, width, height, 1, _capture->unpack_alignment));
+	_real.TexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+}
+
+static void APIENTRY _capture_TexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels) {
+	_begin(GL_CAPTURE_OP_TEXSUBIMAGE3D);
+	_put_value(target);
+	_put_value(level);
+	_put_value(xoffset);
+	_put_value(yoffset);
+	_put_value(zoffset);
+	_put_value(width);
+	_put_value(height);
+	_put_value(depth);
+	_put_value(format);
+	_put_value(type);
+	_put_blob(pixels, _image_size(format, type, width, height, depth, _capture->unpack_alignment));
+	_real.TexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+}
+
+//ͬβ0һдطʱֱӴȥ
+static void APIENTRY _capture_TransformFeedbackVaryings(GLuint program, GLsizei count, const GLchar* const* varyings, GLenum bufferMode) {
+	_begin(GL_CAPTURE_OP_TRANSFORMFEEDBACKVARYINGS);
+	_put_value(program);
+	_put_value(count);
+	for (GLsizei i = 0; i < count; i++) {
+		_put_blob(varyings[i], strlen(varyings[i]) + 1);
+	}
+	_put_value(bufferMode);
+	_real.TransformFeedbackVaryings(program, count, varyings, bufferMode);
+}
+
+static void APIENTRY _capture_Uniform1f(GLint location, GLfloat v0) {
+	_begin(GL_CAPTURE_OP_UNIFORM1F);
+	_put_value(location);
+	_put_value(v0);
+	_real.Uniform1f(location, v0);
+}
+
+static void APIENTRY _capture_Uniform1i(GLint location, GLint v0) {
+	_begin(GL_CAPTURE_OP_UNIFORM1I);
+	_put_value(location);
+	_put_value(v0);
+	_real.Uniform1i(location, v0);
+}
+
+static void APIENTRY _capture_Uniform2f(GLint location, GLfloat v0, GLfloat v1) {
+	GLfloat v[2] = { v0, v1 };
+	_begin(GL_CAPTURE_OP_UNIFORM2F);
+	_put_value(location);
+	_put(v, sizeof(v));
+	_real.Uniform2f(location, v0, v1);
+}
+
+static void APIENTRY _capture_Uniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+	GLfloat v[3] = { v0, v1, v2 };
+	_begin(GL_CAPTURE_OP_UNIFORM3F);
+	_put_value(location);
+	_put(v, sizeof(v));
+	_real.Uniform3f(location, v0, v1, v2);
+}
+
+static void APIENTRY _capture_Uniform3fv(GLint location, GLsizei count, const GLfloat* value) {
+	_begin(GL_CAPTURE_OP_UNIFORM3FV);
+	_put_value(location);
+	_put_value(count);
+	_put(value, (size_t)count * 3 * sizeof(GLfloat));
+	_real.Uniform3fv(location, count, value);
+}
+
+static void APIENTRY _capture_Uniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+	GLfloat v[4] = { v0, v1, v2, v3 };
+	_begin(GL_CAPTURE_OP_UNIFORM4F);
+	_put_value(location);
+	_put(v, sizeof(v));
+	_real.Uniform4f(location, v0, v1, v2, v3);
+}
+
+static void APIENTRY _capture_UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+	_begin(GL_CAPTURE_OP_UNIFORMMATRIX4FV);
+	_put_value(location);
+	_put_value(count);
+	_put_value(transpose);
+	_put(value, (size_t)count * 16 * sizeof(GLfloat));
+	_real.UniformMatrix4fv(location, count, transpose, value);
+}
+
+static GLboolean APIENTRY _capture_UnmapBuffer(GLenum target) {
+	_begin(GL_CAPTURE_OP_UNMAPBUFFER);
+	_put_value(target);
+	_put_blob(_capture->mapped_size ? _capture->mapped : NULL, _capture->mapped_size);
+	_capture->mapped = NULL;
+	_capture->mapped_size = 0;
+	return _real.UnmapBuffer(target);
+}
+
+static void APIENTRY _capture_UseProgram(GLuint program) {
+	_begin(GL_CAPTURE_OP_USEPROGRAM);
+	_put_value(program);
+	_real.UseProgram(program);
+}
+
+static void APIENTRY _capture_VertexAttribDivisor(GLuint index, GLuint divisor) {
+	_begin(GL_CAPTURE_OP_VERTEXATTRIBDIVISOR);
+	_put_value(index);
+	_put_value(divisor);
+	_real.VertexAttribDivisor(index, divisor);
+}
+
+//ݶڰ󶨵Ļpointerǻڵƫ
+static void APIENTRY _capture_VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer) {
+	_begin(GL_CAPTURE_OP_VERTEXATTRIBPOINTER);
+	_put_value(index);
+	_put_value(size);
+	_put_value(type);
+	_put_value(normalized);
+	_put_value(stride);
+	_put_pointer(pointer);
+	_real.VertexAttribPointer(index, size, type, normalized, stride, pointer);
+}
+
+static void APIENTRY _capture_Viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+	GLint rect[4] = { x, y, width, height };
+	_begin(GL_CAPTURE_OP_VIEWPORT);
+	_put(rect, sizeof(rect));
+	_real.Viewport(x, y, width, height);
+}
+
+bool gl_capture_begin(gl_capture_t* capture, const char* path) {
+	memset(capture, 0, sizeof(*capture));
+	if (_capture) {
+		printf("ERROR::GL_CAPTURE::ALREADY_CAPTURING: %s\n", path);
+		return false;
+	}
+	capture->fp = fopen(path, "wb");
+	if (capture->fp == NULL) {
+		printf("ERROR::GL_CAPTURE::OPEN_FAILED: %s\n", path);
+		return false;
+	}
+	capture->header.magic = GL_CAPTURE_MAGIC;
+	capture->header.version = GL_CAPTURE_VERSION;
+	//ļͷռλʱٻд
+	capture->ok = fwrite(&capture->header, sizeof(capture->header), 1, capture->fp) == 1;
+	capture->buffer = (unsigned char*)malloc(GL_CAPTURE_BUFFER_SIZE);
+	glGetIntegerv(GL_UNPACK_ALIGNMENT, &capture->unpack_alignment);
+	glGetIntegerv(GL_PACK_ALIGNMENT, &capture->pack_alignment);
+	_capture = capture;
+
+#define GL_CAPTURE_HOOK(name, upper) _real.name = glad_gl##name; glad_gl##name = _capture_##name;
+	GL_CAPTURE_FUNCTIONS(GL_CAPTURE_HOOK)
+#undef GL_CAPTURE_HOOK
+	return true;
+}
+
+void gl_capture_frame(gl_capture_t* capture) {
+	uint8_t code = GL_CAPTURE_OP_FRAME;
+	_put_value(code);
+	capture->header.frame_count++;
+}
+
+bool gl_capture_end(gl_capture_t* capture) {
+	if (_capture != capture) {
+		return false;
+	}
+#define GL_CAPTURE_UNHOOK(name, upper) glad_gl##name = _real.name;
+	GL_CAPTURE_FUNCTIONS(GL_CAPTURE_UNHOOK)
+#undef GL_CAPTURE_UNHOOK
+	_flush();
+	_capture = NULL;
+
+	bool ok = capture->ok
+		&& fseek(capture->fp, 0, SEEK_SET) == 0
+		&& fwrite(&capture->header, sizeof(capture->header), 1, capture->fp) == 1;
+	ok = (fclose(capture->fp) == 0) && ok;
+	if (!ok) {
+		printf("ERROR::GL_CAPTURE::WRITE_FAILED\n");
+	}
+	free(capture->buffer);
+	capture->fp = NULL;
+	capture->buffer = NULL;
+	return ok;
+}
+
+//ط
+
+static uint64_t _name_hash(uint64_t key) {
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdull;
+	key ^= key >> 33;
+	return key;
+}
+
+static void _name_insert(gl_replay_t* replay, uint64_t key, uint64_t value);
+
+static void _name_grow(gl_replay_t* replay) {
+	gl_replay_entry_t* old = replay->names;
+	uint32_t old_capacity = replay->name_capacity;
+	replay->name_capacity = old_capacity ? old_capacity * 2 : 1024;
+	replay->names = (gl_replay_entry_t*)calloc(replay->name_capacity, sizeof(gl_replay_entry_t));
+	replay->name_count = 0;
+	for (uint32_t i = 0; i < old_capacity; i++) {
+		if (old[i].key) {
+			_name_insert(replay, old[i].key, old[i].value);
+		}
+	}
+	free(old);
+}
+
+//keyĸ8λռ䣬00ʾղ
+static void _name_insert(gl_replay_t* replay, uint64_t key, uint64_t value) {
+	if ((replay->name_count + 1) * 2 > replay->name_capacity) {
+		_name_grow(replay);
+	}
+	uint32_t mask = replay->name_capacity - 1;
+	uint32_t i = (uint32_t)_name_hash(key) & mask;
+	while (replay->names[i].key && replay->names[i].key != key) {
+		i = (i + 1) & mask;
+	}
+	if (replay->names[i].key == 0) {
+		replay->name_count++;
+	}
+	replay->names[i].key = key;
+	replay->names[i].value = value;
+}
+
+//ûӳԭأ0Ĭ϶Ҫӳ
+static uint64_t _name_find(const gl_replay_t* replay, uint64_t key, uint64_t recorded) {
+	if (replay->name_capacity == 0) {
+		return recorded;
+	}
+	uint32_t mask = replay->name_capacity - 1;
+	uint32_t i = (uint32_t)_name_hash(key) & mask;
+	while (replay->names[i].key) {
+		if (replay->names[i].key == key) {
+			return replay->names[i].value;
+		}
+		i = (i + 1) & mask;
+	}
+	return recorded;
+}
+
+static uint64_t _key(gl_name_space_t space, uint64_t name) {
+	return ((uint64_t)space << 56) | (name & 0x00ffffffffffffffull);
+}
+
+static GLuint _name(const gl_replay_t* replay, gl_name_space_t space, GLuint recorded) {
+	return recorded ? (GLuint)_name_find(replay, _key(space, recorded), recorded) : 0;
+}
+
+static GLsync _sync(const gl_replay_t* replay, uint64_t recorded) {
+	return (GLsync)(uintptr_t)_name_find(replay, _key(GL_NAME_SYNC, recorded), recorded);
+}
+
+//uniformλֻĳ壬ǰ
+static uint64_t _location_key(const gl_replay_t* replay, GLint location) {
+	return _key(GL_NAME_LOCATION, ((uint64_t)replay->program << 32) | (uint32_t)location);
+}
+
+static GLint _location(const gl_replay_t* replay, GLint recorded) {
+	return recorded < 0 ? recorded : (GLint)_name_find(replay, _location_key(replay, recorded), (uint64_t)recorded);
+}
+
+static const unsigned char* _get(gl_replay_t* replay, size_t size) {
+	if (!replay->ok || replay->offset + size > replay->map.size) {
+		replay->ok = false;
+		return NULL;
+	}
+	const unsigned char* p = replay->map.data + replay->offset;
+	replay->offset += size;
+	return p;
+}
+
+static uint32_t _u32(gl_replay_t* replay) {
+	uint32_t v = 0;
+	const unsigned char* p = _get(replay, sizeof(v));
+	if (p) {
+		memcpy(&v, p, sizeof(v));
+	}
+	return v;
+}
+
+static int32_t _i32(gl_replay_t* replay) {
+	return (int32_t)_u32(replay);
+}
+
+static float _f32(gl_replay_t* replay) {
+	uint32_t bits = _u32(replay);
+	float v;
+	memcpy(&v, &bits, sizeof(v));
+	return v;
+}
+
+static uint64_t _u64(gl_replay_t* replay) {
+	uint64_t v = 0;
+	const unsigned char* p = _get(replay, sizeof(v));
+	if (p) {
+		memcpy(&v, p, sizeof(v));
+	}
+	return v;
+}
+
+static uint8_t _u8(gl_replay_t* replay) {
+	const unsigned char* p = _get(replay, 1);
+	return p ? *p : 0;
+}
+
+static const void* _pointer(gl_replay_t* replay) {
+	return (const void*)(uintptr_t)_u64(replay);
+}
+
+//ݿֱָӳ䣬Ϊ0ʱNULL
+static const void* _blob(gl_replay_t* replay, uint32_t* size) {
+	uint32_t length = _u32(replay);
+	if (size) {
+		*size = length;
+	}
+	return length ? _get(replay, length) : NULL;
+}
+
+//鿽ʱڴӳеݲ֤
+static void* _array(gl_replay_t* replay, size_t size, size_t offset) {
+	const unsigned char* p = _get(replay, size);
+	if (p == NULL) {
+		return NULL;
+	}
+	if (replay->scratch_size < offset + size) {
+		replay->scratch_size = (offset + size) * 2;
+		replay->scratch = (unsigned char*)realloc(replay->scratch, replay->scratch_size);
+	}
+	memcpy(replay->scratch + offset, p, size);
+	return replay->scratch + offset;
+}
+
+static void* _scratch(gl_replay_t* replay, size_t size) {
+	if (replay->scratch_size < size) {
+		replay->scratch_size = size * 2;
+		replay->scratch = (unsigned char*)realloc(replay->scratch, replay->scratch_size);
+	}
+	return replay->scratch;
+}
+
+typedef void (APIENTRYP _gen_fn)(GLsizei n, GLuint* names);
+
+static void _replay_gen(gl_replay_t* replay, gl_name_space_t space, _gen_fn gen) {
+	GLsizei n = _i32(replay);
+	const unsigned char* recorded = _get(replay, (size_t)n * sizeof(GLuint));
+	if (recorded == NULL) {
+		return;
+	}
+	GLuint* names = (GLuint*)_scratch(replay, (size_t)n * sizeof(GLuint));
+	gen(n, names);
+	for (GLsizei i = 0; i < n; i++) {
+		GLuint name;
+		memcpy(&name, recorded + i * sizeof(GLuint), sizeof(name));
+		_name_insert(replay, _key(space, name), names[i]);
+	}
+}
+
+static void _replay_delete(gl_replay_t* replay, gl_name_space_t space, _gen_fn destroy) {
+	GLsizei n = _i32(replay);
+	GLuint* names = (GLuint*)_array(replay, (size_t)n * sizeof(GLuint), 0);
+	if (names == NULL) {
+		return;
+	}
+	for (GLsizei i = 0; i < n; i++) {
+		names[i] = _name(replay, space, names[i]);
+	}
+	destroy(n, names);
+}
+
+bool gl_replay_open(gl_replay_t* replay, const char* path) {
+	memset(replay, 0, sizeof(*replay));
+	if (!file_map_open(&replay->map, path)) {
+		printf("ERROR::GL_REPLAY::OPEN_FAILED: %s\n", path);
+		return false;
+	}
+	if (replay->map.size < sizeof(gl_capture_header_t)) {
+		printf("ERROR::GL_REPLAY::INVALID_FILE: %s\n", path);
+		file_map_close(&replay->map);
+		return false;
+	}
+	memcpy(&replay->header, replay->map.data, sizeof(replay->header));
+	if (replay->header.magic != GL_CAPTURE_MAGIC || replay->header.version != GL_CAPTURE_VERSION) {
+		printf("ERROR::GL_REPLAY::INVALID_FILE: %s\n", path);
+		file_map_close(&replay->map);
+		return false;
+	}
+	replay->offset = sizeof(gl_capture_header_t);
+	replay->ok = true;
+	return true;
+}
+
+void gl_replay_close(gl_replay_t* replay) {
+	file_map_close(&replay->map);
+	free(replay->names);
+	free(replay->scratch);
+	memset(replay, 0, sizeof(*replay));
+}
+
+bool gl_replay_frame(gl_replay_t* replay, uint64_t* calls) {
+	uint64_t count = 0;
+	bool frame = false;
+	while (replay->ok && !frame && replay->offset < replay->map.size) {
+		uint8_t op = _u8(replay);
+		if (op != GL_CAPTURE_OP_FRAME) {
+			count++;
+		}
+		switch (op) {
+		case GL_CAPTURE_OP_FRAME: {
+			frame = true;
+		} break;
+		case GL_CAPTURE_OP_ACTIVETEXTURE: {
+			glActiveTexture(_u32(replay));
+		} break;
+		case GL_CAPTURE_OP_ATTACHSHADER: {
+			GLuint program = _name(replay, GL_NAME_PROGRAM, _u32(replay));
+			glAttachShader(program, _name(replay, GL_NAME_PROGRAM, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_BEGINQUERY: {
+			GLenum target = _u32(replay);
+			glBeginQuery(target, _name(replay, GL_NAME_QUERY, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_BEGINTRANSFORMFEEDBACK: {
+			glBeginTransformFeedback(_u32(replay));
+		} break;
+		case GL_CAPTURE_OP_BINDBUFFER: {
+			GLenum target = _u32(replay);
+			glBindBuffer(target, _name(replay, GL_NAME_BUFFER, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_BINDBUFFERBASE: {
+			GLenum target = _u32(replay);
+			GLuint index = _u32(replay);
+			glBindBufferBase(target, index, _name(replay, GL_NAME_BUFFER, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_BINDFRAMEBUFFER: {
+			GLenum target = _u32(replay);
+			glBindFramebuffer(target, _name(replay, GL_NAME_FRAMEBUFFER, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_BINDRENDERBUFFER: {
+			GLenum target = _u32(replay);
+			glBindRenderbuffer(target, _name(replay, GL_NAME_RENDERBUFFER, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_BINDTEXTURE: {
+			GLenum target = _u32(replay);
+			glBindTexture(target, _name(replay, GL_NAME_TEXTURE, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_BINDVERTEXARRAY: {
+			glBindVertexArray(_name(replay, GL_NAME_VERTEX_ARRAY, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_BLENDFUNC: {
+			GLenum sfactor = _u32(replay);
+			glBlendFunc(sfactor, _u32(replay));
+		} break;
+		case GL_CAPTURE_OP_BLITFRAMEBUFFER: {
+			GLint r[8];
+			for (int i = 0; i < 8; i++) {
+				r[i] = _i32(replay);
+			}
+			GLbitfield mask = _u32(replay);
+			glBlitFramebuffer(r[0], r[1], r[2], r[3], r[4], r[5], r[6], r[7], mask, _u32(replay));
+		} break;
+		case GL_CAPTURE_OP_BUFFERDATA: {
+			GLenum target = _u32(replay);
+			int64_t size = (int64_t)_u64(replay);
+			const void* data = _blob(replay, NULL);
+			glBufferData(target, (GLsizeiptr)size, data, _u32(replay));
+		} break;
+		case GL_CAPTURE_OP_BUFFERSUBDATA: {
+			GLenum target = _u32(replay);
+			int64_t offset = (int64_t)_u64(replay);
+			uint32_t size;
+			const void* data = _blob(replay, &size);
+			glBufferSubData(target, (GLintptr)offset, size, data);
+		} break;
+		case GL_CAPTURE_OP_CHECKFRAMEBUFFERSTATUS: {
+			glCheckFramebufferStatus(_u32(replay));
+		} break;
+		case GL_CAPTURE_OP_CLEAR: {
+			glClear(_u32(replay));
+		} break;
+		case GL_CAPTURE_OP_CLEARCOLOR: {
+			float r = _f32(replay);
+			float g = _f32(replay);
+			float b = _f32(replay);
+			glClearColor(r, g, b, _f32(replay));
+		} break;
+		case GL_CAPTURE_OP_CLIENTWAITSYNC: {
+			GLsync sync = _sync(replay, _u64(replay));
+			GLbitfield flags = _u32(replay);
+			glClientWaitSync(sync, flags, _u64(replay));
+		} break;
+		case GL_CAPTURE_OP_COMPILESHADER: {
+			glCompileShader(_name(replay, GL_NAME_PROGRAM, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_CREATEPROGRAM: {
+			GLuint recorded = _u32(replay);
+			_name_insert(replay, _key(GL_NAME_PROGRAM, recorded), glCreateProgram());
+		} break;
+		case GL_CAPTURE_OP_CREATESHADER: {
+			GLenum type = _u32(replay);
+			GLuint recorded = _u32(replay);
+			_name_insert(replay, _key(GL_NAME_PROGRAM, recorded), glCreateShader(type));
+		} break;
+		case GL_CAPTURE_OP_DELETEBUFFERS: {
+			_replay_delete(replay, GL_NAME_BUFFER, (_gen_fn)glad_glDeleteBuffers);
+		} break;
+		case GL_CAPTURE_OP_DELETEFRAMEBUFFERS: {
+			_replay_delete(replay, GL_NAME_FRAMEBUFFER, (_gen_fn)glad_glDeleteFramebuffers);
+		} break;
+		case GL_CAPTURE_OP_DELETEPROGRAM: {
+			glDeleteProgram(_name(replay, GL_NAME_PROGRAM, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_DELETEQUERIES: {
+			_replay_delete(replay, GL_NAME_QUERY, (_gen_fn)glad_glDeleteQueries);
+		} break;
+		case GL_CAPTURE_OP_DELETERENDERBUFFERS: {
+			_replay_delete(replay, GL_NAME_RENDERBUFFER, (_gen_fn)glad_glDeleteRenderbuffers);
+		} break;
+		case GL_CAPTURE_OP_DELETESHADER: {
+			glDeleteShader(_name(replay, GL_NAME_PROGRAM, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_DELETESYNC: {
+			glDeleteSync(_sync(replay, _u64(replay)));
+		} break;
+		case GL_CAPTURE_OP_DELETETEXTURES: {
+			_replay_delete(replay, GL_NAME_TEXTURE, (_gen_fn)glad_glDeleteTextures);
+		} break;
+		case GL_CAPTURE_OP_DELETEVERTEXARRAYS: {
+			_replay_delete(replay, GL_NAME_VERTEX_ARRAY, (_gen_fn)glad_glDeleteVertexArrays);
+		} break;
+		case GL_CAPTURE_OP_DEPTHMASK: {
+			glDepthMask(_u8(replay));
+		} break;
+		case GL_CAPTURE_OP_DISABLE: {
+			glDisable(_u32(replay));
+		} break;
+		case GL_CAPTURE_OP_DRAWARRAYS: {
+			GLenum mode = _u32(replay);
+			GLint first = _i32(replay);
+			glDrawArrays(mode, first, _i32(replay));
+		} break;
+		case GL_CAPTURE_OP_DRAWARRAYSINSTANCED: {
+			GLenum mode = _u32(replay);
+			GLint first = _i32(replay);
+			GLsizei count = _i32(replay);
+			glDrawArraysInstanced(mode, first, count, _i32(replay));
+		} break;
+		case GL_CAPTURE_OP_DRAWELEMENTS: {
+			GLenum mode = _u32(replay);
+			GLsizei count = _i32(replay);
+			GLenum type = _u32(replay);
+			glDrawElements(mode, count, type, _pointer(replay));
+		} break;
+		case GL_CAPTURE_OP_DRAWELEMENTSBASEVERTEX: {
+			GLenum mode = _u32(replay);
+			GLsizei count = _i32(replay);
+			GLenum type = _u32(replay);
+			const void* indices = _pointer(replay);
+			glDrawElementsBaseVertex(mode, count, type, indices, _i32(replay));
+		} break;
+		case GL_CAPTURE_OP_DRAWELEMENTSINSTANCED: {
+			GLenum mode = _u32(replay);
+			GLsizei count = _i32(replay);
+			GLenum type = _u32(replay);
+			const void* indices = _pointer(replay);
+			glDrawElementsInstanced(mode, count, type, indices, _i32(replay));
+		} break;
+		case GL_CAPTURE_OP_ENABLE: {
+			glEnable(_u32(replay));
+		} break;
+		case GL_CAPTURE_OP_ENABLEVERTEXATTRIBARRAY: {
+			glEnableVertexAttribArray(_u32(replay));
+		} break;
+		case GL_CAPTURE_OP_ENDQUERY: {
+			glEndQuery(_u32(replay));
+		} break;
+		case GL_CAPTURE_OP_ENDTRANSFORMFEEDBACK: {
+			glEndTransformFeedback();
+		} break;
+		case GL_CAPTURE_OP_FENCESYNC: {
+			GLenum condition = _u32(replay);
+			GLbitfield flags = _u32(replay);
+			uint64_t recorded = _u64(replay);
+			_name_insert(replay, _key(GL_NAME_SYNC, recorded), (uint64_t)(uintptr_t)glFenceSync(condition, flags));
+		} break;
+		case GL_CAPTURE_OP_FINISH: {
+			glFinish();
+		} break;
+		case GL_CAPTURE_OP_FLUSH: {
+			glFlush();
+		} break;
+		case GL_CAPTURE_OP_FRAMEBUFFERRENDERBUFFER: {
+			GLenum target = _u32(replay);
+			GLenum attachment = _u32(replay);
+			GLenum renderbuffertarget = _u32(replay);
+			glFramebufferRenderbuffer(target, attachment, renderbuffertarget, _name(replay, GL_NAME_RENDERBUFFER, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_FRAMEBUFFERTEXTURE2D: {
+			GLenum target = _u32(replay);
+			GLenum attachment = _u32(replay);
+			GLenum textarget = _u32(replay);
+			GLuint texture = _name(replay, GL_NAME_TEXTURE, _u32(replay));
+			glFramebufferTexture2D(target, attachment, textarget, texture, _i32(replay));
+		} break;
+		case GL_CAPTURE_OP_GENBUFFERS: {
+			_replay_gen(replay, GL_NAME_BUFFER, glad_glGenBuffers);
+		} break;
+		case GL_CAPTURE_OP_GENFRAMEBUFFERS: {
+			_replay_gen(replay, GL_NAME_FRAMEBUFFER, glad_glGenFramebuffers);
+		} break;
+		case GL_CAPTURE_OP_GENQUERIES: {
+			_replay_gen(replay, GL_NAME_QUERY, glad_glGenQueries);
+		} break;
+		case GL_CAPTURE_OP_GENRENDERBUFFERS: {
+			_replay_gen(replay, GL_NAME_RENDERBUFFER, glad_glGenRenderbuffers);
+		} break;
+		case GL_CAPTURE_OP_GENTEXTURES: {
+			_replay_gen(replay, GL_NAME_TEXTURE, glad_glGenTextures);
+		} break;
+		case GL_CAPTURE_OP_GENVERTEXARRAYS: {
+			_replay_gen(replay, GL_NAME_VERTEX_ARRAY, glad_glGenVertexArrays);
+		} break;
+		case GL_CAPTURE_OP_GENERATEMIPMAP: {
+			glGenerateMipmap(_u32(replay));
+		} break;
+		case GL_CAPTURE_OP_GETINTEGERV: {
+			//෵16ֵĲѯ
+			glGetIntegerv(_u32(replay), (GLint*)_scratch(replay, 16 * sizeof(GLint)));
+		} break;
+		case GL_CAPTURE_OP_GETPROGRAMINFOLOG: {
+			GLuint program = _name(replay, GL_NAME_PROGRAM, _u32(replay));
+			GLsizei size = _i32(replay);
+			glGetProgramInfoLog(program, size, NULL, (GLchar*)_scratch(replay, size > 0 ? size : 1));
+		} break;
+		case GL_CAPTURE_OP_GETPROGRAMIV: {
+			GLuint program = _name(replay, GL_NAME_PROGRAM, _u32(replay));
+			glGetProgramiv(program, _u32(replay), (GLint*)_scratch(replay, 16 * sizeof(GLint)));
+		} break;
+		case GL_CAPTURE_OP_GETQUERYOBJECTUI64V: {
+			GLuint id = _name(replay, GL_NAME_QUERY, _u32(replay));
+			glGetQueryObjectui64v(id, _u32(replay), (GLuint64*)_scratch(replay, sizeof(GLuint64)));
+		} break;
+		case GL_CAPTURE_OP_GETSHADERINFOLOG: {
+			GLuint shader = _name(replay, GL_NAME_PROGRAM, _u32(replay));
+			GLsizei size = _i32(replay);
+			glGetShaderInfoLog(shader, size, NULL, (GLchar*)_scratch(replay, size > 0 ? size : 1));
+		} break;
+		case GL_CAPTURE_OP_GETSHADERIV: {
+			GLuint shader = _name(replay, GL_NAME_PROGRAM, _u32(replay));
+			glGetShaderiv(shader, _u32(replay), (GLint*)_scratch(replay, 16 * sizeof(GLint)));
+		} break;
+		case GL_CAPTURE_OP_GETTEXIMAGE: {
+			GLenum target = _u32(replay);
+			GLint level = _i32(replay);
+			GLenum format = _u32(replay);
+			GLenum type = _u32(replay);
+			uint64_t size = _u64(replay);
+			glGetTexImage(target, level, format, type, _scratch(replay, (size_t)size));
+		} break;
+		case GL_CAPTURE_OP_GETUNIFORMLOCATION: {
+			GLuint recorded = _u32(replay);
+			const GLchar* name = (const GLchar*)_blob(replay, NULL);
+			GLint location = _i32(replay);
+			if (name && location >= 0) {
+				uint32_t current = replay->program;
+				replay->program = recorded;
+				_name_insert(replay, _location_key(replay, location), (uint32_t)glGetUniformLocation(_name(replay, GL_NAME_PROGRAM, recorded), name));
+				replay->program = current;
+			}
+		} break;
+		case GL_CAPTURE_OP_LINKPROGRAM: {
+			glLinkProgram(_name(replay, GL_NAME_PROGRAM, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_MAPBUFFERRANGE: {
+			GLenum target = _u32(replay);
+			int64_t offset = (int64_t)_u64(replay);
+			int64_t length = (int64_t)_u64(replay);
+			GLbitfield access = _u32(replay);
+			replay->mapped = replay->ok ? glMapBufferRange(target, (GLintptr)offset, (GLsizeiptr)length, access) : NULL;
+			replay->mapped_size = replay->mapped ? (size_t)length : 0;
+		} break;
+		case GL_CAPTURE_OP_MULTIDRAWARRAYS: {
+			GLenum mode = _u32(replay);
+			GLsizei n = _i32(replay);
+			GLint* first = (GLint*)_array(replay, (size_t)n * sizeof(GLint), 0);
+			GLsizei* count = (GLsizei*)_array(replay, (size_t)n * sizeof(GLsizei), (size_t)n * sizeof(GLint));
+			if (first && count) {
+				first = (GLint*)replay->scratch;
+				glMultiDrawArrays(mode, first, count, n);
+			}
+		} break;
+		case GL_CAPTURE_OP_MULTIDRAWELEMENTS: {
+			GLenum mode = _u32(replay);
+			GLenum type = _u32(replay);
+			GLsizei n = _i32(replay);
+			size_t count_size = ((size_t)n * sizeof(GLsizei) + 7) & ~(size_t)7;
+			if (_array(replay, (size_t)n * sizeof(GLsizei), 0) == NULL) {
+				break;
+			}
+			//ƫڼ棬8ֽڶ
+			const unsigned char* offsets = _get(replay, (size_t)n * sizeof(uint64_t));
+			if (offsets == NULL) {
+				break;
+			}
+			unsigned char* base = (unsigned char*)_scratch(replay, count_size + (size_t)n * sizeof(void*));
+			const void** indices = (const void**)(base + count_size);
+			for (GLsizei i = 0; i < n; i++) {
+				uint64_t offset;
+				memcpy(&offset, offsets + i * sizeof(uint64_t), sizeof(offset));
+				indices[i] = (const void*)(uintptr_t)offset;
+			}
+			glMultiDrawElements(mode, (const GLsizei*)base, type, indices, n);
+		} break;
+		case GL_CAPTURE_OP_PIXELSTOREI: {
+			GLenum pname = _u32(replay);
+			glPixelStorei(pname, _i32(replay));
+		} break;
+		case GL_CAPTURE_OP_RENDERBUFFERSTORAGE: {
+			GLenum target = _u32(replay);
+			GLenum internalformat = _u32(replay);
+			GLsizei width = _i32(replay);
+			glRenderbufferStorage(target, internalformat, width, _i32(replay));
+		} break;
+		case GL_CAPTURE_OP_SHADERSOURCE: {
+			GLuint shader = _name(replay, GL_NAME_PROGRAM, _u32(replay));
+			GLsizei count = _i32(replay);
+			if (count <= 0 || count > 64) {
+				replay->ok = false;
+				break;
+			}
+			const GLchar* strings[64];
+			GLint lengths[64];
+			for (GLsizei i = 0; i < count; i++) {
+				uint32_t size;
+				strings[i] = (const GLchar*)_blob(replay, &size);
+				lengths[i] = (GLint)size;
+				if (strings[i] == NULL) {
+					strings[i] = "";
+				}
+			}
+			glShaderSource(shader, count, strings, lengths);
+		} break;
+		case GL_CAPTURE_OP_TEXBUFFER: {
+			GLenum target = _u32(replay);
+			GLenum internalformat = _u32(replay);
+			glTexBuffer(target, internalformat, _name(replay, GL_NAME_BUFFER, _u32(replay)));
+		} break;
+		case GL_CAPTURE_OP_TEXIMAGE2D: {
+			GLint v[8];
+			for (int i = 0; i < 8; i++) {
+				v[i] = _i32(replay);
+			}
+			glTexImage2D(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], _blob(replay, NULL));
+		} break;
+		case GL_CAPTURE_OP_TEXIMAGE3D: {
+			GLint v[9];
+			for (int i = 0; i < 9; i++) {
+				v[i] = _i32(replay);
+			}
+			glTexImage3D(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8], _blob(replay, NULL));
+		} break;
+		case GL_CAPTURE_OP_TEXPARAMETERI: {
+			GLenum target = _u32(replay);
+			GLenum pname = _u32(replay);
+			glTexParameteri(target, pname, _i32(replay));
+		} break;
+		case GL_CAPTURE_OP_TEXSUBIMAGE2D: {
+			GLint v[8];
+			for (int i = 0; i < 8; i++) {
+				v[i] = _i32(replay);
+			}
+			glTexSubImage2D(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], _blob(replay, NULL));
+		} break;
+		case GL_CAPTURE_OP_TEXSUBIMAGE3D: {
+			GLint v[10];
+			for (int i = 0; i < 10; i++) {
+				v[i] = _i32(replay);
+			}
+			glTexSubImage3D(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8], v[9], _blob(replay, NULL));
+		} break;
+		case GL_CAPTURE_OP_TRANSFORMFEEDBACKVARYINGS: {
+			GLuint program = _name(replay, GL_NAME_PROGRAM, _u32(replay));
+			GLsizei count = _i32(replay);
+			if (count <= 0 || count > 64) {
+				replay->ok = false;
+				break;
+			}
+			const GLchar* varyings[64];
+			for (GLsizei i = 0; i < count; i++) {
+				uint32_t size;
+				varyings[i] = (const GLchar*)_blob(replay, &size);
+				if (varyings[i] == NULL || varyings[i][size - 1] != '\0') {
+					replay->ok = false;
+				}
+			}
+			GLenum mode = _u32(replay);
+			if (replay->ok) {
+				glTransformFeedbackVaryings(program, count, varyings, mode);
+			}
+		} break;
+		case GL_CAPTURE_OP_UNIFORM1F: {
+			GLint location = _location(replay, _i32(replay));
+			glUniform1f(location, _f32(replay));
+		} break;
+		case GL_CAPTURE_OP_UNIFORM1I: {
+			GLint location = _location(replay, _i32(replay));
+			glUniform1i(location, _i32(replay));
+		} break;
+		case GL_CAPTURE_OP_UNIFORM2F: {
+			GLint location = _location(replay, _i32(replay));
+			float x = _f32(replay);
+			glUniform2f(location, x, _f32(replay));
+		} break;
+		case GL_CAPTURE_OP_UNIFORM3F: {
+			GLint location = _location(replay, _i32(replay));
+			float x = _f32(replay);
+			float y = _f32(replay);
+			glUniform3f(location, x, y, _f32(replay));
+		} break;
+		case GL_CAPTURE_OP_UNIFORM3FV: {
+			GLint location = _location(replay, _i32(replay));
+			GLsizei count = _i32(replay);
+			const GLfloat* value = (const GLfloat*)_array(replay, (size_t)count * 3 * sizeof(GLfloat), 0);
+			if (value) {
+				glUniform3fv(location, count, value);
+			}
+		} break;
+		case GL_CAPTURE_OP_UNIFORM4F: {
+			GLint location = _location(replay, _i32(replay));
+			float x = _f32(replay);
+			float y = _f32(replay);
+			float z = _f32(replay);
+			glUniform4f(location, x, y, z, _f32(replay));
+		} break;
+		case GL_CAPTURE_OP_UNIFORMMATRIX4FV: {
+			GLint location = _location(replay, _i32(replay));
+			GLsizei count = _i32(replay);
+			GLboolean transpose = _u8(replay);
+			const GLfloat* value = (const GLfloat*)_array(replay, (size_t)count * 16 * sizeof(GLfloat), 0);
+			if (value) {
+				glUniformMatrix4fv(location, count, transpose, value);
+			}
+		} break;
+		case GL_CAPTURE_OP_UNMAPBUFFER: {
+			GLenum target = _u32(replay);
+			uint32_t size;
+			const void* data = _blob(replay, &size);
+			if (data && replay->mapped) {
+				memcpy(replay->mapped, data, size < replay->mapped_size ? size : replay->mapped_size);
+			}
+			replay->mapped = NULL;
+			replay->mapped_size = 0;
+			glUnmapBuffer(target);
+		} break;
+		case GL_CAPTURE_OP_USEPROGRAM: {
+			replay->program = _u32(replay);
+			glUseProgram(_name(replay, GL_NAME_PROGRAM, replay->program));
+		} break;
+		case GL_CAPTURE_OP_VERTEXATTRIBDIVISOR: {
+			GLuint index = _u32(replay);
+			glVertexAttribDivisor(index, _u32(replay));
+		} break;
+		case GL_CAPTURE_OP_VERTEXATTRIBPOINTER: {
+			GLuint index = _u32(replay);
+			GLint size = _i32(replay);
+			GLenum type = _u32(replay);
+			GLboolean normalized = _u8(replay);
+			GLsizei stride = _i32(replay);
+			glVertexAttribPointer(index, size, type, normalized, stride, _pointer(replay));
+		} break;
+		case GL_CAPTURE_OP_VIEWPORT: {
+			GLint x = _i32(replay);
+			GLint y = _i32(replay);
+			GLsizei width = _i32(replay);
+			glViewport(x, y, width, _i32(replay));
+		} break;
+		default: {
+			printf("ERROR::GL_REPLAY::UNKNOWN_OPCODE: %u at %zu\n", op, replay->offset - 1);
+			replay->ok = false;
+		} break;
+		}
+	}
+	replay->calls += count;
+	if (calls) {
+		*calls = count;
+	}
+	return replay->ok && frame;
+}
@@ -0,0 +1,66 @@
+_Pragma("once")
+
+#include <cstdio>
+#include <cstdint>
+#include "file-map.h"
+
+#define GL_CAPTURE_MAGIC		0x52544c47	//"GLTR"
+#define GL_CAPTURE_VERSION		3
+#define GL_CAPTURE_BUFFER_SIZE	(1 << 20)	//ܹôдļñֻڴ濽
+
+//ļͷÿ1ֽڲ룬水˳Уݿǰ32λ
+//uniformλúͬ¼ʱֵ棬طʱӳ䵽´Ķ
+typedef struct gl_capture_header_s {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t call_count;
+	uint64_t frame_count;
+	uint64_t blob_bytes;		//塢ɫԴݿֽ
+}gl_capture_header_t;
+
+//滻gladĺָ룬֮GLͬһдļͬһʱֻһ¼
+//ֻرгĺõĶڱõĺҪӽȥ
+typedef struct gl_capture_s {
+	FILE* fp;
+	unsigned char* buffer;
+	size_t size;
+	gl_capture_header_t header;
+	int unpack_alignment;		//glPixelStoreiݿĴС
+	int pack_alignment;
+	void* mapped;				//ǰӳĻ壬ӳʱдļͬһʱֻһ
+	size_t mapped_size;			//ûдȨ޵ӳΪ0
+	bool ok;
+}gl_capture_t;
+
+//gladLoadGLLoader֮Ҫ¼Ƶĵһ֮ǰ
+extern bool gl_capture_begin(gl_capture_t* capture, const char* path);
+//֡ķֽ磬طŰ֡ͳʱ
+extern void gl_capture_frame(gl_capture_t* capture);
+//ָgladĺָ룬дļͷ
+extern bool gl_capture_end(gl_capture_t* capture);
+
+typedef struct gl_replay_entry_s {
+	uint64_t key;
+	uint64_t value;
+}gl_replay_entry_t;
+
+typedef struct gl_replay_s {
+	file_map_t map;
+	gl_capture_header_t header;
+	size_t offset;				//һλ
+	gl_replay_entry_t* names;	//¼ʱĶ -> طʱĶ
+	uint32_t name_count;
+	uint32_t name_capacity;		//2
+	uint32_t program;			//ǰ¼ʱ֣uniformλðӳ
+	unsigned char* scratch;		//õĿڴ
+	size_t scratch_size;
+	void* mapped;				//طʱӳĻ壬ӳǰ¼µݿȥ
+	size_t mapped_size;
+	uint64_t calls;
+	bool ok;
+}gl_replay_t;
+
+extern bool gl_replay_open(gl_replay_t* replay, const char* path);
+extern void gl_replay_close(gl_replay_t* replay);
+//ִеһֽ֡磬һ֡ĵ߳ʱfalseһֽ֮ĵҲѾִ
+extern bool gl_replay_frame(gl_replay_t* replay, uint64_t* calls);
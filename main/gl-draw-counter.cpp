@@ -0,0 +1,68 @@
+#include <glad/glad.h>
+#include "gl-draw-counter.h"
+
+static uint64_t _draw_calls;
+static PFNGLDRAWARRAYSPROC _gl_draw_arrays;
+static PFNGLDRAWELEMENTSPROC _gl_draw_elements;
+static PFNGLDRAWARRAYSINSTANCEDPROC _gl_draw_arrays_instanced;
+static PFNGLDRAWELEMENTSINSTANCEDPROC _gl_draw_elements_instanced;
+static PFNGLMULTIDRAWARRAYSPROC _gl_multi_draw_arrays;
+static PFNGLMULTIDRAWELEMENTSPROC _gl_multi_draw_elements;
+static PFNGLDRAWELEMENTSBASEVERTEXPROC _gl_draw_elements_base_vertex;
+
+static void APIENTRY _count_draw_arrays(GLenum mode, GLint first, GLsizei count) {
+	_draw_calls++;
+	_gl_draw_arrays(mode, first, count);
+}
+
+static void APIENTRY _count_draw_elements(GLenum mode, GLsizei count, GLenum type, const void* indices) {
+	_draw_calls++;
+	_gl_draw_elements(mode, count, type, indices);
+}
+
+static void APIENTRY _count_draw_arrays_instanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount) {
+	_draw_calls++;
+	_gl_draw_arrays_instanced(mode, first, count, instancecount);
+}
+
+static void APIENTRY _count_draw_elements_instanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount) {
+	_draw_calls++;
+	_gl_draw_elements_instanced(mode, count, type, indices, instancecount);
+}
+
+//ػưеĻƣͲɵʱɱ
+static void APIENTRY _count_multi_draw_arrays(GLenum mode, const GLint* first, const GLsizei* count, GLsizei drawcount) {
+	_draw_calls += drawcount;
+	_gl_multi_draw_arrays(mode, first, count, drawcount);
+}
+
+static void APIENTRY _count_multi_draw_elements(GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawcount) {
+	_draw_calls += drawcount;
+	_gl_multi_draw_elements(mode, count, type, indices, drawcount);
+}
+
+static void APIENTRY _count_draw_elements_base_vertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex) {
+	_draw_calls++;
+	_gl_draw_elements_base_vertex(mode, count, type, indices, basevertex);
+}
+
+void gl_draw_counter_hook() {
+	_gl_draw_arrays = glad_glDrawArrays;
+	_gl_draw_elements = glad_glDrawElements;
+	_gl_draw_arrays_instanced = glad_glDrawArraysInstanced;
+	_gl_draw_elements_instanced = glad_glDrawElementsInstanced;
+	_gl_multi_draw_arrays = glad_glMultiDrawArrays;
+	_gl_multi_draw_elements = glad_glMultiDrawElements;
+	_gl_draw_elements_base_vertex = glad_glDrawElementsBaseVertex;
+	glad_glDrawArrays = _count_draw_arrays;
+	glad_glDrawElements = _count_draw_elements;
+	glad_glDrawArraysInstanced = _count_draw_arrays_instanced;
+	glad_glDrawElementsInstanced = _count_draw_elements_instanced;
+	glad_glMultiDrawArrays = _count_multi_draw_arrays;
+	glad_glMultiDrawElements = _count_multi_draw_elements;
+	glad_glDrawElementsBaseVertex = _count_draw_elements_base_vertex;
+}
+
+uint64_t gl_draw_counter_get() {
+	return _draw_calls;
+}
@@ -0,0 +1,11 @@
+_Pragma("once")
+
+#include <cstdint>
+
+//滻gladĺָͳƻƵã벻Ҫ
+//ԭӵģֻGLڵ߳϶
+
+//gladLoadGLLoader֮һ
+extern void gl_draw_counter_hook();
+//ۼƵĻƵ
+extern uint64_t gl_draw_counter_get();
@@ -0,0 +1,239 @@
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include "image-mip.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_MIP_SSE 1
+#include <emmintrin.h>
+#endif
+
+#define SRGB_ENCODE_SIZE	4096
+
+//ÿٴֽ̫СĿȿȼ㻹
+#define IMAGE_MIP_TILE_BYTES	(64 * 1024)
+
+typedef struct _srgb_tables_s {
+	float decode[256];						//sRGB -> 
+	unsigned char encode[SRGB_ENCODE_SIZE];	// -> sRGB
+}_srgb_tables_t;
+
+static _srgb_tables_t _srgb_tables_init() {
+	_srgb_tables_t tables;
+	for (int i = 0; i < 256; i++) {
+		float c = i / 255.0f;
+		tables.decode[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+	}
+	for (int i = 0; i < SRGB_ENCODE_SIZE; i++) {
+		float l = i / (float)(SRGB_ENCODE_SIZE - 1);
+		float c = l <= 0.0031308f ? l * 12.92f : 1.055f * powf(l, 1.0f / 2.4f) - 0.055f;
+		tables.encode[i] = (unsigned char)(c * 255.0f + 0.5f);
+	}
+	return tables;
+}
+
+static const _srgb_tables_t* _srgb_tables() {
+	static const _srgb_tables_t tables = _srgb_tables_init();
+	return &tables;
+}
+
+typedef struct _mip_job_s {
+	const unsigned char* src;
+	unsigned char* dst;
+	int src_width;
+	int src_height;
+	int dst_width;
+	int dst_height;
+	int channels;
+	uint32_t flags;
+	const _srgb_tables_t* tables;
+}_mip_job_t;
+
+static uint32_t _rows_per_tile(int width) {
+	uint32_t rows = IMAGE_MIP_TILE_BYTES / ((uint32_t)width * 4);
+	return rows ? rows : 1;
+}
+
+uint32_t image_mip_level_count(int width, int height) {
+	uint32_t count = 1;
+	while ((width > 1 || height > 1) && count < IMAGE_MIP_MAX_LEVELS) {
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+		count++;
+	}
+	return count;
+}
+
+//0㣺ת + ͨչ
+static void _mip_expand_rows(void* user, uint32_t begin, uint32_t end) {
+	const _mip_job_t* job = (const _mip_job_t*)user;
+	int width = job->dst_width;
+	int channels = job->channels;
+	for (uint32_t y = begin; y < end; y++) {
+		uint32_t src_y = (job->flags & IMAGE_MIP_FLIP_Y) ? job->src_height - 1 - y : y;
+		const unsigned char* src = job->src + (size_t)src_y * width * channels;
+		unsigned char* dst = job->dst + (size_t)y * width * 4;
+		if (channels == 4) {
+			memcpy(dst, src, (size_t)width * 4);
+		}
+		else if (channels == 3) {
+			for (int x = 0; x < width; x++) {
+				dst[0] = src[0];
+				dst[1] = src[1];
+				dst[2] = src[2];
+				dst[3] = 255;
+				src += 3;
+				dst += 4;
+			}
+		}
+		else {
+			for (int x = 0; x < width; x++) {
+				dst[0] = src[0];
+				dst[1] = src[0];
+				dst[2] = src[0];
+				dst[3] = channels == 2 ? src[1] : 255;
+				src += channels;
+				dst += 4;
+			}
+		}
+	}
+}
+
+//ݵ2x2ƽSSEһ
+static void _mip_box_rows(void* user, uint32_t begin, uint32_t end) {
+	const _mip_job_t* job = (const _mip_job_t*)user;
+	int src_w = job->src_width;
+	int dst_w = job->dst_width;
+	//Ϊ1ʱһάСβͬһ/
+	int step_x = src_w > 1 ? 4 : 0;
+	for (uint32_t y = begin; y < end; y++) {
+		uint32_t y0 = job->src_height > 1 ? y * 2 : 0;
+		uint32_t y1 = job->src_height > 1 ? y0 + 1 : 0;
+		const unsigned char* row0 = job->src + (size_t)y0 * src_w * 4;
+		const unsigned char* row1 = job->src + (size_t)y1 * src_w * 4;
+		unsigned char* dst = job->dst + (size_t)y * dst_w * 4;
+		int x = 0;
+#if defined(IMAGE_MIP_SSE)
+		if (step_x) {
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i round = _mm_set1_epi16(2);
+			for (; x + 2 <= dst_w && x * 2 + 4 <= src_w; x += 2) {
+				__m128i a = _mm_loadu_si128((const __m128i*)(row0 + x * 8));
+				__m128i b = _mm_loadu_si128((const __m128i*)(row1 + x * 8));
+				//ӣlo01hi23
+				__m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+				__m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+				//ٰ
+				__m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+				sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+				_mm_storel_epi64((__m128i*)(dst + x * 4), _mm_packus_epi16(sum, sum));
+			}
+		}
+#endif
+		for (; x < dst_w; x++) {
+			const unsigned char* p00 = row0 + x * 2 * 4;
+			const unsigned char* p01 = p00 + step_x;
+			const unsigned char* p10 = row1 + x * 2 * 4;
+			const unsigned char* p11 = p10 + step_x;
+			for (int c = 0; c < 4; c++) {
+				dst[x * 4 + c] = (unsigned char)((p00[c] + p01[c] + p10[c] + p11[c] + 2) >> 2);
+			}
+		}
+	}
+}
+
+//sRGBתԿռƽalphaԵ
+static void _mip_srgb_rows(void* user, uint32_t begin, uint32_t end) {
+	const _mip_job_t* job = (const _mip_job_t*)user;
+	const float* decode = job->tables->decode;
+	const unsigned char* encode = job->tables->encode;
+	int src_w = job->src_width;
+	int dst_w = job->dst_width;
+	int step_x = src_w > 1 ? 4 : 0;
+	for (uint32_t y = begin; y < end; y++) {
+		uint32_t y0 = job->src_height > 1 ? y * 2 : 0;
+		uint32_t y1 = job->src_height > 1 ? y0 + 1 : 0;
+		const unsigned char* row0 = job->src + (size_t)y0 * src_w * 4;
+		const unsigned char* row1 = job->src + (size_t)y1 * src_w * 4;
+		unsigned char* dst = job->dst + (size_t)y * dst_w * 4;
+		for (int x = 0; x < dst_w; x++) {
+			const unsigned char* p[4];
+			p[0] = row0 + x * 2 * 4;
+			p[1] = p[0] + step_x;
+			p[2] = row1 + x * 2 * 4;
+			p[3] = p[2] + step_x;
+#if defined(IMAGE_MIP_SSE)
+			__m128 sum = _mm_setzero_ps();
+			for (int i = 0; i < 4; i++) {
+				sum = _mm_add_ps(sum, _mm_set_ps(p[i][3] * (1.0f / 255.0f), decode[p[i][2]], decode[p[i][1]], decode[p[i][0]]));
+			}
+			//ƽӳ䵽±꣬0.5
+			__m128 scaled = _mm_add_ps(_mm_mul_ps(sum, _mm_set1_ps(0.25f * (SRGB_ENCODE_SIZE - 1))), _mm_set1_ps(0.5f));
+			__m128i index = _mm_cvttps_epi32(scaled);
+			int lanes[4];
+			_mm_storeu_si128((__m128i*)lanes, index);
+			dst[x * 4 + 0] = encode[lanes[0]];
+			dst[x * 4 + 1] = encode[lanes[1]];
+			dst[x * 4 + 2] = encode[lanes[2]];
+			dst[x * 4 + 3] = (unsigned char)((p[0][3] + p[1][3] + p[2][3] + p[3][3] + 2) >> 2);
+#else
+			for (int c = 0; c < 3; c++) {
+				float l = (decode[p[0][c]] + decode[p[1][c]] + decode[p[2][c]] + decode[p[3][c]]) * 0.25f;
+				dst[x * 4 + c] = encode[(int)(l * (SRGB_ENCODE_SIZE - 1) + 0.5f)];
+			}
+			dst[x * 4 + 3] = (unsigned char)((p[0][3] + p[1][3] + p[2][3] + p[3][3] + 2) >> 2);
+#endif
+		}
+	}
+}
+
+bool image_mip_chain_build(image_mip_chain_t* chain, const unsigned char* pixels, int width, int height, int channels,
+	uint32_t flags, job_pool_t* jobs) {
+	memset(chain, 0, sizeof(*chain));
+	if (pixels == NULL || width <= 0 || height <= 0 || channels < 1 || channels > 4) {
+		return false;
+	}
+	chain->level_count = image_mip_level_count(width, height);
+	int w = width;
+	int h = height;
+	for (uint32_t i = 0; i < chain->level_count; i++) {
+		chain->levels[i].offset = chain->size;
+		chain->levels[i].width = w;
+		chain->levels[i].height = h;
+		chain->size += (size_t)w * h * 4;
+		w = w > 1 ? w / 2 : 1;
+		h = h > 1 ? h / 2 : 1;
+	}
+	chain->data = (unsigned char*)malloc(chain->size);
+
+	_mip_job_t job;
+	job.src = pixels;
+	job.dst = chain->data;
+	job.src_width = width;
+	job.src_height = height;
+	job.dst_width = width;
+	job.dst_height = height;
+	job.channels = channels;
+	job.flags = flags;
+	job.tables = (flags & IMAGE_MIP_SRGB) ? _srgb_tables() : NULL;
+	job_pool_parallel_for(jobs, height, _rows_per_tile(width), _mip_expand_rows, &job);
+
+	//ÿһһ㣬ڰзֿ鲢
+	for (uint32_t i = 1; i < chain->level_count; i++) {
+		const image_mip_level_t* src = &chain->levels[i - 1];
+		const image_mip_level_t* dst = &chain->levels[i];
+		job.src = chain->data + src->offset;
+		job.dst = chain->data + dst->offset;
+		job.src_width = src->width;
+		job.src_height = src->height;
+		job.dst_width = dst->width;
+		job.dst_height = dst->height;
+		job_pool_parallel_for(jobs, dst->height, _rows_per_tile(src->width * 2), (flags & IMAGE_MIP_SRGB) ? _mip_srgb_rows : _mip_box_rows, &job);
+	}
+	return true;
+}
+
+void image_mip_chain_destroy(image_mip_chain_t* chain) {
+	free(chain->data);
+	memset(chain, 0, sizeof(*chain));
+}
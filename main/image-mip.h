@@ -0,0 +1,30 @@
+_Pragma("once")
+
+#include <cstddef>
+#include <cstdint>
+#include "job-pool.h"
+
+#define IMAGE_MIP_MAX_LEVELS	16
+
+#define IMAGE_MIP_FLIP_Y	0x1		//·תstbi_set_flip_vertically_on_load
+#define IMAGE_MIP_SRGB		0x2		//ɫsRGB洢Կռн
+
+typedef struct image_mip_level_s {
+	size_t offset;		//chain->dataеֽƫ
+	int width;
+	int height;
+}image_mip_level_t;
+
+//RGBA8mipв㼶һڴ
+typedef struct image_mip_chain_s {
+	unsigned char* data;
+	size_t size;
+	image_mip_level_t levels[IMAGE_MIP_MAX_LEVELS];
+	uint32_t level_count;
+}image_mip_chain_t;
+
+extern uint32_t image_mip_level_count(int width, int height);
+//0ͬһɷת1/2/3ͨRGBAչ֮2x2ʽ˲ÿ㰴зֿ鲢
+extern bool image_mip_chain_build(image_mip_chain_t* chain, const unsigned char* pixels, int width, int height, int channels,
+	uint32_t flags, job_pool_t* jobs);
+extern void image_mip_chain_destroy(image_mip_chain_t* chain);
@@ -0,0 +1,67 @@
+#include <cstring>
+#include "input-queue.h"
+
+static void _input_queue_push(input_queue_t* queue, input_event_type_t type, float dx, float dy) {
+	if (queue->count == INPUT_QUEUE_SIZE) {
+		//˾Ͳͬ¼drainֻͣӲᶪʧƶ
+		queue->merged++;
+		for (uint32_t i = queue->count; i > 0; i--) {
+			input_event_t* same = &queue->events[(queue->head + i - 1) % INPUT_QUEUE_SIZE];
+			if (same->type == type) {
+				same->dx += dx;
+				same->dy += dy;
+				return;
+			}
+		}
+		//ûͬ¼˵ȫһ֣ɵĲڶɵģճһλ
+		input_event_t* oldest = &queue->events[queue->head];
+		input_event_t* next = &queue->events[(queue->head + 1) % INPUT_QUEUE_SIZE];
+		next->dx += oldest->dx;
+		next->dy += oldest->dy;
+		queue->head = (queue->head + 1) % INPUT_QUEUE_SIZE;
+		queue->count--;
+	}
+	input_event_t* event = &queue->events[(queue->head + queue->count) % INPUT_QUEUE_SIZE];
+	event->type = type;
+	event->dx = dx;
+	event->dy = dy;
+	queue->count++;
+}
+
+void input_queue_init(input_queue_t* queue) {
+	memset(queue, 0, sizeof(*queue));
+}
+
+void input_queue_push_cursor(input_queue_t* queue, double x, double y) {
+	if (!queue->has_cursor) {
+		queue->cursor_x = x;
+		queue->cursor_y = y;
+		queue->has_cursor = true;
+		return;
+	}
+	//y£תΪ
+	_input_queue_push(queue, INPUT_EVENT_MOUSE_MOVE, (float)(x - queue->cursor_x), (float)(queue->cursor_y - y));
+	queue->cursor_x = x;
+	queue->cursor_y = y;
+}
+
+void input_queue_push_scroll(input_queue_t* queue, double yoffset) {
+	_input_queue_push(queue, INPUT_EVENT_SCROLL, 0.0f, (float)yoffset);
+}
+
+void input_queue_drain(input_queue_t* queue, input_frame_t* frame) {
+	memset(frame, 0, sizeof(*frame));
+	for (uint32_t i = 0; i < queue->count; i++) {
+		const input_event_t* event = &queue->events[(queue->head + i) % INPUT_QUEUE_SIZE];
+		if (event->type == INPUT_EVENT_MOUSE_MOVE) {
+			frame->mouse_dx += event->dx;
+			frame->mouse_dy += event->dy;
+		}
+		else if (event->type == INPUT_EVENT_SCROLL) {
+			frame->scroll += event->dy;
+		}
+	}
+	frame->event_count = queue->count;
+	queue->head = 0;
+	queue->count = 0;
+}
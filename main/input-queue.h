@@ -0,0 +1,42 @@
+_Pragma("once")
+
+#include <cstdint>
+
+#define INPUT_QUEUE_SIZE	1024
+
+typedef enum input_event_type_e {
+	INPUT_EVENT_MOUSE_MOVE,
+	INPUT_EVENT_SCROLL,
+}input_event_type_t;
+
+typedef struct input_event_s {
+	input_event_type_t type;
+	float dx;
+	float dy;
+}input_event_t;
+
+//صֻ¼¼ÿ֡ͳһȡ֣߻رʵһ֡Ҳֻһ
+typedef struct input_queue_s {
+	input_event_t events[INPUT_QUEUE_SIZE];
+	uint32_t head;
+	uint32_t count;
+	bool has_cursor;	//һյλ֮ǰûпĻ׼
+	double cursor_x;
+	double cursor_y;
+	uint32_t merged;	//ʱϲ¼Ҳ
+}input_queue_t;
+
+//һ֡ۼƵԭʼ
+typedef struct input_frame_s {
+	float mouse_dx;
+	float mouse_dy;		//Ϊ
+	float scroll;
+	uint32_t event_count;
+}input_frame_t;
+
+extern void input_queue_init(input_queue_t* queue);
+//ľλãڲת
+extern void input_queue_push_cursor(input_queue_t* queue, double x, double y);
+extern void input_queue_push_scroll(input_queue_t* queue, double yoffset);
+//ȡ¼ۼӵframeУ
+extern void input_queue_drain(input_queue_t* queue, input_frame_t* frame);
@@ -0,0 +1,336 @@
+#include <cstdio>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "job-pool.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#define JOB_POOL_DEQUE_MASK		(JOB_POOL_DEQUE_SIZE - 1)
+#define JOB_POOL_SPIN_COUNT		64		//˯ǰתԵĴ
+
+typedef struct _job_s {
+	job_range_fn fn;
+	void* user;
+	uint32_t begin;
+	uint32_t end;
+	job_counter_t* counter;
+}_job_t;
+
+//͵ȡʱܺߵд벢ÿֶεԭӶдCASɹʹöֵ
+typedef struct _job_slot_s {
+	std::atomic<job_range_fn> fn;
+	std::atomic<void*> user;
+	std::atomic<uint32_t> begin;
+	std::atomic<uint32_t> end;
+	std::atomic<job_counter_t*> counter;
+}_job_slot_t;
+
+//Chase-Lev˫˶Уbottompush/pop߳topsteal
+typedef struct _job_deque_s {
+	alignas(64) std::atomic<int64_t> top;
+	alignas(64) std::atomic<int64_t> bottom;
+	alignas(64) _job_slot_t slots[JOB_POOL_DEQUE_SIZE];
+}_job_deque_t;
+
+struct job_pool_impl_s {
+	uint32_t worker_count;
+	std::thread workers[JOB_POOL_MAX_WORKERS];
+	_job_deque_t* deques;
+	//ǹ߳ύ
+	std::mutex shared_mutex;
+	_job_t shared[JOB_POOL_DEQUE_SIZE];
+	uint32_t shared_head;
+	uint32_t shared_count;
+	//еĹ߳˯
+	std::mutex sleep_mutex;
+	std::condition_variable wake;
+	std::atomic<int32_t> pending;	//ӻûȡߵ
+	std::atomic<uint32_t> sleepers;
+	std::atomic<bool> quit;
+};
+
+static thread_local job_pool_impl_t* _job_thread_pool = NULL;
+static thread_local uint32_t _job_thread_index = 0;
+static thread_local uint32_t _job_thread_seed = 0x9e3779b9u;
+
+static void _job_slot_store(_job_slot_t* slot, const _job_t* job) {
+	slot->fn.store(job->fn, std::memory_order_relaxed);
+	slot->user.store(job->user, std::memory_order_relaxed);
+	slot->begin.store(job->begin, std::memory_order_relaxed);
+	slot->end.store(job->end, std::memory_order_relaxed);
+	slot->counter.store(job->counter, std::memory_order_relaxed);
+}
+
+static void _job_slot_load(const _job_slot_t* slot, _job_t* job) {
+	job->fn = slot->fn.load(std::memory_order_relaxed);
+	job->user = slot->user.load(std::memory_order_relaxed);
+	job->begin = slot->begin.load(std::memory_order_relaxed);
+	job->end = slot->end.load(std::memory_order_relaxed);
+	job->counter = slot->counter.load(std::memory_order_relaxed);
+}
+
+static bool _job_deque_push(_job_deque_t* deque, const _job_t* job) {
+	int64_t b = deque->bottom.load(std::memory_order_relaxed);
+	int64_t t = deque->top.load(std::memory_order_acquire);
+	if (b - t >= JOB_POOL_DEQUE_SIZE) {
+		return false;
+	}
+	_job_slot_store(&deque->slots[b & JOB_POOL_DEQUE_MASK], job);
+	std::atomic_thread_fence(std::memory_order_release);
+	deque->bottom.store(b + 1, std::memory_order_relaxed);
+	return true;
+}
+
+static bool _job_deque_pop(_job_deque_t* deque, _job_t* job) {
+	int64_t b = deque->bottom.load(std::memory_order_relaxed) - 1;
+	deque->bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t t = deque->top.load(std::memory_order_relaxed);
+	if (t > b) {
+		deque->bottom.store(b + 1, std::memory_order_relaxed);
+		return false;
+	}
+	_job_slot_load(&deque->slots[b & JOB_POOL_DEQUE_MASK], job);
+	if (t == b) {
+		//ֻʣһ͵ȡ߳̾
+		bool won = deque->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		deque->bottom.store(b + 1, std::memory_order_relaxed);
+		return won;
+	}
+	return true;
+}
+
+static bool _job_deque_steal(_job_deque_t* deque, _job_t* job) {
+	int64_t t = deque->top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t b = deque->bottom.load(std::memory_order_acquire);
+	if (t >= b) {
+		return false;
+	}
+	//topûǰ֮ǰ߲ḲۣCASɹʱһ
+	_job_slot_load(&deque->slots[t & JOB_POOL_DEQUE_MASK], job);
+	return deque->top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+static bool _job_shared_push(job_pool_impl_t* impl, const _job_t* job) {
+	std::lock_guard<std::mutex> lock(impl->shared_mutex);
+	if (impl->shared_count == JOB_POOL_DEQUE_SIZE) {
+		return false;
+	}
+	impl->shared[(impl->shared_head + impl->shared_count) & JOB_POOL_DEQUE_MASK] = *job;
+	impl->shared_count++;
+	return true;
+}
+
+static bool _job_shared_pop(job_pool_impl_t* impl, _job_t* job) {
+	std::lock_guard<std::mutex> lock(impl->shared_mutex);
+	if (impl->shared_count == 0) {
+		return false;
+	}
+	*job = impl->shared[impl->shared_head];
+	impl->shared_head = (impl->shared_head + 1) & JOB_POOL_DEQUE_MASK;
+	impl->shared_count--;
+	return true;
+}
+
+static uint32_t _job_self(const job_pool_impl_t* impl) {
+	return _job_thread_pool == impl ? _job_thread_index : impl->worker_count;
+}
+
+//ԼĶ ->  -> һ߳̿ʼ͵
+static bool _job_take(job_pool_impl_t* impl, uint32_t self, _job_t* job) {
+	bool found = (self < impl->worker_count && _job_deque_pop(&impl->deques[self], job)) || _job_shared_pop(impl, job);
+	if (!found) {
+		_job_thread_seed ^= _job_thread_seed << 13;
+		_job_thread_seed ^= _job_thread_seed >> 17;
+		_job_thread_seed ^= _job_thread_seed << 5;
+		uint32_t start = _job_thread_seed % impl->worker_count;
+		for (uint32_t i = 0; i < impl->worker_count && !found; i++) {
+			uint32_t victim = (start + i) % impl->worker_count;
+			found = victim != self && _job_deque_steal(&impl->deques[victim], job);
+		}
+	}
+	if (found) {
+		impl->pending.fetch_sub(1, std::memory_order_relaxed);
+	}
+	return found;
+}
+
+static void _job_run(const _job_t* job) {
+	job->fn(job->user, job->begin, job->end);
+	if (job->counter) {
+		job->counter->value.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+//0߳
+static void _job_pin_thread(uint32_t index) {
+	uint32_t hardware = std::thread::hardware_concurrency();
+	if (hardware <= 1) {
+		return;
+	}
+	uint32_t core = (index + 1) % hardware;
+#if defined(_WIN32)
+	SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << core);
+#elif defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(core, &set);
+	if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+		printf("ERROR::JOB_POOL::PIN_THREAD_FAILED: %u\n", core);
+	}
+#endif
+}
+
+static void _job_worker(job_pool_impl_t* impl, uint32_t index, uint32_t flags) {
+	_job_thread_pool = impl;
+	_job_thread_index = index;
+	_job_thread_seed += index * 0x632be5abu;
+	if (flags & JOB_POOL_PIN_THREADS) {
+		_job_pin_thread(index);
+	}
+	uint32_t spins = 0;
+	while (!impl->quit.load(std::memory_order_acquire)) {
+		_job_t job;
+		if (_job_take(impl, index, &job)) {
+			_job_run(&job);
+			spins = 0;
+			continue;
+		}
+		if (++spins < JOB_POOL_SPIN_COUNT) {
+			std::this_thread::yield();
+			continue;
+		}
+		spins = 0;
+		std::unique_lock<std::mutex> lock(impl->sleep_mutex);
+		impl->sleepers.fetch_add(1);
+		impl->wake.wait(lock, [&] { return impl->quit.load() || impl->pending.load() > 0; });
+		impl->sleepers.fetch_sub(1);
+	}
+}
+
+void job_pool_create(job_pool_t* pool, uint32_t worker_count, uint32_t flags) {
+	if (worker_count == 0) {
+		uint32_t hardware = std::thread::hardware_concurrency();
+		worker_count = hardware > 1 ? hardware - 1 : 0;
+	}
+	if (worker_count > JOB_POOL_MAX_WORKERS) {
+		worker_count = JOB_POOL_MAX_WORKERS;
+	}
+	job_pool_impl_t* impl = new job_pool_impl_t();
+	impl->worker_count = worker_count;
+	impl->deques = worker_count ? new _job_deque_t[worker_count]() : NULL;
+	impl->shared_head = 0;
+	impl->shared_count = 0;
+	impl->pending.store(0);
+	impl->sleepers.store(0);
+	impl->quit.store(false);
+	for (uint32_t i = 0; i < worker_count; i++) {
+		impl->workers[i] = std::thread(_job_worker, impl, i, flags);
+	}
+	pool->impl = impl;
+	pool->worker_count = worker_count;
+}
+
+void job_pool_destroy(job_pool_t* pool) {
+	job_pool_impl_t* impl = pool->impl;
+	if (impl == NULL) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(impl->sleep_mutex);
+		impl->quit.store(true);
+	}
+	impl->wake.notify_all();
+	for (uint32_t i = 0; i < impl->worker_count; i++) {
+		impl->workers[i].join();
+	}
+	delete[] impl->deques;
+	delete impl;
+	pool->impl = NULL;
+	pool->worker_count = 0;
+}
+
+void job_counter_init(job_counter_t* counter) {
+	counter->value.store(0, std::memory_order_relaxed);
+}
+
+void job_pool_submit(job_pool_t* pool, job_range_fn fn, void* user, uint32_t begin, uint32_t end, job_counter_t* counter) {
+	_job_t job = { fn, user, begin, end, counter };
+	if (counter) {
+		counter->value.fetch_add(1, std::memory_order_relaxed);
+	}
+	job_pool_impl_t* impl = pool ? pool->impl : NULL;
+	if (impl == NULL || impl->worker_count == 0) {
+		_job_run(&job);
+		return;
+	}
+	uint32_t self = _job_self(impl);
+	bool queued = self < impl->worker_count ? _job_deque_push(&impl->deques[self], &job) : _job_shared_push(impl, &job);
+	if (!queued) {
+		//˾͵ִУЧϱԼȡһ
+		_job_run(&job);
+		return;
+	}
+	impl->pending.fetch_add(1);
+	if (impl->sleepers.load() > 0) {
+		std::lock_guard<std::mutex> lock(impl->sleep_mutex);
+		impl->wake.notify_one();
+	}
+}
+
+void job_pool_wait(job_pool_t* pool, job_counter_t* counter) {
+	job_pool_impl_t* impl = pool ? pool->impl : NULL;
+	uint32_t self = impl ? _job_self(impl) : 0;
+	while (counter->value.load(std::memory_order_acquire) != 0) {
+		_job_t job;
+		if (impl && impl->worker_count && _job_take(impl, self, &job)) {
+			_job_run(&job);
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+void job_pool_parallel_for(job_pool_t* pool, uint32_t count, uint32_t grain, job_range_fn fn, void* user) {
+	if (count == 0) {
+		return;
+	}
+	if (grain == 0) {
+		grain = 1;
+	}
+	if (pool == NULL || pool->impl == NULL || pool->worker_count == 0 || count <= grain) {
+		fn(user, 0, count);
+		return;
+	}
+	//һ룬Ƕύռ
+	uint32_t max_chunks = JOB_POOL_DEQUE_SIZE / 2;
+	if ((count + grain - 1) / grain > max_chunks) {
+		grain = (count + max_chunks - 1) / max_chunks;
+	}
+	job_counter_t counter;
+	job_counter_init(&counter);
+	uint32_t begin = 0;
+	for (; count - begin > grain; begin += grain) {
+		job_pool_submit(pool, fn, user, begin, begin + grain, &counter);
+	}
+	//һɵ߳ԼִУȻæʣµ
+	fn(user, begin, count);
+	job_pool_wait(pool, &counter);
+}
+
+uint32_t job_pool_thread_index(const job_pool_t* pool) {
+	if (pool == NULL || pool->impl == NULL) {
+		return 0;
+	}
+	return _job_self(pool->impl);
+}
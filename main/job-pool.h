@@ -0,0 +1,39 @@
+_Pragma("once")
+
+#include <atomic>
+#include <cstdint>
+
+#define JOB_POOL_MAX_WORKERS	32
+#define JOB_POOL_DEQUE_SIZE		4096	//ÿ̵߳2
+
+#define JOB_POOL_PIN_THREADS	0x1		//̰߳󶨵̶ĺ
+
+//[begin, end)ϵuserɵߴ룻伴
+typedef void (*job_range_fn)(void* user, uint32_t begin, uint32_t end);
+
+//ύʱһʱһ0ʾһȫɣ
+typedef struct job_counter_s {
+	std::atomic<uint32_t> value;
+}job_counter_t;
+
+typedef struct job_pool_impl_s job_pool_impl_t;
+
+//ÿ߳һChase-Lev˫˶УԼӵײȡʱӱ̶߳͵
+//ǹ߳ύУȴʱ߳Ҳִ
+typedef struct job_pool_s {
+	job_pool_impl_t* impl;
+	uint32_t worker_count;
+}job_pool_t;
+
+//worker_countΪ0ʱʹӲ߳һflagsJOB_POOL_*
+extern void job_pool_create(job_pool_t* pool, uint32_t worker_count, uint32_t flags);
+extern void job_pool_destroy(job_pool_t* pool);
+extern void job_counter_init(job_counter_t* counter);
+//counterΪNULLpoolΪNULLûй߳ʱֱڵǰִ߳
+extern void job_pool_submit(job_pool_t* pool, job_range_fn fn, void* user, uint32_t begin, uint32_t end, job_counter_t* counter);
+//ȵ㣬ȴڼִжԿڲȴ
+extern void job_pool_wait(job_pool_t* pool, job_counter_t* counter);
+//[0, count)grainпָ̣߳ʱȫɣڲǶ׵
+extern void job_pool_parallel_for(job_pool_t* pool, uint32_t count, uint32_t grain, job_range_fn fn, void* user);
+//ǰ߳ڳеıţ߳0..worker_count-1̷߳worker_count
+extern uint32_t job_pool_thread_index(const job_pool_t* pool);
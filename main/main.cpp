@@ -1,65 +1,246 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <cstdio>
-#include <chrono>
 #include <thread>
+#include <atomic>
 #include "opengl-examples.h"
+#include "input-queue.h"
+#include "sim-loop.h"
+#include "frame-queue.h"
+#include "camera-path.h"
+#include "gl-capture.h"
+#include "gl-draw-counter.h"
+#include "alloc-counter.h"
+#include "opengl-hud.h"
+#include "debug-draw.h"
 
 #define SCENE	TYPE_CAMERA_02
+#define SIM_THREADED	0	//ģǷڵ߳
+#define RENDER_THREADED	1	//GLǷ񽻸Ⱦֻ̣߳߳¼ģ
+#define CAMERA_RECORD	NULL	//"camera.path"ÿһдļ˳ʱ
+#define CAMERA_REPLAY	NULL	//ط¼Ƶ̣Զ˳
+#define HUD_VISIBLE		1		//Ͻǵ֡ʡƵúڴͳƣF1л
+#define DEBUG_DRAW_VISIBLE	0	//Χȵ߿F2лֻDEBUG_DRAWİ汾
+#define GL_CAPTURE		NULL	//"scene.gltrace"¼ȾGLãglfw-demo-replayط
+#define SWAP_INTERVAL	1		//1Ŵֱͬ֡0֡ʣȽģʽ
 opengl_ctx_t opengl_ctx;
 
+//GLֻȾ߳еãֻ¼Сһ֡Ⱦ߳
+static unsigned int framebuffer_width;
+static unsigned int framebuffer_height;
+
 static void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
-	glViewport(0, 0, width, height);
 	printf("window size changed, width: %d, height: %d\n", width, height);
 
-	opengl_ctx.viewport_width = width;
-	opengl_ctx.viewport_height = height;
+	framebuffer_width = width;
+	framebuffer_height = height;
 }
 
-static void mouse_callback(GLFWwindow* window, double xpos, double ypos) {
-	static bool fisrt = true;
-	static float last_x;
-	static float last_y;
+//صglfwPollEventsпܱúܶΣֻ¼¼ÿ֡ʼʱͳһ
+static input_queue_t input_queue;
 
-	float x = (float)xpos;
-	float y = (float)ypos;
+static void mouse_callback(GLFWwindow* window, double xpos, double ypos) {
+	input_queue_push_cursor(&input_queue, xpos, ypos);
+}
 
-	if (fisrt){
-		last_x = x;
-		last_y = y;
-		fisrt = false;
-	}
-	float xoffset = x - last_x;
-	float yoffset = last_y - y;
+static void scroll_callback(GLFWwindow* window, double xoffset, double yoffset) {
+	input_queue_push_scroll(&input_queue, yoffset);
+}
 
-	last_x = x;
-	last_y = y;
+//ֻģⲽʣȾõopengl_ctx.camera
+typedef struct sim_context_s {
+	opengl_camera_t camera;
+	uint64_t ticks;					//ѾִеĲ
+	camera_path_t* record;
+	camera_path_t* replay;
+	std::atomic<bool> replay_done;
+}sim_context_t;
 
-	opengl_camera_rotate(&opengl_ctx.camera, xoffset, yoffset);
-}
+static sim_context_t sim_context;
 
-static void scroll_callback(GLFWwindow* window, double xoffset, double yoffset) {
-	opengl_camera_zoom(&opengl_ctx.camera, (float)yoffset);
+static void sim_step(void* user, sim_state_t* state, const sim_input_t* input, float dt) {
+	sim_context_t* context = (sim_context_t*)user;
+	opengl_camera_t* camera = &context->camera;
+	context->ticks++;
+	if (context->replay) {
+		//طŰȡ¼Ƶ״̬ε֡ʡ붼޹
+		if (!camera_path_state(context->replay, context->ticks, state)) {
+			context->replay_done.store(true, std::memory_order_relaxed);
+		}
+		return;
+	}
+	if (input->mouse_dx != 0.0f || input->mouse_dy != 0.0f) {
+		opengl_camera_rotate(camera, input->mouse_dx, input->mouse_dy);
+	}
+	if (input->scroll != 0.0f) {
+		opengl_camera_zoom(camera, input->scroll);
+	}
+	for (int movement = FORWARD; movement <= RIGHT; movement++) {
+		if (input->moves & (1u << movement)) {
+			opengl_camera_move(camera, (opengl_camera_movement_t)movement, dt);
+		}
+	}
+	state->camera_pos = camera->pos;
+	state->camera_yaw = camera->yaw;
+	state->camera_pitch = camera->pitch;
+	state->camera_zoom = camera->zoom;
+	state->time += dt;
+	if (context->record) {
+		camera_path_record(context->record, context->ticks, input, state);
+	}
 }
 
+static bool hud_visible = HUD_VISIBLE;
+static bool hud_key_down;
+static bool debug_draw_visible = DEBUG_DRAW_VISIBLE;
+static bool debug_draw_key_down;
 
-static void process_input(opengl_ctx_t* ctx, GLFWwindow* window) {
+static void process_input(sim_loop_t* sim, GLFWwindow* window) {
 	if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
 		glfwSetWindowShouldClose(window, 1);
 	}
+	//µһ֡лסᷴл
+	bool hud_key = glfwGetKey(window, GLFW_KEY_F1) == GLFW_PRESS;
+	if (hud_key && !hud_key_down) {
+		hud_visible = !hud_visible;
+	}
+	hud_key_down = hud_key;
+	bool debug_draw_key = glfwGetKey(window, GLFW_KEY_F2) == GLFW_PRESS;
+	if (debug_draw_key && !debug_draw_key_down) {
+		debug_draw_visible = !debug_draw_visible;
+	}
+	debug_draw_key_down = debug_draw_key;
+	uint32_t moves = 0;
 	if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) {
-		opengl_camera_move(&ctx->camera, FORWARD);
+		moves |= 1u << FORWARD;
 	}
 	if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) {
-		opengl_camera_move(&ctx->camera, BACKWARD);
+		moves |= 1u << BACKWARD;
 	}
 	if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) {
-		opengl_camera_move(&ctx->camera, LEFT);
+		moves |= 1u << LEFT;
 	}
 	if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) {
-		opengl_camera_move(&ctx->camera, RIGHT);
+		moves |= 1u << RIGHT;
+	}
+	sim_loop_set_moves(sim, moves);
+}
+
+static void make_packet(sim_loop_t* sim, frame_packet_t* packet) {
+	packet->index++;
+	packet->created = sim_loop_now();
+	sim_loop_sample(sim, &packet->state);
+	packet->viewport_width = framebuffer_width;
+	packet->viewport_height = framebuffer_height;
+	packet->hud = hud_visible;
+	packet->debug_draw = debug_draw_visible;
+	packet->quit = false;
+}
+
+//ֻȾһʹ
+static gl_capture_t gl_capture;
+static bool gl_capturing;
+static opengl_hud_t hud;
+static double hud_frame_start;		//һ֡ʼʱ
+static uint64_t hud_allocs;			//һ֡Ķѷ
+static double hud_resident_mb;
+
+static void render_init() {
+	gl_draw_counter_hook();
+	//֡ɽʱĴֱͬģʽٹ̶˯
+	glfwSwapInterval(SWAP_INTERVAL);
+	const char* capture_path = GL_CAPTURE;
+	if (capture_path) {
+		gl_capturing = gl_capture_begin(&gl_capture, capture_path);
+	}
+	opengl_shader_program_create(&opengl_ctx, SCENE);
+	opengl_scene_create(&opengl_ctx, SCENE);
+	opengl_shader_program_use(&opengl_ctx);
+	opengl_hud_init(&hud);
+	debug_draw_init();
+}
+
+static void render_shutdown() {
+	debug_draw_destroy();
+	opengl_hud_destroy(&hud);
+	opengl_scene_destroy(&opengl_ctx);
+	opengl_shader_program_destroy(&opengl_ctx);
+	if (gl_capturing) {
+		gl_capture_end(&gl_capture);
+		gl_capturing = false;
+	}
+}
+
+//opengl_ctxֻȾһ
+static void render_frame(GLFWwindow* window, const frame_packet_t* packet) {
+	double start = sim_loop_now();
+	uint64_t allocs = alloc_counter_app();
+	if (packet->viewport_width != opengl_ctx.viewport_width || packet->viewport_height != opengl_ctx.viewport_height) {
+		glViewport(0, 0, packet->viewport_width, packet->viewport_height);
+		opengl_ctx.viewport_width = packet->viewport_width;
+		opengl_ctx.viewport_height = packet->viewport_height;
+		if (packet->viewport_height > 0) {
+			opengl_camera_set_aspect(&opengl_ctx.camera, (float)packet->viewport_width / (float)packet->viewport_height);
+		}
+	}
+	//ľڳһζȡʱؽһ֡һ
+	opengl_camera_set_pose(&opengl_ctx.camera, packet->state.camera_pos, packet->state.camera_yaw, packet->state.camera_pitch, packet->state.camera_zoom);
+	opengl_ctx.time = packet->state.time;
+
+	frame_arena_begin_frame(&opengl_ctx.frame_arena);
+	debug_draw_set_enabled(packet->debug_draw);
+	uint64_t draws = gl_draw_counter_get();
+	opengl_scene_draw(&opengl_ctx, SCENE);
+	//ӵ߿ԭᣬHUD棬ĻƵ
+	debug_draw_axes(glm::mat4(1.0f), 1.0f);
+	debug_draw_flush(opengl_camera_view_projection(&opengl_ctx.camera));
+	if (packet->hud) {
+		opengl_hud_stats_t stats;
+		stats.frame_ms = hud_frame_start > 0.0 ? (start - hud_frame_start) * 1000.0 : 0.0;
+		stats.draw_calls = gl_draw_counter_get() - draws;
+		stats.heap_allocs = hud_allocs;
+		frame_arena_stats_t arena;
+		frame_arena_get_stats(&opengl_ctx.frame_arena, &arena);
+		stats.arena_bytes = arena.used;
+		//פڴ汾Ҫ䣬ԼһһΣһ֡ķ༸
+		if (packet->index % 60 == 1) {
+			hud_resident_mb = alloc_counter_resident_mb();
+		}
+		stats.resident_mb = hud_resident_mb;
+		opengl_hud_draw(&hud, &stats, opengl_ctx.viewport_width, opengl_ctx.viewport_height);
+	}
+	if (gl_capturing) {
+		gl_capture_frame(&gl_capture);
+	}
+	glfwSwapBuffers(window);
+	hud_frame_start = start;
+	hud_allocs = alloc_counter_app() - allocs;
+}
+
+#if RENDER_THREADED
+static frame_queue_t frame_queue;
+
+//Ⱦ߳ӵGLģN֡ύͬʱ߳Ѿ׼N+1֡
+static void render_thread(GLFWwindow* window) {
+	glfwMakeContextCurrent(window);
+	render_init();
+
+	frame_stats_t stats;
+	frame_stats_init(&stats, "render thread");
+	for (;;) {
+		frame_packet_t packet;
+		frame_queue_wait_pop(&frame_queue, &packet);
+		if (packet.quit) {
+			break;
+		}
+		render_frame(window, &packet);
+		double now = sim_loop_now();
+		frame_stats_record(&stats, now - packet.created, now);
 	}
+	render_shutdown();
+	glfwMakeContextCurrent(NULL);
 }
+#endif
 
 int main(void) {
 	glfwInit();
@@ -86,6 +267,11 @@ int main(void) {
 		abort();
 	}
 	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+	//ԭʼƶϵͳļٺţֻڹʱЧ
+	if (glfwRawMouseMotionSupported()) {
+		glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+	}
+	input_queue_init(&input_queue);
 	glfwMakeContextCurrent(window);
 	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 	glfwSetCursorPosCallback(window, mouse_callback);
@@ -95,21 +281,99 @@ int main(void) {
 		printf("Failed to initialize GLAD\n");
 		abort();
 	}
-	opengl_shader_program_create(&opengl_ctx, SCENE);
-	opengl_scene_create(&opengl_ctx, SCENE);
-	opengl_shader_program_use(&opengl_ctx);
+	job_pool_create(&opengl_ctx.jobs, 0, JOB_POOL_PIN_THREADS);
+	frame_arena_init(&opengl_ctx.frame_arena, FRAME_ARENA_DEFAULT_SIZE, &opengl_ctx.jobs);
+
+	//ƶͶʱ䰴̶ƽȾ֡޹
+	sim_context.camera = opengl_ctx.camera;
+	sim_state_t state;
+	state.camera_pos = sim_context.camera.pos;
+	state.camera_yaw = sim_context.camera.yaw;
+	state.camera_pitch = sim_context.camera.pitch;
+	state.camera_zoom = sim_context.camera.zoom;
+	state.time = 0.0;
+
+	const char* record_path = CAMERA_RECORD;
+	const char* replay_path = CAMERA_REPLAY;
+	camera_path_t record;
+	camera_path_t replay;
+	if (replay_path && camera_path_load(&replay, replay_path)) {
+		if (replay.header.dt != 1.0 / SIM_LOOP_DEFAULT_HZ) {
+			printf("camera path was recorded at %.1f Hz, replaying at %.1f Hz\n", 1.0 / replay.header.dt, SIM_LOOP_DEFAULT_HZ);
+		}
+		camera_path_state(&replay, 0, &state);
+		sim_context.replay = &replay;
+	}
+	else if (record_path) {
+		camera_path_init(&record, 1.0 / SIM_LOOP_DEFAULT_HZ, &state);
+		sim_context.record = &record;
+	}
+	sim_loop_t sim;
+	sim_loop_create(&sim, &state, SIM_LOOP_DEFAULT_HZ, SIM_THREADED, sim_step, &sim_context);
+
+	framebuffer_width = window_width;
+	framebuffer_height = window_height;
+	frame_packet_t packet = {};
+
+#if RENDER_THREADED
+	//ĽȾ̣֮߳߳ٵGL
+	glfwMakeContextCurrent(NULL);
+	frame_queue_init(&frame_queue);
+	std::thread renderer(render_thread, window);
 
 	while (!glfwWindowShouldClose(window)) {
-		process_input(&opengl_ctx, window);
-		
-		opengl_scene_draw(&opengl_ctx, SCENE);
+		glfwPollEvents();
+		if (sim_context.replay_done.load(std::memory_order_relaxed)) {
+			glfwSetWindowShouldClose(window, 1);
+		}
+		input_frame_t input;
+		input_queue_drain(&input_queue, &input);
+		sim_loop_add_input(&sim, input.mouse_dx, input.mouse_dy, input.scroll);
+		process_input(&sim, window);
+
+		//˵Ⱦ󣬵пλ֮ٲȥ״̬
+		frame_queue_wait_space(&frame_queue);
+		make_packet(&sim, &packet);
+		frame_queue_push(&frame_queue, &packet);
+	}
+	packet.quit = true;
+	frame_queue_wait_space(&frame_queue);
+	frame_queue_push(&frame_queue, &packet);
+	renderer.join();
+#else
+	render_init();
+	frame_stats_t stats;
+	frame_stats_init(&stats, "single thread");
+
+	while (!glfwWindowShouldClose(window)) {
+		input_frame_t input;
+		input_queue_drain(&input_queue, &input);
+		sim_loop_add_input(&sim, input.mouse_dx, input.mouse_dy, input.scroll);
+		process_input(&sim, window);
+
+		make_packet(&sim, &packet);
+		render_frame(window, &packet);
+		double now = sim_loop_now();
+		frame_stats_record(&stats, now - packet.created, now);
 
 		glfwPollEvents();
-		glfwSwapBuffers(window);
-		std::this_thread::sleep_for(std::chrono::milliseconds(16));
+		if (sim_context.replay_done.load(std::memory_order_relaxed)) {
+			glfwSetWindowShouldClose(window, 1);
+		}
 	}
-	opengl_scene_destroy(&opengl_ctx);
-	opengl_shader_program_destroy(&opengl_ctx);
+	render_shutdown();
+#endif
+	sim_loop_destroy(&sim);
+	if (sim_context.record) {
+		camera_path_write(&record, record_path);
+		printf("camera path: %llu ticks, %u records -> %s\n", (unsigned long long)record.header.tick_count, record.header.record_count, record_path);
+		camera_path_destroy(&record);
+	}
+	if (sim_context.replay) {
+		camera_path_destroy(&replay);
+	}
+	frame_arena_destroy(&opengl_ctx.frame_arena);
+	job_pool_destroy(&opengl_ctx.jobs);
 
 	glfwTerminate();
 	return 0;
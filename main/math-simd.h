@@ -0,0 +1,319 @@
+_Pragma("once")
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <glm.hpp>
+
+//ͱ任·õѧ㣺16ֽڶvec4/mat4ţglm::mat4ڴ沼ͬ
+//ڱʱѡ񣬿-DMATH_BACKEND=MATH_BACKEND_SCALARǿָstatic inlineͬ˵ķ뵥Ԫһ
+#define MATH_BACKEND_SCALAR		0
+#define MATH_BACKEND_SSE		1
+#define MATH_BACKEND_AVX		2		//˷任ÿδ/SSEͬ
+
+#if !defined(MATH_BACKEND)
+#if defined(__AVX__)
+#define MATH_BACKEND MATH_BACKEND_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_BACKEND MATH_BACKEND_SSE
+#else
+#define MATH_BACKEND MATH_BACKEND_SCALAR
+#endif
+#endif
+
+#if MATH_BACKEND == MATH_BACKEND_AVX
+#include <immintrin.h>
+#define MATH_BACKEND_NAME	"avx"
+#elif MATH_BACKEND == MATH_BACKEND_SSE
+#include <emmintrin.h>
+#define MATH_BACKEND_NAME	"sse"
+#else
+#define MATH_BACKEND_NAME	"scalar"
+#endif
+
+typedef struct alignas(16) math_vec4_s {
+	float v[4];
+}math_vec4_t;
+
+typedef math_vec4_t math_quat_t;	//xyz鲿wʵ
+
+typedef struct alignas(16) math_mat4_s {
+	float m[16];				//m[col * 4 + row]
+}math_mat4_t;
+
+static inline void math_mat4_from_glm(math_mat4_t* out, const glm::mat4& m) {
+	memcpy(out->m, &m[0][0], sizeof(out->m));
+}
+
+static inline glm::mat4 math_mat4_to_glm(const math_mat4_t* m) {
+	glm::mat4 out;
+	memcpy(&out[0][0], m->m, sizeof(m->m));
+	return out;
+}
+
+static inline void math_mat4_identity(math_mat4_t* out) {
+	memset(out->m, 0, sizeof(out->m));
+	out->m[0] = 1.0f;
+	out->m[5] = 1.0f;
+	out->m[10] = 1.0f;
+	out->m[15] = 1.0f;
+}
+
+#if MATH_BACKEND != MATH_BACKEND_SCALAR
+//ĵjaаbjеķ
+static inline __m128 _math_combine(const __m128* a, __m128 b) {
+	__m128 x = _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0));
+	__m128 y = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 1, 1));
+	__m128 z = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2));
+	__m128 w = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3));
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], x), _mm_mul_ps(a[1], y)), _mm_add_ps(_mm_mul_ps(a[2], z), _mm_mul_ps(a[3], w)));
+}
+
+//wΪ0ά
+static inline __m128 _math_dot3(__m128 a, __m128 b) {
+	__m128 m = _mm_mul_ps(a, b);
+	__m128 x = _mm_shuffle_ps(m, m, _MM_SHUFFLE(0, 0, 0, 0));
+	__m128 y = _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1));
+	__m128 z = _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 2, 2, 2));
+	return _mm_add_ps(_mm_add_ps(x, y), z);
+}
+
+static inline __m128 _math_cross3(__m128 a, __m128 b) {
+	__m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+	__m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+	__m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+	return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+//ȷͳglm::normalizeĲڼulp֮
+static inline __m128 _math_normalize3(__m128 v) {
+	return _mm_div_ps(v, _mm_sqrt_ps(_math_dot3(v, v)));
+}
+#endif
+
+//outԺabͬ
+static inline void math_mat4_mul(math_mat4_t* out, const math_mat4_t* a, const math_mat4_t* b) {
+#if MATH_BACKEND == MATH_BACKEND_AVX
+	__m256 a0 = _mm256_broadcast_ps((const __m128*)&a->m[0]);
+	__m256 a1 = _mm256_broadcast_ps((const __m128*)&a->m[4]);
+	__m256 a2 = _mm256_broadcast_ps((const __m128*)&a->m[8]);
+	__m256 a3 = _mm256_broadcast_ps((const __m128*)&a->m[12]);
+	__m256 b01 = _mm256_loadu_ps(&b->m[0]);
+	__m256 b23 = _mm256_loadu_ps(&b->m[8]);
+	//shuffleÿ128λͨڹ㲥һ
+	__m256 c01 = _mm256_add_ps(
+		_mm256_add_ps(_mm256_mul_ps(a0, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(0, 0, 0, 0))), _mm256_mul_ps(a1, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(1, 1, 1, 1)))),
+		_mm256_add_ps(_mm256_mul_ps(a2, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(2, 2, 2, 2))), _mm256_mul_ps(a3, _mm256_shuffle_ps(b01, b01, _MM_SHUFFLE(3, 3, 3, 3)))));
+	__m256 c23 = _mm256_add_ps(
+		_mm256_add_ps(_mm256_mul_ps(a0, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(0, 0, 0, 0))), _mm256_mul_ps(a1, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(1, 1, 1, 1)))),
+		_mm256_add_ps(_mm256_mul_ps(a2, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(2, 2, 2, 2))), _mm256_mul_ps(a3, _mm256_shuffle_ps(b23, b23, _MM_SHUFFLE(3, 3, 3, 3)))));
+	_mm256_storeu_ps(&out->m[0], c01);
+	_mm256_storeu_ps(&out->m[8], c23);
+#elif MATH_BACKEND == MATH_BACKEND_SSE
+	__m128 ca[4] = { _mm_load_ps(&a->m[0]), _mm_load_ps(&a->m[4]), _mm_load_ps(&a->m[8]), _mm_load_ps(&a->m[12]) };
+	__m128 c0 = _math_combine(ca, _mm_load_ps(&b->m[0]));
+	__m128 c1 = _math_combine(ca, _mm_load_ps(&b->m[4]));
+	__m128 c2 = _math_combine(ca, _mm_load_ps(&b->m[8]));
+	__m128 c3 = _math_combine(ca, _mm_load_ps(&b->m[12]));
+	_mm_store_ps(&out->m[0], c0);
+	_mm_store_ps(&out->m[4], c1);
+	_mm_store_ps(&out->m[8], c2);
+	_mm_store_ps(&out->m[12], c3);
+#else
+	math_mat4_t r;
+	for (int col = 0; col < 4; col++) {
+		for (int row = 0; row < 4; row++) {
+			r.m[col * 4 + row] = a->m[row] * b->m[col * 4] + a->m[4 + row] * b->m[col * 4 + 1]
+				+ a->m[8 + row] * b->m[col * 4 + 2] + a->m[12 + row] * b->m[col * 4 + 3];
+		}
+	}
+	*out = r;
+#endif
+}
+
+//out[i] = m * in[i]inoutͬһ
+static inline void math_mat4_mul_vec4_batch(const math_mat4_t* m, const math_vec4_t* in, math_vec4_t* out, uint32_t count) {
+#if MATH_BACKEND == MATH_BACKEND_AVX
+	__m256 c0 = _mm256_broadcast_ps((const __m128*)&m->m[0]);
+	__m256 c1 = _mm256_broadcast_ps((const __m128*)&m->m[4]);
+	__m256 c2 = _mm256_broadcast_ps((const __m128*)&m->m[8]);
+	__m256 c3 = _mm256_broadcast_ps((const __m128*)&m->m[12]);
+	uint32_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		__m256 v = _mm256_loadu_ps(in[i].v);
+		__m256 r = _mm256_add_ps(
+			_mm256_add_ps(_mm256_mul_ps(c0, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0))), _mm256_mul_ps(c1, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)))),
+			_mm256_add_ps(_mm256_mul_ps(c2, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))), _mm256_mul_ps(c3, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)))));
+		_mm256_storeu_ps(out[i].v, r);
+	}
+	if (i < count) {
+		__m128 ca[4] = { _mm256_castps256_ps128(c0), _mm256_castps256_ps128(c1), _mm256_castps256_ps128(c2), _mm256_castps256_ps128(c3) };
+		_mm_store_ps(out[i].v, _math_combine(ca, _mm_load_ps(in[i].v)));
+	}
+#elif MATH_BACKEND == MATH_BACKEND_SSE
+	__m128 ca[4] = { _mm_load_ps(&m->m[0]), _mm_load_ps(&m->m[4]), _mm_load_ps(&m->m[8]), _mm_load_ps(&m->m[12]) };
+	for (uint32_t i = 0; i < count; i++) {
+		_mm_store_ps(out[i].v, _math_combine(ca, _mm_load_ps(in[i].v)));
+	}
+#else
+	for (uint32_t i = 0; i < count; i++) {
+		const float* v = in[i].v;
+		float r[4];
+		for (int row = 0; row < 4; row++) {
+			r[row] = m->m[row] * v[0] + m->m[4 + row] * v[1] + m->m[8 + row] * v[2] + m->m[12 + row] * v[3];
+		}
+		memcpy(out[i].v, r, sizeof(r));
+	}
+#endif
+}
+
+//ֻһ(0,0,0,1)ľ3x3ð棬ƽƲ-A^-1 * tͨõ4x4һϵ
+static inline void math_mat4_inverse_affine(math_mat4_t* out, const math_mat4_t* m) {
+#if MATH_BACKEND != MATH_BACKEND_SCALAR
+	__m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+	__m128 c0 = _mm_and_ps(_mm_load_ps(&m->m[0]), mask);
+	__m128 c1 = _mm_and_ps(_mm_load_ps(&m->m[4]), mask);
+	__m128 c2 = _mm_and_ps(_mm_load_ps(&m->m[8]), mask);
+	__m128 t = _mm_and_ps(_mm_load_ps(&m->m[12]), mask);
+	//Ĳʽ
+	__m128 r0 = _math_cross3(c1, c2);
+	__m128 r1 = _math_cross3(c2, c0);
+	__m128 r2 = _math_cross3(c0, c1);
+	__m128 inv_det = _mm_div_ps(_mm_set1_ps(1.0f), _math_dot3(c0, r0));
+	r0 = _mm_mul_ps(r0, inv_det);
+	r1 = _mm_mul_ps(r1, inv_det);
+	r2 = _mm_mul_ps(r2, inv_det);
+	__m128 r3 = _mm_setzero_ps();
+	__m128 tx = _math_dot3(r0, t);
+	__m128 ty = _math_dot3(r1, t);
+	__m128 tz = _math_dot3(r2, t);
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	__m128 translation = _mm_sub_ps(_mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f), _mm_unpacklo_ps(_mm_unpacklo_ps(tx, tz), _mm_unpacklo_ps(ty, _mm_setzero_ps())));
+	_mm_store_ps(&out->m[0], r0);
+	_mm_store_ps(&out->m[4], r1);
+	_mm_store_ps(&out->m[8], r2);
+	_mm_store_ps(&out->m[12], translation);
+#else
+	const float* a = m->m;
+	float r[9];
+	r[0] = a[5] * a[10] - a[6] * a[9];
+	r[1] = a[6] * a[8] - a[4] * a[10];
+	r[2] = a[4] * a[9] - a[5] * a[8];
+	r[3] = a[9] * a[2] - a[10] * a[1];
+	r[4] = a[10] * a[0] - a[8] * a[2];
+	r[5] = a[8] * a[1] - a[9] * a[0];
+	r[6] = a[1] * a[6] - a[2] * a[5];
+	r[7] = a[2] * a[4] - a[0] * a[6];
+	r[8] = a[0] * a[5] - a[1] * a[4];
+	float inv_det = 1.0f / (a[0] * r[0] + a[1] * r[1] + a[2] * r[2]);
+	for (int i = 0; i < 9; i++) {
+		r[i] *= inv_det;
+	}
+	math_mat4_t o;
+	//rдţдʱת
+	for (int row = 0; row < 3; row++) {
+		for (int col = 0; col < 3; col++) {
+			o.m[col * 4 + row] = r[row * 3 + col];
+		}
+		o.m[12 + row] = -(r[row * 3] * a[12] + r[row * 3 + 1] * a[13] + r[row * 3 + 2] * a[14]);
+	}
+	o.m[3] = 0.0f;
+	o.m[7] = 0.0f;
+	o.m[11] = 0.0f;
+	o.m[15] = 1.0f;
+	*out = o;
+#endif
+}
+
+//axisҪǵλ
+static inline void math_quat_from_axis_angle(math_quat_t* out, const glm::vec3& axis, float angle) {
+	float s = sinf(angle * 0.5f) / sqrtf(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+	out->v[0] = axis.x * s;
+	out->v[1] = axis.y * s;
+	out->v[2] = axis.z * s;
+	out->v[3] = cosf(angle * 0.5f);
+}
+
+//translate(position) * mat4_cast(rotation) * scale(scale)ÿģ;һ꣬˷
+static inline void math_mat4_from_trs(math_mat4_t* out, const glm::vec3& position, const math_quat_t* rotation, const glm::vec3& scale) {
+	float x = rotation->v[0], y = rotation->v[1], z = rotation->v[2], w = rotation->v[3];
+	float xx = x * x, yy = y * y, zz = z * z;
+	float xy = x * y, xz = x * z, yz = y * z;
+	float wx = w * x, wy = w * y, wz = w * z;
+#if MATH_BACKEND != MATH_BACKEND_SCALAR
+	_mm_store_ps(&out->m[0], _mm_mul_ps(_mm_setr_ps(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f), _mm_set1_ps(scale.x)));
+	_mm_store_ps(&out->m[4], _mm_mul_ps(_mm_setr_ps(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f), _mm_set1_ps(scale.y)));
+	_mm_store_ps(&out->m[8], _mm_mul_ps(_mm_setr_ps(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f), _mm_set1_ps(scale.z)));
+	_mm_store_ps(&out->m[12], _mm_setr_ps(position.x, position.y, position.z, 1.0f));
+#else
+	float* m = out->m;
+	m[0] = (1.0f - 2.0f * (yy + zz)) * scale.x;
+	m[1] = 2.0f * (xy + wz) * scale.x;
+	m[2] = 2.0f * (xz - wy) * scale.x;
+	m[3] = 0.0f;
+	m[4] = 2.0f * (xy - wz) * scale.y;
+	m[5] = (1.0f - 2.0f * (xx + zz)) * scale.y;
+	m[6] = 2.0f * (yz + wx) * scale.y;
+	m[7] = 0.0f;
+	m[8] = 2.0f * (xz + wy) * scale.z;
+	m[9] = 2.0f * (yz - wx) * scale.z;
+	m[10] = (1.0f - 2.0f * (xx + yy)) * scale.z;
+	m[11] = 0.0f;
+	m[12] = position.x;
+	m[13] = position.y;
+	m[14] = position.z;
+	m[15] = 1.0f;
+#endif
+}
+
+//glm::rotate(m, angle, axis)ͬm * RRԪõ
+static inline void math_mat4_rotate(math_mat4_t* out, const math_mat4_t* m, float angle, const glm::vec3& axis) {
+	math_quat_t q;
+	math_quat_from_axis_angle(&q, axis, angle);
+	math_mat4_t r;
+	math_mat4_from_trs(&r, glm::vec3(0.0f), &q, glm::vec3(1.0f));
+	math_mat4_mul(out, m, &r);
+}
+
+//mylookAtͬͼ
+static inline void math_look_at(math_mat4_t* out, const glm::vec3& position, const glm::vec3& target, const glm::vec3& world_up) {
+#if MATH_BACKEND != MATH_BACKEND_SCALAR
+	__m128 eye = _mm_setr_ps(position.x, position.y, position.z, 0.0f);
+	__m128 front = _math_normalize3(_mm_sub_ps(_mm_setr_ps(target.x, target.y, target.z, 0.0f), eye));
+	__m128 right = _math_normalize3(_math_cross3(front, _mm_setr_ps(world_up.x, world_up.y, world_up.z, 0.0f)));
+	__m128 up = _math_normalize3(_math_cross3(right, front));
+	__m128 back = _mm_sub_ps(_mm_setzero_ps(), front);
+	__m128 last = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+	//right/up/-frontתֵУתóУƽк-eyeĵ
+	_MM_TRANSPOSE4_PS(right, up, back, last);
+	__m128 ex = _mm_shuffle_ps(eye, eye, _MM_SHUFFLE(0, 0, 0, 0));
+	__m128 ey = _mm_shuffle_ps(eye, eye, _MM_SHUFFLE(1, 1, 1, 1));
+	__m128 ez = _mm_shuffle_ps(eye, eye, _MM_SHUFFLE(2, 2, 2, 2));
+	__m128 t = _mm_add_ps(_mm_add_ps(_mm_mul_ps(right, ex), _mm_mul_ps(up, ey)), _mm_mul_ps(back, ez));
+	_mm_store_ps(&out->m[0], right);
+	_mm_store_ps(&out->m[4], up);
+	_mm_store_ps(&out->m[8], back);
+	_mm_store_ps(&out->m[12], _mm_sub_ps(last, t));
+#else
+	glm::vec3 front = glm::normalize(target - position);
+	glm::vec3 right = glm::normalize(glm::cross(front, world_up));
+	glm::vec3 up = glm::normalize(glm::cross(right, front));
+	float* m = out->m;
+	m[0] = right.x;
+	m[1] = up.x;
+	m[2] = -front.x;
+	m[3] = 0.0f;
+	m[4] = right.y;
+	m[5] = up.y;
+	m[6] = -front.y;
+	m[7] = 0.0f;
+	m[8] = right.z;
+	m[9] = up.z;
+	m[10] = -front.z;
+	m[11] = 0.0f;
+	m[12] = -glm::dot(right, position);
+	m[13] = -glm::dot(up, position);
+	m[14] = glm::dot(front, position);
+	m[15] = 1.0f;
+#endif
+}
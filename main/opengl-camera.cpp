@@ -0,0 +1,210 @@
+#include <cmath>
+#include "opengl-camera.h"
+#include "math-simd.h"
+
+void opengl_frustum_from_matrix(opengl_frustum_t* frustum, const glm::mat4& m) {
+	//Gribb-HartmannӲüֱȡƽ棬glmm[col][row]
+	glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+	glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+	glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+	glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+	frustum->planes[0] = row3 + row0;
+	frustum->planes[1] = row3 - row0;
+	frustum->planes[2] = row3 + row1;
+	frustum->planes[3] = row3 - row1;
+	frustum->planes[4] = row3 + row2;
+	frustum->planes[5] = row3 - row2;
+	for (int i = 0; i < 6; i++) {
+		frustum->planes[i] /= glm::length(glm::vec3(frustum->planes[i]));
+	}
+}
+
+bool opengl_frustum_test_sphere(const opengl_frustum_t* frustum, const glm::vec4& sphere) {
+	for (int i = 0; i < 6; i++) {
+		const glm::vec4& p = frustum->planes[i];
+		if (p.x * sphere.x + p.y * sphere.y + p.z * sphere.z + p.w < -sphere.w) {
+			return false;
+		}
+	}
+	return true;
+}
+
+glm::mat4 mylookAt(glm::vec3 position, glm::vec3 target, glm::vec3 worldUp) {
+	glm::vec3 front = glm::normalize(target - position);
+	glm::vec3 right = glm::normalize(glm::cross(front, worldUp));
+	glm::vec3 up = glm::normalize(glm::cross(right, front));
+
+	glm::mat4 translation = glm::mat4(1.0f);
+	translation[3][0] = -position.x;
+	translation[3][1] = -position.y;
+	translation[3][2] = -position.z;
+
+	glm::mat4 rotation = glm::mat4(1.0f);
+	// glm У֣ mat[col][row] ʽԪ
+	rotation[0][0] = right.x;
+	rotation[1][0] = right.y;
+	rotation[2][0] = right.z;
+	rotation[0][1] = up.x;
+	rotation[1][1] = up.y;
+	rotation[2][1] = up.z;
+	rotation[0][2] = -front.x;
+	rotation[1][2] = -front.y;
+	rotation[2][2] = -front.z;
+
+	return rotation * translation;//ĶƽƣȻת
+}
+
+static void _camera_update_vectors(opengl_camera_t* camera) {
+	glm::vec3 front;
+	front.x = cos(glm::radians(camera->yaw)) * cos(glm::radians(camera->pitch));
+	front.y = sin(glm::radians(camera->pitch));
+	front.z = sin(glm::radians(camera->yaw)) * cos(glm::radians(camera->pitch));
+	
+	camera->front = glm::normalize(front);
+	camera->right = glm::normalize(glm::cross(camera->front, camera->world_up));
+	camera->up = glm::normalize(glm::cross(camera->right, camera->front));
+}
+
+static void _camera_resolve(opengl_camera_t* camera, uint32_t wanted) {
+	if ((camera->dirty & wanted) == 0) {
+		return;
+	}
+	//ϵview/projection -> view_projection -> inverse/frustum
+	if ((wanted & OPENGL_CAMERA_DIRTY_VIEW) && (camera->dirty & OPENGL_CAMERA_DIRTY_VIEW)) {
+		//camera->upҲcamera->world_upֻѾcamera->up
+		//camera->view = glm::lookAt(camera->pos, camera->pos + camera->front, camera->up);
+		//mylookAtĽֱͬдʡתƽ
+		math_mat4_t view;
+		math_look_at(&view, camera->pos, camera->pos + camera->front, camera->world_up);
+		camera->view = math_mat4_to_glm(&view);
+		camera->dirty &= ~OPENGL_CAMERA_DIRTY_VIEW;
+	}
+	if ((wanted & OPENGL_CAMERA_DIRTY_PROJECTION) && (camera->dirty & OPENGL_CAMERA_DIRTY_PROJECTION)) {
+		camera->projection = glm::mat4(1.0f);
+		camera->projection = glm::perspective(glm::radians(camera->zoom), camera->aspect, OPENGL_CAMERA_NEAR, OPENGL_CAMERA_FAR);
+		camera->dirty &= ~OPENGL_CAMERA_DIRTY_PROJECTION;
+	}
+	if ((wanted & (OPENGL_CAMERA_DIRTY_VIEW_PROJECTION | OPENGL_CAMERA_DIRTY_INVERSE | OPENGL_CAMERA_DIRTY_FRUSTUM))
+		&& (camera->dirty & OPENGL_CAMERA_DIRTY_VIEW_PROJECTION)) {
+		//glm::mat4֤16ֽڶ룬ȿľٳ
+		math_mat4_t projection, view, view_projection;
+		math_mat4_from_glm(&projection, camera->projection);
+		math_mat4_from_glm(&view, camera->view);
+		math_mat4_mul(&view_projection, &projection, &view);
+		camera->view_projection = math_mat4_to_glm(&view_projection);
+		camera->dirty &= ~OPENGL_CAMERA_DIRTY_VIEW_PROJECTION;
+	}
+	if ((wanted & OPENGL_CAMERA_DIRTY_INVERSE) && (camera->dirty & OPENGL_CAMERA_DIRTY_INVERSE)) {
+		camera->inverse_view_projection = glm::inverse(camera->view_projection);
+		camera->dirty &= ~OPENGL_CAMERA_DIRTY_INVERSE;
+	}
+	if ((wanted & OPENGL_CAMERA_DIRTY_FRUSTUM) && (camera->dirty & OPENGL_CAMERA_DIRTY_FRUSTUM)) {
+		opengl_frustum_from_matrix(&camera->frustum, camera->view_projection);
+		camera->dirty &= ~OPENGL_CAMERA_DIRTY_FRUSTUM;
+	}
+}
+
+void opengl_camera_init(opengl_camera_t* camera, glm::vec3 pos, float pitch, float yaw, float aspect) {
+	camera->pos = pos;
+	camera->world_up = glm::vec3(0.0f, 1.0f, 0.0f);
+	camera->yaw = yaw;
+	camera->pitch = pitch;
+	camera->sensitivity = 0.1f;
+	camera->zoom = 45.0f;
+	camera->aspect = aspect;
+
+	_camera_update_vectors(camera);
+	camera->dirty = OPENGL_CAMERA_DIRTY_ALL;
+}
+
+void opengl_camera_move(opengl_camera_t* camera, opengl_camera_movement_t movement, float dt) {
+	float speed = OPENGL_CAMERA_SPEED * dt;
+
+	if (movement == FORWARD) {
+		camera->pos += speed * camera->front;
+	}
+	if (movement == BACKWARD) {
+		camera->pos -= speed * camera->front;
+	}
+	if (movement == LEFT) {
+		camera->pos -= speed * camera->right;
+	}
+	if (movement == RIGHT) {
+		camera->pos += speed * camera->right;
+	}
+	camera->dirty |= OPENGL_CAMERA_DIRTY_VIEW | OPENGL_CAMERA_DIRTY_DERIVED;
+}
+
+void opengl_camera_zoom(opengl_camera_t* camera, float zoom_offset) {
+	camera->zoom -= (float)zoom_offset;
+	if (camera->zoom < 1.0f)
+		camera->zoom = 1.0f;
+	if (camera->zoom > 45.0f)
+		camera->zoom = 45.0f;
+	//ֻӰͶӰviewҪؽ
+	camera->dirty |= OPENGL_CAMERA_DIRTY_PROJECTION | OPENGL_CAMERA_DIRTY_DERIVED;
+}
+
+void opengl_camera_rotate(opengl_camera_t* camera, float yaw_offset, float pitch_offset) {
+	yaw_offset *= camera->sensitivity;
+	pitch_offset *= camera->sensitivity;
+
+	camera->yaw += yaw_offset;
+	camera->pitch += pitch_offset;
+
+	if (camera->pitch > 89.0f)
+		camera->pitch = 89.0f;
+	if (camera->pitch < -89.0f)
+		camera->pitch = -89.0f;
+
+	//ƶҪõµĳԷϸ£ȵȡʱ
+	_camera_update_vectors(camera);
+	camera->dirty |= OPENGL_CAMERA_DIRTY_VIEW | OPENGL_CAMERA_DIRTY_DERIVED;
+}
+
+void opengl_camera_set_aspect(opengl_camera_t* camera, float aspect) {
+	if (camera->aspect != aspect) {
+		camera->aspect = aspect;
+		camera->dirty |= OPENGL_CAMERA_DIRTY_PROJECTION | OPENGL_CAMERA_DIRTY_DERIVED;
+	}
+}
+
+void opengl_camera_set_pose(opengl_camera_t* camera, const glm::vec3& pos, float yaw, float pitch, float zoom) {
+	if (camera->pos != pos || camera->yaw != yaw || camera->pitch != pitch) {
+		camera->pos = pos;
+		camera->yaw = yaw;
+		camera->pitch = pitch;
+		_camera_update_vectors(camera);
+		camera->dirty |= OPENGL_CAMERA_DIRTY_VIEW | OPENGL_CAMERA_DIRTY_DERIVED;
+	}
+	if (camera->zoom != zoom) {
+		camera->zoom = zoom;
+		camera->dirty |= OPENGL_CAMERA_DIRTY_PROJECTION | OPENGL_CAMERA_DIRTY_DERIVED;
+	}
+}
+
+const glm::mat4& opengl_camera_view(opengl_camera_t* camera) {
+	_camera_resolve(camera, OPENGL_CAMERA_DIRTY_VIEW);
+	return camera->view;
+}
+
+const glm::mat4& opengl_camera_projection(opengl_camera_t* camera) {
+	_camera_resolve(camera, OPENGL_CAMERA_DIRTY_PROJECTION);
+	return camera->projection;
+}
+
+const glm::mat4& opengl_camera_view_projection(opengl_camera_t* camera) {
+	_camera_resolve(camera, OPENGL_CAMERA_DIRTY_VIEW | OPENGL_CAMERA_DIRTY_PROJECTION | OPENGL_CAMERA_DIRTY_VIEW_PROJECTION);
+	return camera->view_projection;
+}
+
+const glm::mat4& opengl_camera_inverse_view_projection(opengl_camera_t* camera) {
+	_camera_resolve(camera, OPENGL_CAMERA_DIRTY_ALL & ~OPENGL_CAMERA_DIRTY_FRUSTUM);
+	return camera->inverse_view_projection;
+}
+
+const opengl_frustum_t* opengl_camera_frustum(opengl_camera_t* camera) {
+	_camera_resolve(camera, OPENGL_CAMERA_DIRTY_ALL & ~OPENGL_CAMERA_DIRTY_INVERSE);
+	return &camera->frustum;
+}
@@ -0,0 +1,69 @@
+_Pragma("once")
+
+#include <cstdint>
+#include <glm.hpp>
+#include <gtc/matrix_transform.hpp>
+
+#define OPENGL_CAMERA_NEAR	0.1f
+#define OPENGL_CAMERA_FAR	100.0f
+#define OPENGL_CAMERA_SPEED	6.0f	//ÿƶľ
+
+//ľЩҪ
+#define OPENGL_CAMERA_DIRTY_VIEW			0x01
+#define OPENGL_CAMERA_DIRTY_PROJECTION		0x02
+#define OPENGL_CAMERA_DIRTY_VIEW_PROJECTION	0x04
+#define OPENGL_CAMERA_DIRTY_INVERSE			0x08
+#define OPENGL_CAMERA_DIRTY_FRUSTUM			0x10
+#define OPENGL_CAMERA_DIRTY_DERIVED			(OPENGL_CAMERA_DIRTY_VIEW_PROJECTION | OPENGL_CAMERA_DIRTY_INVERSE | OPENGL_CAMERA_DIRTY_FRUSTUM)
+#define OPENGL_CAMERA_DIRTY_ALL				0x1f
+
+typedef struct opengl_frustum_s {
+	glm::vec4 planes[6];	//left right bottom top near farָ׶ڲ
+}opengl_frustum_t;
+
+typedef enum opengl_camera_movement_e {
+	FORWARD,
+	BACKWARD,
+	LEFT,
+	RIGHT
+}opengl_camera_movement_t;
+
+typedef struct opengl_camera_s {
+	glm::vec3 pos;
+	glm::vec3 front;
+	glm::vec3 up;
+	glm::vec3 right;
+	glm::vec3 world_up;
+	float yaw;
+	float pitch;
+	float sensitivity;
+	float zoom;
+	float aspect;
+	uint32_t dirty;
+	//ǻ棬ͨopengl_camera_viewȺȡһζȡʱż
+	glm::mat4 view;
+	glm::mat4 projection;
+	glm::mat4 view_projection;
+	glm::mat4 inverse_view_projection;
+	opengl_frustum_t frustum;
+}opengl_camera_t;
+
+extern void opengl_frustum_from_matrix(opengl_frustum_t* frustum, const glm::mat4& view_projection);
+extern bool opengl_frustum_test_sphere(const opengl_frustum_t* frustum, const glm::vec4& sphere);
+
+extern glm::mat4 mylookAt(glm::vec3 position, glm::vec3 target, glm::vec3 worldUp);
+
+extern void opengl_camera_init(opengl_camera_t* camera, glm::vec3 pos, float pitch, float yaw, float aspect);
+//漸ֻ޸Ĳλؽ
+extern void opengl_camera_move(opengl_camera_t* camera, opengl_camera_movement_t movement, float dt);
+extern void opengl_camera_zoom(opengl_camera_t* camera, float zoom_offset);
+extern void opengl_camera_rotate(opengl_camera_t* camera, float yaw_offset, float pitch_offset);
+extern void opengl_camera_set_aspect(opengl_camera_t* camera, float aspect);
+//ֱλúͳڰģֵ״̬Ⱦõ
+extern void opengl_camera_set_pose(opengl_camera_t* camera, const glm::vec3& pos, float yaw, float pitch, float zoom);
+
+extern const glm::mat4& opengl_camera_view(opengl_camera_t* camera);
+extern const glm::mat4& opengl_camera_projection(opengl_camera_t* camera);
+extern const glm::mat4& opengl_camera_view_projection(opengl_camera_t* camera);
+extern const glm::mat4& opengl_camera_inverse_view_projection(opengl_camera_t* camera);
+extern const opengl_frustum_t* opengl_camera_frustum(opengl_camera_t* camera);
@@ -0,0 +1,67 @@
+#include <cstdlib>
+#include <cstring>
+#include "opengl-culling.h"
+
+void opengl_instance_set_create(opengl_instance_set_t* set, uint32_t count) {
+	memset(set, 0, sizeof(*set));
+	set->count = count;
+	set->models = (glm::mat4*)calloc(count, sizeof(glm::mat4));
+	set->spheres = (glm::vec4*)calloc(count, sizeof(glm::vec4));
+	set->scales = (float*)calloc(count, sizeof(float));
+	set->lods = (uint8_t*)calloc(count, sizeof(uint8_t));
+	for (uint32_t i = 0; i < count; i++) {
+		set->models[i] = glm::mat4(1.0f);
+	}
+}
+
+void opengl_instance_set_destroy(opengl_instance_set_t* set) {
+	free(set->models);
+	free(set->spheres);
+	free(set->scales);
+	free(set->lods);
+	memset(set, 0, sizeof(*set));
+}
+
+void opengl_instance_set_update_bounds(opengl_instance_set_t* set, const glm::vec3& center, float radius) {
+	for (uint32_t i = 0; i < set->count; i++) {
+		const glm::mat4& m = set->models[i];
+		float scale = glm::sqrt(glm::max(glm::dot(glm::vec3(m[0]), glm::vec3(m[0])),
+			glm::max(glm::dot(glm::vec3(m[1]), glm::vec3(m[1])), glm::dot(glm::vec3(m[2]), glm::vec3(m[2])))));
+		glm::vec3 world = glm::vec3(m * glm::vec4(center, 1.0f));
+		set->spheres[i] = glm::vec4(world, radius * scale);
+		set->scales[i] = scale;
+	}
+}
+
+void opengl_instance_set_cull(opengl_instance_set_t* set, frame_arena_t* arena, const opengl_frustum_t* frustum, const glm::vec3& camera_pos,
+	const opengl_lod_chain_t* chain, const opengl_lod_selector_t* selector) {
+	memset(set->lod_counts, 0, sizeof(set->lod_counts));
+	set->visible_count = 0;
+	set->visible = FRAME_ARENA_NEW(arena, uint32_t, set->count);
+
+	//һ飺޳ֻɼʵѡLOD
+	for (uint32_t i = 0; i < set->count; i++) {
+		const glm::vec4& sphere = set->spheres[i];
+		if (!opengl_frustum_test_sphere(frustum, sphere)) {
+			continue;
+		}
+		float distance = glm::length(glm::vec3(sphere) - camera_pos) - sphere.w;
+		uint8_t lod = opengl_lod_select(chain, selector, distance, set->scales[i], set->lods[i]);
+		set->lods[i] = lod;
+		set->lod_counts[lod]++;
+		set->visible[set->visible_count++] = i;
+	}
+	uint32_t offset = 0;
+	uint32_t cursors[OPENGL_LOD_MAX];
+	for (uint32_t lod = 0; lod < OPENGL_LOD_MAX; lod++) {
+		set->lod_offsets[lod] = offset;
+		cursors[lod] = offset;
+		offset += set->lod_counts[lod];
+	}
+	//ڶ飺LODֶд룬ÿLODһʵ
+	set->packed = FRAME_ARENA_NEW(arena, glm::mat4, set->visible_count);
+	for (uint32_t i = 0; i < set->visible_count; i++) {
+		uint32_t index = set->visible[i];
+		set->packed[cursors[set->lods[index]]++] = set->models[index];
+	}
+}
@@ -0,0 +1,29 @@
+_Pragma("once")
+
+#include <cstdint>
+#include <glm.hpp>
+#include "opengl-lod.h"
+#include "opengl-camera.h"
+#include "frame-arena.h"
+
+//һ鹲ͬһ(LOD)ʵÿ֡޳LODֶδɼʵģ;
+typedef struct opengl_instance_set_s {
+	glm::mat4* models;
+	glm::vec4* spheres;		//ռΧ xyz: w:뾶
+	float* scales;			//ģ;ţڻLOD
+	uint8_t* lods;			//ÿʵǰLOD֡ͺж
+	uint32_t count;
+	uint32_t* visible;		//֡Ϸ䣬ֻڵǰ֡Ч
+	glm::mat4* packed;
+	uint32_t visible_count;
+	uint32_t lod_offsets[OPENGL_LOD_MAX];	//packedеʼλ
+	uint32_t lod_counts[OPENGL_LOD_MAX];
+}opengl_instance_set_t;
+
+extern void opengl_instance_set_create(opengl_instance_set_t* set, uint32_t count);
+extern void opengl_instance_set_destroy(opengl_instance_set_t* set);
+//ģ;޸ĺãľֲΧռΧ
+extern void opengl_instance_set_update_bounds(opengl_instance_set_t* set, const glm::vec3& center, float radius);
+//׶޳ֻԿɼʵѡLODarenaǰ֡ڴ
+extern void opengl_instance_set_cull(opengl_instance_set_t* set, frame_arena_t* arena, const opengl_frustum_t* frustum, const glm::vec3& camera_pos,
+	const opengl_lod_chain_t* chain, const opengl_lod_selector_t* selector);
@@ -1,7 +1,9 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <cstring>
+#include <cstddef>
 #include "opengl-examples.h"
+#include "math-simd.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
@@ -332,6 +334,170 @@ static void _camera02_shader_program_create(opengl_ctx_t* ctx) {
 	_common_shader_program_create(ctx, vertex_shader_source, frag_shader_source);
 }
 
+static void _mesh01_shader_program_create(opengl_ctx_t* ctx) {
+	const char* vertex_shader_source =
+		"#version 330 core\n"
+		"layout (location = 0) in vec3 aPos;										\
+		 layout (location = 1) in vec2 aTexCoord;									\
+		 out vec2 TexCoord;															\
+		 uniform mat4 uModel;														\
+		 uniform mat4 uView;														\
+		 uniform mat4 uProjection;													\
+		 void main() {																\
+			gl_Position = uProjection * uView * uModel * vec4(aPos, 1.0);			\
+			TexCoord = aTexCoord;													\
+		 }																			\
+		";
+
+	const char* frag_shader_source =
+		"#version 330 core\n"
+		"out vec4 FragColor;																\
+		 in vec2 TexCoord;																	\
+		 uniform sampler2D texture0;														\
+		 uniform sampler2D texture1;														\
+		 void main() {																		\
+			FragColor = mix(texture(texture0, TexCoord), texture(texture1, TexCoord), 0.2);	\
+		 }																					\
+		";
+	_common_shader_program_create(ctx, vertex_shader_source, frag_shader_source);
+}
+
+static void _lod01_shader_program_create(opengl_ctx_t* ctx) {
+	const char* vertex_shader_source =
+		"#version 330 core\n"
+		"layout (location = 0) in vec3 aPos;										\
+		 layout (location = 2) in vec3 aNormal;										\
+		 layout (location = 3) in mat4 aModel;										\
+		 out vec3 Normal;															\
+		 uniform mat4 uView;														\
+		 uniform mat4 uProjection;													\
+		 void main() {																\
+			gl_Position = uProjection * uView * aModel * vec4(aPos, 1.0);			\
+			Normal = mat3(aModel) * aNormal;										\
+		 }																			\
+		";
+
+	const char* frag_shader_source =
+		"#version 330 core\n"
+		"out vec4 FragColor;																\
+		 in vec3 Normal;																	\
+		 uniform vec3 uColor;																\
+		 void main() {																		\
+			float light = max(dot(normalize(Normal), normalize(vec3(0.3, 1.0, 0.5))), 0.0);	\
+			FragColor = vec4(uColor * (0.2 + 0.8 * light), 1.0);							\
+		 }																					\
+		";
+	_common_shader_program_create(ctx, vertex_shader_source, frag_shader_source);
+}
+
+static void _meshlet01_shader_program_create(opengl_ctx_t* ctx) {
+	const char* vertex_shader_source =
+		"#version 330 core\n"
+		"layout (location = 0) in vec3 aPos;										\
+		 layout (location = 2) in vec3 aNormal;										\
+		 out vec3 Normal;															\
+		 uniform mat4 uModel;														\
+		 uniform mat4 uView;														\
+		 uniform mat4 uProjection;													\
+		 void main() {																\
+			gl_Position = uProjection * uView * uModel * vec4(aPos, 1.0);			\
+			Normal = mat3(uModel) * aNormal;										\
+		 }																			\
+		";
+
+	const char* frag_shader_source =
+		"#version 330 core\n"
+		"out vec4 FragColor;																\
+		 in vec3 Normal;																	\
+		 void main() {																		\
+			float light = max(dot(normalize(Normal), normalize(vec3(0.3, 1.0, 0.5))), 0.0);	\
+			FragColor = vec4(vec3(1.0, 0.5, 0.2) * (0.2 + 0.8 * light), 1.0);				\
+		 }																					\
+		";
+	_common_shader_program_create(ctx, vertex_shader_source, frag_shader_source);
+}
+
+static void _texture_array01_shader_program_create(opengl_ctx_t* ctx) {
+	const char* vertex_shader_source =
+		"#version 330 core\n"
+		"layout (location = 0) in vec3 aPos;										\
+		 layout (location = 1) in vec2 aTexCoord;									\
+		 layout (location = 3) in mat4 aModel;										\
+		 layout (location = 7) in float aLayer;										\
+		 out vec3 TexCoord;															\
+		 uniform mat4 uView;														\
+		 uniform mat4 uProjection;													\
+		 void main() {																\
+			gl_Position = uProjection * uView * aModel * vec4(aPos, 1.0);			\
+			TexCoord = vec3(aTexCoord, aLayer);										\
+		 }																			\
+		";
+
+	const char* frag_shader_source =
+		"#version 330 core\n"
+		"out vec4 FragColor;																\
+		 in vec3 TexCoord;																	\
+		 uniform sampler2DArray uTextures;													\
+		 void main() {																		\
+			FragColor = texture(uTextures, TexCoord);										\
+		 }																					\
+		";
+	_common_shader_program_create(ctx, vertex_shader_source, frag_shader_source);
+}
+
+static void _texture_stream01_shader_program_create(opengl_ctx_t* ctx) {
+	const char* vertex_shader_source =
+		"#version 330 core\n"
+		"layout (location = 0) in vec3 aPos;										\
+		 layout (location = 1) in vec2 aTexCoord;									\
+		 out vec2 TexCoord;															\
+		 uniform mat4 uModel;														\
+		 uniform mat4 uView;														\
+		 uniform mat4 uProjection;													\
+		 void main() {																\
+			gl_Position = uProjection * uView * uModel * vec4(aPos, 1.0);			\
+			TexCoord = aTexCoord;													\
+		 }																			\
+		";
+
+	const char* frag_shader_source =
+		"#version 330 core\n"
+		"out vec4 FragColor;																\
+		 in vec2 TexCoord;																	\
+		 uniform sampler2D texture0;														\
+		 void main() {																		\
+			FragColor = texture(texture0, TexCoord);										\
+		 }																					\
+		";
+	_common_shader_program_create(ctx, vertex_shader_source, frag_shader_source);
+}
+static void _resource01_shader_program_create(opengl_ctx_t* ctx) {
+	const char* vertex_shader_source =
+		"#version 330 core\n"
+		"layout (location = 0) in vec3 aPos;										\
+		 layout (location = 1) in vec2 aTexCoord;									\
+		 out vec2 TexCoord;															\
+		 uniform mat4 uModel;														\
+		 uniform mat4 uView;														\
+		 uniform mat4 uProjection;													\
+		 void main() {																\
+			gl_Position = uProjection * uView * uModel * vec4(aPos, 1.0);			\
+			TexCoord = aTexCoord;													\
+		 }																			\
+		";
+
+	const char* frag_shader_source =
+		"#version 330 core\n"
+		"out vec4 FragColor;																\
+		 in vec2 TexCoord;																	\
+		 uniform sampler2D texture0;														\
+		 void main() {																		\
+			FragColor = texture(texture0, TexCoord);										\
+		 }																					\
+		";
+	_common_shader_program_create(ctx, vertex_shader_source, frag_shader_source);
+}
+
 static void _triangle01_scene_create(opengl_ctx_t* ctx) {
 	float vertices[] = {
 		-0.5f,	-0.5f,	0.0f,
@@ -1120,6 +1286,434 @@ static void _camera02_scene_create(opengl_ctx_t* ctx) {
 	glBindVertexArray(0);//ѡֹ޸
 }
 
+static void _mesh01_scene_create(opengl_ctx_t* ctx) {
+	//һμʱobjɶƻ棬ֱ֮ӳ仺ļ
+	if (!opengl_mesh_load(&ctx->mesh, "../../../resource/cube.obj")) {
+		abort();
+	}
+	opengl_mesh_upload(&ctx->mesh, &ctx->vao, &ctx->vbo, &ctx->ebo);
+
+	////////////////////////////////////////////////////////////////////////////
+	//פһʹʱżأԤʱLRUmip߻
+	//mipCPUù߳ɣתRGB->RGBAͬһ
+	opengl_texture_residency_init(&ctx->residency, OPENGL_TEXTURE_RESIDENCY_DEFAULT_BUDGET, &ctx->jobs);
+	ctx->resident_textures[0] = opengl_texture_residency_register(&ctx->residency, "../../../resource/container.jpg", IMAGE_MIP_FLIP_Y | IMAGE_MIP_SRGB);
+	ctx->resident_textures[1] = opengl_texture_residency_register(&ctx->residency, "../../../resource/awesomeface.png", IMAGE_MIP_FLIP_Y | IMAGE_MIP_SRGB);
+
+	//ɫеƬɫӦ,ҶɫǰҪuse
+	opengl_shader_program_use(ctx);
+	//Ԫֵ
+	glUniform1i(glGetUniformLocation(ctx->shader_program, "texture0"), 0);
+	glUniform1i(glGetUniformLocation(ctx->shader_program, "texture1"), 1);
+}
+
+static void _lod01_scene_create(opengl_ctx_t* ctx) {
+	opengl_mesh_create_sphere(&ctx->mesh, 128, 64);
+	opengl_lod_chain_generate(&ctx->lod_chain, &ctx->mesh, 6, 0.5f);
+	opengl_mesh_upload(&ctx->mesh, &ctx->vao, &ctx->vbo, &ctx->ebo);
+
+	glBindVertexArray(ctx->vao);
+	//LODƴͬһʱƫѡ
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ctx->ebo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, ctx->lod_chain.index_count * sizeof(uint32_t), ctx->lod_chain.indices, GL_STATIC_DRAW);
+
+	const unsigned int grid = 64;
+	opengl_instance_set_create(&ctx->instances, grid * grid);
+	for (unsigned int z = 0; z < grid; z++) {
+		for (unsigned int x = 0; x < grid; x++) {
+			glm::mat4 model = glm::mat4(1.0f);
+			model = glm::translate(model, glm::vec3(x * 3.0f - grid * 1.5f, -2.0f, -(float)z * 3.0f));
+			ctx->instances.models[z * grid + x] = model;
+		}
+	}
+	opengl_instance_set_update_bounds(&ctx->instances, ctx->mesh.bounds_center, ctx->mesh.bounds_radius);
+
+	//ʵģ;ռlocation 3~6ÿʵǰһ
+	glGenBuffers(1, &ctx->instance_vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, ctx->instance_vbo);
+	glBufferData(GL_ARRAY_BUFFER, ctx->instances.count * sizeof(glm::mat4), NULL, GL_STREAM_DRAW);
+	for (unsigned int i = 0; i < 4; i++) {
+		glEnableVertexAttribArray(3 + i);
+		glVertexAttribDivisor(3 + i, 1);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+	glBindVertexArray(0);//ѡֹ޸
+}
+
+static void _meshlet01_scene_create(opengl_ctx_t* ctx) {
+	opengl_mesh_create_sphere(&ctx->mesh, 512, 256);
+	opengl_mesh_build_meshlets(&ctx->mesh, OPENGL_MESHLET_MAX_VERTICES, OPENGL_MESHLET_MAX_TRIANGLES);
+	opengl_meshlet_cull_create(&ctx->meshlet_cull, &ctx->mesh);
+	opengl_mesh_upload(&ctx->mesh, &ctx->vao, &ctx->vbo, &ctx->ebo);
+
+	//尴ص˳УɼؿֱӰύ
+	uint32_t index_count;
+	uint32_t* indices = opengl_meshlet_expand_indices(&ctx->mesh, &index_count);
+	glBindVertexArray(ctx->vao);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ctx->ebo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+	glBindVertexArray(0);//ѡֹ޸
+	free(indices);
+}
+
+static void _texture_array01_scene_create(opengl_ctx_t* ctx) {
+	//ÿ
+	float vertices[] = {
+	-0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
+	 0.5f, -0.5f, -0.5f,  1.0f, 0.0f,
+	 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+	 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+	-0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
+	-0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
+
+	-0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+	 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
+	 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
+	 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
+	-0.5f,  0.5f,  0.5f,  0.0f, 1.0f,
+	-0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+
+	-0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+	-0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+	-0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+	-0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+	-0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+	-0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+
+	 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+	 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+	 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+	 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+	 0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+	 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+
+	-0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+	 0.5f, -0.5f, -0.5f,  1.0f, 1.0f,
+	 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
+	 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
+	-0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+	-0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+
+	-0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
+	 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+	 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+	 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+	-0.5f,  0.5f,  0.5f,  0.0f, 0.0f,
+	-0.5f,  0.5f, -0.5f,  0.0f, 1.0f
+	};
+	glGenVertexArrays(1, &ctx->vao);
+	glBindVertexArray(ctx->vao);
+
+	glGenBuffers(1, &ctx->vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, ctx->vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+
+	//ͼƬߴͬᱻŽͬһ
+	const char* paths[] = {
+		"../../../resource/container.jpg",
+		"../../../resource/awesomeface.png",
+		"../../../resource/wall.jpg",
+	};
+	opengl_texture_layer_t layers[3];
+	opengl_texture_arrays_init(&ctx->texture_arrays, &ctx->jobs);
+	for (unsigned int i = 0; i < 3; i++) {
+		if (!opengl_texture_arrays_load(&ctx->texture_arrays, paths[i], &layers[i])) {
+			abort();
+		}
+	}
+	opengl_texture_arrays_build(&ctx->texture_arrays);
+
+	//ÿʵģ; + 
+	typedef struct instance_s {
+		glm::mat4 model;
+		float layer;
+	}instance_t;
+	const unsigned int grid = 100;
+	instance_t* instances = (instance_t*)malloc(grid * grid * sizeof(instance_t));
+	for (unsigned int z = 0; z < grid; z++) {
+		for (unsigned int x = 0; x < grid; x++) {
+			unsigned int i = z * grid + x;
+			glm::mat4 model = glm::mat4(1.0f);
+			model = glm::translate(model, glm::vec3(x * 1.5f - grid * 0.75f, -2.0f, -(float)z * 1.5f));
+			model = glm::rotate(model, glm::radians(20.0f * i), glm::vec3(1.0f, 0.3f, 0.5f));
+			instances[i].model = model;
+			instances[i].layer = (float)layers[i % 3].layer;
+		}
+	}
+	glGenBuffers(1, &ctx->instance_vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, ctx->instance_vbo);
+	glBufferData(GL_ARRAY_BUFFER, grid * grid * sizeof(instance_t), instances, GL_STATIC_DRAW);
+	for (unsigned int i = 0; i < 4; i++) {
+		glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, sizeof(instance_t), (void*)(offsetof(instance_t, model) + i * sizeof(glm::vec4)));
+		glEnableVertexAttribArray(3 + i);
+		glVertexAttribDivisor(3 + i, 1);
+	}
+	glVertexAttribPointer(7, 1, GL_FLOAT, GL_FALSE, sizeof(instance_t), (void*)offsetof(instance_t, layer));
+	glEnableVertexAttribArray(7);
+	glVertexAttribDivisor(7, 1);
+	free(instances);
+
+	opengl_shader_program_use(ctx);
+	glUniform1i(glGetUniformLocation(ctx->shader_program, "uTextures"), 0);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+	glBindVertexArray(0);//ѡֹ޸
+}
+
+static void _texture_stream01_scene_create(opengl_ctx_t* ctx) {
+	float vertices[] = {
+	-0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
+	 0.5f, -0.5f, -0.5f,  1.0f, 0.0f,
+	 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+	 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+	-0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
+	-0.5f, -0.5f, -0.5f,  0.0f, 0.0f,
+
+	-0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+	 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
+	 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
+	 0.5f,  0.5f,  0.5f,  1.0f, 1.0f,
+	-0.5f,  0.5f,  0.5f,  0.0f, 1.0f,
+	-0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+
+	-0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+	-0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+	-0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+	-0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+	-0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+	-0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+
+	 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+	 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+	 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+	 0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+	 0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+	 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+
+	-0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+	 0.5f, -0.5f, -0.5f,  1.0f, 1.0f,
+	 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
+	 0.5f, -0.5f,  0.5f,  1.0f, 0.0f,
+	-0.5f, -0.5f,  0.5f,  0.0f, 0.0f,
+	-0.5f, -0.5f, -0.5f,  0.0f, 1.0f,
+
+	-0.5f,  0.5f, -0.5f,  0.0f, 1.0f,
+	 0.5f,  0.5f, -0.5f,  1.0f, 1.0f,
+	 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+	 0.5f,  0.5f,  0.5f,  1.0f, 0.0f,
+	-0.5f,  0.5f,  0.5f,  0.0f, 0.0f,
+	-0.5f,  0.5f, -0.5f,  0.0f, 1.0f
+	};
+	glGenVertexArrays(1, &ctx->vao);
+	glBindVertexArray(ctx->vao);
+
+	glGenBuffers(1, &ctx->vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, ctx->vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+	glBindVertexArray(0);//ѡֹ޸
+
+	//һʼֻС64x64mipԴУ߽֮ϸĲں̨ȡ
+	const char* paths[] = {
+		"../../../resource/container.jpg",
+		"../../../resource/awesomeface.png",
+		"../../../resource/wall.jpg",
+	};
+	opengl_texture_stream_init(&ctx->texture_stream);
+	for (unsigned int i = 0; i < 3; i++) {
+		ctx->streamed_textures[i] = opengl_texture_stream_open(&ctx->texture_stream, paths[i], IMAGE_MIP_FLIP_Y | IMAGE_MIP_SRGB, &ctx->jobs);
+		if (ctx->streamed_textures[i] == OPENGL_TEXTURE_STREAM_INVALID) {
+			abort();
+		}
+	}
+
+	opengl_shader_program_use(ctx);
+	glUniform1i(glGetUniformLocation(ctx->shader_program, "texture0"), 0);
+}
+
+static void _resource01_scene_create(opengl_ctx_t* ctx) {
+	//8ϸ̶ֳȲͬÿǵԴֻ
+	opengl_resources_init(&ctx->resources);
+	for (unsigned int i = 0; i < 8; i++) {
+		opengl_mesh_t mesh;
+		opengl_mesh_create_sphere(&mesh, 8 + i * 4, 4 + i * 2);
+		ctx->resource_meshes[i] = opengl_resources_upload_mesh(&ctx->resources, &mesh);
+		opengl_mesh_destroy(&mesh);
+	}
+	const char* paths[] = {
+		"../../../resource/container.jpg",
+		"../../../resource/awesomeface.png",
+		"../../../resource/wall.jpg",
+	};
+	for (unsigned int i = 0; i < 3; i++) {
+		ctx->resource_textures[i] = opengl_resources_load_texture(&ctx->resources, paths[i], IMAGE_MIP_FLIP_Y | IMAGE_MIP_SRGB, &ctx->jobs);
+		if (opengl_resources_texture(&ctx->resources, ctx->resource_textures[i]) == NULL) {
+			abort();
+		}
+	}
+	ctx->resource_epoch = 0;
+
+	opengl_shader_program_use(ctx);
+	glUniform1i(glGetUniformLocation(ctx->shader_program, "texture0"), 0);
+}
+
+static void _ecs01_scene_create(opengl_ctx_t* ctx) {
+	opengl_mesh_create_sphere(&ctx->mesh, 128, 64);
+	opengl_lod_chain_generate(&ctx->lod_chain, &ctx->mesh, 6, 0.5f);
+	opengl_mesh_upload(&ctx->mesh, &ctx->vao, &ctx->vbo, &ctx->ebo);
+
+	glBindVertexArray(ctx->vao);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ctx->ebo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, ctx->lod_chain.index_count * sizeof(uint32_t), ctx->lod_chain.indices, GL_STATIC_DRAW);
+
+	//ÿһʵ壬任Χһ
+	ecs_world_init(&ctx->world, &ctx->jobs);
+	ecs_render_register(&ctx->world, &ctx->ecs_components);
+	const ecs_render_components_t* c = &ctx->ecs_components;
+	ecs_mask_t mask = ecs_render_mask(c) | ECS_BIT(c->animation);
+	const unsigned int grid = 256;
+	uint32_t seed = 1;
+	for (unsigned int z = 0; z < grid; z++) {
+		for (unsigned int x = 0; x < grid; x++) {
+			ecs_entity_t entity = ecs_create(&ctx->world, mask);
+			float r[4];
+			for (unsigned int i = 0; i < 4; i++) {
+				seed = seed * 1664525u + 1013904223u;
+				r[i] = (float)(seed >> 8) / (float)(1u << 24);
+			}
+			ecs_transform_t* transform = (ecs_transform_t*)ecs_get(&ctx->world, entity, c->transform);
+			transform->position = glm::vec3(x * 3.0f - grid * 1.5f, -2.0f, -(float)z * 3.0f);
+			transform->scale = 0.5f + r[0];
+			transform->rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+			ecs_animation_t* animation = (ecs_animation_t*)ecs_get(&ctx->world, entity, c->animation);
+			animation->axis = glm::normalize(glm::vec3(r[1] - 0.5f, 1.0f, r[2] - 0.5f));
+			animation->speed = 0.5f + 2.0f * r[3];
+			animation->phase = 6.2831853f * r[0];
+			ecs_render_mesh_t* mesh = (ecs_render_mesh_t*)ecs_get(&ctx->world, entity, c->render_mesh);
+			mesh->center = ctx->mesh.bounds_center;
+			mesh->radius = ctx->mesh.bounds_radius;
+		}
+	}
+
+	glGenBuffers(1, &ctx->instance_vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, ctx->instance_vbo);
+	glBufferData(GL_ARRAY_BUFFER, grid * grid * sizeof(glm::mat4), NULL, GL_STREAM_DRAW);
+	for (unsigned int i = 0; i < 4; i++) {
+		glEnableVertexAttribArray(3 + i);
+		glVertexAttribDivisor(3 + i, 1);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+	glBindVertexArray(0);//ѡֹ޸
+}
+
+//ÿǴ8ǣÿǴ4ǣǵ幫ת
+#define HIERARCHY_STARS		16
+#define HIERARCHY_PLANETS	8
+#define HIERARCHY_MOONS		4
+
+static void _hierarchy01_scene_create(opengl_ctx_t* ctx) {
+	opengl_mesh_create_sphere(&ctx->mesh, 32, 16);
+	opengl_mesh_upload(&ctx->mesh, &ctx->vao, &ctx->vbo, &ctx->ebo);
+
+	//˳ӣڵ±ǹ̶ģǺǵλöڸڵ
+	scene_graph_init(&ctx->scene_graph, HIERARCHY_STARS * (1 + HIERARCHY_PLANETS * (1 + HIERARCHY_MOONS)));
+	for (unsigned int s = 0; s < HIERARCHY_STARS; s++) {
+		glm::mat4 star = glm::translate(glm::mat4(1.0f), glm::vec3((s % 4) * 12.0f - 18.0f, -2.0f, -(float)(s / 4) * 12.0f - 6.0f));
+		uint32_t star_node = scene_graph_add(&ctx->scene_graph, SCENE_GRAPH_NONE, star);
+		for (unsigned int p = 0; p < HIERARCHY_PLANETS; p++) {
+			glm::mat4 planet = glm::rotate(glm::mat4(1.0f), p * 0.785f, glm::vec3(0.0f, 1.0f, 0.0f));
+			planet = glm::translate(planet, glm::vec3(1.5f + p * 0.5f, 0.0f, 0.0f));
+			planet = glm::scale(planet, glm::vec3(0.3f));
+			uint32_t planet_node = scene_graph_add(&ctx->scene_graph, star_node, planet);
+			for (unsigned int m = 0; m < HIERARCHY_MOONS; m++) {
+				glm::mat4 moon = glm::rotate(glm::mat4(1.0f), m * 1.571f, glm::vec3(0.0f, 0.0f, 1.0f));
+				moon = glm::translate(moon, glm::vec3(2.0f, 0.0f, 0.0f));
+				moon = glm::scale(moon, glm::vec3(0.4f));
+				scene_graph_add(&ctx->scene_graph, planet_node, moon);
+			}
+		}
+	}
+	scene_graph_update_all(&ctx->scene_graph);
+
+	glBindVertexArray(ctx->vao);
+	glGenBuffers(1, &ctx->instance_vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, ctx->instance_vbo);
+	glBufferData(GL_ARRAY_BUFFER, ctx->scene_graph.count * sizeof(glm::mat4), NULL, GL_STREAM_DRAW);
+	for (unsigned int i = 0; i < 4; i++) {
+		glEnableVertexAttribArray(3 + i);
+		glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(i * sizeof(glm::vec4)));
+		glVertexAttribDivisor(3 + i, 1);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+	glBindVertexArray(0);//ѡֹ޸
+}
+
+//һڣͼƬһɵԲ㽻֣ÿ֡ȫ
+#define SPRITE_COLUMNS	1000
+#define SPRITE_ROWS		1000
+#define SPRITE_SIZE		4.0f	//
+
+static void _sprite01_scene_create(opengl_ctx_t* ctx) {
+	const char* paths[] = {
+		"../../../resource/container.jpg",
+		"../../../resource/awesomeface.png",
+		"../../../resource/wall.jpg",
+	};
+	opengl_texture_arrays_init(&ctx->texture_arrays, &ctx->jobs);
+	for (unsigned int i = 0; i < 3; i++) {
+		if (!opengl_texture_arrays_load(&ctx->texture_arrays, paths[i], &ctx->sprite_textures[i])) {
+			abort();
+		}
+	}
+	//ߴ粻ͬŽһֳλ
+	const int dot = 32;
+	unsigned char* pixels = (unsigned char*)malloc(dot * dot * 4);
+	for (int y = 0; y < dot; y++) {
+		for (int x = 0; x < dot; x++) {
+			float dx = (x + 0.5f) / dot * 2.0f - 1.0f;
+			float dy = (y + 0.5f) / dot * 2.0f - 1.0f;
+			float alpha = 1.0f - sqrtf(dx * dx + dy * dy);
+			unsigned char* p = &pixels[(y * dot + x) * 4];
+			p[0] = p[1] = p[2] = 255;
+			p[3] = (unsigned char)(alpha > 0.0f ? alpha * 255.0f : 0.0f);
+		}
+	}
+	if (!opengl_texture_arrays_add(&ctx->texture_arrays, pixels, dot, dot, 4, 0, &ctx->sprite_textures[3])) {
+		abort();
+	}
+	free(pixels);
+	opengl_texture_arrays_build(&ctx->texture_arrays);
+	opengl_sprite_batch_init(&ctx->sprites);
+}
+
+//ȪGPUñ任ģ⣬CPUÿֻ֡·һС
+#define PARTICLES_CAPACITY	(256 * 1024)
+#define PARTICLES_LIFETIME	2.0f	//룬ʷ䣬ȥʱһȦ
+#define PARTICLES_SIZE		0.02f
+
+static void _particles01_scene_create(opengl_ctx_t* ctx) {
+	opengl_particles_init(&ctx->particles, PARTICLES_CAPACITY, OPENGL_PARTICLES_GPU, &ctx->jobs);
+	ctx->particle_time = ctx->time;
+	ctx->particle_carry = 0.0f;
+}
+
+//̳translaterotateԪһдģ;
+static void _cube_model(math_mat4_t* model, const glm::vec3& position, float angle) {
+	math_quat_t rotation;
+	math_quat_from_axis_angle(&rotation, glm::vec3(1.0f, 0.3f, 0.5f), angle);
+	math_mat4_from_trs(model, position, &rotation, glm::vec3(1.0f));
+}
 
 static void _triangle01_scene_draw(opengl_ctx_t* ctx) {
 	glBindVertexArray(ctx->vao);
@@ -1174,7 +1768,7 @@ static void _matrix02_scene_draw(opengl_ctx_t* ctx) {
 
 	glm::mat4 trans = glm::mat4(1.0f);
 	trans = glm::translate(trans, glm::vec3(0.5f, -0.5f, 0.0f));
-	trans = glm::rotate(trans, (float)glfwGetTime(), glm::vec3(0.0f, 0.0f, 1.0f));
+	trans = glm::rotate(trans, (float)ctx->time, glm::vec3(0.0f, 0.0f, 1.0f));
 	//ȷ֮ǰѾglUseProgram
 	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uTransform"), 1, GL_FALSE, glm::value_ptr(trans));
 
@@ -1221,15 +1815,14 @@ static void _coords02_scene_draw(opengl_ctx_t* ctx) {
 	glClear(GL_DEPTH_BUFFER_BIT);
 	glEnable(GL_DEPTH_TEST);
 
-	float factor = (float)glfwGetTime();
+	float factor = (float)ctx->time;
 
 	for (unsigned int i = 0; i < 10; i++) {
-		glm::mat4 model = glm::mat4(1.0f);
-		model = glm::translate(model, cubePositions[i]);
+		math_mat4_t model;
 		float angle = 20.0f * i + 20.0f;
-		model = glm::rotate(model, factor * glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
+		_cube_model(&model, cubePositions[i], factor * glm::radians(angle));
 
-		glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uModel"), 1, GL_FALSE, glm::value_ptr(model));
+		glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uModel"), 1, GL_FALSE, model.m);
 		
 		glDrawArrays(GL_TRIANGLES, 0, 36);
 	}
@@ -1259,7 +1852,7 @@ static void _camera01_scene_draw(opengl_ctx_t* ctx) {
 	glClear(GL_DEPTH_BUFFER_BIT);
 	glEnable(GL_DEPTH_TEST);
 
-	float factor = (float)glfwGetTime();
+	float factor = (float)ctx->time;
 	float radius = 10.0f;
 	float camX = sin(factor) * radius;
 	float camZ = cos(factor) * radius;
@@ -1271,11 +1864,10 @@ static void _camera01_scene_draw(opengl_ctx_t* ctx) {
 	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uView"), 1, GL_FALSE, glm::value_ptr(view));
 
 	for (unsigned int i = 0; i < 10; i++) {
-		glm::mat4 model = glm::mat4(1.0f);
-		model = glm::translate(model, cubePositions[i]);
+		math_mat4_t model;
 		float angle = 20.0f * i + 20.0f;
-		model = glm::rotate(model, factor * glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
-		glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uModel"), 1, GL_FALSE, glm::value_ptr(model));
+		_cube_model(&model, cubePositions[i], factor * glm::radians(angle));
+		glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uModel"), 1, GL_FALSE, model.m);
 		glDrawArrays(GL_TRIANGLES, 0, 36);
 	}
 }
@@ -1304,21 +1896,418 @@ static void _camera02_scene_draw(opengl_ctx_t* ctx) {
 	glClear(GL_DEPTH_BUFFER_BIT);
 	glEnable(GL_DEPTH_TEST);
 
-	float factor = (float)glfwGetTime();
+	float factor = (float)ctx->time;
 
-	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uView"), 1, GL_FALSE, glm::value_ptr(ctx->camera.view));
-	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uProjection"), 1, GL_FALSE, glm::value_ptr(ctx->camera.projection));
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uView"), 1, GL_FALSE, glm::value_ptr(opengl_camera_view(&ctx->camera)));
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uProjection"), 1, GL_FALSE, glm::value_ptr(opengl_camera_projection(&ctx->camera)));
 	
+	for (unsigned int i = 0; i < 10; i++) {
+		math_mat4_t model;
+		float angle = 20.0f * i + 20.0f;
+		_cube_model(&model, cubePositions[i], factor * glm::radians(angle));
+		glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uModel"), 1, GL_FALSE, model.m);
+		glDrawArrays(GL_TRIANGLES, 0, 36);
+	}
+}
+
+static void _mesh01_scene_draw(opengl_ctx_t* ctx) {
+	glBindVertexArray(ctx->vao);
+
+	glm::vec3 cubePositions[] = {
+		glm::vec3(0.0f,  0.0f,  0.0f),
+		glm::vec3(2.0f,  5.0f, -15.0f),
+		glm::vec3(-1.5f, -2.2f, -2.5f),
+		glm::vec3(-3.8f, -2.0f, -12.3f),
+		glm::vec3(2.4f, -0.4f, -3.5f),
+		glm::vec3(-1.7f,  3.0f, -7.5f),
+		glm::vec3(1.3f, -2.0f, -2.5f),
+		glm::vec3(1.5f,  2.0f, -2.5f),
+		glm::vec3(1.5f,  0.2f, -1.5f),
+		glm::vec3(-1.3f,  1.0f, -1.5f)
+	};
+	opengl_texture_residency_begin_frame(&ctx->residency);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, opengl_texture_residency_acquire(&ctx->residency, ctx->resident_textures[0]));
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, opengl_texture_residency_acquire(&ctx->residency, ctx->resident_textures[1]));
+
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_DEPTH_TEST);
+
+	float factor = (float)ctx->time;
+
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uView"), 1, GL_FALSE, glm::value_ptr(opengl_camera_view(&ctx->camera)));
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uProjection"), 1, GL_FALSE, glm::value_ptr(opengl_camera_projection(&ctx->camera)));
+
+	for (unsigned int i = 0; i < 10; i++) {
+		math_mat4_t model;
+		float angle = 20.0f * i + 20.0f;
+		_cube_model(&model, cubePositions[i], factor * glm::radians(angle));
+		glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uModel"), 1, GL_FALSE, model.m);
+		glDrawElements(GL_TRIANGLES, ctx->mesh.index_count, GL_UNSIGNED_INT, 0);
+	}
+}
+
+static void _lod01_scene_draw(opengl_ctx_t* ctx) {
+	static const glm::vec3 lod_colors[OPENGL_LOD_MAX] = {
+		glm::vec3(1.0f, 1.0f, 1.0f),
+		glm::vec3(0.3f, 1.0f, 0.3f),
+		glm::vec3(0.3f, 0.6f, 1.0f),
+		glm::vec3(1.0f, 1.0f, 0.3f),
+		glm::vec3(1.0f, 0.5f, 0.2f),
+		glm::vec3(1.0f, 0.2f, 0.2f),
+		glm::vec3(0.8f, 0.2f, 1.0f),
+		glm::vec3(0.5f, 0.5f, 0.5f),
+	};
+	glBindVertexArray(ctx->vao);
+
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_DEPTH_TEST);
+
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uView"), 1, GL_FALSE, glm::value_ptr(opengl_camera_view(&ctx->camera)));
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uProjection"), 1, GL_FALSE, glm::value_ptr(opengl_camera_projection(&ctx->camera)));
+
+	opengl_lod_selector_t selector;
+	opengl_lod_selector_init(&selector, ctx->camera.zoom, ctx->viewport_height);
+	opengl_instance_set_cull(&ctx->instances, &ctx->frame_arena, opengl_camera_frustum(&ctx->camera), ctx->camera.pos, &ctx->lod_chain, &selector);
+
+	glBindBuffer(GL_ARRAY_BUFFER, ctx->instance_vbo);
+	glBufferData(GL_ARRAY_BUFFER, ctx->instances.count * sizeof(glm::mat4), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, ctx->instances.visible_count * sizeof(glm::mat4), ctx->instances.packed);
+
+	GLint color_location = glGetUniformLocation(ctx->shader_program, "uColor");
+	for (unsigned int lod = 0; lod < ctx->lod_chain.lod_count; lod++) {
+		unsigned int count = ctx->instances.lod_counts[lod];
+		if (count == 0) {
+			continue;
+		}
+		//GL 3.3ûbaseInstanceָͨƫѡһʵ
+		size_t base = ctx->instances.lod_offsets[lod] * sizeof(glm::mat4);
+		for (unsigned int i = 0; i < 4; i++) {
+			glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(base + i * sizeof(glm::vec4)));
+		}
+		glUniform3fv(color_location, 1, glm::value_ptr(lod_colors[lod]));
+
+		const opengl_lod_t* l = &ctx->lod_chain.lods[lod];
+		glDrawElementsInstanced(GL_TRIANGLES, l->index_count, GL_UNSIGNED_INT, (void*)(l->index_offset * sizeof(uint32_t)), count);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+static void _meshlet01_scene_draw(opengl_ctx_t* ctx) {
+	glBindVertexArray(ctx->vao);
+
+	glm::vec3 cubePositions[] = {
+		glm::vec3(0.0f,  0.0f,  0.0f),
+		glm::vec3(2.0f,  5.0f, -15.0f),
+		glm::vec3(-1.5f, -2.2f, -2.5f),
+		glm::vec3(-3.8f, -2.0f, -12.3f),
+		glm::vec3(2.4f, -0.4f, -3.5f),
+		glm::vec3(-1.7f,  3.0f, -7.5f),
+		glm::vec3(1.3f, -2.0f, -2.5f),
+		glm::vec3(1.5f,  2.0f, -2.5f),
+		glm::vec3(1.5f,  0.2f, -1.5f),
+		glm::vec3(-1.3f,  1.0f, -1.5f)
+	};
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_DEPTH_TEST);
+
+	const glm::mat4& view_projection = opengl_camera_view_projection(&ctx->camera);
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uView"), 1, GL_FALSE, glm::value_ptr(opengl_camera_view(&ctx->camera)));
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uProjection"), 1, GL_FALSE, glm::value_ptr(opengl_camera_projection(&ctx->camera)));
+
 	for (unsigned int i = 0; i < 10; i++) {
 		glm::mat4 model = glm::mat4(1.0f);
 		model = glm::translate(model, cubePositions[i]);
-		float angle = 20.0f * i + 20.0f;
-		model = glm::rotate(model, factor * glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
+		model = glm::scale(model, glm::vec3(0.5f));
+		//׶Ĵύǰ޳
+		if (opengl_meshlet_cull_run(&ctx->meshlet_cull, model, view_projection, ctx->camera.pos) == 0) {
+			continue;
+		}
+		glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uModel"), 1, GL_FALSE, glm::value_ptr(model));
+		glMultiDrawElements(GL_TRIANGLES, ctx->meshlet_cull.draw_counts, GL_UNSIGNED_INT, ctx->meshlet_cull.draw_offsets, ctx->meshlet_cull.draw_count);
+	}
+}
+
+static void _texture_array01_scene_draw(opengl_ctx_t* ctx) {
+	glBindVertexArray(ctx->vao);
+
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_DEPTH_TEST);
+
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uView"), 1, GL_FALSE, glm::value_ptr(opengl_camera_view(&ctx->camera)));
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uProjection"), 1, GL_FALSE, glm::value_ptr(opengl_camera_projection(&ctx->camera)));
+
+	//һֻһΣһͬһλ
+	opengl_texture_arrays_bind(&ctx->texture_arrays, 0, 0);
+	glDrawArraysInstanced(GL_TRIANGLES, 0, 36, 100 * 100);
+}
+
+static void _texture_stream01_scene_draw(opengl_ctx_t* ctx) {
+	glBindVertexArray(ctx->vao);
+
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_DEPTH_TEST);
+
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uView"), 1, GL_FALSE, glm::value_ptr(opengl_camera_view(&ctx->camera)));
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uProjection"), 1, GL_FALSE, glm::value_ptr(opengl_camera_projection(&ctx->camera)));
+
+	//-zųһȣԶֻҪСmip
+	const unsigned int count = 60;
+	const float radius = 0.87f;	//λİΧ뾶
+	float projection_scale = ctx->viewport_height / (2.0f * tanf(glm::radians(ctx->camera.zoom) * 0.5f));
+	for (unsigned int i = 0; i < count; i++) {
+		glm::vec3 pos((float)(i % 3) * 2.0f - 2.0f, 0.0f, -(float)i * 1.5f);
+		float distance = glm::length(pos - ctx->camera.pos);
+		float screen_size = opengl_texture_stream_footprint(radius, distance, projection_scale);
+		opengl_texture_stream_request(&ctx->texture_stream, ctx->streamed_textures[i % 3], screen_size);
+	}
+	opengl_texture_stream_update(&ctx->texture_stream);
+
+	glActiveTexture(GL_TEXTURE0);
+	for (unsigned int i = 0; i < count; i++) {
+		glBindTexture(GL_TEXTURE_2D, opengl_texture_stream_texture(&ctx->texture_stream, ctx->streamed_textures[i % 3]));
+		glm::mat4 model = glm::mat4(1.0f);
+		model = glm::translate(model, glm::vec3((float)(i % 3) * 2.0f - 2.0f, 0.0f, -(float)i * 1.5f));
 		glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uModel"), 1, GL_FALSE, glm::value_ptr(model));
 		glDrawArrays(GL_TRIANGLES, 0, 36);
 	}
 }
 
+static void _resource01_scene_draw(opengl_ctx_t* ctx) {
+	const unsigned int mesh_count = 8;
+	const unsigned int grid = 32;
+
+	//ÿ뻻һ񣺾ɾʧЧGLһ֡դ֮ɾ
+	uint32_t epoch = (uint32_t)ctx->time;
+	if (epoch != ctx->resource_epoch) {
+		ctx->resource_epoch = epoch;
+		unsigned int slot = epoch % mesh_count;
+		opengl_resources_release_mesh(&ctx->resources, ctx->resource_meshes[slot]);
+		opengl_mesh_t mesh;
+		opengl_mesh_create_sphere(&mesh, 6 + (epoch * 7) % 40, 3 + (epoch * 5) % 20);
+		ctx->resource_meshes[slot] = opengl_resources_upload_mesh(&ctx->resources, &mesh);
+		opengl_mesh_destroy(&mesh);
+	}
+
+	//ȾĿӿڴСߴ仯ʱɵһӳɾ
+	const opengl_gpu_render_target_t* target = opengl_resources_render_target(&ctx->resources, ctx->render_target);
+	int width = (int)ctx->viewport_width;
+	int height = (int)ctx->viewport_height;
+	if (width > 0 && height > 0 && (target == NULL || target->width != width || target->height != height)) {
+		opengl_resources_release_render_target(&ctx->resources, ctx->render_target);
+		ctx->render_target = opengl_resources_create_render_target(&ctx->resources, width, height);
+		target = opengl_resources_render_target(&ctx->resources, ctx->render_target);
+	}
+	if (target) {
+		glBindFramebuffer(GL_FRAMEBUFFER, target->framebuffer);
+		glClear(GL_COLOR_BUFFER_BIT);
+	}
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_DEPTH_TEST);
+
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uView"), 1, GL_FALSE, glm::value_ptr(opengl_camera_view(&ctx->camera)));
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uProjection"), 1, GL_FALSE, glm::value_ptr(opengl_camera_projection(&ctx->camera)));
+	GLint model_location = glGetUniformLocation(ctx->shader_program, "uModel");
+	const math_quat_t identity = { { 0.0f, 0.0f, 0.0f, 1.0f } };
+
+	//飬ÿֻһVAO
+	glActiveTexture(GL_TEXTURE0);
+	for (unsigned int m = 0; m < mesh_count; m++) {
+		const opengl_gpu_mesh_t* mesh = opengl_resources_mesh(&ctx->resources, ctx->resource_meshes[m]);
+		if (mesh == NULL) {
+			continue;
+		}
+		glBindVertexArray(mesh->vao);
+		for (unsigned int i = m; i < grid * grid; i += mesh_count) {
+			const opengl_gpu_texture_t* texture = opengl_resources_texture(&ctx->resources, ctx->resource_textures[i % 3]);
+			glBindTexture(GL_TEXTURE_2D, texture ? texture->texture : 0);
+			math_mat4_t model;
+			math_mat4_from_trs(&model, glm::vec3((i % grid) * 1.5f - grid * 0.75f, -2.0f, -(float)(i / grid) * 1.5f), &identity, glm::vec3(0.5f));
+			glUniformMatrix4fv(model_location, 1, GL_FALSE, model.m);
+			glDrawElements(GL_TRIANGLES, mesh->index_count, GL_UNSIGNED_INT, 0);
+		}
+	}
+	glBindVertexArray(0);//ѡֹ޸
+
+	if (target) {
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, target->framebuffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(0, 0, target->width, target->height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+	opengl_resources_end_frame(&ctx->resources);
+}
+
+static void _ecs01_scene_draw(opengl_ctx_t* ctx) {
+	static const glm::vec3 lod_colors[OPENGL_LOD_MAX] = {
+		glm::vec3(1.0f, 1.0f, 1.0f),
+		glm::vec3(0.3f, 1.0f, 0.3f),
+		glm::vec3(0.3f, 0.6f, 1.0f),
+		glm::vec3(1.0f, 1.0f, 0.3f),
+		glm::vec3(1.0f, 0.5f, 0.2f),
+		glm::vec3(1.0f, 0.2f, 0.2f),
+		glm::vec3(0.8f, 0.2f, 1.0f),
+		glm::vec3(0.5f, 0.5f, 0.5f),
+	};
+	glBindVertexArray(ctx->vao);
+
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_DEPTH_TEST);
+
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uView"), 1, GL_FALSE, glm::value_ptr(opengl_camera_view(&ctx->camera)));
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uProjection"), 1, GL_FALSE, glm::value_ptr(opengl_camera_projection(&ctx->camera)));
+
+	//ܶϵͳ޳ϵͳָ߳
+	opengl_lod_selector_t selector;
+	opengl_lod_selector_init(&selector, ctx->camera.zoom, ctx->viewport_height);
+	ecs_render_output_t output;
+	ecs_render_animate(&ctx->world, &ctx->ecs_components, (float)ctx->time);
+	ecs_render_cull(&ctx->world, &ctx->ecs_components, &ctx->frame_arena, opengl_camera_frustum(&ctx->camera), ctx->camera.pos, &ctx->lod_chain, &selector, &output);
+
+	glBindBuffer(GL_ARRAY_BUFFER, ctx->instance_vbo);
+	glBufferData(GL_ARRAY_BUFFER, ctx->world.entity_count * sizeof(glm::mat4), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, output.visible_count * sizeof(glm::mat4), output.packed);
+
+	GLint color_location = glGetUniformLocation(ctx->shader_program, "uColor");
+	for (unsigned int lod = 0; lod < ctx->lod_chain.lod_count; lod++) {
+		unsigned int count = output.lod_counts[lod];
+		if (count == 0) {
+			continue;
+		}
+		size_t base = output.lod_offsets[lod] * sizeof(glm::mat4);
+		for (unsigned int i = 0; i < 4; i++) {
+			glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(base + i * sizeof(glm::vec4)));
+		}
+		glUniform3fv(color_location, 1, glm::value_ptr(lod_colors[lod]));
+
+		const opengl_lod_t* l = &ctx->lod_chain.lods[lod];
+		glDrawElementsInstanced(GL_TRIANGLES, l->index_count, GL_UNSIGNED_INT, (void*)(l->index_offset * sizeof(uint32_t)), count);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+static void _hierarchy01_scene_draw(opengl_ctx_t* ctx) {
+	glBindVertexArray(ctx->vao);
+
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_DEPTH_TEST);
+
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uView"), 1, GL_FALSE, glm::value_ptr(opengl_camera_view(&ctx->camera)));
+	glUniformMatrix4fv(glGetUniformLocation(ctx->shader_program, "uProjection"), 1, GL_FALSE, glm::value_ptr(opengl_camera_projection(&ctx->camera)));
+	glUniform3f(glGetUniformLocation(ctx->shader_program, "uColor"), 1.0f, 0.8f, 0.5f);
+
+	//ÿֻ֡һϵתֻϵû
+	unsigned int nodes_per_star = 1 + HIERARCHY_PLANETS * (1 + HIERARCHY_MOONS);
+	unsigned int s = (unsigned int)(ctx->time * 0.5) % HIERARCHY_STARS;
+	uint32_t star_node = s * nodes_per_star;
+	glm::mat4 star = glm::translate(glm::mat4(1.0f), glm::vec3((s % 4) * 12.0f - 18.0f, -2.0f, -(float)(s / 4) * 12.0f - 6.0f));
+	star = glm::rotate(star, (float)ctx->time, glm::vec3(0.0f, 1.0f, 0.0f));
+	scene_graph_set_local(&ctx->scene_graph, star_node, star);
+	scene_graph_update(&ctx->scene_graph);
+
+	glBindBuffer(GL_ARRAY_BUFFER, ctx->instance_vbo);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, ctx->scene_graph.count * sizeof(glm::mat4), ctx->scene_graph.worlds);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+	glDrawElementsInstanced(GL_TRIANGLES, ctx->mesh.index_count, GL_UNSIGNED_INT, 0, ctx->scene_graph.count);
+}
+
+typedef struct _sprite01_job_s {
+	opengl_sprite_t* sprites;
+	const opengl_texture_layer_t* textures;
+	float time;
+	float cell_width;
+	float cell_height;
+}_sprite01_job_t;
+
+static void _sprite01_fill(void* user, uint32_t begin, uint32_t end) {
+	const _sprite01_job_t* job = (const _sprite01_job_t*)user;
+	for (uint32_t i = begin; i < end; i++) {
+		uint32_t column = i % SPRITE_COLUMNS;
+		uint32_t row = i / SPRITE_COLUMNS;
+		opengl_sprite_t* sprite = &job->sprites[i];
+		sprite->position[0] = (column + 0.5f) * job->cell_width + 3.0f * sinf(job->time * 2.0f + row * 0.05f);
+		sprite->position[1] = (row + 0.5f) * job->cell_height + 3.0f * cosf(job->time * 2.0f + column * 0.05f);
+		sprite->size[0] = SPRITE_SIZE;
+		sprite->size[1] = SPRITE_SIZE;
+		sprite->rotation = job->time + i * 0.001f;
+		sprite->color = OPENGL_SPRITE_RGBA(64 + column * 191 / SPRITE_COLUMNS, 64 + row * 191 / SPRITE_ROWS, 160, 255);
+		//ڵľòͬύ˳ҵģϲ
+		const opengl_texture_layer_t* texture = &job->textures[i & 3];
+		sprite->layer = (uint16_t)texture->layer;
+		sprite->pool = (uint16_t)texture->pool;
+	}
+}
+
+static void _sprite01_scene_draw(opengl_ctx_t* ctx) {
+	//ݺͳ޹أֱ߳дԤһ
+	_sprite01_job_t job;
+	job.sprites = opengl_sprite_batch_alloc(&ctx->sprites, SPRITE_COLUMNS * SPRITE_ROWS);
+	job.textures = ctx->sprite_textures;
+	job.time = (float)ctx->time;
+	job.cell_width = (float)ctx->viewport_width / SPRITE_COLUMNS;
+	job.cell_height = (float)ctx->viewport_height / SPRITE_ROWS;
+	job_pool_parallel_for(&ctx->jobs, SPRITE_COLUMNS * SPRITE_ROWS, 4096, _sprite01_fill, &job);
+
+	glm::mat4 projection = glm::ortho(0.0f, (float)ctx->viewport_width, 0.0f, (float)ctx->viewport_height, -1.0f, 1.0f);
+	opengl_sprite_batch_flush(&ctx->sprites, &ctx->texture_arrays, projection);
+}
+
+static void _particles01_scene_draw(opengl_ctx_t* ctx) {
+	glClear(GL_DEPTH_BUFFER_BIT);
+	//ģʱ䣬0.1
+	float dt = (float)(ctx->time - ctx->particle_time);
+	dt = dt < 0.0f ? 0.0f : (dt > 0.1f ? 0.1f : dt);
+	ctx->particle_time = ctx->time;
+
+	opengl_particle_emitter_t emitter;
+	emitter.position = glm::vec3(0.0f, -1.0f, 0.0f);
+	emitter.velocity = glm::vec3(0.5f * sinf((float)ctx->time), 3.0f, 0.0f);
+	emitter.spread = 0.6f;
+	emitter.lifetime = PARTICLES_LIFETIME;
+	float emit = PARTICLES_CAPACITY / PARTICLES_LIFETIME * dt + ctx->particle_carry;
+	uint32_t count = (uint32_t)emit;
+	ctx->particle_carry = emit - (float)count;
+	opengl_particles_emit(&ctx->particles, &emitter, count);
+	opengl_particles_update(&ctx->particles, dt, glm::vec3(0.0f, -2.5f, 0.0f));
+
+	//projection[1][1]1/tan(fov/2)ϰӿڸ߶ȾǾΪ1ÿ絥λ
+	float point_scale = opengl_camera_projection(&ctx->camera)[1][1] * 0.5f * ctx->viewport_height * PARTICLES_SIZE;
+	opengl_particles_draw(&ctx->particles, opengl_camera_view_projection(&ctx->camera), point_scale);
+}
+
+const char* opengl_scene_name(opengl_scene_type_t type) {
+	static const char* names[TYPE_SCENE_COUNT] = {
+		"TRIANGLE_01",
+		"TRIANGLE_02",
+		"RECTANGLE_01",
+		"RECTANGLE_02",
+		"TEXTURE_01",
+		"TEXTURE_02",
+		"MATRIX_01",
+		"MATRIX_02",
+		"COORDS_01",
+		"COORDS_02",
+		"CAMERA_01",
+		"CAMERA_02",
+		"CAMERA_03",
+		"MESH_01",
+		"LOD_01",
+		"MESHLET_01",
+		"TEXTURE_ARRAY_01",
+		"TEXTURE_STREAM_01",
+		"RESOURCE_01",
+		"ECS_01",
+		"HIERARCHY_01",
+		"SPRITE_01",
+		"PARTICLES_01",
+	};
+	if (type < 0 || type >= TYPE_SCENE_COUNT) {
+		return "UNKNOWN";
+	}
+	return names[type];
+}
+
 void opengl_shader_program_create(opengl_ctx_t* ctx, opengl_scene_type_t type) {
 	if (type == TYPE_TRIANGLE_01) {
 		_triangle01_shader_program_create(ctx);
@@ -1356,6 +2345,31 @@ void opengl_shader_program_create(opengl_ctx_t* ctx, opengl_scene_type_t type) {
 	if (type == TYPE_CAMERA_02) {
 		_camera02_shader_program_create(ctx);
 	}
+	if (type == TYPE_MESH_01) {
+		_mesh01_shader_program_create(ctx);
+	}
+	if (type == TYPE_LOD_01) {
+		_lod01_shader_program_create(ctx);
+	}
+	if (type == TYPE_MESHLET_01) {
+		_meshlet01_shader_program_create(ctx);
+	}
+	if (type == TYPE_TEXTURE_ARRAY_01) {
+		_texture_array01_shader_program_create(ctx);
+	}
+	if (type == TYPE_TEXTURE_STREAM_01) {
+		_texture_stream01_shader_program_create(ctx);
+	}
+	if (type == TYPE_RESOURCE_01) {
+		_resource01_shader_program_create(ctx);
+	}
+	if (type == TYPE_ECS_01) {
+		_lod01_shader_program_create(ctx);
+	}
+	if (type == TYPE_HIERARCHY_01) {
+		_lod01_shader_program_create(ctx);
+	}
+	//TYPE_SPRITE_01þԼĳTYPE_PARTICLES_01ĳϵͳ
 }
 
 void opengl_shader_program_use(opengl_ctx_t* ctx) {
@@ -1403,6 +2417,36 @@ void opengl_scene_create(opengl_ctx_t* ctx, opengl_scene_type_t type) {
 	if (type == TYPE_CAMERA_02) {
 		_camera02_scene_create(ctx);
 	}
+	if (type == TYPE_MESH_01) {
+		_mesh01_scene_create(ctx);
+	}
+	if (type == TYPE_LOD_01) {
+		_lod01_scene_create(ctx);
+	}
+	if (type == TYPE_MESHLET_01) {
+		_meshlet01_scene_create(ctx);
+	}
+	if (type == TYPE_TEXTURE_ARRAY_01) {
+		_texture_array01_scene_create(ctx);
+	}
+	if (type == TYPE_TEXTURE_STREAM_01) {
+		_texture_stream01_scene_create(ctx);
+	}
+	if (type == TYPE_RESOURCE_01) {
+		_resource01_scene_create(ctx);
+	}
+	if (type == TYPE_ECS_01) {
+		_ecs01_scene_create(ctx);
+	}
+	if (type == TYPE_HIERARCHY_01) {
+		_hierarchy01_scene_create(ctx);
+	}
+	if (type == TYPE_SPRITE_01) {
+		_sprite01_scene_create(ctx);
+	}
+	if (type == TYPE_PARTICLES_01) {
+		_particles01_scene_create(ctx);
+	}
 }
 
 void opengl_scene_draw(opengl_ctx_t* ctx, opengl_scene_type_t type) {
@@ -1445,6 +2489,36 @@ void opengl_scene_draw(opengl_ctx_t* ctx, opengl_scene_type_t type) {
 	if (type == TYPE_CAMERA_02) {
 		_camera02_scene_draw(ctx);
 	}
+	if (type == TYPE_MESH_01) {
+		_mesh01_scene_draw(ctx);
+	}
+	if (type == TYPE_LOD_01) {
+		_lod01_scene_draw(ctx);
+	}
+	if (type == TYPE_MESHLET_01) {
+		_meshlet01_scene_draw(ctx);
+	}
+	if (type == TYPE_TEXTURE_ARRAY_01) {
+		_texture_array01_scene_draw(ctx);
+	}
+	if (type == TYPE_TEXTURE_STREAM_01) {
+		_texture_stream01_scene_draw(ctx);
+	}
+	if (type == TYPE_RESOURCE_01) {
+		_resource01_scene_draw(ctx);
+	}
+	if (type == TYPE_ECS_01) {
+		_ecs01_scene_draw(ctx);
+	}
+	if (type == TYPE_HIERARCHY_01) {
+		_hierarchy01_scene_draw(ctx);
+	}
+	if (type == TYPE_SPRITE_01) {
+		_sprite01_scene_draw(ctx);
+	}
+	if (type == TYPE_PARTICLES_01) {
+		_particles01_scene_draw(ctx);
+	}
 }
 
 void opengl_scene_destroy(opengl_ctx_t* ctx) {
@@ -1452,102 +2526,17 @@ void opengl_scene_destroy(opengl_ctx_t* ctx) {
 	glDeleteBuffers(1, &ctx->vbo);
 	glDeleteBuffers(1, &ctx->ebo);
 	glDeleteTextures(sizeof(ctx->textures) / sizeof(ctx->textures[0]), ctx->textures);
-}
-
-glm::mat4 mylookAt(glm::vec3 position, glm::vec3 target, glm::vec3 worldUp) {
-	glm::vec3 front = glm::normalize(target - position);
-	glm::vec3 right = glm::normalize(glm::cross(front, worldUp));
-	glm::vec3 up = glm::normalize(glm::cross(right, front));
-
-	glm::mat4 translation = glm::mat4(1.0f);
-	translation[3][0] = -position.x;
-	translation[3][1] = -position.y;
-	translation[3][2] = -position.z;
-
-	glm::mat4 rotation = glm::mat4(1.0f);
-	// glm У֣ mat[col][row] ʽԪ
-	rotation[0][0] = right.x;
-	rotation[1][0] = right.y;
-	rotation[2][0] = right.z;
-	rotation[0][1] = up.x;
-	rotation[1][1] = up.y;
-	rotation[2][1] = up.z;
-	rotation[0][2] = -front.x;
-	rotation[1][2] = -front.y;
-	rotation[2][2] = -front.z;
-
-	return rotation * translation;//ĶƽƣȻת
-}
-
-static void _camera_setup(opengl_camera_t* camera) {
-	glm::vec3 front;
-	front.x = cos(glm::radians(camera->yaw)) * cos(glm::radians(camera->pitch));
-	front.y = sin(glm::radians(camera->pitch));
-	front.z = sin(glm::radians(camera->yaw)) * cos(glm::radians(camera->pitch));
-	
-	camera->front = glm::normalize(front);
-	camera->right = glm::normalize(glm::cross(camera->front, camera->world_up));
-	camera->up = glm::normalize(glm::cross(camera->right, camera->front));
-
-	camera->view = glm::mat4(1.0f);
-	//camera->upҲcamera->world_upֻѾcamera->up
-	//camera->view = glm::lookAt(camera->pos, camera->pos + camera->front, camera->up);
-	camera->view = mylookAt(camera->pos, camera->pos + camera->front, camera->world_up);
-
-	camera->projection = glm::mat4(1.0f);
-	camera->projection = glm::perspective(glm::radians(camera->zoom), camera->aspect, 0.1f, 100.0f);
-}
-
-void opengl_camera_init(opengl_camera_t* camera, glm::vec3 pos, float pitch, float yaw, float aspect) {
-	camera->pos = pos;
-	camera->world_up = glm::vec3(0.0f, 1.0f, 0.0f);
-	camera->yaw = yaw;
-	camera->pitch = pitch;
-	camera->sensitivity = 0.1f;
-	camera->zoom = 45.0f;
-	camera->aspect = aspect;
-
-	_camera_setup(camera);
-}
-
-void opengl_camera_move(opengl_camera_t* camera, opengl_camera_movement_t movement) {
-	float speed = 0.1f;
-
-	if (movement == FORWARD) {
-		camera->pos += speed * camera->front;
-	}
-	if (movement == BACKWARD) {
-		camera->pos -= speed * camera->front;
-	}
-	if (movement == LEFT) {
-		camera->pos -= speed * camera->right;
-	}
-	if (movement == RIGHT) {
-		camera->pos += speed * camera->right;
-	}
-	_camera_setup(camera);
-}
-
-void opengl_camera_zoom(opengl_camera_t* camera, float zoom_offset) {
-	camera->zoom -= (float)zoom_offset;
-	if (camera->zoom < 1.0f)
-		camera->zoom = 1.0f;
-	if (camera->zoom > 45.0f)
-		camera->zoom = 45.0f;
-	_camera_setup(camera);
-}
-
-void opengl_camera_rotate(opengl_camera_t* camera, float yaw_offset, float pitch_offset) {
-	yaw_offset *= camera->sensitivity;
-	pitch_offset *= camera->sensitivity;
-
-	camera->yaw += yaw_offset;
-	camera->pitch += pitch_offset;
-
-	if (camera->pitch > 89.0f)
-		camera->pitch = 89.0f;
-	if (camera->pitch < -89.0f)
-		camera->pitch = -89.0f;
-
-	_camera_setup(camera);
+	opengl_mesh_destroy(&ctx->mesh);
+	opengl_lod_chain_destroy(&ctx->lod_chain);
+	opengl_instance_set_destroy(&ctx->instances);
+	glDeleteBuffers(1, &ctx->instance_vbo);
+	opengl_meshlet_cull_destroy(&ctx->meshlet_cull);
+	opengl_texture_arrays_destroy(&ctx->texture_arrays);
+	opengl_texture_residency_destroy(&ctx->residency);
+	opengl_texture_stream_destroy(&ctx->texture_stream);
+	opengl_resources_destroy(&ctx->resources);
+	ecs_world_destroy(&ctx->world);
+	scene_graph_destroy(&ctx->scene_graph);
+	opengl_sprite_batch_destroy(&ctx->sprites);
+	opengl_particles_destroy(&ctx->particles);
 }
\ No newline at end of file
@@ -3,28 +3,23 @@ _Pragma("once")
 #include <glm.hpp>
 #include <gtc/matrix_transform.hpp>
 #include <gtc/type_ptr.hpp>
-
-typedef enum opengl_camera_movement_e {
-	FORWARD,
-	BACKWARD,
-	LEFT,
-	RIGHT
-}opengl_camera_movement_t;
-
-typedef struct opengl_camera_s {
-	glm::vec3 pos;
-	glm::vec3 front;
-	glm::vec3 up;
-	glm::vec3 right;
-	glm::vec3 world_up;
-	glm::mat4 view;
-	glm::mat4 projection;
-	float yaw;
-	float pitch;
-	float sensitivity;
-	float zoom;
-	float aspect;
-}opengl_camera_t;
+#include "opengl-camera.h"
+#include "opengl-mesh.h"
+#include "opengl-lod.h"
+#include "opengl-culling.h"
+#include "opengl-meshlet.h"
+#include "opengl-texture-array.h"
+#include "opengl-texture.h"
+#include "opengl-texture-residency.h"
+#include "opengl-texture-stream.h"
+#include "job-pool.h"
+#include "frame-arena.h"
+#include "opengl-resource.h"
+#include "ecs.h"
+#include "ecs-render.h"
+#include "scene-graph.h"
+#include "opengl-sprite.h"
+#include "opengl-particles.h"
 
 typedef struct opengl_ctx_s {
 	unsigned int vao;
@@ -35,6 +30,32 @@ typedef struct opengl_ctx_s {
 	unsigned int viewport_width;
 	unsigned int viewport_height;
 	opengl_camera_t camera;
+	double time;		//ֵģʱ䣬glfwGetTime
+	opengl_mesh_t mesh;
+	opengl_lod_chain_t lod_chain;
+	opengl_instance_set_t instances;
+	unsigned int instance_vbo;
+	opengl_meshlet_cull_t meshlet_cull;
+	opengl_texture_arrays_t texture_arrays;
+	job_pool_t jobs;
+	frame_arena_t frame_arena;	//ÿ֡ʱݣȾ߳ÿ֡ʼʱл
+	opengl_texture_residency_t residency;
+	uint32_t resident_textures[16];	//פеıţGL
+	opengl_texture_stream_t texture_stream;
+	uint32_t streamed_textures[16];
+	opengl_resources_t resources;	//GLԴһӵ
+	opengl_mesh_handle_t resource_meshes[16];
+	opengl_texture_handle_t resource_textures[16];
+	opengl_render_target_handle_t render_target;
+	uint32_t resource_epoch;		//һ滻ʱ
+	ecs_world_t world;				//尴ԭʹţ޳ʵ鲢
+	ecs_render_components_t ecs_components;
+	scene_graph_t scene_graph;
+	opengl_sprite_batch_t sprites;	//ά飬Դɫ
+	opengl_texture_layer_t sprite_textures[4];
+	opengl_particles_t particles;
+	double particle_time;			//һģ⵽ʱ
+	float particle_carry;			//һķһ֡
 }opengl_ctx_t;
 
 typedef enum opengl_scene_type_e {
@@ -51,8 +72,22 @@ typedef enum opengl_scene_type_e {
 	TYPE_CAMERA_01,
 	TYPE_CAMERA_02,
 	TYPE_CAMERA_03,
+	TYPE_MESH_01,
+	TYPE_LOD_01,
+	TYPE_MESHLET_01,
+	TYPE_TEXTURE_ARRAY_01,
+	TYPE_TEXTURE_STREAM_01,
+	TYPE_RESOURCE_01,
+	TYPE_ECS_01,
+	TYPE_HIERARCHY_01,
+	TYPE_SPRITE_01,
+	TYPE_PARTICLES_01,
+	TYPE_SCENE_COUNT,	//³ǰ
 }opengl_scene_type_t;
 
+//öȥTYPE_ǰ׺׼Եͻ߰ƥ
+extern const char* opengl_scene_name(opengl_scene_type_t type);
+
 extern void opengl_shader_program_create(opengl_ctx_t* ctx, opengl_scene_type_t type);
 extern void opengl_shader_program_use(opengl_ctx_t* ctx);
 extern void opengl_shader_program_destroy(opengl_ctx_t* ctx);
@@ -60,8 +95,3 @@ extern void opengl_shader_program_destroy(opengl_ctx_t* ctx);
 extern void opengl_scene_create(opengl_ctx_t* ctx, opengl_scene_type_t type);
 extern void opengl_scene_draw(opengl_ctx_t* ctx, opengl_scene_type_t type);
 extern void opengl_scene_destroy(opengl_ctx_t* ctx);
-
-extern void opengl_camera_init(opengl_camera_t* camera, glm::vec3 pos, float pitch, float yaw, float aspect);
-extern void opengl_camera_move(opengl_camera_t* camera, opengl_camera_movement_t movement);
-extern void opengl_camera_zoom(opengl_camera_t* camera, float zoom_offset);
-extern void opengl_camera_rotate(opengl_camera_t* camera, float yaw_offset, float pitch_offset);
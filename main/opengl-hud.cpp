@@ -0,0 +1,367 @@
+#include <glad/glad.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include "opengl-hud.h"
+
+#define _CELL_WIDTH		6		//5x7μұߺ±߸һصļ
+#define _CELL_HEIGHT	8
+#define _ATLAS_COLUMNS	16
+#define _ATLAS_ROWS		6
+#define _LINE_COUNT		5
+#define _GRAPH_HEIGHT	64
+#define _GRAPH_BAR		2		//ÿؿ
+#define _GRAPH_MAX_MS	(1000.0f / 30.0f)	//ߵĶˣĽض
+#define _PADDING		6
+
+//ASCII 32-126ÿ7Уÿе5λ
+static const uint8_t _font[95][7] = {
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },	//' '
+	{ 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 },	//'!'
+	{ 0x0a, 0x0a, 0x0a, 0x00, 0x00, 0x00, 0x00 },	//'"'
+	{ 0x0a, 0x0a, 0x1f, 0x0a, 0x1f, 0x0a, 0x0a },	//'#'
+	{ 0x04, 0x0f, 0x14, 0x0e, 0x05, 0x1e, 0x04 },	//'$'
+	{ 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 },	//'%'
+	{ 0x0c, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0d },	//'&'
+	{ 0x04, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00 },	//'''
+	{ 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 },	//'('
+	{ 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 },	//')'
+	{ 0x00, 0x04, 0x15, 0x0e, 0x15, 0x04, 0x00 },	//'*'
+	{ 0x00, 0x04, 0x04, 0x1f, 0x04, 0x04, 0x00 },	//'+'
+	{ 0x00, 0x00, 0x00, 0x00, 0x0c, 0x04, 0x08 },	//','
+	{ 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00 },	//'-'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x0c },	//'.'
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 },	//'/'
+	{ 0x0e, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0e },	//'0'
+	{ 0x04, 0x0c, 0x04, 0x04, 0x04, 0x04, 0x0e },	//'1'
+	{ 0x0e, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1f },	//'2'
+	{ 0x1f, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0e },	//'3'
+	{ 0x02, 0x06, 0x0a, 0x12, 0x1f, 0x02, 0x02 },	//'4'
+	{ 0x1f, 0x10, 0x1e, 0x01, 0x01, 0x11, 0x0e },	//'5'
+	{ 0x06, 0x08, 0x10, 0x1e, 0x11, 0x11, 0x0e },	//'6'
+	{ 0x1f, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 },	//'7'
+	{ 0x0e, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x0e },	//'8'
+	{ 0x0e, 0x11, 0x11, 0x0f, 0x01, 0x02, 0x0c },	//'9'
+	{ 0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x0c, 0x00 },	//':'
+	{ 0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x04, 0x08 },	//';'
+	{ 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 },	//'<'
+	{ 0x00, 0x00, 0x1f, 0x00, 0x1f, 0x00, 0x00 },	//'='
+	{ 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 },	//'>'
+	{ 0x0e, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 },	//'?'
+	{ 0x0e, 0x11, 0x01, 0x0d, 0x15, 0x15, 0x0e },	//'@'
+	{ 0x0e, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11 },	//'A'
+	{ 0x1e, 0x11, 0x11, 0x1e, 0x11, 0x11, 0x1e },	//'B'
+	{ 0x0e, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0e },	//'C'
+	{ 0x1c, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1c },	//'D'
+	{ 0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x1f },	//'E'
+	{ 0x1f, 0x10, 0x10, 0x1e, 0x10, 0x10, 0x10 },	//'F'
+	{ 0x0e, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0f },	//'G'
+	{ 0x11, 0x11, 0x11, 0x1f, 0x11, 0x11, 0x11 },	//'H'
+	{ 0x0e, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e },	//'I'
+	{ 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0c },	//'J'
+	{ 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 },	//'K'
+	{ 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1f },	//'L'
+	{ 0x11, 0x1b, 0x15, 0x15, 0x11, 0x11, 0x11 },	//'M'
+	{ 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 },	//'N'
+	{ 0x0e, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e },	//'O'
+	{ 0x1e, 0x11, 0x11, 0x1e, 0x10, 0x10, 0x10 },	//'P'
+	{ 0x0e, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0d },	//'Q'
+	{ 0x1e, 0x11, 0x11, 0x1e, 0x14, 0x12, 0x11 },	//'R'
+	{ 0x0f, 0x10, 0x10, 0x0e, 0x01, 0x01, 0x1e },	//'S'
+	{ 0x1f, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 },	//'T'
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e },	//'U'
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x0a, 0x04 },	//'V'
+	{ 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0a },	//'W'
+	{ 0x11, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x11 },	//'X'
+	{ 0x11, 0x11, 0x0a, 0x04, 0x04, 0x04, 0x04 },	//'Y'
+	{ 0x1f, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1f },	//'Z'
+	{ 0x0e, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0e },	//'['
+	{ 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 },	//'\\'
+	{ 0x0e, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0e },	//']'
+	{ 0x04, 0x0a, 0x11, 0x00, 0x00, 0x00, 0x00 },	//'^'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f },	//'_'
+	{ 0x08, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00 },	//'`'
+	{ 0x00, 0x00, 0x0e, 0x01, 0x0f, 0x11, 0x0f },	//'a'
+	{ 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1e },	//'b'
+	{ 0x00, 0x00, 0x0e, 0x10, 0x10, 0x11, 0x0e },	//'c'
+	{ 0x01, 0x01, 0x0d, 0x13, 0x11, 0x11, 0x0f },	//'d'
+	{ 0x00, 0x00, 0x0e, 0x11, 0x1f, 0x10, 0x0e },	//'e'
+	{ 0x06, 0x09, 0x08, 0x1c, 0x08, 0x08, 0x08 },	//'f'
+	{ 0x00, 0x0f, 0x11, 0x11, 0x0f, 0x01, 0x0e },	//'g'
+	{ 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11 },	//'h'
+	{ 0x04, 0x00, 0x0c, 0x04, 0x04, 0x04, 0x0e },	//'i'
+	{ 0x02, 0x00, 0x06, 0x02, 0x02, 0x12, 0x0c },	//'j'
+	{ 0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12 },	//'k'
+	{ 0x0c, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0e },	//'l'
+	{ 0x00, 0x00, 0x1a, 0x15, 0x15, 0x11, 0x11 },	//'m'
+	{ 0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11 },	//'n'
+	{ 0x00, 0x00, 0x0e, 0x11, 0x11, 0x11, 0x0e },	//'o'
+	{ 0x00, 0x00, 0x1e, 0x11, 0x1e, 0x10, 0x10 },	//'p'
+	{ 0x00, 0x00, 0x0d, 0x13, 0x0f, 0x01, 0x01 },	//'q'
+	{ 0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10 },	//'r'
+	{ 0x00, 0x00, 0x0e, 0x10, 0x0e, 0x01, 0x1e },	//'s'
+	{ 0x08, 0x08, 0x1c, 0x08, 0x08, 0x09, 0x06 },	//'t'
+	{ 0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0d },	//'u'
+	{ 0x00, 0x00, 0x11, 0x11, 0x11, 0x0a, 0x04 },	//'v'
+	{ 0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0a },	//'w'
+	{ 0x00, 0x00, 0x11, 0x0a, 0x04, 0x0a, 0x11 },	//'x'
+	{ 0x00, 0x00, 0x11, 0x11, 0x0f, 0x01, 0x0e },	//'y'
+	{ 0x00, 0x00, 0x1f, 0x02, 0x04, 0x08, 0x1f },	//'z'
+	{ 0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02 },	//'{'
+	{ 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 },	//'|'
+	{ 0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08 },	//'}'
+	{ 0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00 },	//'~'
+};
+
+static const char* _vertex_shader_source = "#version 330 core\n"
+	"layout (location = 0) in vec4 aRect;\n"
+	"layout (location = 1) in float aGlyph;\n"
+	"layout (location = 2) in vec4 aColor;\n"
+	"uniform vec2 uViewport;\n"
+	"out vec2 vLocal;\n"
+	"flat out vec2 vCell;\n"
+	"out vec4 vColor;\n"
+	"void main()\n"
+	"{\n"
+	"	vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);\n"
+	"	vec2 pos = aRect.xy + corner * aRect.zw;\n"
+	"	gl_Position = vec4(pos.x / uViewport.x * 2.0 - 1.0, 1.0 - pos.y / uViewport.y * 2.0, 0.0, 1.0);\n"
+	"	int glyph = int(aGlyph);\n"
+	"	vCell = vec2(glyph % 16, glyph / 16) * vec2(6.0, 8.0);\n"
+	"	vLocal = corner * vec2(6.0, 8.0);\n"
+	"	vColor = aColor;\n"
+	"}\n";
+
+//ڵλȡͼŴ춼ɵڵĸ
+static const char* _frag_shader_source = "#version 330 core\n"
+	"out vec4 FragColor;\n"
+	"in vec2 vLocal;\n"
+	"flat in vec2 vCell;\n"
+	"in vec4 vColor;\n"
+	"uniform sampler2D uAtlas;\n"
+	"void main()\n"
+	"{\n"
+	"	ivec2 texel = ivec2(vCell + min(floor(vLocal), vec2(5.0, 7.0)));\n"
+	"	FragColor = vec4(vColor.rgb, vColor.a * texelFetch(uAtlas, texel, 0).r);\n"
+	"}\n";
+
+static unsigned int _compile(GLenum type, const char* source) {
+	int success;
+	char info[512];
+	unsigned int shader = glCreateShader(type);
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success) {
+		glGetShaderInfoLog(shader, sizeof(info), NULL, info);
+		printf("ERROR::HUD::SHADER_COMPILATION_FAILED: %s\n", info);
+	}
+	return shader;
+}
+
+static void _bake_atlas(unsigned char* pixels) {
+	const int width = _ATLAS_COLUMNS * _CELL_WIDTH;
+	memset(pixels, 0, width * _ATLAS_ROWS * _CELL_HEIGHT);
+	for (int glyph = 0; glyph < 95; glyph++) {
+		int x0 = (glyph % _ATLAS_COLUMNS) * _CELL_WIDTH;
+		int y0 = (glyph / _ATLAS_COLUMNS) * _CELL_HEIGHT;
+		for (int y = 0; y < 7; y++) {
+			for (int x = 0; x < 5; x++) {
+				if (_font[glyph][y] & (0x10 >> x)) {
+					pixels[(y0 + y) * width + x0 + x] = 255;
+				}
+			}
+		}
+	}
+	int x0 = (OPENGL_HUD_SOLID % _ATLAS_COLUMNS) * _CELL_WIDTH;
+	int y0 = (OPENGL_HUD_SOLID / _ATLAS_COLUMNS) * _CELL_HEIGHT;
+	for (int y = 0; y < _CELL_HEIGHT; y++) {
+		memset(&pixels[(y0 + y) * width + x0], 255, _CELL_WIDTH);
+	}
+}
+
+void opengl_hud_init(opengl_hud_t* hud) {
+	memset(hud, 0, sizeof(*hud));
+	hud->quads = (opengl_hud_quad_t*)malloc(OPENGL_HUD_MAX_QUADS * sizeof(opengl_hud_quad_t));
+
+	unsigned int vertex_shader = _compile(GL_VERTEX_SHADER, _vertex_shader_source);
+	unsigned int frag_shader = _compile(GL_FRAGMENT_SHADER, _frag_shader_source);
+	hud->program = glCreateProgram();
+	glAttachShader(hud->program, vertex_shader);
+	glAttachShader(hud->program, frag_shader);
+	glLinkProgram(hud->program);
+	int success;
+	glGetProgramiv(hud->program, GL_LINK_STATUS, &success);
+	if (!success) {
+		char info[512];
+		glGetProgramInfoLog(hud->program, sizeof(info), NULL, info);
+		printf("ERROR::HUD::LINK_FAILED: %s\n", info);
+	}
+	glDeleteShader(vertex_shader);
+	glDeleteShader(frag_shader);
+	hud->viewport_location = glGetUniformLocation(hud->program, "uViewport");
+
+	GLint current;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+	glUseProgram(hud->program);
+	glUniform1i(glGetUniformLocation(hud->program, "uAtlas"), OPENGL_HUD_TEXTURE_UNIT);
+	glUseProgram(current);
+
+	unsigned char pixels[_ATLAS_COLUMNS * _CELL_WIDTH * _ATLAS_ROWS * _CELL_HEIGHT];
+	_bake_atlas(pixels);
+	glGenTextures(1, &hud->atlas);
+	glBindTexture(GL_TEXTURE_2D, hud->atlas);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, _ATLAS_COLUMNS * _CELL_WIDTH, _ATLAS_ROWS * _CELL_HEIGHT, 0, GL_RED, GL_UNSIGNED_BYTE, pixels);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);//ѡֹ޸
+
+	//ĸgl_VertexIDɣȫʵ
+	glGenVertexArrays(1, &hud->vao);
+	glGenBuffers(1, &hud->vbo);
+	glBindVertexArray(hud->vao);
+	glBindBuffer(GL_ARRAY_BUFFER, hud->vbo);
+	glBufferData(GL_ARRAY_BUFFER, OPENGL_HUD_MAX_QUADS * sizeof(opengl_hud_quad_t), NULL, GL_STREAM_DRAW);
+	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(opengl_hud_quad_t), (void*)offsetof(opengl_hud_quad_t, rect));
+	glEnableVertexAttribArray(0);
+	glVertexAttribDivisor(0, 1);
+	glVertexAttribPointer(1, 1, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(opengl_hud_quad_t), (void*)offsetof(opengl_hud_quad_t, glyph));
+	glEnableVertexAttribArray(1);
+	glVertexAttribDivisor(1, 1);
+	glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(opengl_hud_quad_t), (void*)offsetof(opengl_hud_quad_t, color));
+	glEnableVertexAttribArray(2);
+	glVertexAttribDivisor(2, 1);
+	glBindVertexArray(0);//ѡֹ޸
+	glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+}
+
+void opengl_hud_destroy(opengl_hud_t* hud) {
+	glDeleteProgram(hud->program);
+	glDeleteVertexArrays(1, &hud->vao);
+	glDeleteBuffers(1, &hud->vbo);
+	glDeleteTextures(1, &hud->atlas);
+	free(hud->quads);
+	memset(hud, 0, sizeof(*hud));
+}
+
+static void _quad(opengl_hud_t* hud, float x, float y, float w, float h, uint16_t glyph, uint32_t color) {
+	if (hud->quad_count >= OPENGL_HUD_MAX_QUADS) {
+		return;
+	}
+	opengl_hud_quad_t* q = &hud->quads[hud->quad_count++];
+	q->rect[0] = x;
+	q->rect[1] = y;
+	q->rect[2] = w;
+	q->rect[3] = h;
+	q->glyph = glyph;
+	q->padding = 0;
+	q->color = color;
+}
+
+//ոֻǰʵ
+static void _text(opengl_hud_t* hud, float x, float y, const char* text, uint32_t color) {
+	const float w = _CELL_WIDTH * OPENGL_HUD_SCALE;
+	const float h = _CELL_HEIGHT * OPENGL_HUD_SCALE;
+	for (const char* c = text; *c; c++, x += w) {
+		if (*c > ' ' && *c < 127) {
+			_quad(hud, x, y, w, h, (uint16_t)(*c - ' '), color);
+		}
+	}
+}
+
+static uint32_t _bar_color(float ms) {
+	if (ms <= 1000.0f / 60.0f) {
+		return OPENGL_HUD_RGBA(80, 220, 80, 230);
+	}
+	if (ms <= 1000.0f / 30.0f) {
+		return OPENGL_HUD_RGBA(240, 200, 60, 230);
+	}
+	return OPENGL_HUD_RGBA(240, 70, 60, 230);
+}
+
+void opengl_hud_draw(opengl_hud_t* hud, const opengl_hud_stats_t* stats, unsigned int width, unsigned int height) {
+	auto begin = std::chrono::steady_clock::now();
+
+	hud->history[hud->history_index] = (float)stats->frame_ms;
+	hud->history_index = (hud->history_index + 1) % OPENGL_HUD_HISTORY;
+	if (hud->history_count < OPENGL_HUD_HISTORY) {
+		hud->history_count++;
+	}
+	if (width == 0 || height == 0) {
+		return;
+	}
+	float sum = 0.0f;
+	float max = 0.0f;
+	for (uint32_t i = 0; i < hud->history_count; i++) {
+		sum += hud->history[i];
+		max = hud->history[i] > max ? hud->history[i] : max;
+	}
+	float avg = sum / hud->history_count;
+
+	char lines[_LINE_COUNT][64];
+	snprintf(lines[0], sizeof(lines[0]), "%.1f fps %.2f ms", avg > 0.0f ? 1000.0f / avg : 0.0f, stats->frame_ms);
+	snprintf(lines[1], sizeof(lines[1]), "avg %.2f max %.2f ms", avg, max);
+	snprintf(lines[2], sizeof(lines[2]), "draws %llu allocs %llu", (unsigned long long)stats->draw_calls, (unsigned long long)stats->heap_allocs);
+	if (stats->resident_mb > 0.0) {
+		snprintf(lines[3], sizeof(lines[3]), "arena %.1f KB rss %.1f MB", stats->arena_bytes / 1024.0, stats->resident_mb);
+	} else {
+		snprintf(lines[3], sizeof(lines[3]), "arena %.1f KB", stats->arena_bytes / 1024.0);
+	}
+	snprintf(lines[4], sizeof(lines[4]), "hud %.3f ms", hud->cpu_ms);
+
+	//οߡ׷ӣһλĸסǰ
+	const float line_height = (_CELL_HEIGHT + 1) * OPENGL_HUD_SCALE;
+	const float graph_width = OPENGL_HUD_HISTORY * _GRAPH_BAR;
+	float panel_width = graph_width;
+	for (int i = 0; i < _LINE_COUNT; i++) {
+		float w = strlen(lines[i]) * _CELL_WIDTH * OPENGL_HUD_SCALE;
+		panel_width = w > panel_width ? w : panel_width;
+	}
+	const float x0 = _PADDING;
+	const float y0 = _PADDING;
+	const float graph_y = y0 + _PADDING + _LINE_COUNT * line_height;
+	hud->quad_count = 0;
+	_quad(hud, x0, y0, panel_width + 2 * _PADDING, graph_y + _GRAPH_HEIGHT + _PADDING - y0, OPENGL_HUD_SOLID, OPENGL_HUD_RGBA(0, 0, 0, 160));
+
+	const float gx = x0 + _PADDING;
+	const float scale = _GRAPH_HEIGHT / _GRAPH_MAX_MS;
+	_quad(hud, gx, graph_y + _GRAPH_HEIGHT - 1000.0f / 60.0f * scale, graph_width, 1, OPENGL_HUD_SOLID, OPENGL_HUD_RGBA(255, 255, 255, 90));
+	for (uint32_t i = 0; i < hud->history_count; i++) {
+		float ms = hud->history[(hud->history_index + OPENGL_HUD_HISTORY - hud->history_count + i) % OPENGL_HUD_HISTORY];
+		float h = (ms < _GRAPH_MAX_MS ? ms : _GRAPH_MAX_MS) * scale;
+		float x = gx + (OPENGL_HUD_HISTORY - hud->history_count + i) * _GRAPH_BAR;
+		_quad(hud, x, graph_y + _GRAPH_HEIGHT - h, _GRAPH_BAR, h, OPENGL_HUD_SOLID, _bar_color(ms));
+	}
+	for (int i = 0; i < _LINE_COUNT; i++) {
+		_text(hud, gx, y0 + _PADDING + i * line_height, lines[i], OPENGL_HUD_RGBA(255, 255, 255, 255));
+	}
+
+	//ÿ֡鶪дõһ֡Ļƶ
+	GLint current;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+	glUseProgram(hud->program);
+	glUniform2f(hud->viewport_location, (float)width, (float)height);
+	glBindBuffer(GL_ARRAY_BUFFER, hud->vbo);
+	glBufferData(GL_ARRAY_BUFFER, OPENGL_HUD_MAX_QUADS * sizeof(opengl_hud_quad_t), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, hud->quad_count * sizeof(opengl_hud_quad_t), hud->quads);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+	glActiveTexture(GL_TEXTURE0 + OPENGL_HUD_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_2D, hud->atlas);
+	glActiveTexture(GL_TEXTURE0);
+
+	glDisable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glBindVertexArray(hud->vao);
+	glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, hud->quad_count);
+	glBindVertexArray(0);//ѡֹ޸
+	glDisable(GL_BLEND);
+	glUseProgram(current);
+
+	double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+	hud->cpu_ms = hud->cpu_ms > 0.0 ? hud->cpu_ms * 0.95 + elapsed * 0.05 : elapsed;
+}
@@ -0,0 +1,49 @@
+_Pragma("once")
+
+#include <cstddef>
+#include <cstdint>
+
+#define OPENGL_HUD_HISTORY		120		//֡ʱߵĲһ֡һ
+#define OPENGL_HUD_MAX_QUADS	1024	//֡ߺͱϼƵʵޣĲ
+#define OPENGL_HUD_SCALE		2		//ηŴı
+#define OPENGL_HUD_TEXTURE_UNIT	15		//һԪӰ쳡󶨵
+#define OPENGL_HUD_SOLID		95		//ͼһʵĵ
+#define OPENGL_HUD_RGBA(r, g, b, a)	((uint32_t)(r) | ((uint32_t)(g) << 8) | ((uint32_t)(b) << 16) | ((uint32_t)(a) << 24))
+
+//һʵĻϵһΣɫgl_VertexIDչĸ
+typedef struct opengl_hud_quad_s {
+	float rect[4];			//꣬ԭϽǣx, y, w, h
+	uint16_t glyph;			//ͼĸӣַȥ32OPENGL_HUD_SOLIDʵĿ飬
+	uint16_t padding;
+	uint32_t color;			//OPENGL_HUD_RGBA
+}opengl_hud_quad_t;
+
+//÷ÿ֡ռݣHUDֻʾ
+typedef struct opengl_hud_stats_s {
+	double frame_ms;		//һ֡ʼһ֡ʼ
+	uint64_t draw_calls;	//һ֡ĻƵãHUDԼ
+	uint64_t heap_allocs;	//һ֡߳﹤̴Ķѷ
+	size_t arena_bytes;		//֡һ֡õֽ
+	double resident_mb;		//̵ĳפڴ棬0ʾʾ
+}opengl_hud_stats_t;
+
+//5x7決ɵͼֺÿ֡һʵ
+typedef struct opengl_hud_s {
+	unsigned int program;
+	unsigned int vao;
+	unsigned int vbo;
+	unsigned int atlas;
+	int viewport_location;
+	opengl_hud_quad_t* quads;
+	uint32_t quad_count;
+	float history[OPENGL_HUD_HISTORY];	//λ壬λ
+	uint32_t history_index;
+	uint32_t history_count;
+	double cpu_ms;			//HUDԼÿ֡CPUʱ䣬ƽ֮ʾ
+}opengl_hud_t;
+
+extern void opengl_hud_init(opengl_hud_t* hud);
+extern void opengl_hud_destroy(opengl_hud_t* hud);
+//¼һ֡ݲϽǣڳꡢ֮ǰ
+//ıVAOͻ״̬ʱָǰĳÿ֡
+extern void opengl_hud_draw(opengl_hud_t* hud, const opengl_hud_stats_t* stats, unsigned int width, unsigned int height);
@@ -0,0 +1,297 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <gtc/type_ptr.hpp>
+#include "opengl-lod.h"
+
+//Գ4x4ֻǣa00 a01 a02 a03 a11 a12 a13 a22 a23 a33
+typedef struct _quadric_s {
+	double a[10];
+}_quadric_t;
+
+typedef struct _collapse_s {
+	float cost;
+	uint32_t u;		//ƳĶ
+	uint32_t v;		//Ķ
+
+	bool operator>(const _collapse_s& other) const {
+		return cost > other.cost;
+	}
+}_collapse_t;
+
+static void _quadric_add_plane(_quadric_t* q, glm::dvec3 n, double d) {
+	q->a[0] += n.x * n.x; q->a[1] += n.x * n.y; q->a[2] += n.x * n.z; q->a[3] += n.x * d;
+	q->a[4] += n.y * n.y; q->a[5] += n.y * n.z; q->a[6] += n.y * d;
+	q->a[7] += n.z * n.z; q->a[8] += n.z * d;
+	q->a[9] += d * d;
+}
+
+static void _quadric_add(_quadric_t* q, const _quadric_t* other) {
+	for (int i = 0; i < 10; i++) {
+		q->a[i] += other->a[i];
+	}
+}
+
+static double _quadric_eval(const _quadric_t* q, const _quadric_t* r, const float* p) {
+	double a[10];
+	for (int i = 0; i < 10; i++) {
+		a[i] = q->a[i] + r->a[i];
+	}
+	double x = p[0], y = p[1], z = p[2];
+	double e = a[0] * x * x + 2 * a[1] * x * y + 2 * a[2] * x * z + 2 * a[3] * x
+		+ a[4] * y * y + 2 * a[5] * y * z + 2 * a[6] * y
+		+ a[7] * z * z + 2 * a[8] * z
+		+ a[9];
+	return e > 0.0 ? e : 0.0;
+}
+
+static glm::vec3 _triangle_normal(const float* positions, uint32_t a, uint32_t b, uint32_t c) {
+	glm::vec3 pa = glm::make_vec3(&positions[a * 3]);
+	glm::vec3 pb = glm::make_vec3(&positions[b * 3]);
+	glm::vec3 pc = glm::make_vec3(&positions[c * 3]);
+	return glm::cross(pb - pa, pc - pa);
+}
+
+static uint64_t _edge_key(uint32_t a, uint32_t b) {
+	return a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+}
+
+uint32_t opengl_mesh_simplify(const opengl_mesh_t* mesh, const uint32_t* indices, uint32_t index_count,
+	uint32_t target_index_count, uint32_t* out_indices, float* out_error) {
+	const float* positions = mesh->positions;
+	uint32_t vertex_count = mesh->vertex_count;
+	uint32_t triangle_count = index_count / 3;
+
+	//1. λúϲ㣬ͬһλжԶ(uvӷ)Ϊ
+	std::vector<uint32_t> group(vertex_count);
+	std::vector<uint32_t> group_size(vertex_count, 0);
+	std::unordered_map<uint64_t, uint32_t> position_map;
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		uint32_t bits[3];
+		memcpy(bits, &positions[i * 3], sizeof(bits));
+		uint64_t key = file_hash_bytes(bits, sizeof(bits));
+		auto it = position_map.find(key);
+		if (it != position_map.end() && memcmp(&positions[it->second * 3], bits, sizeof(bits)) == 0) {
+			group[i] = it->second;
+		}
+		else {
+			group[i] = i;
+			position_map.emplace(key, i);
+		}
+		group_size[group[i]]++;
+	}
+	std::vector<uint8_t> locked(vertex_count, 0);
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		locked[i] = group_size[group[i]] > 1;
+	}
+	//2. ֻһʹõı߽磬߽綥Ҳ
+	std::unordered_map<uint64_t, uint32_t> edge_use;
+	for (uint32_t t = 0; t < triangle_count; t++) {
+		for (uint32_t k = 0; k < 3; k++) {
+			uint32_t a = group[indices[t * 3 + k]];
+			uint32_t b = group[indices[t * 3 + (k + 1) % 3]];
+			edge_use[_edge_key(a, b)]++;
+		}
+	}
+	for (uint32_t t = 0; t < triangle_count; t++) {
+		for (uint32_t k = 0; k < 3; k++) {
+			uint32_t a = indices[t * 3 + k];
+			uint32_t b = indices[t * 3 + (k + 1) % 3];
+			if (edge_use[_edge_key(group[a], group[b])] == 1) {
+				locked[a] = 1;
+				locked[b] = 1;
+			}
+		}
+	}
+	//3. ÿλۼƽĶ
+	std::vector<_quadric_t> quadrics(vertex_count);
+	memset(quadrics.data(), 0, quadrics.size() * sizeof(_quadric_t));
+	std::vector<uint32_t> tris(indices, indices + index_count);
+	std::vector<uint8_t> tri_alive(triangle_count, 1);
+	std::vector<std::vector<uint32_t>> vertex_tris(vertex_count);
+	for (uint32_t t = 0; t < triangle_count; t++) {
+		uint32_t a = tris[t * 3], b = tris[t * 3 + 1], c = tris[t * 3 + 2];
+		glm::dvec3 n = glm::dvec3(_triangle_normal(positions, a, b, c));
+		double len = glm::length(n);
+		if (len > 0.0) {
+			n /= len;
+			double d = -glm::dot(n, glm::dvec3(glm::make_vec3(&positions[a * 3])));
+			_quadric_add_plane(&quadrics[group[a]], n, d);
+			_quadric_add_plane(&quadrics[group[b]], n, d);
+			_quadric_add_plane(&quadrics[group[c]], n, d);
+		}
+		vertex_tris[a].push_back(t);
+		vertex_tris[b].push_back(t);
+		vertex_tris[c].push_back(t);
+	}
+	//4. ۵u->vֻƳδĶ㣬λúԲ䣬LODԹö㻺
+	std::priority_queue<_collapse_t, std::vector<_collapse_t>, std::greater<_collapse_t>> heap;
+	std::vector<uint8_t> vertex_alive(vertex_count, 1);
+	auto push_edges = [&](uint32_t t) {
+		for (uint32_t k = 0; k < 3; k++) {
+			uint32_t a = tris[t * 3 + k];
+			uint32_t b = tris[t * 3 + (k + 1) % 3];
+			if (!locked[a]) {
+				heap.push({ (float)_quadric_eval(&quadrics[group[a]], &quadrics[group[b]], &positions[b * 3]), a, b });
+			}
+			if (!locked[b]) {
+				heap.push({ (float)_quadric_eval(&quadrics[group[b]], &quadrics[group[a]], &positions[a * 3]), b, a });
+			}
+		}
+	};
+	for (uint32_t t = 0; t < triangle_count; t++) {
+		push_edges(t);
+	}
+	uint32_t alive_count = triangle_count;
+	float max_error = 0.0f;
+
+	while (alive_count * 3 > target_index_count && !heap.empty()) {
+		_collapse_t collapse = heap.top();
+		heap.pop();
+		uint32_t u = collapse.u;
+		uint32_t v = collapse.v;
+		if (!vertex_alive[u] || !vertex_alive[v]) {
+			continue;
+		}
+		//ǶԸµģ仯
+		float cost = (float)_quadric_eval(&quadrics[group[u]], &quadrics[group[v]], &positions[v * 3]);
+		if (cost > collapse.cost * 1.0001f + 1e-12f) {
+			heap.push({ cost, u, v });
+			continue;
+		}
+		//߱Ȼڣ۵η
+		bool connected = false;
+		bool flipped = false;
+		for (uint32_t t : vertex_tris[u]) {
+			if (!tri_alive[t]) {
+				continue;
+			}
+			uint32_t* tri = &tris[t * 3];
+			if (tri[0] == v || tri[1] == v || tri[2] == v) {
+				connected = true;
+				continue;
+			}
+			glm::vec3 before = _triangle_normal(positions, tri[0], tri[1], tri[2]);
+			uint32_t after_tri[3] = { tri[0] == u ? v : tri[0], tri[1] == u ? v : tri[1], tri[2] == u ? v : tri[2] };
+			glm::vec3 after = _triangle_normal(positions, after_tri[0], after_tri[1], after_tri[2]);
+			if (glm::dot(before, after) <= 0.0f) {
+				flipped = true;
+				break;
+			}
+		}
+		if (!connected || flipped) {
+			continue;
+		}
+		for (uint32_t t : vertex_tris[u]) {
+			if (!tri_alive[t]) {
+				continue;
+			}
+			uint32_t* tri = &tris[t * 3];
+			if (tri[0] == v || tri[1] == v || tri[2] == v) {
+				tri_alive[t] = 0;
+				alive_count--;
+				continue;
+			}
+			for (uint32_t k = 0; k < 3; k++) {
+				if (tri[k] == u) {
+					tri[k] = v;
+				}
+			}
+			vertex_tris[v].push_back(t);
+		}
+		vertex_alive[u] = 0;
+		vertex_tris[u].clear();
+		_quadric_add(&quadrics[group[v]], &quadrics[group[u]]);
+		max_error = glm::max(max_error, cost);
+
+		for (uint32_t t : vertex_tris[v]) {
+			if (tri_alive[t]) {
+				push_edges(t);
+			}
+		}
+	}
+	uint32_t out_count = 0;
+	for (uint32_t t = 0; t < triangle_count; t++) {
+		if (tri_alive[t]) {
+			memcpy(&out_indices[out_count], &tris[t * 3], 3 * sizeof(uint32_t));
+			out_count += 3;
+		}
+	}
+	if (out_error) {
+		*out_error = sqrtf(max_error);
+	}
+	return out_count;
+}
+
+bool opengl_lod_chain_generate(opengl_lod_chain_t* chain, const opengl_mesh_t* mesh, uint32_t lod_count, float reduction) {
+	memset(chain, 0, sizeof(*chain));
+	if (lod_count == 0 || lod_count > OPENGL_LOD_MAX || mesh->index_count == 0) {
+		return false;
+	}
+	//ÿһһĴСᳬlod_count
+	chain->indices = (uint32_t*)malloc((size_t)mesh->index_count * lod_count * sizeof(uint32_t));
+	memcpy(chain->indices, mesh->indices, mesh->index_count * sizeof(uint32_t));
+	chain->lods[0].index_offset = 0;
+	chain->lods[0].index_count = mesh->index_count;
+	chain->lods[0].error = 0.0f;
+	chain->lod_count = 1;
+	chain->index_count = mesh->index_count;
+
+	for (uint32_t i = 1; i < lod_count; i++) {
+		const opengl_lod_t* prev = &chain->lods[i - 1];
+		uint32_t target = (uint32_t)(prev->index_count * reduction) / 3 * 3;
+		float error = 0.0f;
+		uint32_t count = opengl_mesh_simplify(mesh, chain->indices + prev->index_offset, prev->index_count,
+			target, chain->indices + chain->index_count, &error);
+		//򻯲(󲿷ֶ㱻)ͲɸֵLOD
+		if (count == 0 || count > prev->index_count * 0.9f) {
+			break;
+		}
+		opengl_lod_t* lod = &chain->lods[i];
+		lod->index_offset = chain->index_count;
+		lod->index_count = count;
+		lod->error = glm::max(error, prev->error);
+		chain->index_count += count;
+		chain->lod_count++;
+	}
+	return true;
+}
+
+void opengl_lod_chain_destroy(opengl_lod_chain_t* chain) {
+	free(chain->indices);
+	memset(chain, 0, sizeof(*chain));
+}
+
+void opengl_lod_selector_init(opengl_lod_selector_t* selector, float fovy_degrees, unsigned int viewport_height) {
+	selector->projection_scale = (float)viewport_height / (2.0f * tanf(glm::radians(fovy_degrees) * 0.5f));
+	selector->threshold = 1.0f;
+	selector->hysteresis = 0.25f;
+}
+
+static float _lod_projected_error(const opengl_lod_t* lod, const opengl_lod_selector_t* selector, float distance, float scale) {
+	return lod->error * scale * selector->projection_scale / distance;
+}
+
+uint8_t opengl_lod_select(const opengl_lod_chain_t* chain, const opengl_lod_selector_t* selector, float distance, float scale, uint8_t current) {
+	distance = glm::max(distance, 0.1f);
+	//LODֵһ
+	uint8_t target = 0;
+	while (target + 1u < chain->lod_count
+		&& _lod_projected_error(&chain->lods[target + 1], selector, distance, scale) <= selector->threshold) {
+		target++;
+	}
+	if (target <= current) {
+		return target;
+	}
+	//ʱʹøϸֵֵ
+	float strict = selector->threshold * (1.0f - selector->hysteresis);
+	uint8_t coarse = current;
+	while (coarse < target && _lod_projected_error(&chain->lods[coarse + 1], selector, distance, scale) <= strict) {
+		coarse++;
+	}
+	return coarse;
+}
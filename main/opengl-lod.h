@@ -0,0 +1,36 @@
+_Pragma("once")
+
+#include <cstdint>
+#include "opengl-mesh.h"
+
+#define OPENGL_LOD_MAX	8
+
+typedef struct opengl_lod_s {
+	uint32_t index_offset;	//chain->indicesеʼλ
+	uint32_t index_count;
+	float error;			//ģͿռļ
+}opengl_lod_t;
+
+//LODĶ㻺壬ֻͬLOD˳ƴһ
+typedef struct opengl_lod_chain_s {
+	opengl_lod_t lods[OPENGL_LOD_MAX];
+	uint32_t lod_count;
+	uint32_t* indices;
+	uint32_t index_count;
+}opengl_lod_chain_t;
+
+typedef struct opengl_lod_selector_s {
+	float projection_scale;	//viewport_height / (2 * tan(fovy / 2))
+	float threshold;		//Ļռ()
+	float hysteresis;		//лֵLODʱthreshold * (1 - hysteresis)
+}opengl_lod_selector_t;
+
+//(QEM)ı۵򻯣ؼ򻯺
+extern uint32_t opengl_mesh_simplify(const opengl_mesh_t* mesh, const uint32_t* indices, uint32_t index_count,
+	uint32_t target_index_count, uint32_t* out_indices, float* out_error);
+
+extern bool opengl_lod_chain_generate(opengl_lod_chain_t* chain, const opengl_mesh_t* mesh, uint32_t lod_count, float reduction);
+extern void opengl_lod_chain_destroy(opengl_lod_chain_t* chain);
+
+extern void opengl_lod_selector_init(opengl_lod_selector_t* selector, float fovy_degrees, unsigned int viewport_height);
+extern uint8_t opengl_lod_select(const opengl_lod_chain_t* chain, const opengl_lod_selector_t* selector, float distance, float scale, uint8_t current);
@@ -0,0 +1,471 @@
+#include <glad/glad.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cfloat>
+#include <unordered_map>
+#include <gtc/type_ptr.hpp>
+#include <gtc/constants.hpp>
+#include "opengl-mesh.h"
+#include "opengl-meshlet.h"
+
+typedef struct _obj_vertex_key_s {
+	int v;
+	int vt;
+	int vn;
+
+	bool operator==(const _obj_vertex_key_s& other) const {
+		return v == other.v && vt == other.vt && vn == other.vn;
+	}
+}_obj_vertex_key_t;
+
+typedef struct _obj_vertex_key_hash_s {
+	size_t operator()(const _obj_vertex_key_t& key) const {
+		return (size_t)file_hash_bytes(&key, sizeof(key));
+	}
+}_obj_vertex_key_hash_t;
+
+typedef struct _float_array_s {
+	float* data;
+	uint32_t count;
+	uint32_t capacity;
+}_float_array_t;
+
+static void _float_array_push(_float_array_t* array, const float* values, uint32_t n) {
+	if (array->count + n > array->capacity) {
+		array->capacity = array->capacity ? array->capacity * 2 : 1024;
+		while (array->count + n > array->capacity) {
+			array->capacity *= 2;
+		}
+		array->data = (float*)realloc(array->data, array->capacity * sizeof(float));
+	}
+	memcpy(array->data + array->count, values, n * sizeof(float));
+	array->count += n;
+}
+
+static void* _array_grow(void* data, uint32_t count, uint32_t* capacity, size_t elem_size) {
+	if (count < *capacity) {
+		return data;
+	}
+	*capacity = *capacity ? *capacity * 2 : 1024;
+	return realloc(data, *capacity * elem_size);
+}
+
+//obj1ʼʾĩβ
+static int _obj_resolve_index(int index, uint32_t count) {
+	if (index > 0) {
+		return index - 1;
+	}
+	if (index < 0) {
+		return (int)count + index;
+	}
+	return -1;
+}
+
+static bool _obj_parse_corner(const char** cursor, _obj_vertex_key_t* key) {
+	char* end;
+	key->v = (int)strtol(*cursor, &end, 10);
+	key->vt = 0;
+	key->vn = 0;
+	if (end == *cursor) {
+		return false;
+	}
+	if (*end == '/') {
+		end++;
+		if (*end != '/') {
+			key->vt = (int)strtol(end, &end, 10);
+		}
+		if (*end == '/') {
+			end++;
+			key->vn = (int)strtol(end, &end, 10);
+		}
+	}
+	*cursor = end;
+	return true;
+}
+
+bool opengl_mesh_import_obj(opengl_mesh_t* mesh, const char* path) {
+	FILE* fp = fopen(path, "rb");
+	if (fp == NULL) {
+		printf("ERROR::MESH::OPEN_FAILED: %s\n", path);
+		return false;
+	}
+	memset(mesh, 0, sizeof(*mesh));
+
+	_float_array_t v = {};
+	_float_array_t vt = {};
+	_float_array_t vn = {};
+	uint32_t vertex_capacity = 0;
+	uint32_t index_capacity = 0;
+	bool has_normals = false;
+	std::unordered_map<_obj_vertex_key_t, uint32_t, _obj_vertex_key_hash_t> vertex_map;
+
+	char line[1024];
+	while (fgets(line, sizeof(line), fp)) {
+		const char* cursor = line;
+		float values[3] = { 0.0f, 0.0f, 0.0f };
+
+		if (strncmp(line, "v ", 2) == 0) {
+			sscanf(line + 2, "%f %f %f", &values[0], &values[1], &values[2]);
+			_float_array_push(&v, values, 3);
+		}
+		else if (strncmp(line, "vt ", 3) == 0) {
+			sscanf(line + 3, "%f %f", &values[0], &values[1]);
+			_float_array_push(&vt, values, 2);
+		}
+		else if (strncmp(line, "vn ", 3) == 0) {
+			sscanf(line + 3, "%f %f %f", &values[0], &values[1], &values[2]);
+			_float_array_push(&vn, values, 3);
+		}
+		else if (strncmp(line, "f ", 2) == 0) {
+			cursor += 2;
+			uint32_t corners[64];
+			uint32_t corner_count = 0;
+			_obj_vertex_key_t key;
+
+			while (corner_count < 64) {
+				while (*cursor == ' ' || *cursor == '\t') {
+					cursor++;
+				}
+				if (!_obj_parse_corner(&cursor, &key)) {
+					break;
+				}
+				key.v = _obj_resolve_index(key.v, v.count / 3);
+				key.vt = _obj_resolve_index(key.vt, vt.count / 2);
+				key.vn = _obj_resolve_index(key.vn, vn.count / 3);
+				if (key.v < 0 || key.v >= (int)(v.count / 3)) {
+					break;
+				}
+				//ͬv/vt/vnϸͬһ
+				auto it = vertex_map.find(key);
+				if (it == vertex_map.end()) {
+					uint32_t index = mesh->vertex_count++;
+					if (index >= vertex_capacity) {
+						mesh->positions = (float*)_array_grow(mesh->positions, index, &vertex_capacity, 3 * sizeof(float));
+						mesh->normals = (float*)realloc(mesh->normals, vertex_capacity * 3 * sizeof(float));
+						mesh->texcoords = (float*)realloc(mesh->texcoords, vertex_capacity * 2 * sizeof(float));
+					}
+
+					memcpy(&mesh->positions[index * 3], &v.data[key.v * 3], 3 * sizeof(float));
+					if (key.vn >= 0 && key.vn < (int)(vn.count / 3)) {
+						memcpy(&mesh->normals[index * 3], &vn.data[key.vn * 3], 3 * sizeof(float));
+						has_normals = true;
+					}
+					else {
+						memset(&mesh->normals[index * 3], 0, 3 * sizeof(float));
+					}
+					if (key.vt >= 0 && key.vt < (int)(vt.count / 2)) {
+						memcpy(&mesh->texcoords[index * 2], &vt.data[key.vt * 2], 2 * sizeof(float));
+					}
+					else {
+						memset(&mesh->texcoords[index * 2], 0, 2 * sizeof(float));
+					}
+					it = vertex_map.emplace(key, index).first;
+				}
+				corners[corner_count++] = it->second;
+			}
+			//ΰβ
+			for (uint32_t i = 2; i < corner_count; i++) {
+				mesh->indices = (uint32_t*)_array_grow(mesh->indices, mesh->index_count + 2, &index_capacity, sizeof(uint32_t));
+				mesh->indices[mesh->index_count++] = corners[0];
+				mesh->indices[mesh->index_count++] = corners[i - 1];
+				mesh->indices[mesh->index_count++] = corners[i];
+			}
+		}
+	}
+	fclose(fp);
+	free(v.data);
+	free(vt.data);
+	free(vn.data);
+
+	if (mesh->index_count == 0) {
+		printf("ERROR::MESH::NO_FACES: %s\n", path);
+		opengl_mesh_destroy(mesh);
+		return false;
+	}
+	//ûзʱ淨ۼ
+	if (!has_normals) {
+		for (uint32_t i = 0; i < mesh->index_count; i += 3) {
+			uint32_t a = mesh->indices[i];
+			uint32_t b = mesh->indices[i + 1];
+			uint32_t c = mesh->indices[i + 2];
+			glm::vec3 pa = glm::make_vec3(&mesh->positions[a * 3]);
+			glm::vec3 pb = glm::make_vec3(&mesh->positions[b * 3]);
+			glm::vec3 pc = glm::make_vec3(&mesh->positions[c * 3]);
+			glm::vec3 n = glm::cross(pb - pa, pc - pa);
+			for (uint32_t k = 0; k < 3; k++) {
+				uint32_t idx = mesh->indices[i + k];
+				mesh->normals[idx * 3 + 0] += n.x;
+				mesh->normals[idx * 3 + 1] += n.y;
+				mesh->normals[idx * 3 + 2] += n.z;
+			}
+		}
+		for (uint32_t i = 0; i < mesh->vertex_count; i++) {
+			glm::vec3 n = glm::make_vec3(&mesh->normals[i * 3]);
+			float len = glm::length(n);
+			if (len > 0.0f) {
+				n /= len;
+			}
+			memcpy(&mesh->normals[i * 3], &n[0], 3 * sizeof(float));
+		}
+	}
+	opengl_mesh_compute_bounds(mesh);
+	return true;
+}
+
+//λ򣬾߷һuvӷ
+void opengl_mesh_create_sphere(opengl_mesh_t* mesh, uint32_t slices, uint32_t stacks) {
+	memset(mesh, 0, sizeof(*mesh));
+	mesh->vertex_count = (slices + 1) * (stacks + 1);
+	mesh->positions = (float*)malloc(mesh->vertex_count * 3 * sizeof(float));
+	mesh->normals = (float*)malloc(mesh->vertex_count * 3 * sizeof(float));
+	mesh->texcoords = (float*)malloc(mesh->vertex_count * 2 * sizeof(float));
+
+	for (uint32_t y = 0; y <= stacks; y++) {
+		float v = (float)y / stacks;
+		float phi = v * glm::pi<float>();
+		for (uint32_t x = 0; x <= slices; x++) {
+			float u = (float)x / slices;
+			float theta = u * 2.0f * glm::pi<float>();
+			uint32_t i = y * (slices + 1) + x;
+			glm::vec3 n(sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta));
+			memcpy(&mesh->positions[i * 3], &n[0], 3 * sizeof(float));
+			memcpy(&mesh->normals[i * 3], &n[0], 3 * sizeof(float));
+			mesh->texcoords[i * 2 + 0] = u;
+			mesh->texcoords[i * 2 + 1] = 1.0f - v;
+		}
+	}
+	//һȦ˻ģ
+	mesh->indices = (uint32_t*)malloc(slices * stacks * 6 * sizeof(uint32_t));
+	for (uint32_t y = 0; y < stacks; y++) {
+		for (uint32_t x = 0; x < slices; x++) {
+			uint32_t a = y * (slices + 1) + x;
+			uint32_t b = a + slices + 1;
+			if (y != 0) {
+				mesh->indices[mesh->index_count++] = a;
+				mesh->indices[mesh->index_count++] = a + 1;
+				mesh->indices[mesh->index_count++] = b;
+			}
+			if (y != stacks - 1) {
+				mesh->indices[mesh->index_count++] = a + 1;
+				mesh->indices[mesh->index_count++] = b + 1;
+				mesh->indices[mesh->index_count++] = b;
+			}
+		}
+	}
+	opengl_mesh_compute_bounds(mesh);
+}
+
+void opengl_mesh_compute_bounds(opengl_mesh_t* mesh) {
+	glm::vec3 lo(FLT_MAX);
+	glm::vec3 hi(-FLT_MAX);
+	for (uint32_t i = 0; i < mesh->vertex_count; i++) {
+		glm::vec3 p = glm::make_vec3(&mesh->positions[i * 3]);
+		lo = glm::min(lo, p);
+		hi = glm::max(hi, p);
+	}
+	if (mesh->vertex_count == 0) {
+		lo = hi = glm::vec3(0.0f);
+	}
+	mesh->bounds_min = lo;
+	mesh->bounds_max = hi;
+	mesh->bounds_center = (lo + hi) * 0.5f;
+
+	float radius2 = 0.0f;
+	for (uint32_t i = 0; i < mesh->vertex_count; i++) {
+		glm::vec3 d = glm::make_vec3(&mesh->positions[i * 3]) - mesh->bounds_center;
+		radius2 = glm::max(radius2, glm::dot(d, d));
+	}
+	mesh->bounds_radius = sqrtf(radius2);
+}
+
+static uint64_t _cache_align(uint64_t offset) {
+	return (offset + OPENGL_MESH_CACHE_ALIGN - 1) & ~(uint64_t)(OPENGL_MESH_CACHE_ALIGN - 1);
+}
+
+static void _cache_layout(opengl_mesh_cache_header_t* header) {
+	uint64_t offset = _cache_align(sizeof(opengl_mesh_cache_header_t));
+	header->position_offset = offset;
+	offset = _cache_align(offset + (uint64_t)header->vertex_count * 3 * sizeof(float));
+	header->normal_offset = offset;
+	offset = _cache_align(offset + (uint64_t)header->vertex_count * 3 * sizeof(float));
+	header->texcoord_offset = offset;
+	offset = _cache_align(offset + (uint64_t)header->vertex_count * 2 * sizeof(float));
+	header->index_offset = offset;
+	offset = _cache_align(offset + (uint64_t)header->index_count * sizeof(uint32_t));
+	header->meshlet_offset = offset;
+	offset = _cache_align(offset + (uint64_t)header->meshlet_count * sizeof(opengl_meshlet_t));
+	header->meshlet_vertex_offset = offset;
+	offset = _cache_align(offset + (uint64_t)header->meshlet_vertex_count * sizeof(uint32_t));
+	header->meshlet_triangle_offset = offset;
+	offset = offset + (uint64_t)header->meshlet_triangle_count * 3;
+	header->file_size = offset;
+}
+
+static bool _cache_write_section(FILE* fp, uint64_t offset, const void* data, size_t size) {
+	static const unsigned char zeros[OPENGL_MESH_CACHE_ALIGN] = {};
+	long pos = ftell(fp);
+	if (pos < 0 || (uint64_t)pos > offset || offset - (uint64_t)pos > sizeof(zeros)) {
+		return false;
+	}
+	if (fwrite(zeros, 1, (size_t)(offset - (uint64_t)pos), fp) != (size_t)(offset - (uint64_t)pos)) {
+		return false;
+	}
+	return size == 0 || fwrite(data, 1, size, fp) == size;
+}
+
+bool opengl_mesh_cache_write(const opengl_mesh_t* mesh, const char* cache_path, uint64_t source_hash) {
+	opengl_mesh_cache_header_t header = {};
+	header.magic = OPENGL_MESH_CACHE_MAGIC;
+	header.version = OPENGL_MESH_CACHE_VERSION;
+	header.source_hash = source_hash;
+	header.vertex_count = mesh->vertex_count;
+	header.index_count = mesh->index_count;
+	header.meshlet_count = mesh->meshlet_count;
+	header.meshlet_vertex_count = mesh->meshlet_vertex_count;
+	header.meshlet_triangle_count = mesh->meshlet_triangle_count;
+	memcpy(header.bounds_min, &mesh->bounds_min[0], sizeof(header.bounds_min));
+	memcpy(header.bounds_max, &mesh->bounds_max[0], sizeof(header.bounds_max));
+	memcpy(header.bounds_center, &mesh->bounds_center[0], sizeof(header.bounds_center));
+	header.bounds_radius = mesh->bounds_radius;
+	_cache_layout(&header);
+
+	//дʱļٸ;ʧ°
+	char tmp_path[1024];
+	snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", cache_path);
+	FILE* fp = fopen(tmp_path, "wb");
+	if (fp == NULL) {
+		printf("ERROR::MESH::CACHE_WRITE_FAILED: %s\n", cache_path);
+		return false;
+	}
+	bool ok = fwrite(&header, sizeof(header), 1, fp) == 1
+		&& _cache_write_section(fp, header.position_offset, mesh->positions, (size_t)mesh->vertex_count * 3 * sizeof(float))
+		&& _cache_write_section(fp, header.normal_offset, mesh->normals, (size_t)mesh->vertex_count * 3 * sizeof(float))
+		&& _cache_write_section(fp, header.texcoord_offset, mesh->texcoords, (size_t)mesh->vertex_count * 2 * sizeof(float))
+		&& _cache_write_section(fp, header.index_offset, mesh->indices, (size_t)mesh->index_count * sizeof(uint32_t))
+		&& _cache_write_section(fp, header.meshlet_offset, mesh->meshlets, (size_t)mesh->meshlet_count * sizeof(opengl_meshlet_t))
+		&& _cache_write_section(fp, header.meshlet_vertex_offset, mesh->meshlet_vertices, (size_t)mesh->meshlet_vertex_count * sizeof(uint32_t))
+		&& _cache_write_section(fp, header.meshlet_triangle_offset, mesh->meshlet_triangles, (size_t)mesh->meshlet_triangle_count * 3);
+	ok = (fclose(fp) == 0) && ok;
+	if (ok) {
+		remove(cache_path);
+		ok = rename(tmp_path, cache_path) == 0;
+	}
+	if (!ok) {
+		remove(tmp_path);
+		printf("ERROR::MESH::CACHE_WRITE_FAILED: %s\n", cache_path);
+	}
+	return ok;
+}
+
+bool opengl_mesh_cache_open(opengl_mesh_t* mesh, const char* cache_path, uint64_t source_hash) {
+	memset(mesh, 0, sizeof(*mesh));
+
+	file_map_t map;
+	if (!file_map_open(&map, cache_path)) {
+		return false;
+	}
+	if (map.size < sizeof(opengl_mesh_cache_header_t)) {
+		file_map_close(&map);
+		return false;
+	}
+	opengl_mesh_cache_header_t header;
+	memcpy(&header, map.data, sizeof(header));
+
+	//汾ϣ鲼κһһ¶ΪʧЧ
+	opengl_mesh_cache_header_t expected = header;
+	_cache_layout(&expected);
+	if (header.magic != OPENGL_MESH_CACHE_MAGIC
+		|| header.version != OPENGL_MESH_CACHE_VERSION
+		|| header.source_hash != source_hash
+		|| memcmp(&header, &expected, sizeof(header)) != 0
+		|| header.file_size > map.size) {
+		file_map_close(&map);
+		return false;
+	}
+	unsigned char* base = (unsigned char*)map.data;
+	mesh->positions = (float*)(base + header.position_offset);
+	mesh->normals = (float*)(base + header.normal_offset);
+	mesh->texcoords = (float*)(base + header.texcoord_offset);
+	mesh->indices = (uint32_t*)(base + header.index_offset);
+	mesh->meshlets = (opengl_meshlet_t*)(base + header.meshlet_offset);
+	mesh->meshlet_vertices = (uint32_t*)(base + header.meshlet_vertex_offset);
+	mesh->meshlet_triangles = (uint8_t*)(base + header.meshlet_triangle_offset);
+	mesh->vertex_count = header.vertex_count;
+	mesh->index_count = header.index_count;
+	mesh->meshlet_count = header.meshlet_count;
+	mesh->meshlet_vertex_count = header.meshlet_vertex_count;
+	mesh->meshlet_triangle_count = header.meshlet_triangle_count;
+	mesh->bounds_min = glm::make_vec3(header.bounds_min);
+	mesh->bounds_max = glm::make_vec3(header.bounds_max);
+	mesh->bounds_center = glm::make_vec3(header.bounds_center);
+	mesh->bounds_radius = header.bounds_radius;
+	mesh->map = map;
+	return true;
+}
+
+bool opengl_mesh_load(opengl_mesh_t* mesh, const char* path) {
+	uint64_t hash;
+	if (!file_hash(path, &hash)) {
+		printf("ERROR::MESH::OPEN_FAILED: %s\n", path);
+		return false;
+	}
+	char cache_path[1024];
+	snprintf(cache_path, sizeof(cache_path), "%s.cache", path);
+	if (opengl_mesh_cache_open(mesh, cache_path, hash)) {
+		return true;
+	}
+	if (!opengl_mesh_import_obj(mesh, path)) {
+		return false;
+	}
+	opengl_mesh_build_meshlets(mesh, OPENGL_MESHLET_MAX_VERTICES, OPENGL_MESHLET_MAX_TRIANGLES);
+	opengl_mesh_cache_write(mesh, cache_path, hash);
+	return true;
+}
+
+void opengl_mesh_destroy(opengl_mesh_t* mesh) {
+	if (mesh->map.data) {
+		file_map_close(&mesh->map);
+	}
+	else {
+		free(mesh->positions);
+		free(mesh->normals);
+		free(mesh->texcoords);
+		free(mesh->indices);
+		free(mesh->meshlets);
+		free(mesh->meshlet_vertices);
+		free(mesh->meshlet_triangles);
+	}
+	memset(mesh, 0, sizeof(*mesh));
+}
+
+void opengl_mesh_upload(const opengl_mesh_t* mesh, unsigned int* vao, unsigned int* vbo, unsigned int* ebo) {
+	GLsizeiptr position_size = (GLsizeiptr)mesh->vertex_count * 3 * sizeof(float);
+	GLsizeiptr normal_size = (GLsizeiptr)mesh->vertex_count * 3 * sizeof(float);
+	GLsizeiptr texcoord_size = (GLsizeiptr)mesh->vertex_count * 2 * sizeof(float);
+
+	glGenVertexArrays(1, vao);
+	glBindVertexArray(*vao);
+
+	//ֱӴӳ()ϴƴɽʽ
+	glGenBuffers(1, vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, *vbo);
+	glBufferData(GL_ARRAY_BUFFER, position_size + normal_size + texcoord_size, NULL, GL_STATIC_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, position_size, mesh->positions);
+	glBufferSubData(GL_ARRAY_BUFFER, position_size, normal_size, mesh->normals);
+	glBufferSubData(GL_ARRAY_BUFFER, position_size + normal_size, texcoord_size, mesh->texcoords);
+
+	glGenBuffers(1, ebo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *ebo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)mesh->index_count * sizeof(uint32_t), mesh->indices, GL_STATIC_DRAW);
+
+	glVertexAttribPointer(OPENGL_MESH_ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(OPENGL_MESH_ATTRIB_POSITION);
+	glVertexAttribPointer(OPENGL_MESH_ATTRIB_NORMAL, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)position_size);
+	glEnableVertexAttribArray(OPENGL_MESH_ATTRIB_NORMAL);
+	glVertexAttribPointer(OPENGL_MESH_ATTRIB_TEXCOORD, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)(position_size + normal_size));
+	glEnableVertexAttribArray(OPENGL_MESH_ATTRIB_TEXCOORD);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+	glBindVertexArray(0);//ѡֹ޸
+}
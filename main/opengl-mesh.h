@@ -0,0 +1,85 @@
+_Pragma("once")
+
+#include <cstdint>
+#include <glm.hpp>
+#include "file-map.h"
+
+#define OPENGL_MESH_CACHE_MAGIC		0x4853454d	//"MESH"
+#define OPENGL_MESH_CACHE_VERSION	2
+#define OPENGL_MESH_CACHE_ALIGN		64			//ÿ鰴ж
+
+//ԵlocationɫеlayoutӦ
+#define OPENGL_MESH_ATTRIB_POSITION	0
+#define OPENGL_MESH_ATTRIB_TEXCOORD	1
+#define OPENGL_MESH_ATTRIB_NORMAL	2
+
+typedef struct opengl_meshlet_s {
+	uint32_t vertex_offset;		//meshlet_verticesеʼλ
+	uint32_t triangle_offset;	//meshlet_trianglesеʼλ(ÿ3ֽ)
+	uint32_t vertex_count;
+	uint32_t triangle_count;
+	float center[3];			//Χ
+	float radius;
+	float cone_axis[3];			//׶
+	float cone_cutoff;
+}opengl_meshlet_t;
+
+//㰴(SoA)ţpositionsnormalstexcoords
+//ӻʱָ붼ָֻӳ䣬޸ġ
+typedef struct opengl_mesh_s {
+	float* positions;			//ÿ3float
+	float* normals;				//ÿ3float
+	float* texcoords;			//ÿ2float
+	uint32_t* indices;
+	opengl_meshlet_t* meshlets;
+	uint32_t* meshlet_vertices;
+	uint8_t* meshlet_triangles;
+	uint32_t vertex_count;
+	uint32_t index_count;
+	uint32_t meshlet_count;
+	uint32_t meshlet_vertex_count;
+	uint32_t meshlet_triangle_count;
+	glm::vec3 bounds_min;
+	glm::vec3 bounds_max;
+	glm::vec3 bounds_center;	//Χ
+	float bounds_radius;
+	file_map_t map;
+}opengl_mesh_t;
+
+//ļͷŰOPENGL_MESH_CACHE_ALIGNĸ
+typedef struct opengl_mesh_cache_header_s {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t source_hash;
+	uint32_t vertex_count;
+	uint32_t index_count;
+	uint32_t meshlet_count;
+	uint32_t meshlet_vertex_count;
+	uint32_t meshlet_triangle_count;
+	uint32_t reserved;
+	float bounds_min[3];
+	float bounds_max[3];
+	float bounds_center[3];
+	float bounds_radius;
+	uint64_t position_offset;
+	uint64_t normal_offset;
+	uint64_t texcoord_offset;
+	uint64_t index_offset;
+	uint64_t meshlet_offset;
+	uint64_t meshlet_vertex_offset;
+	uint64_t meshlet_triangle_offset;
+	uint64_t file_size;
+}opengl_mesh_cache_header_t;
+
+extern bool opengl_mesh_import_obj(opengl_mesh_t* mesh, const char* path);
+extern void opengl_mesh_create_sphere(opengl_mesh_t* mesh, uint32_t slices, uint32_t stacks);
+extern void opengl_mesh_compute_bounds(opengl_mesh_t* mesh);
+
+extern bool opengl_mesh_cache_write(const opengl_mesh_t* mesh, const char* cache_path, uint64_t source_hash);
+extern bool opengl_mesh_cache_open(opengl_mesh_t* mesh, const char* cache_path, uint64_t source_hash);
+
+//ȴ"<path>.cache"ӳأԴļϣƥʱµ벢д
+extern bool opengl_mesh_load(opengl_mesh_t* mesh, const char* path);
+extern void opengl_mesh_destroy(opengl_mesh_t* mesh);
+
+extern void opengl_mesh_upload(const opengl_mesh_t* mesh, unsigned int* vao, unsigned int* vbo, unsigned int* ebo);
@@ -0,0 +1,361 @@
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cfloat>
+#include <gtc/type_ptr.hpp>
+#include "opengl-meshlet.h"
+#include "opengl-culling.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MESHLET_SSE 1
+#include <emmintrin.h>
+#endif
+
+typedef struct _meshlet_builder_s {
+	uint32_t vertices[OPENGL_MESHLET_MAX_VERTICES];
+	uint8_t triangles[OPENGL_MESHLET_MAX_TRIANGLES * 3];
+	glm::vec3 normals[OPENGL_MESHLET_MAX_TRIANGLES];
+	uint32_t vertex_count;
+	uint32_t triangle_count;
+}_meshlet_builder_t;
+
+static void _meshlet_finish(opengl_mesh_t* mesh, _meshlet_builder_t* builder, int16_t* local,
+	uint32_t* meshlet_capacity, uint32_t* vertex_capacity, uint32_t* triangle_capacity) {
+	if (builder->triangle_count == 0) {
+		return;
+	}
+	if (mesh->meshlet_count == *meshlet_capacity) {
+		*meshlet_capacity = *meshlet_capacity ? *meshlet_capacity * 2 : 256;
+		mesh->meshlets = (opengl_meshlet_t*)realloc(mesh->meshlets, *meshlet_capacity * sizeof(opengl_meshlet_t));
+	}
+	while (mesh->meshlet_vertex_count + builder->vertex_count > *vertex_capacity) {
+		*vertex_capacity = *vertex_capacity ? *vertex_capacity * 2 : 256 * OPENGL_MESHLET_MAX_VERTICES;
+		mesh->meshlet_vertices = (uint32_t*)realloc(mesh->meshlet_vertices, *vertex_capacity * sizeof(uint32_t));
+	}
+	while (mesh->meshlet_triangle_count + builder->triangle_count > *triangle_capacity) {
+		*triangle_capacity = *triangle_capacity ? *triangle_capacity * 2 : 256 * OPENGL_MESHLET_MAX_TRIANGLES;
+		mesh->meshlet_triangles = (uint8_t*)realloc(mesh->meshlet_triangles, *triangle_capacity * 3);
+	}
+	opengl_meshlet_t* meshlet = &mesh->meshlets[mesh->meshlet_count++];
+	meshlet->vertex_offset = mesh->meshlet_vertex_count;
+	meshlet->triangle_offset = mesh->meshlet_triangle_count;
+	meshlet->vertex_count = builder->vertex_count;
+	meshlet->triangle_count = builder->triangle_count;
+	memcpy(&mesh->meshlet_vertices[mesh->meshlet_vertex_count], builder->vertices, builder->vertex_count * sizeof(uint32_t));
+	memcpy(&mesh->meshlet_triangles[mesh->meshlet_triangle_count * 3], builder->triangles, builder->triangle_count * 3);
+	mesh->meshlet_vertex_count += builder->vertex_count;
+	mesh->meshlet_triangle_count += builder->triangle_count;
+
+	//Χ򣺰Χ + Զ
+	glm::vec3 lo(FLT_MAX);
+	glm::vec3 hi(-FLT_MAX);
+	for (uint32_t i = 0; i < builder->vertex_count; i++) {
+		glm::vec3 p = glm::make_vec3(&mesh->positions[builder->vertices[i] * 3]);
+		lo = glm::min(lo, p);
+		hi = glm::max(hi, p);
+	}
+	glm::vec3 center = (lo + hi) * 0.5f;
+	float radius2 = 0.0f;
+	for (uint32_t i = 0; i < builder->vertex_count; i++) {
+		glm::vec3 d = glm::make_vec3(&mesh->positions[builder->vertices[i] * 3]) - center;
+		radius2 = glm::max(radius2, glm::dot(d, d));
+	}
+	//׶ƽΪᣬŽƫξŽ̫ʱ޳
+	glm::vec3 axis(0.0f);
+	for (uint32_t i = 0; i < builder->triangle_count; i++) {
+		axis += builder->normals[i];
+	}
+	float axis_len = glm::length(axis);
+	float min_dot = 1.0f;
+	if (axis_len > 0.0f) {
+		axis /= axis_len;
+		for (uint32_t i = 0; i < builder->triangle_count; i++) {
+			if (builder->normals[i] != glm::vec3(0.0f)) {
+				min_dot = glm::min(min_dot, glm::dot(axis, builder->normals[i]));
+			}
+		}
+	}
+	if (axis_len == 0.0f || min_dot <= 0.1f) {
+		axis = glm::vec3(0.0f);
+		meshlet->cone_cutoff = 1.0f;
+	}
+	else {
+		meshlet->cone_cutoff = sqrtf(1.0f - min_dot * min_dot);
+	}
+	memcpy(meshlet->center, &center[0], sizeof(meshlet->center));
+	meshlet->radius = sqrtf(radius2);
+	memcpy(meshlet->cone_axis, &axis[0], sizeof(meshlet->cone_axis));
+
+	for (uint32_t i = 0; i < builder->vertex_count; i++) {
+		local[builder->vertices[i]] = -1;
+	}
+	builder->vertex_count = 0;
+	builder->triangle_count = 0;
+}
+
+void opengl_mesh_build_meshlets(opengl_mesh_t* mesh, uint32_t max_vertices, uint32_t max_triangles) {
+	if (mesh->map.data) {
+		return;	//ӳĻֻģѾ˴ر
+	}
+	free(mesh->meshlets);
+	free(mesh->meshlet_vertices);
+	free(mesh->meshlet_triangles);
+	mesh->meshlets = NULL;
+	mesh->meshlet_vertices = NULL;
+	mesh->meshlet_triangles = NULL;
+	mesh->meshlet_count = 0;
+	mesh->meshlet_vertex_count = 0;
+	mesh->meshlet_triangle_count = 0;
+	max_vertices = glm::min(max_vertices, (uint32_t)OPENGL_MESHLET_MAX_VERTICES);
+	max_triangles = glm::min(max_triangles, (uint32_t)OPENGL_MESHLET_MAX_TRIANGLES);
+
+	uint32_t triangle_count = mesh->index_count / 3;
+	//㵽εڽӱ(CSR)
+	uint32_t* adjacency_offsets = (uint32_t*)calloc(mesh->vertex_count + 1, sizeof(uint32_t));
+	uint32_t* adjacency = (uint32_t*)malloc(mesh->index_count * sizeof(uint32_t));
+	for (uint32_t i = 0; i < mesh->index_count; i++) {
+		adjacency_offsets[mesh->indices[i] + 1]++;
+	}
+	for (uint32_t i = 0; i < mesh->vertex_count; i++) {
+		adjacency_offsets[i + 1] += adjacency_offsets[i];
+	}
+	uint32_t* fill = (uint32_t*)malloc(mesh->vertex_count * sizeof(uint32_t));
+	memcpy(fill, adjacency_offsets, mesh->vertex_count * sizeof(uint32_t));
+	for (uint32_t i = 0; i < mesh->index_count; i++) {
+		adjacency[fill[mesh->indices[i]]++] = i / 3;
+	}
+	free(fill);
+
+	uint8_t* used = (uint8_t*)calloc(triangle_count, 1);
+	int16_t* local = (int16_t*)malloc(mesh->vertex_count * sizeof(int16_t));
+	memset(local, 0xff, mesh->vertex_count * sizeof(int16_t));
+	_meshlet_builder_t* builder = (_meshlet_builder_t*)calloc(1, sizeof(_meshlet_builder_t));
+	uint32_t meshlet_capacity = 0;
+	uint32_t vertex_capacity = 0;
+	uint32_t triangle_capacity = 0;
+	uint32_t cursor = 0;
+
+	for (;;) {
+		//̰ѡ͵ǰعΣ֤ڿռϽ
+		uint32_t best = UINT32_MAX;
+		uint32_t best_new = 4;
+		for (uint32_t i = 0; i < builder->vertex_count && best_new > 0; i++) {
+			uint32_t v = builder->vertices[i];
+			for (uint32_t k = adjacency_offsets[v]; k < adjacency_offsets[v + 1]; k++) {
+				uint32_t t = adjacency[k];
+				if (used[t]) {
+					continue;
+				}
+				const uint32_t* tri = &mesh->indices[t * 3];
+				uint32_t new_count = (local[tri[0]] < 0) + (local[tri[1]] < 0) + (local[tri[2]] < 0);
+				if (new_count < best_new) {
+					best = t;
+					best_new = new_count;
+				}
+			}
+		}
+		if (best == UINT32_MAX) {
+			//ǰûڵˣһδʹõ¿ʼ
+			_meshlet_finish(mesh, builder, local, &meshlet_capacity, &vertex_capacity, &triangle_capacity);
+			while (cursor < triangle_count && used[cursor]) {
+				cursor++;
+			}
+			if (cursor == triangle_count) {
+				break;
+			}
+			best = cursor;
+			best_new = 3;
+		}
+		if (builder->vertex_count + best_new > max_vertices || builder->triangle_count + 1 > max_triangles) {
+			_meshlet_finish(mesh, builder, local, &meshlet_capacity, &vertex_capacity, &triangle_capacity);
+		}
+		const uint32_t* tri = &mesh->indices[best * 3];
+		for (uint32_t k = 0; k < 3; k++) {
+			if (local[tri[k]] < 0) {
+				local[tri[k]] = (int16_t)builder->vertex_count;
+				builder->vertices[builder->vertex_count++] = tri[k];
+			}
+			builder->triangles[builder->triangle_count * 3 + k] = (uint8_t)local[tri[k]];
+		}
+		glm::vec3 pa = glm::make_vec3(&mesh->positions[tri[0] * 3]);
+		glm::vec3 pb = glm::make_vec3(&mesh->positions[tri[1] * 3]);
+		glm::vec3 pc = glm::make_vec3(&mesh->positions[tri[2] * 3]);
+		glm::vec3 n = glm::cross(pb - pa, pc - pa);
+		float len = glm::length(n);
+		builder->normals[builder->triangle_count] = len > 0.0f ? n / len : glm::vec3(0.0f);
+		builder->triangle_count++;
+		used[best] = 1;
+	}
+	free(builder);
+	free(local);
+	free(used);
+	free(adjacency);
+	free(adjacency_offsets);
+}
+
+uint32_t* opengl_meshlet_expand_indices(const opengl_mesh_t* mesh, uint32_t* index_count) {
+	uint32_t* indices = (uint32_t*)malloc((size_t)mesh->meshlet_triangle_count * 3 * sizeof(uint32_t));
+	uint32_t count = 0;
+	for (uint32_t m = 0; m < mesh->meshlet_count; m++) {
+		const opengl_meshlet_t* meshlet = &mesh->meshlets[m];
+		const uint32_t* vertices = &mesh->meshlet_vertices[meshlet->vertex_offset];
+		const uint8_t* triangles = &mesh->meshlet_triangles[meshlet->triangle_offset * 3];
+		for (uint32_t i = 0; i < meshlet->triangle_count * 3; i++) {
+			indices[count++] = vertices[triangles[i]];
+		}
+	}
+	*index_count = count;
+	return indices;
+}
+
+void opengl_meshlet_cull_create(opengl_meshlet_cull_t* cull, const opengl_mesh_t* mesh) {
+	memset(cull, 0, sizeof(*cull));
+	cull->count = mesh->meshlet_count;
+	cull->padded_count = (mesh->meshlet_count + 3) & ~3u;
+	float** streams[] = { &cull->center_x, &cull->center_y, &cull->center_z, &cull->radius,
+		&cull->cone_x, &cull->cone_y, &cull->cone_z, &cull->cone_cutoff };
+	for (float** stream : streams) {
+		*stream = (float*)calloc(cull->padded_count, sizeof(float));
+	}
+	cull->triangle_counts = (uint32_t*)calloc(cull->padded_count, sizeof(uint32_t));
+	cull->index_offsets = (uint32_t*)calloc(cull->padded_count, sizeof(uint32_t));
+	cull->visible = (uint32_t*)calloc(cull->padded_count, sizeof(uint32_t));
+	cull->draw_counts = (int*)calloc(cull->padded_count, sizeof(int));
+	cull->draw_offsets = (const void**)calloc(cull->padded_count, sizeof(void*));
+#if defined(MESHLET_SSE)
+	cull->simd = true;
+#endif
+
+	uint32_t offset = 0;
+	for (uint32_t i = 0; i < mesh->meshlet_count; i++) {
+		const opengl_meshlet_t* meshlet = &mesh->meshlets[i];
+		cull->center_x[i] = meshlet->center[0];
+		cull->center_y[i] = meshlet->center[1];
+		cull->center_z[i] = meshlet->center[2];
+		cull->radius[i] = meshlet->radius;
+		cull->cone_x[i] = meshlet->cone_axis[0];
+		cull->cone_y[i] = meshlet->cone_axis[1];
+		cull->cone_z[i] = meshlet->cone_axis[2];
+		cull->cone_cutoff[i] = meshlet->cone_cutoff;
+		cull->triangle_counts[i] = meshlet->triangle_count;
+		cull->index_offsets[i] = offset;
+		offset += meshlet->triangle_count * 3;
+	}
+}
+
+void opengl_meshlet_cull_destroy(opengl_meshlet_cull_t* cull) {
+	free(cull->center_x);
+	free(cull->center_y);
+	free(cull->center_z);
+	free(cull->radius);
+	free(cull->cone_x);
+	free(cull->cone_y);
+	free(cull->cone_z);
+	free(cull->cone_cutoff);
+	free(cull->triangle_counts);
+	free(cull->index_offsets);
+	free(cull->visible);
+	free(cull->draw_counts);
+	free(cull->draw_offsets);
+	memset(cull, 0, sizeof(*cull));
+}
+
+static uint32_t _meshlet_cull_scalar(opengl_meshlet_cull_t* cull, const opengl_frustum_t* frustum, const glm::vec3& camera) {
+	uint32_t visible_count = 0;
+	for (uint32_t i = 0; i < cull->count; i++) {
+		glm::vec4 sphere(cull->center_x[i], cull->center_y[i], cull->center_z[i], cull->radius[i]);
+		if (!opengl_frustum_test_sphere(frustum, sphere)) {
+			continue;
+		}
+		glm::vec3 v = glm::vec3(sphere) - camera;
+		glm::vec3 axis(cull->cone_x[i], cull->cone_y[i], cull->cone_z[i]);
+		if (glm::dot(v, axis) >= cull->cone_cutoff[i] * glm::length(v) + sphere.w) {
+			continue;
+		}
+		cull->visible[visible_count++] = i;
+	}
+	return visible_count;
+}
+
+#if defined(MESHLET_SSE)
+static uint32_t _meshlet_cull_sse(opengl_meshlet_cull_t* cull, const opengl_frustum_t* frustum, const glm::vec3& camera) {
+	__m128 px[6], py[6], pz[6], pw[6];
+	for (int p = 0; p < 6; p++) {
+		px[p] = _mm_set1_ps(frustum->planes[p].x);
+		py[p] = _mm_set1_ps(frustum->planes[p].y);
+		pz[p] = _mm_set1_ps(frustum->planes[p].z);
+		pw[p] = _mm_set1_ps(frustum->planes[p].w);
+	}
+	__m128 cam_x = _mm_set1_ps(camera.x);
+	__m128 cam_y = _mm_set1_ps(camera.y);
+	__m128 cam_z = _mm_set1_ps(camera.z);
+	__m128 zero = _mm_setzero_ps();
+	uint32_t visible_count = 0;
+
+	for (uint32_t i = 0; i < cull->padded_count; i += 4) {
+		__m128 cx = _mm_loadu_ps(cull->center_x + i);
+		__m128 cy = _mm_loadu_ps(cull->center_y + i);
+		__m128 cz = _mm_loadu_ps(cull->center_z + i);
+		__m128 r = _mm_loadu_ps(cull->radius + i);
+		__m128 neg_r = _mm_sub_ps(zero, r);
+
+		__m128 culled = _mm_setzero_ps();
+		for (int p = 0; p < 6; p++) {
+			__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px[p], cx), _mm_mul_ps(py[p], cy)), _mm_add_ps(_mm_mul_ps(pz[p], cz), pw[p]));
+			culled = _mm_or_ps(culled, _mm_cmplt_ps(d, neg_r));
+		}
+		__m128 vx = _mm_sub_ps(cx, cam_x);
+		__m128 vy = _mm_sub_ps(cy, cam_y);
+		__m128 vz = _mm_sub_ps(cz, cam_z);
+		__m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz)));
+		__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, _mm_loadu_ps(cull->cone_x + i)), _mm_mul_ps(vy, _mm_loadu_ps(cull->cone_y + i))),
+			_mm_mul_ps(vz, _mm_loadu_ps(cull->cone_z + i)));
+		__m128 limit = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(cull->cone_cutoff + i), len), r);
+		culled = _mm_or_ps(culled, _mm_cmpge_ps(dot, limit));
+
+		int mask = ~_mm_movemask_ps(culled) & 0xf;
+		for (uint32_t lane = 0; lane < 4; lane++) {
+			if ((mask & (1 << lane)) && i + lane < cull->count) {
+				cull->visible[visible_count++] = i + lane;
+			}
+		}
+	}
+	return visible_count;
+}
+#endif
+
+uint32_t opengl_meshlet_cull_run(opengl_meshlet_cull_t* cull, const glm::mat4& model, const glm::mat4& view_projection, const glm::vec3& camera_pos) {
+	//MVPȡƽֱģͿռ䣬λҲ任ģͿռ䣬ݾͲ任
+	opengl_frustum_t frustum;
+	opengl_frustum_from_matrix(&frustum, view_projection * model);
+	glm::vec3 camera = glm::vec3(glm::inverse(model) * glm::vec4(camera_pos, 1.0f));
+
+#if defined(MESHLET_SSE)
+	if (cull->simd) {
+		cull->visible_count = _meshlet_cull_sse(cull, &frustum, camera);
+	}
+	else
+#endif
+	{
+		cull->visible_count = _meshlet_cull_scalar(cull, &frustum, camera);
+	}
+	//ڵĿɼҲģϲһ
+	cull->draw_count = 0;
+	cull->triangles_submitted = 0;
+	uint32_t prev = UINT32_MAX;
+	for (uint32_t i = 0; i < cull->visible_count; i++) {
+		uint32_t id = cull->visible[i];
+		uint32_t count = cull->triangle_counts[id] * 3;
+		if (prev != UINT32_MAX && id == prev + 1) {
+			cull->draw_counts[cull->draw_count - 1] += (int)count;
+		}
+		else {
+			cull->draw_counts[cull->draw_count] = (int)count;
+			cull->draw_offsets[cull->draw_count] = (const void*)(cull->index_offsets[id] * sizeof(uint32_t));
+			cull->draw_count++;
+		}
+		cull->triangles_submitted += cull->triangle_counts[id];
+		prev = id;
+	}
+	return cull->visible_count;
+}
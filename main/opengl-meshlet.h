@@ -0,0 +1,41 @@
+_Pragma("once")
+
+#include <cstdint>
+#include <glm.hpp>
+#include "opengl-mesh.h"
+
+#define OPENGL_MESHLET_MAX_VERTICES		64
+#define OPENGL_MESHLET_MAX_TRIANGLES	124
+
+//޳õSoAΧݣ뵽4ıSSEһδ4
+typedef struct opengl_meshlet_cull_s {
+	float* center_x;
+	float* center_y;
+	float* center_z;
+	float* radius;
+	float* cone_x;
+	float* cone_y;
+	float* cone_z;
+	float* cone_cutoff;
+	uint32_t* triangle_counts;
+	uint32_t* index_offsets;	//չеʼλ
+	uint32_t count;
+	uint32_t padded_count;
+	bool simd;
+	//ÿ֡Ľɼغϲ󽻸glMultiDrawElements
+	uint32_t* visible;
+	uint32_t visible_count;
+	int* draw_counts;
+	const void** draw_offsets;
+	uint32_t draw_count;
+	uint32_t triangles_submitted;
+}opengl_meshlet_cull_t;
+
+extern void opengl_mesh_build_meshlets(opengl_mesh_t* mesh, uint32_t max_vertices, uint32_t max_triangles);
+//ص˳ѾֲչȫصҪfree
+extern uint32_t* opengl_meshlet_expand_indices(const opengl_mesh_t* mesh, uint32_t* index_count);
+
+extern void opengl_meshlet_cull_create(opengl_meshlet_cull_t* cull, const opengl_mesh_t* mesh);
+extern void opengl_meshlet_cull_destroy(opengl_meshlet_cull_t* cull);
+//ģͿռ׶ͷ׶޳ģ;ֻ
+extern uint32_t opengl_meshlet_cull_run(opengl_meshlet_cull_t* cull, const glm::mat4& model, const glm::mat4& view_projection, const glm::vec3& camera_pos);
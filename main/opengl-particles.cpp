@@ -0,0 +1,303 @@
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <gtc/type_ptr.hpp>
+#include "math-simd.h"
+#include "opengl-particles.h"
+
+//ֻжɫ任дһդص
+static const char* _update_shader_source = "#version 330 core\n"
+	"layout (location = 0) in vec4 aPositionAge;\n"
+	"layout (location = 1) in vec4 aVelocityLifetime;\n"
+	"uniform float uDt;\n"
+	"uniform vec3 uGravity;\n"
+	"out vec4 PositionAge;\n"
+	"out vec4 VelocityLifetime;\n"
+	"void main()\n"
+	"{\n"
+	"	PositionAge = aPositionAge;\n"
+	"	VelocityLifetime = aVelocityLifetime;\n"
+	"	if (aPositionAge.w < aVelocityLifetime.w) {\n"
+	"		VelocityLifetime.xyz += uGravity * uDt;\n"
+	"		PositionAge.xyz += VelocityLifetime.xyz * uDt;\n"
+	"		PositionAge.w += uDt;\n"
+	"	}\n"
+	"}\n";
+
+static const char* _vertex_shader_source = "#version 330 core\n"
+	"layout (location = 0) in vec4 aPositionAge;\n"
+	"layout (location = 1) in vec4 aVelocityLifetime;\n"
+	"uniform mat4 uViewProjection;\n"
+	"uniform float uPointScale;\n"
+	"out vec4 vColor;\n"
+	"void main()\n"
+	"{\n"
+	"	if (aPositionAge.w >= aVelocityLifetime.w) {\n"
+	"		gl_Position = vec4(2.0, 2.0, 2.0, 1.0);\n"	//ü⣬㱻
+	"		gl_PointSize = 1.0;\n"
+	"		vColor = vec4(0.0);\n"
+	"		return;\n"
+	"	}\n"
+	"	float t = aPositionAge.w / aVelocityLifetime.w;\n"
+	"	gl_Position = uViewProjection * vec4(aPositionAge.xyz, 1.0);\n"
+	"	gl_PointSize = uPointScale / max(gl_Position.w, 0.001);\n"
+	"	vColor = vec4(mix(vec3(1.0, 0.8, 0.3), vec3(0.8, 0.1, 0.05), t) * (1.0 - t), 1.0);\n"
+	"}\n";
+
+static const char* _frag_shader_source = "#version 330 core\n"
+	"out vec4 FragColor;\n"
+	"in vec4 vColor;\n"
+	"void main()\n"
+	"{\n"
+	"	vec2 d = gl_PointCoord * 2.0 - 1.0;\n"
+	"	float falloff = max(1.0 - dot(d, d), 0.0);\n"
+	"	FragColor = vColor * falloff;\n"
+	"}\n";
+
+static const char* _feedback_varyings[] = { "PositionAge", "VelocityLifetime" };
+
+typedef struct _particles_update_job_s {
+	opengl_particle_t* particles;
+	float dt;
+	glm::vec3 gravity;
+}_particles_update_job_t;
+
+static unsigned int _compile(GLenum type, const char* source) {
+	int success;
+	char info[512];
+	unsigned int shader = glCreateShader(type);
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success) {
+		glGetShaderInfoLog(shader, sizeof(info), NULL, info);
+		printf("ERROR::PARTICLES::SHADER_COMPILATION_FAILED: %s\n", info);
+	}
+	return shader;
+}
+
+static void _link(unsigned int program) {
+	int success;
+	glLinkProgram(program);
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	if (!success) {
+		char info[512];
+		glGetProgramInfoLog(program, sizeof(info), NULL, info);
+		printf("ERROR::PARTICLES::LINK_FAILED: %s\n", info);
+	}
+}
+
+//xorshift32[-1, 1)
+static inline float _random(uint32_t* state) {
+	uint32_t x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return (float)(x >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+//͸ɫļͬһ__m128֧ԭд
+static void _update_range(void* user, uint32_t begin, uint32_t end) {
+	_particles_update_job_t* job = (_particles_update_job_t*)user;
+	float dt = job->dt;
+#if MATH_BACKEND != MATH_BACKEND_SCALAR
+	float* data = (float*)&job->particles[begin];
+	__m128 dt4 = _mm_set1_ps(dt);
+	__m128 gravity = _mm_setr_ps(job->gravity.x * dt, job->gravity.y * dt, job->gravity.z * dt, 0.0f);
+	__m128 xyz = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+	__m128 w1 = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+	for (uint32_t i = begin; i < end; i++, data += 8) {
+		__m128 position = _mm_load_ps(data);
+		__m128 velocity = _mm_load_ps(data + 4);
+		__m128 alive = _mm_cmplt_ps(_mm_shuffle_ps(position, position, _MM_SHUFFLE(3, 3, 3, 3)), _mm_shuffle_ps(velocity, velocity, _MM_SHUFFLE(3, 3, 3, 3)));
+		__m128 next_velocity = _mm_add_ps(velocity, gravity);
+		//w1λúһμ
+		__m128 step = _mm_or_ps(_mm_and_ps(next_velocity, xyz), w1);
+		__m128 next_position = _mm_add_ps(position, _mm_mul_ps(step, dt4));
+		_mm_store_ps(data, _mm_or_ps(_mm_and_ps(alive, next_position), _mm_andnot_ps(alive, position)));
+		_mm_store_ps(data + 4, _mm_or_ps(_mm_and_ps(alive, next_velocity), _mm_andnot_ps(alive, velocity)));
+	}
+#else
+	for (uint32_t i = begin; i < end; i++) {
+		opengl_particle_t* particle = &job->particles[i];
+		if (particle->age >= particle->lifetime) {
+			continue;
+		}
+		for (int k = 0; k < 3; k++) {
+			particle->velocity[k] += job->gravity[k] * dt;
+			particle->position[k] += particle->velocity[k] * dt;
+		}
+		particle->age += dt;
+	}
+#endif
+}
+
+void opengl_particles_init(opengl_particles_t* particles, uint32_t capacity, opengl_particles_mode_t mode, job_pool_t* jobs) {
+	memset(particles, 0, sizeof(*particles));
+	particles->mode = mode;
+	particles->jobs = jobs;
+	particles->capacity = capacity;
+	particles->rng = 0x9e3779b9u;
+
+	//任Ҫ֮ǰָ
+	unsigned int update_shader = _compile(GL_VERTEX_SHADER, _update_shader_source);
+	particles->update_program = glCreateProgram();
+	glAttachShader(particles->update_program, update_shader);
+	glTransformFeedbackVaryings(particles->update_program, 2, _feedback_varyings, GL_INTERLEAVED_ATTRIBS);
+	_link(particles->update_program);
+	glDeleteShader(update_shader);
+	particles->dt_location = glGetUniformLocation(particles->update_program, "uDt");
+	particles->gravity_location = glGetUniformLocation(particles->update_program, "uGravity");
+
+	unsigned int vertex_shader = _compile(GL_VERTEX_SHADER, _vertex_shader_source);
+	unsigned int frag_shader = _compile(GL_FRAGMENT_SHADER, _frag_shader_source);
+	particles->render_program = glCreateProgram();
+	glAttachShader(particles->render_program, vertex_shader);
+	glAttachShader(particles->render_program, frag_shader);
+	_link(particles->render_program);
+	glDeleteShader(vertex_shader);
+	glDeleteShader(frag_shader);
+	particles->view_projection_location = glGetUniformLocation(particles->render_program, "uViewProjection");
+	particles->point_scale_location = glGetUniformLocation(particles->render_program, "uPointScale");
+
+	//ȫ0һʼģCPUģֻõһ
+	opengl_particle_t* zeros = (opengl_particle_t*)calloc(capacity ? capacity : 1, sizeof(opengl_particle_t));
+	uint32_t buffer_count = mode == OPENGL_PARTICLES_GPU ? 2 : 1;
+	glGenBuffers(buffer_count, particles->vbos);
+	glGenVertexArrays(buffer_count, particles->vaos);
+	for (uint32_t i = 0; i < buffer_count; i++) {
+		glBindVertexArray(particles->vaos[i]);
+		glBindBuffer(GL_ARRAY_BUFFER, particles->vbos[i]);
+		glBufferData(GL_ARRAY_BUFFER, (size_t)capacity * sizeof(opengl_particle_t), zeros, mode == OPENGL_PARTICLES_GPU ? GL_DYNAMIC_COPY : GL_STREAM_DRAW);
+		glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(opengl_particle_t), (void*)offsetof(opengl_particle_t, position));
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(opengl_particle_t), (void*)offsetof(opengl_particle_t, velocity));
+		glEnableVertexAttribArray(1);
+	}
+	glBindVertexArray(0);//ѡֹ޸
+	glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+	if (mode == OPENGL_PARTICLES_CPU) {
+		particles->staging = zeros;
+		particles->staging_capacity = capacity;
+	}
+	else {
+		free(zeros);
+	}
+}
+
+void opengl_particles_destroy(opengl_particles_t* particles) {
+	glDeleteProgram(particles->update_program);
+	glDeleteProgram(particles->render_program);
+	glDeleteVertexArrays(2, particles->vaos);
+	glDeleteBuffers(2, particles->vbos);
+	free(particles->staging);
+	memset(particles, 0, sizeof(*particles));
+}
+
+void opengl_particles_emit(opengl_particles_t* particles, const opengl_particle_emitter_t* emitter, uint32_t count) {
+	if (count > particles->capacity) {
+		count = particles->capacity;
+	}
+	if (count == 0) {
+		return;
+	}
+	//CPUģֱдĻGPUģɵݴٷֳɻβͻͷϴ
+	opengl_particle_t* out;
+	if (particles->mode == OPENGL_PARTICLES_CPU) {
+		out = NULL;
+	}
+	else {
+		if (count > particles->staging_capacity) {
+			uint32_t capacity = particles->staging_capacity ? particles->staging_capacity * 2 : 1024;
+			while (capacity < count) {
+				capacity *= 2;
+			}
+			particles->staging = (opengl_particle_t*)realloc(particles->staging, capacity * sizeof(opengl_particle_t));
+			particles->staging_capacity = capacity;
+		}
+		out = particles->staging;
+	}
+	uint32_t head = particles->emit_head;
+	for (uint32_t i = 0; i < count; i++) {
+		opengl_particle_t* particle = out ? &out[i] : &particles->staging[(head + i) % particles->capacity];
+		particle->position[0] = emitter->position.x;
+		particle->position[1] = emitter->position.y;
+		particle->position[2] = emitter->position.z;
+		particle->age = 0.0f;
+		particle->velocity[0] = emitter->velocity.x + _random(&particles->rng) * emitter->spread;
+		particle->velocity[1] = emitter->velocity.y + _random(&particles->rng) * emitter->spread;
+		particle->velocity[2] = emitter->velocity.z + _random(&particles->rng) * emitter->spread;
+		particle->lifetime = emitter->lifetime * (0.875f + 0.125f * _random(&particles->rng));
+	}
+	if (out) {
+		uint32_t tail = particles->capacity - head < count ? particles->capacity - head : count;
+		glBindBuffer(GL_ARRAY_BUFFER, particles->vbos[particles->current]);
+		glBufferSubData(GL_ARRAY_BUFFER, (size_t)head * sizeof(opengl_particle_t), (size_t)tail * sizeof(opengl_particle_t), out);
+		if (tail < count) {
+			glBufferSubData(GL_ARRAY_BUFFER, 0, (size_t)(count - tail) * sizeof(opengl_particle_t), out + tail);
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+	}
+	particles->emit_head = (head + count) % particles->capacity;
+}
+
+void opengl_particles_update(opengl_particles_t* particles, float dt, const glm::vec3& gravity) {
+	if (particles->capacity == 0 || dt <= 0.0f) {
+		return;
+	}
+	if (particles->mode == OPENGL_PARTICLES_CPU) {
+		_particles_update_job_t job = { particles->staging, dt, gravity };
+		job_pool_parallel_for(particles->jobs, particles->capacity, OPENGL_PARTICLES_CPU_GRAIN, _update_range, &job);
+		//ָһµĴ洢õһ֡Ļ
+		glBindBuffer(GL_ARRAY_BUFFER, particles->vbos[0]);
+		glBufferData(GL_ARRAY_BUFFER, (size_t)particles->capacity * sizeof(opengl_particle_t), particles->staging, GL_STREAM_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);//ѡֹ޸
+		return;
+	}
+
+	//currentдһȻ󽻻ͬһͬʱͷ
+	uint32_t next = particles->current ^ 1;
+	GLint current;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+	glUseProgram(particles->update_program);
+	glUniform1f(particles->dt_location, dt);
+	glUniform3f(particles->gravity_location, gravity.x, gravity.y, gravity.z);
+	glEnable(GL_RASTERIZER_DISCARD);
+	glBindVertexArray(particles->vaos[particles->current]);
+	glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, particles->vbos[next]);
+	glBeginTransformFeedback(GL_POINTS);
+	glDrawArrays(GL_POINTS, 0, particles->capacity);
+	glEndTransformFeedback();
+	glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);//ѡֹ޸
+	glBindVertexArray(0);//ѡֹ޸
+	glDisable(GL_RASTERIZER_DISCARD);
+	glUseProgram(current);
+	particles->current = next;
+}
+
+void opengl_particles_draw(const opengl_particles_t* particles, const glm::mat4& view_projection, float point_scale) {
+	if (particles->capacity == 0) {
+		return;
+	}
+	GLint current;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+	glUseProgram(particles->render_program);
+	glUniformMatrix4fv(particles->view_projection_location, 1, GL_FALSE, glm::value_ptr(view_projection));
+	glUniform1f(particles->point_scale_location, point_scale);
+	//ӷϺ˳޹أ򣻲ȵд֮䲻ڵ
+	glEnable(GL_PROGRAM_POINT_SIZE);
+	glEnable(GL_DEPTH_TEST);
+	glDepthMask(GL_FALSE);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE);
+	glBindVertexArray(particles->vaos[particles->current]);
+	glDrawArrays(GL_POINTS, 0, particles->capacity);
+	glBindVertexArray(0);//ѡֹ޸
+	glDisable(GL_BLEND);
+	glDepthMask(GL_TRUE);
+	glDisable(GL_PROGRAM_POINT_SIZE);
+	glUseProgram(current);
+}
@@ -0,0 +1,58 @@
+_Pragma("once")
+
+#include <cstdint>
+#include <glm.hpp>
+#include "job-pool.h"
+
+#define OPENGL_PARTICLES_CPU_GRAIN	16384	//CPUģʱÿ
+
+//ģ⣺GPUñ任֮дCPUSIMDڴĸÿ֡ϴ
+//ģĽֻͬȽϿ֮л
+typedef enum opengl_particles_mode_e {
+	OPENGL_PARTICLES_GPU,
+	OPENGL_PARTICLES_CPU,
+}opengl_particles_mode_t;
+
+//vec4Ͷԡ任һһӦage >= lifetimeģƶҲ
+typedef struct alignas(16) opengl_particle_s {
+	float position[3];
+	float age;				//
+	float velocity[3];
+	float lifetime;			//
+}opengl_particle_t;
+
+typedef struct opengl_particle_emitter_s {
+	glm::vec3 position;
+	glm::vec3 velocity;		//ƽٶ
+	float spread;			//ٶÿƫƵķΧ
+	float lifetime;			//ƽÿ0.751֮
+}opengl_particle_emitter_t;
+
+typedef struct opengl_particles_s {
+	opengl_particles_mode_t mode;
+	job_pool_t* jobs;		//CPUģãΪNULL
+	unsigned int update_program;
+	unsigned int render_program;
+	int dt_location;
+	int gravity_location;
+	int view_projection_location;
+	int point_scale_location;
+	unsigned int vbos[2];
+	unsigned int vaos[2];	//vaos[i]vbos[i]ºͻƹ
+	uint32_t current;		//µ״̬vbos[current]CPUģʱһֱ0
+	uint32_t capacity;
+	uint32_t emit_head;		//䰴θǣдϵȱ滻
+	uint32_t rng;
+	opengl_particle_t* staging;		//GPUģʱһηӣCPUģʱȫ
+	uint32_t staging_capacity;
+}opengl_particles_t;
+
+extern void opengl_particles_init(opengl_particles_t* particles, uint32_t capacity, opengl_particles_mode_t mode, job_pool_t* jobs);
+extern void opengl_particles_destroy(opengl_particles_t* particles);
+//ڻдcountӣԭûGPUģʱglBufferSubDataֻcountй
+extern void opengl_particles_emit(opengl_particles_t* particles, const opengl_particle_emitter_t* emitter, uint32_t count);
+//ʽŷȸٶٶȸλ
+extern void opengl_particles_update(opengl_particles_t* particles, float dt, const glm::vec3& gravity);
+//㾫飬Сţpoint_scaleӿڸ߶ȳ2*tan(fov/2)ٳռֱ
+//ӷϣдȣıVAOϺд룬ʱָǰд
+extern void opengl_particles_draw(const opengl_particles_t* particles, const glm::mat4& view_projection, float point_scale);
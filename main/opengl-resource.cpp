@@ -0,0 +1,334 @@
+#include <glad/glad.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "opengl-resource.h"
+#include "opengl-texture.h"
+
+#define RESOURCE_SLOT_NONE		0xffffffffu
+
+typedef enum _garbage_type_e {
+	_GARBAGE_MESH,
+	_GARBAGE_TEXTURE,
+	_GARBAGE_PROGRAM,
+	_GARBAGE_RENDER_TARGET,
+}_garbage_type_t;
+
+static void _pool_init(opengl_resource_pool_t* pool, uint32_t item_size) {
+	memset(pool, 0, sizeof(*pool));
+	pool->item_size = item_size;
+	pool->free_head = RESOURCE_SLOT_NONE;
+}
+
+static void _pool_destroy(opengl_resource_pool_t* pool) {
+	free(pool->items);
+	free(pool->item_slots);
+	free(pool->slot_items);
+	free(pool->generations);
+	memset(pool, 0, sizeof(*pool));
+}
+
+static uint32_t _pool_add(opengl_resource_pool_t* pool, const void* item) {
+	uint32_t slot = pool->free_head;
+	if (slot != RESOURCE_SLOT_NONE) {
+		pool->free_head = pool->slot_items[slot];
+	}
+	else {
+		if (pool->slot_count > OPENGL_HANDLE_INDEX_MASK) {
+			printf("ERROR::RESOURCE::TOO_MANY_HANDLES: %u\n", pool->slot_count);
+			abort();
+		}
+		if (pool->slot_count == pool->slot_capacity) {
+			pool->slot_capacity = pool->slot_capacity ? pool->slot_capacity * 2 : 64;
+			pool->slot_items = (uint32_t*)realloc(pool->slot_items, pool->slot_capacity * sizeof(uint32_t));
+			pool->generations = (uint16_t*)realloc(pool->generations, pool->slot_capacity * sizeof(uint16_t));
+		}
+		slot = pool->slot_count++;
+		pool->generations[slot] = 1;
+	}
+	if (pool->count == pool->capacity) {
+		pool->capacity = pool->capacity ? pool->capacity * 2 : 64;
+		pool->items = (unsigned char*)realloc(pool->items, (size_t)pool->capacity * pool->item_size);
+		pool->item_slots = (uint32_t*)realloc(pool->item_slots, pool->capacity * sizeof(uint32_t));
+	}
+	memcpy(pool->items + (size_t)pool->count * pool->item_size, item, pool->item_size);
+	pool->item_slots[pool->count] = slot;
+	pool->slot_items[slot] = pool->count++;
+	return ((uint32_t)pool->generations[slot] << OPENGL_HANDLE_INDEX_BITS) | slot;
+}
+
+static void* _pool_get(const opengl_resource_pool_t* pool, uint32_t id) {
+	uint32_t slot = id & OPENGL_HANDLE_INDEX_MASK;
+	uint32_t generation = id >> OPENGL_HANDLE_INDEX_BITS;
+	if (id == 0 || slot >= pool->slot_count || pool->generations[slot] != generation) {
+		return NULL;
+	}
+	return pool->items + (size_t)pool->slot_items[slot] * pool->item_size;
+}
+
+//ȡԴþʧЧһԴŲճλ
+static bool _pool_remove(opengl_resource_pool_t* pool, uint32_t id, void* out) {
+	void* item = _pool_get(pool, id);
+	if (item == NULL) {
+		return false;
+	}
+	memcpy(out, item, pool->item_size);
+	uint32_t slot = id & OPENGL_HANDLE_INDEX_MASK;
+	uint32_t index = pool->slot_items[slot];
+	uint32_t last = pool->count - 1;
+	if (index != last) {
+		memcpy(item, pool->items + (size_t)last * pool->item_size, pool->item_size);
+		pool->item_slots[index] = pool->item_slots[last];
+		pool->slot_items[pool->item_slots[index]] = index;
+	}
+	pool->count--;
+	uint16_t generation = (uint16_t)((pool->generations[slot] + 1) & OPENGL_HANDLE_GENERATION_MASK);
+	pool->generations[slot] = generation ? generation : 1;
+	pool->slot_items[slot] = pool->free_head;
+	pool->free_head = slot;
+	return true;
+}
+
+static void _garbage_delete(const opengl_resource_garbage_t* garbage) {
+	const unsigned int* objects = garbage->objects;
+	if (garbage->type == _GARBAGE_MESH) {
+		glDeleteVertexArrays(1, &objects[0]);
+		glDeleteBuffers(2, &objects[1]);
+	}
+	if (garbage->type == _GARBAGE_TEXTURE) {
+		glDeleteTextures(1, &objects[0]);
+	}
+	if (garbage->type == _GARBAGE_PROGRAM) {
+		glDeleteProgram(objects[0]);
+	}
+	if (garbage->type == _GARBAGE_RENDER_TARGET) {
+		glDeleteFramebuffers(1, &objects[0]);
+		glDeleteTextures(1, &objects[1]);
+		glDeleteRenderbuffers(1, &objects[2]);
+	}
+}
+
+static void _garbage_push(opengl_resources_t* resources, uint32_t type, unsigned int a, unsigned int b, unsigned int c) {
+	if (resources->garbage_count == resources->garbage_capacity) {
+		resources->garbage_capacity = resources->garbage_capacity ? resources->garbage_capacity * 2 : 64;
+		resources->garbage = (opengl_resource_garbage_t*)realloc(resources->garbage, resources->garbage_capacity * sizeof(opengl_resource_garbage_t));
+	}
+	opengl_resource_garbage_t* garbage = &resources->garbage[resources->garbage_count++];
+	garbage->type = type;
+	garbage->objects[0] = a;
+	garbage->objects[1] = b;
+	garbage->objects[2] = c;
+	garbage->frame = resources->frame;
+}
+
+static void _fence_pop(opengl_resources_t* resources) {
+	resources->completed_frame = resources->fence_frames[resources->fence_head];
+	glDeleteSync((GLsync)resources->fences[resources->fence_head]);
+	resources->fence_head = (resources->fence_head + 1) % OPENGL_RESOURCE_MAX_FENCES;
+	resources->fence_count--;
+}
+
+void opengl_resources_init(opengl_resources_t* resources) {
+	memset(resources, 0, sizeof(*resources));
+	_pool_init(&resources->meshes, sizeof(opengl_gpu_mesh_t));
+	_pool_init(&resources->textures, sizeof(opengl_gpu_texture_t));
+	_pool_init(&resources->programs, sizeof(opengl_gpu_program_t));
+	_pool_init(&resources->render_targets, sizeof(opengl_gpu_render_target_t));
+	resources->frame = 1;
+}
+
+void opengl_resources_destroy(opengl_resources_t* resources) {
+	for (uint32_t i = 0; i < resources->meshes.count; i++) {
+		const opengl_gpu_mesh_t* mesh = &((const opengl_gpu_mesh_t*)resources->meshes.items)[i];
+		_garbage_push(resources, _GARBAGE_MESH, mesh->vao, mesh->vbo, mesh->ebo);
+	}
+	for (uint32_t i = 0; i < resources->textures.count; i++) {
+		const opengl_gpu_texture_t* texture = &((const opengl_gpu_texture_t*)resources->textures.items)[i];
+		_garbage_push(resources, _GARBAGE_TEXTURE, texture->texture, 0, 0);
+	}
+	for (uint32_t i = 0; i < resources->programs.count; i++) {
+		const opengl_gpu_program_t* program = &((const opengl_gpu_program_t*)resources->programs.items)[i];
+		_garbage_push(resources, _GARBAGE_PROGRAM, program->program, 0, 0);
+	}
+	for (uint32_t i = 0; i < resources->render_targets.count; i++) {
+		const opengl_gpu_render_target_t* target = &((const opengl_gpu_render_target_t*)resources->render_targets.items)[i];
+		_garbage_push(resources, _GARBAGE_RENDER_TARGET, target->framebuffer, target->color, target->depth);
+	}
+	for (uint32_t i = 0; i < resources->garbage_count; i++) {
+		_garbage_delete(&resources->garbage[i]);
+	}
+	while (resources->fence_count) {
+		_fence_pop(resources);
+	}
+	free(resources->garbage);
+	_pool_destroy(&resources->meshes);
+	_pool_destroy(&resources->textures);
+	_pool_destroy(&resources->programs);
+	_pool_destroy(&resources->render_targets);
+	memset(resources, 0, sizeof(*resources));
+}
+
+void opengl_resources_end_frame(opengl_resources_t* resources) {
+	//һ֡ͷŵĶҪդ֡˳׷ӣһµ
+	if (resources->garbage_count && resources->garbage[resources->garbage_count - 1].frame == resources->frame) {
+		if (resources->fence_count == OPENGL_RESOURCE_MAX_FENCES) {
+			GLsync oldest = (GLsync)resources->fences[resources->fence_head];
+			while (glClientWaitSync(oldest, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) {
+			}
+			_fence_pop(resources);
+		}
+		uint32_t tail = (resources->fence_head + resources->fence_count) % OPENGL_RESOURCE_MAX_FENCES;
+		resources->fences[tail] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		resources->fence_frames[tail] = resources->frame;
+		resources->fence_count++;
+	}
+	while (resources->fence_count) {
+		GLenum result = glClientWaitSync((GLsync)resources->fences[resources->fence_head], 0, 0);
+		if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+			break;
+		}
+		_fence_pop(resources);
+	}
+	uint32_t kept = 0;
+	for (uint32_t i = 0; i < resources->garbage_count; i++) {
+		if (resources->garbage[i].frame <= resources->completed_frame) {
+			_garbage_delete(&resources->garbage[i]);
+			resources->freed++;
+		}
+		else {
+			resources->garbage[kept++] = resources->garbage[i];
+		}
+	}
+	resources->garbage_count = kept;
+	resources->frame++;
+}
+
+void opengl_resources_get_stats(const opengl_resources_t* resources, opengl_resource_stats_t* stats) {
+	stats->meshes = resources->meshes.count;
+	stats->textures = resources->textures.count;
+	stats->programs = resources->programs.count;
+	stats->render_targets = resources->render_targets.count;
+	stats->pending = resources->garbage_count;
+	stats->freed = resources->freed;
+}
+
+opengl_mesh_handle_t opengl_resources_add_mesh(opengl_resources_t* resources, const opengl_gpu_mesh_t* mesh) {
+	opengl_mesh_handle_t handle = { _pool_add(&resources->meshes, mesh) };
+	return handle;
+}
+
+opengl_mesh_handle_t opengl_resources_upload_mesh(opengl_resources_t* resources, const opengl_mesh_t* mesh) {
+	opengl_gpu_mesh_t gpu;
+	opengl_mesh_upload(mesh, &gpu.vao, &gpu.vbo, &gpu.ebo);
+	gpu.index_count = mesh->index_count;
+	gpu.vertex_count = mesh->vertex_count;
+	return opengl_resources_add_mesh(resources, &gpu);
+}
+
+const opengl_gpu_mesh_t* opengl_resources_mesh(const opengl_resources_t* resources, opengl_mesh_handle_t handle) {
+	return (const opengl_gpu_mesh_t*)_pool_get(&resources->meshes, handle.id);
+}
+
+void opengl_resources_release_mesh(opengl_resources_t* resources, opengl_mesh_handle_t handle) {
+	opengl_gpu_mesh_t mesh;
+	if (_pool_remove(&resources->meshes, handle.id, &mesh)) {
+		_garbage_push(resources, _GARBAGE_MESH, mesh.vao, mesh.vbo, mesh.ebo);
+	}
+}
+
+opengl_texture_handle_t opengl_resources_add_texture(opengl_resources_t* resources, const opengl_gpu_texture_t* texture) {
+	opengl_texture_handle_t handle = { _pool_add(&resources->textures, texture) };
+	return handle;
+}
+
+opengl_texture_handle_t opengl_resources_load_texture(opengl_resources_t* resources, const char* path, uint32_t flags, job_pool_t* jobs) {
+	image_mip_chain_t chain;
+	if (!opengl_texture_load_chain(path, flags, jobs, &chain)) {
+		opengl_texture_handle_t invalid = { 0 };
+		return invalid;
+	}
+	opengl_gpu_texture_t texture;
+	texture.texture = opengl_texture_create(&chain, 0);
+	texture.target = GL_TEXTURE_2D;
+	texture.width = chain.levels[0].width;
+	texture.height = chain.levels[0].height;
+	image_mip_chain_destroy(&chain);
+	return opengl_resources_add_texture(resources, &texture);
+}
+
+const opengl_gpu_texture_t* opengl_resources_texture(const opengl_resources_t* resources, opengl_texture_handle_t handle) {
+	return (const opengl_gpu_texture_t*)_pool_get(&resources->textures, handle.id);
+}
+
+void opengl_resources_release_texture(opengl_resources_t* resources, opengl_texture_handle_t handle) {
+	opengl_gpu_texture_t texture;
+	if (_pool_remove(&resources->textures, handle.id, &texture)) {
+		_garbage_push(resources, _GARBAGE_TEXTURE, texture.texture, 0, 0);
+	}
+}
+
+opengl_program_handle_t opengl_resources_add_program(opengl_resources_t* resources, unsigned int program) {
+	opengl_gpu_program_t gpu = { program };
+	opengl_program_handle_t handle = { _pool_add(&resources->programs, &gpu) };
+	return handle;
+}
+
+const opengl_gpu_program_t* opengl_resources_program(const opengl_resources_t* resources, opengl_program_handle_t handle) {
+	return (const opengl_gpu_program_t*)_pool_get(&resources->programs, handle.id);
+}
+
+void opengl_resources_release_program(opengl_resources_t* resources, opengl_program_handle_t handle) {
+	opengl_gpu_program_t program;
+	if (_pool_remove(&resources->programs, handle.id, &program)) {
+		_garbage_push(resources, _GARBAGE_PROGRAM, program.program, 0, 0);
+	}
+}
+
+opengl_render_target_handle_t opengl_resources_create_render_target(opengl_resources_t* resources, int width, int height) {
+	opengl_gpu_render_target_t target;
+	target.width = width;
+	target.height = height;
+
+	glGenFramebuffers(1, &target.framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+
+	glGenTextures(1, &target.color);
+	glBindTexture(GL_TEXTURE_2D, target.color);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.color, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);//ѡֹ޸
+
+	glGenRenderbuffers(1, &target.depth);
+	glBindRenderbuffer(GL_RENDERBUFFER, target.depth);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target.depth);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);//ѡֹ޸
+
+	GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	if (status != GL_FRAMEBUFFER_COMPLETE) {
+		printf("ERROR::RESOURCE::FRAMEBUFFER_INCOMPLETE: 0x%x\n", status);
+		glDeleteFramebuffers(1, &target.framebuffer);
+		glDeleteTextures(1, &target.color);
+		glDeleteRenderbuffers(1, &target.depth);
+		opengl_render_target_handle_t invalid = { 0 };
+		return invalid;
+	}
+	opengl_render_target_handle_t handle = { _pool_add(&resources->render_targets, &target) };
+	return handle;
+}
+
+const opengl_gpu_render_target_t* opengl_resources_render_target(const opengl_resources_t* resources, opengl_render_target_handle_t handle) {
+	return (const opengl_gpu_render_target_t*)_pool_get(&resources->render_targets, handle.id);
+}
+
+void opengl_resources_release_render_target(opengl_resources_t* resources, opengl_render_target_handle_t handle) {
+	opengl_gpu_render_target_t target;
+	if (_pool_remove(&resources->render_targets, handle.id, &target)) {
+		_garbage_push(resources, _GARBAGE_RENDER_TARGET, target.framebuffer, target.color, target.depth);
+	}
+}
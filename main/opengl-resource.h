@@ -0,0 +1,119 @@
+_Pragma("once")
+
+#include <cstdint>
+#include "opengl-mesh.h"
+#include "job-pool.h"
+
+//20λǲλ12λǴλʱһɾ鲻Դ0Ч
+//ͬһλ4095֮ƣɾſ
+#define OPENGL_HANDLE_INDEX_BITS		20
+#define OPENGL_HANDLE_INDEX_MASK		((1u << OPENGL_HANDLE_INDEX_BITS) - 1)
+#define OPENGL_HANDLE_GENERATION_MASK	((1u << (32 - OPENGL_HANDLE_INDEX_BITS)) - 1)
+#define OPENGL_RESOURCE_MAX_FENCES		8	//ͬʱȴ֡ʱϵһ֡
+
+typedef struct opengl_mesh_handle_s { uint32_t id; }opengl_mesh_handle_t;
+typedef struct opengl_texture_handle_s { uint32_t id; }opengl_texture_handle_t;
+typedef struct opengl_program_handle_s { uint32_t id; }opengl_program_handle_t;
+typedef struct opengl_render_target_handle_s { uint32_t id; }opengl_render_target_handle_t;
+
+typedef struct opengl_gpu_mesh_s {
+	unsigned int vao;
+	unsigned int vbo;
+	unsigned int ebo;
+	uint32_t index_count;
+	uint32_t vertex_count;
+}opengl_gpu_mesh_t;
+
+typedef struct opengl_gpu_texture_s {
+	unsigned int texture;
+	unsigned int target;	//GL_TEXTURE_2D
+	int width;
+	int height;
+}opengl_gpu_texture_t;
+
+typedef struct opengl_gpu_program_s {
+	unsigned int program;
+}opengl_gpu_program_t;
+
+typedef struct opengl_gpu_render_target_s {
+	unsigned int framebuffer;
+	unsigned int color;		//RGBA8ֱӲ
+	unsigned int depth;		//ģȾ
+	int width;
+	int height;
+}opengl_gpu_render_target_t;
+
+//һԴıԴбڱλͨãɾʱһԴŲλ
+typedef struct opengl_resource_pool_s {
+	unsigned char* items;
+	uint32_t* item_slots;		//Դ -> λ
+	uint32_t item_size;
+	uint32_t count;
+	uint32_t capacity;
+	uint32_t* slot_items;		//λ -> Դвλһвλ
+	uint16_t* generations;
+	uint32_t slot_count;
+	uint32_t slot_capacity;
+	uint32_t free_head;
+}opengl_resource_pool_t;
+
+//ѾʧЧGPUܻʹõGL
+typedef struct opengl_resource_garbage_s {
+	uint32_t type;
+	unsigned int objects[3];
+	uint64_t frame;
+}opengl_resource_garbage_t;
+
+typedef struct opengl_resource_stats_s {
+	uint32_t meshes;
+	uint32_t textures;
+	uint32_t programs;
+	uint32_t render_targets;
+	uint32_t pending;			//ȴGPUɺɾĶ
+	uint64_t freed;
+}opengl_resource_stats_t;
+
+typedef struct opengl_resources_s {
+	opengl_resource_pool_t meshes;
+	opengl_resource_pool_t textures;
+	opengl_resource_pool_t programs;
+	opengl_resource_pool_t render_targets;
+	opengl_resource_garbage_t* garbage;
+	uint32_t garbage_count;
+	uint32_t garbage_capacity;
+	void* fences[OPENGL_RESOURCE_MAX_FENCES];	//GLsync
+	uint64_t fence_frames[OPENGL_RESOURCE_MAX_FENCES];
+	uint32_t fence_head;
+	uint32_t fence_count;
+	uint64_t frame;
+	uint64_t completed_frame;	//GPUѾִһ֡
+	uint64_t freed;
+}opengl_resources_t;
+
+extern void opengl_resources_init(opengl_resources_t* resources);
+//ɾԴǰGPUʹ
+extern void opengl_resources_destroy(opengl_resources_t* resources);
+//ÿ֡ύ֮ãһ֡ͷŵĶդɾGPUѾĶ
+extern void opengl_resources_end_frame(opengl_resources_t* resources);
+extern void opengl_resources_get_stats(const opengl_resources_t* resources, opengl_resource_stats_t* stats);
+
+//addӹGLȨѯָһadd/release֮ǰЧʧЧʱNULL
+//release֮ʧЧGLһ֡դɺɾ
+extern opengl_mesh_handle_t opengl_resources_add_mesh(opengl_resources_t* resources, const opengl_gpu_mesh_t* mesh);
+extern opengl_mesh_handle_t opengl_resources_upload_mesh(opengl_resources_t* resources, const opengl_mesh_t* mesh);
+extern const opengl_gpu_mesh_t* opengl_resources_mesh(const opengl_resources_t* resources, opengl_mesh_handle_t handle);
+extern void opengl_resources_release_mesh(opengl_resources_t* resources, opengl_mesh_handle_t handle);
+
+extern opengl_texture_handle_t opengl_resources_add_texture(opengl_resources_t* resources, const opengl_gpu_texture_t* texture);
+//ʧܷЧ
+extern opengl_texture_handle_t opengl_resources_load_texture(opengl_resources_t* resources, const char* path, uint32_t flags, job_pool_t* jobs);
+extern const opengl_gpu_texture_t* opengl_resources_texture(const opengl_resources_t* resources, opengl_texture_handle_t handle);
+extern void opengl_resources_release_texture(opengl_resources_t* resources, opengl_texture_handle_t handle);
+
+extern opengl_program_handle_t opengl_resources_add_program(opengl_resources_t* resources, unsigned int program);
+extern const opengl_gpu_program_t* opengl_resources_program(const opengl_resources_t* resources, opengl_program_handle_t handle);
+extern void opengl_resources_release_program(opengl_resources_t* resources, opengl_program_handle_t handle);
+
+extern opengl_render_target_handle_t opengl_resources_create_render_target(opengl_resources_t* resources, int width, int height);
+extern const opengl_gpu_render_target_t* opengl_resources_render_target(const opengl_resources_t* resources, opengl_render_target_handle_t handle);
+extern void opengl_resources_release_render_target(opengl_resources_t* resources, opengl_render_target_handle_t handle);
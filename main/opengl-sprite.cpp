@@ -0,0 +1,265 @@
+#include <glad/glad.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <gtc/type_ptr.hpp>
+#include "opengl-sprite.h"
+
+//ĸǵ˳(0,0) (1,0) (0,1) (1,1)
+static const char* _vertex_shader_source = "#version 330 core\n"
+	"uniform usamplerBuffer uSprites;\n"
+	"uniform int uFirst;\n"
+	"uniform mat4 uViewProjection;\n"
+	"out vec3 vTexCoord;\n"
+	"out vec4 vColor;\n"
+	"void main()\n"
+	"{\n"
+	"	int sprite = uFirst + (gl_VertexID >> 2);\n"
+	"	vec2 corner = vec2(gl_VertexID & 1, (gl_VertexID >> 1) & 1);\n"
+	"	uvec4 a = texelFetch(uSprites, sprite * 2);\n"
+	"	uvec4 b = texelFetch(uSprites, sprite * 2 + 1);\n"
+	"	vec2 local = (corner - 0.5) * uintBitsToFloat(a.zw);\n"
+	"	float rotation = uintBitsToFloat(b.x);\n"
+	"	float c = cos(rotation);\n"
+	"	float s = sin(rotation);\n"
+	"	vec2 position = uintBitsToFloat(a.xy) + vec2(c * local.x - s * local.y, s * local.x + c * local.y);\n"
+	"	gl_Position = uViewProjection * vec4(position, 0.0, 1.0);\n"
+	"	vTexCoord = vec3(corner, float(b.z & 0xffffu));\n"
+	"	vColor = vec4((uvec4(b.y) >> uvec4(0u, 8u, 16u, 24u)) & 255u) / 255.0;\n"
+	"}\n";
+
+static const char* _frag_shader_source = "#version 330 core\n"
+	"out vec4 FragColor;\n"
+	"in vec3 vTexCoord;\n"
+	"in vec4 vColor;\n"
+	"uniform sampler2DArray uTextures;\n"
+	"void main()\n"
+	"{\n"
+	"	FragColor = texture(uTextures, vTexCoord) * vColor;\n"
+	"}\n";
+
+static unsigned int _compile(GLenum type, const char* source) {
+	int success;
+	char info[512];
+	unsigned int shader = glCreateShader(type);
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+	if (!success) {
+		glGetShaderInfoLog(shader, sizeof(info), NULL, info);
+		printf("ERROR::SPRITE::SHADER_COMPILATION_FAILED: %s\n", info);
+	}
+	return shader;
+}
+
+//ڸλڵλͰ˳ǻƵ˳
+static inline uint32_t _key(const opengl_sprite_t* sprite) {
+	uint32_t pool = sprite->pool < OPENGL_TEXTURE_ARRAY_MAX_POOLS ? sprite->pool : OPENGL_TEXTURE_ARRAY_MAX_POOLS - 1;
+	uint32_t layer = sprite->layer < OPENGL_SPRITE_MAX_LAYERS ? sprite->layer : OPENGL_SPRITE_MAX_LAYERS - 1;
+	return pool * OPENGL_SPRITE_MAX_LAYERS + layer;
+}
+
+//ֻ;йأþͲٸģebo¼VAOʱVAOѾ
+static void _grow_indices(opengl_sprite_batch_t* batch, uint32_t count) {
+	uint32_t capacity = batch->index_capacity ? batch->index_capacity : 1024;
+	while (capacity < count) {
+		capacity *= 2;
+	}
+	if (capacity > batch->max_sprites) {
+		capacity = batch->max_sprites;
+	}
+	uint32_t* indices = (uint32_t*)malloc((size_t)capacity * 6 * sizeof(uint32_t));
+	for (uint32_t i = 0; i < capacity; i++) {
+		uint32_t* quad = &indices[i * 6];
+		quad[0] = i * 4 + 0;
+		quad[1] = i * 4 + 1;
+		quad[2] = i * 4 + 2;
+		quad[3] = i * 4 + 2;
+		quad[4] = i * 4 + 1;
+		quad[5] = i * 4 + 3;
+	}
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, (size_t)capacity * 6 * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+	free(indices);
+	batch->index_capacity = capacity;
+}
+
+void opengl_sprite_batch_init(opengl_sprite_batch_t* batch) {
+	memset(batch, 0, sizeof(*batch));
+	unsigned int vertex_shader = _compile(GL_VERTEX_SHADER, _vertex_shader_source);
+	unsigned int frag_shader = _compile(GL_FRAGMENT_SHADER, _frag_shader_source);
+	batch->program = glCreateProgram();
+	glAttachShader(batch->program, vertex_shader);
+	glAttachShader(batch->program, frag_shader);
+	glLinkProgram(batch->program);
+	int success;
+	glGetProgramiv(batch->program, GL_LINK_STATUS, &success);
+	if (!success) {
+		char info[512];
+		glGetProgramInfoLog(batch->program, sizeof(info), NULL, info);
+		printf("ERROR::SPRITE::LINK_FAILED: %s\n", info);
+	}
+	glDeleteShader(vertex_shader);
+	glDeleteShader(frag_shader);
+	batch->view_projection_location = glGetUniformLocation(batch->program, "uViewProjection");
+	batch->first_location = glGetUniformLocation(batch->program, "uFirst");
+	GLint current;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+	glUseProgram(batch->program);
+	glUniform1i(glGetUniformLocation(batch->program, "uTextures"), OPENGL_SPRITE_TEXTURE_UNIT);
+	glUniform1i(glGetUniformLocation(batch->program, "uSprites"), OPENGL_SPRITE_BUFFER_UNIT);
+	glUseProgram(current);
+
+	//ÿRGBA32UIأ3.3ֻ֤65536أʵʵҪѯ
+	GLint max_texels = 65536;
+	glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &max_texels);
+	batch->max_sprites = (uint32_t)max_texels / 2;
+	batch->ring_size = OPENGL_SPRITE_MIN_RING_SIZE;
+	if (batch->ring_size > (size_t)batch->max_sprites * sizeof(opengl_sprite_t)) {
+		batch->ring_size = (size_t)batch->max_sprites * sizeof(opengl_sprite_t);
+	}
+	glGenBuffers(1, &batch->buffer);
+	glBindBuffer(GL_TEXTURE_BUFFER, batch->buffer);
+	glBufferData(GL_TEXTURE_BUFFER, batch->ring_size, NULL, GL_STREAM_DRAW);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);//ѡֹ޸
+	glGenTextures(1, &batch->buffer_texture);
+	glBindTexture(GL_TEXTURE_BUFFER, batch->buffer_texture);
+	glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32UI, batch->buffer);
+	glBindTexture(GL_TEXTURE_BUFFER, 0);//ѡֹ޸
+
+	//ûжԣVAOֻ
+	glGenVertexArrays(1, &batch->vao);
+	glGenBuffers(1, &batch->ebo);
+	glBindVertexArray(batch->vao);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch->ebo);
+	_grow_indices(batch, 0);
+	glBindVertexArray(0);//ѡֹ޸
+
+	batch->buckets = (uint32_t*)malloc(OPENGL_SPRITE_BUCKETS * sizeof(uint32_t));
+}
+
+void opengl_sprite_batch_destroy(opengl_sprite_batch_t* batch) {
+	glDeleteProgram(batch->program);
+	glDeleteVertexArrays(1, &batch->vao);
+	glDeleteBuffers(1, &batch->buffer);
+	glDeleteBuffers(1, &batch->ebo);
+	glDeleteTextures(1, &batch->buffer_texture);
+	free(batch->sprites);
+	free(batch->buckets);
+	memset(batch, 0, sizeof(*batch));
+}
+
+opengl_sprite_t* opengl_sprite_batch_alloc(opengl_sprite_batch_t* batch, uint32_t count) {
+	if (batch->count + count > batch->capacity) {
+		uint32_t capacity = batch->capacity ? batch->capacity * 2 : 1024;
+		while (capacity < batch->count + count) {
+			capacity *= 2;
+		}
+		batch->sprites = (opengl_sprite_t*)realloc(batch->sprites, capacity * sizeof(opengl_sprite_t));
+		batch->capacity = capacity;
+	}
+	opengl_sprite_t* sprites = &batch->sprites[batch->count];
+	batch->count += count;
+	return sprites;
+}
+
+void opengl_sprite_batch_add(opengl_sprite_batch_t* batch, const opengl_sprite_t* sprite) {
+	*opengl_sprite_batch_alloc(batch, 1) = *sprite;
+}
+
+uint32_t opengl_sprite_batch_flush(opengl_sprite_batch_t* batch, const opengl_texture_arrays_t* arrays, const glm::mat4& view_projection) {
+	batch->draw_count = 0;
+	if (batch->count == 0) {
+		return 0;
+	}
+	if (batch->count > batch->max_sprites) {
+		printf("ERROR::SPRITE::TOO_MANY_SPRITES: %u > %u\n", batch->count, batch->max_sprites);
+		batch->count = batch->max_sprites;
+	}
+	size_t bytes = (size_t)batch->count * sizeof(opengl_sprite_t);
+
+	//ÿͰжٸ˳㿴ӵ˳ǲѾź
+	memset(batch->buckets, 0, OPENGL_SPRITE_BUCKETS * sizeof(uint32_t));
+	uint32_t previous = 0;
+	bool sorted = true;
+	for (uint32_t i = 0; i < batch->count; i++) {
+		uint32_t key = _key(&batch->sprites[i]);
+		batch->buckets[key]++;
+		sorted = sorted && key >= previous;
+		previous = key;
+	}
+	uint32_t pool_counts[OPENGL_TEXTURE_ARRAY_MAX_POOLS] = {};
+	uint32_t offset = 0;
+	for (uint32_t key = 0; key < OPENGL_SPRITE_BUCKETS; key++) {
+		uint32_t count = batch->buckets[key];
+		batch->buckets[key] = offset;
+		offset += count;
+		pool_counts[key / OPENGL_SPRITE_MAX_LAYERS] += count;
+	}
+
+	//ֻдд˲鶪һµģӳһGPUһڶҪͬ
+	glBindBuffer(GL_TEXTURE_BUFFER, batch->buffer);
+	if (bytes > batch->ring_size) {
+		size_t limit = (size_t)batch->max_sprites * sizeof(opengl_sprite_t);
+		batch->ring_size = bytes * OPENGL_SPRITE_RING_FLUSHES < limit ? bytes * OPENGL_SPRITE_RING_FLUSHES : limit;
+		glBufferData(GL_TEXTURE_BUFFER, batch->ring_size, NULL, GL_STREAM_DRAW);
+		batch->ring_head = 0;
+	}
+	else if (batch->ring_head + bytes > batch->ring_size) {
+		glBufferData(GL_TEXTURE_BUFFER, batch->ring_size, NULL, GL_STREAM_DRAW);
+		batch->ring_head = 0;
+	}
+	opengl_sprite_t* mapped = (opengl_sprite_t*)glMapBufferRange(GL_TEXTURE_BUFFER, batch->ring_head, bytes,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	if (mapped == NULL) {
+		printf("ERROR::SPRITE::MAP_FAILED: %zu bytes\n", bytes);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);//ѡֹ޸
+		batch->count = 0;
+		return 0;
+	}
+	//Ľֱдӳ䣬м飻Ѿʱο
+	if (sorted) {
+		memcpy(mapped, batch->sprites, bytes);
+	}
+	else {
+		for (uint32_t i = 0; i < batch->count; i++) {
+			const opengl_sprite_t* sprite = &batch->sprites[i];
+			mapped[batch->buckets[_key(sprite)]++] = *sprite;
+		}
+	}
+	glUnmapBuffer(GL_TEXTURE_BUFFER);
+	glBindBuffer(GL_TEXTURE_BUFFER, 0);//ѡֹ޸
+
+	GLint current;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+	glUseProgram(batch->program);
+	glUniformMatrix4fv(batch->view_projection_location, 1, GL_FALSE, glm::value_ptr(view_projection));
+	glActiveTexture(GL_TEXTURE0 + OPENGL_SPRITE_BUFFER_UNIT);
+	glBindTexture(GL_TEXTURE_BUFFER, batch->buffer_texture);
+	glDisable(GL_DEPTH_TEST);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glBindVertexArray(batch->vao);
+	if (batch->count > batch->index_capacity) {
+		_grow_indices(batch, batch->count);
+	}
+	//ÿδͬһʼuFirstڻĵһ
+	uint32_t first = (uint32_t)(batch->ring_head / sizeof(opengl_sprite_t));
+	for (uint32_t pool = 0; pool < OPENGL_TEXTURE_ARRAY_MAX_POOLS; pool++) {
+		if (pool_counts[pool] == 0) {
+			continue;
+		}
+		glUniform1i(batch->first_location, (GLint)first);
+		opengl_texture_arrays_bind(arrays, pool, OPENGL_SPRITE_TEXTURE_UNIT);
+		glDrawElements(GL_TRIANGLES, pool_counts[pool] * 6, GL_UNSIGNED_INT, 0);
+		first += pool_counts[pool];
+		batch->draw_count++;
+	}
+	glBindVertexArray(0);//ѡֹ޸
+	glActiveTexture(GL_TEXTURE0);
+	glDisable(GL_BLEND);
+	glUseProgram(current);
+
+	batch->ring_head += bytes;
+	batch->count = 0;
+	return batch->draw_count;
+}
@@ -0,0 +1,53 @@
+_Pragma("once")
+
+#include <cstdint>
+#include <glm.hpp>
+#include "opengl-texture-array.h"
+
+#define OPENGL_SPRITE_MAX_LAYERS	256		//GL 3.3֤ٲ򰴲ͰĲ㹲һͰ
+#define OPENGL_SPRITE_BUCKETS		(OPENGL_TEXTURE_ARRAY_MAX_POOLS * OPENGL_SPRITE_MAX_LAYERS)
+#define OPENGL_SPRITE_RING_FLUSHES	3		//λܷôύд鶪
+#define OPENGL_SPRITE_MIN_RING_SIZE	(4 << 20)
+#define OPENGL_SPRITE_TEXTURE_UNIT	13		//ԪӰ쳡󶨵HUD15
+#define OPENGL_SPRITE_BUFFER_UNIT	14
+#define OPENGL_SPRITE_RGBA(r, g, b, a)	((uint32_t)(r) | ((uint32_t)(g) << 8) | ((uint32_t)(b) << 16) | ((uint32_t)(a) << 24))
+
+//ԭɫgl_VertexIDҵľ飬չĸ
+//ʵÿʵֻĸʱGPU߳llvmpipeÿʵҪһζѷ
+typedef struct opengl_sprite_s {
+	float position[2];		//
+	float size[2];			//ߣpositionͬһϵ
+	float rotation;			//ʱתĻ
+	uint32_t color;			//OPENGL_SPRITE_RGBA
+	uint16_t layer;			//Ĳ㣬opengl_texture_layer_tlayer
+	uint16_t pool;			//һopengl_texture_layer_tpoolͬpoolֳɲͬĻ
+	uint32_t padding;		//RGBA32UI
+}opengl_sprite_t;
+
+typedef struct opengl_sprite_batch_s {
+	unsigned int program;
+	int view_projection_location;
+	int first_location;
+	unsigned int vao;
+	unsigned int buffer;		//ݵĻλͨȡ
+	unsigned int buffer_texture;
+	unsigned int ebo;			//ÿεһύɣ֡仯
+	uint32_t index_capacity;	//eboܻľ
+	uint32_t max_sprites;		//ܷŵľĲֶ
+	size_t ring_size;			//bufferֽ
+	size_t ring_head;			//һύдλãǰĲGPUܻڶ
+	opengl_sprite_t* sprites;	//ӵ˳
+	uint32_t count;
+	uint32_t capacity;
+	uint32_t* buckets;			//OPENGL_SPRITE_BUCKETSʱдλ
+	uint32_t draw_count;		//һflushĻƴ
+}opengl_sprite_batch_t;
+
+extern void opengl_sprite_batch_init(opengl_sprite_batch_t* batch);
+extern void opengl_sprite_batch_destroy(opengl_sprite_batch_t* batch);
+//Ԥcount飬÷԰һηָ̲߳дһallocaddflush֮ʧЧ
+extern opengl_sprite_t* opengl_sprite_batch_alloc(opengl_sprite_batch_t* batch, uint32_t count);
+extern void opengl_sprite_batch_add(opengl_sprite_batch_t* batch, const opengl_sprite_t* sprite);
+//ͲȶֱдӳĻλÿõһλƣȻ
+//ӵ˳ҪϸǰϵĲַֿflushıVAOϺȲԣʱָǰ
+extern uint32_t opengl_sprite_batch_flush(opengl_sprite_batch_t* batch, const opengl_texture_arrays_t* arrays, const glm::mat4& view_projection);
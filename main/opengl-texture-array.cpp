@@ -0,0 +1,152 @@
+#include <glad/glad.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "opengl-texture-array.h"
+#include "stb_image.h"
+
+void opengl_texture_arrays_init(opengl_texture_arrays_t* arrays, job_pool_t* jobs) {
+	memset(arrays, 0, sizeof(*arrays));
+	arrays->jobs = jobs;
+	GLint max_layers = 256;
+	glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layers);
+	arrays->max_layers = (uint32_t)max_layers;
+}
+
+static void _texture_pool_upload_layer(const opengl_texture_pool_t* pool, uint32_t layer, const image_mip_chain_t* chain) {
+	for (uint32_t i = 0; i < pool->level_count; i++) {
+		const image_mip_level_t* level = &chain->levels[i];
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, i, 0, 0, layer, level->width, level->height, 1, GL_RGBA, GL_UNSIGNED_BYTE, chain->data + level->offset);
+	}
+}
+
+//ĳأbuild֮ǰԲΪ׼build֮ԤĲΪ׼
+static opengl_texture_pool_t* _texture_pool_find(opengl_texture_arrays_t* arrays, int width, int height, unsigned int internal_format, uint32_t* index) {
+	for (uint32_t i = 0; i < arrays->pool_count; i++) {
+		opengl_texture_pool_t* pool = &arrays->pools[i];
+		uint32_t limit = arrays->built ? pool->layer_capacity : arrays->max_layers;
+		if (pool->width == width && pool->height == height && pool->internal_format == internal_format && pool->layer_count < limit) {
+			*index = i;
+			return pool;
+		}
+	}
+	if (arrays->built || arrays->pool_count == OPENGL_TEXTURE_ARRAY_MAX_POOLS) {
+		return NULL;
+	}
+	*index = arrays->pool_count;
+	opengl_texture_pool_t* pool = &arrays->pools[arrays->pool_count++];
+	memset(pool, 0, sizeof(*pool));
+	pool->width = width;
+	pool->height = height;
+	pool->internal_format = internal_format;
+	pool->level_count = image_mip_level_count(width, height);
+	return pool;
+}
+
+bool opengl_texture_arrays_add(opengl_texture_arrays_t* arrays, const unsigned char* pixels, int width, int height, int channels,
+	uint32_t flags, opengl_texture_layer_t* layer) {
+	uint32_t index;
+	opengl_texture_pool_t* pool = _texture_pool_find(arrays, width, height, GL_RGBA8, &index);
+	if (pool == NULL) {
+		//buildֻ֮ԤĲ㣬ٿµĳ
+		printf("ERROR::TEXTURE_ARRAY::%s: %dx%d\n", arrays->built ? "POOL_FULL" : "NO_POOL", width, height);
+		return false;
+	}
+	image_mip_chain_t chain;
+	if (!image_mip_chain_build(&chain, pixels, width, height, channels, flags, arrays->jobs)) {
+		printf("ERROR::TEXTURE_ARRAY::MIP_FAILED: %dx%d\n", width, height);
+		return false;
+	}
+	if (arrays->built) {
+		//ֻϴһĸmipҪglGenerateMipmap
+		glBindTexture(GL_TEXTURE_2D_ARRAY, pool->texture);
+		_texture_pool_upload_layer(pool, pool->layer_count, &chain);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);//ѡֹ޸
+		image_mip_chain_destroy(&chain);
+	}
+	else {
+		if (pool->layer_count == pool->staged_capacity) {
+			pool->staged_capacity = pool->staged_capacity ? pool->staged_capacity * 2 : OPENGL_TEXTURE_ARRAY_MIN_LAYERS;
+			pool->staged = (image_mip_chain_t*)realloc(pool->staged, pool->staged_capacity * sizeof(image_mip_chain_t));
+		}
+		pool->staged[pool->layer_count] = chain;
+	}
+	layer->pool = index;
+	layer->layer = pool->layer_count++;
+	return true;
+}
+
+bool opengl_texture_arrays_load(opengl_texture_arrays_t* arrays, const char* path, opengl_texture_layer_t* layer) {
+	//صͼƬ(0,0)Ͻǣopenglӿڵԭ(0,0)½ǣתmipʱ
+	stbi_set_flip_vertically_on_load(0);
+
+	int width, height, nrChannels;
+	unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
+	if (data == NULL) {
+		printf("ERROR::TEXTURE_ARRAY::LOAD_FAILED: %s\n", path);
+		return false;
+	}
+	bool ok = opengl_texture_arrays_add(arrays, data, width, height, nrChannels, IMAGE_MIP_FLIP_Y | IMAGE_MIP_SRGB, layer);
+	stbi_image_free(data);
+	return ok;
+}
+
+void opengl_texture_arrays_build(opengl_texture_arrays_t* arrays) {
+	for (uint32_t i = 0; i < arrays->pool_count; i++) {
+		opengl_texture_pool_t* pool = &arrays->pools[i];
+		//ԤһЩbuild֮add֤layer_count
+		pool->layer_capacity = pool->layer_count < OPENGL_TEXTURE_ARRAY_MIN_LAYERS ? OPENGL_TEXTURE_ARRAY_MIN_LAYERS : pool->layer_count;
+		if (pool->layer_capacity > arrays->max_layers) {
+			pool->layer_capacity = arrays->max_layers;
+		}
+		glGenTextures(1, &pool->texture);
+		glBindTexture(GL_TEXTURE_2D_ARRAY, pool->texture);
+
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		//GL 3.3ûglTexStorage3Dÿһ
+		int width = pool->width;
+		int height = pool->height;
+		for (uint32_t level = 0; level < pool->level_count; level++) {
+			glTexImage3D(GL_TEXTURE_2D_ARRAY, level, pool->internal_format, width, height, pool->layer_capacity, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+			width = width > 1 ? width / 2 : 1;
+			height = height > 1 ? height / 2 : 1;
+		}
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, pool->level_count - 1);
+		for (uint32_t layer = 0; layer < pool->layer_count; layer++) {
+			_texture_pool_upload_layer(pool, layer, &pool->staged[layer]);
+		}
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);//ѡֹ޸
+
+		for (uint32_t layer = 0; layer < pool->layer_count; layer++) {
+			image_mip_chain_destroy(&pool->staged[layer]);
+		}
+		free(pool->staged);
+		pool->staged = NULL;
+		pool->staged_capacity = 0;
+	}
+	arrays->built = true;
+}
+
+void opengl_texture_arrays_bind(const opengl_texture_arrays_t* arrays, uint32_t pool, unsigned int unit) {
+	glActiveTexture(GL_TEXTURE0 + unit);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, arrays->pools[pool].texture);
+}
+
+void opengl_texture_arrays_destroy(opengl_texture_arrays_t* arrays) {
+	for (uint32_t i = 0; i < arrays->pool_count; i++) {
+		opengl_texture_pool_t* pool = &arrays->pools[i];
+		if (pool->texture) {
+			glDeleteTextures(1, &pool->texture);
+		}
+		for (uint32_t layer = 0; layer < pool->layer_count && pool->staged; layer++) {
+			image_mip_chain_destroy(&pool->staged[layer]);
+		}
+		free(pool->staged);
+	}
+	memset(arrays, 0, sizeof(*arrays));
+}
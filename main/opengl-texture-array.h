@@ -0,0 +1,45 @@
+_Pragma("once")
+
+#include <cstdint>
+#include "image-mip.h"
+#include "job-pool.h"
+
+#define OPENGL_TEXTURE_ARRAY_MAX_POOLS	16
+#define OPENGL_TEXTURE_ARRAY_MIN_LAYERS	8
+
+//õpoolѡһlayerеĲ㣬ΪʵԴɫ
+typedef struct opengl_texture_layer_s {
+	uint32_t pool;
+	uint32_t layer;
+}opengl_texture_layer_t;
+
+//ͬߴͬʽŽͬһGL_TEXTURE_2D_ARRAYʱٿһͬߴ
+typedef struct opengl_texture_pool_s {
+	unsigned int texture;
+	int width;
+	int height;
+	unsigned int internal_format;
+	uint32_t layer_count;
+	uint32_t layer_capacity;	//build֮ԤĲ
+	uint32_t level_count;
+	image_mip_chain_t* staged;	//build֮ǰݴmip
+	uint32_t staged_capacity;
+}opengl_texture_pool_t;
+
+typedef struct opengl_texture_arrays_s {
+	opengl_texture_pool_t pools[OPENGL_TEXTURE_ARRAY_MAX_POOLS];
+	uint32_t pool_count;
+	bool built;
+	uint32_t max_layers;		//GL_MAX_ARRAY_TEXTURE_LAYERS
+	job_pool_t* jobs;
+}opengl_texture_arrays_t;
+
+//ҪǰGLģѯ
+extern void opengl_texture_arrays_init(opengl_texture_arrays_t* arrays, job_pool_t* jobs);
+//ͳһתRGBA8CPUmipbuild֮ǰֻݴ棬buildֱ֮ϴԤĲ
+extern bool opengl_texture_arrays_add(opengl_texture_arrays_t* arrays, const unsigned char* pixels, int width, int height, int channels,
+	uint32_t flags, opengl_texture_layer_t* layer);
+extern bool opengl_texture_arrays_load(opengl_texture_arrays_t* arrays, const char* path, opengl_texture_layer_t* layer);
+extern void opengl_texture_arrays_build(opengl_texture_arrays_t* arrays);
+extern void opengl_texture_arrays_bind(const opengl_texture_arrays_t* arrays, uint32_t pool, unsigned int unit);
+extern void opengl_texture_arrays_destroy(opengl_texture_arrays_t* arrays);
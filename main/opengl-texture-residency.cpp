@@ -0,0 +1,248 @@
+#include <glad/glad.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "opengl-texture-residency.h"
+#include "opengl-texture.h"
+
+//̴߳ļӳ�һ㣬ȱҳʹIOڹ̣߳ϴbegin_frame
+struct opengl_texture_restore_s {
+	job_counter_t counter;
+	uint32_t level;
+	const unsigned char* source;
+	size_t size;
+	unsigned char* pixels;		//NULLʾʧܣһ
+};
+
+static int _level_size(int size, uint32_t level) {
+	size >>= level;
+	return size > 0 ? size : 1;
+}
+
+static size_t _level_bytes(const opengl_texture_resident_t* texture, uint32_t level) {
+	return (size_t)_level_size(texture->header.width, level) * _level_size(texture->header.height, level) * 4;
+}
+
+static void _residency_account(opengl_texture_residency_t* residency, opengl_texture_resident_t* texture, size_t bytes) {
+	residency->resident_bytes -= texture->bytes;
+	residency->resident_bytes += bytes;
+	texture->bytes = bytes;
+	if (residency->resident_bytes > residency->stats.peak_bytes) {
+		residency->stats.peak_bytes = residency->resident_bytes;
+	}
+}
+
+static void _residency_restore_run(void* user, uint32_t begin, uint32_t end) {
+	opengl_texture_restore_t* restore = (opengl_texture_restore_t*)user;
+	restore->pixels = (unsigned char*)malloc(restore->size);
+	if (restore->pixels) {
+		memcpy(restore->pixels, restore->source, restore->size);
+	}
+}
+
+//ȹ̶߳ٶʱ
+static void _residency_cancel_restore(opengl_texture_residency_t* residency, opengl_texture_resident_t* texture) {
+	if (texture->restore == NULL) {
+		return;
+	}
+	job_pool_wait(residency->jobs, &texture->restore->counter);
+	free(texture->restore->pixels);
+	delete texture->restore;
+	texture->restore = NULL;
+}
+
+//һμʱ.mipsûоͽԴͼƬɣ֮󻻳ټֻӳϴ
+static void _residency_load(opengl_texture_residency_t* residency, opengl_texture_resident_t* texture) {
+	if (texture->map.data == NULL && !opengl_texture_stream_map(texture->path, texture->flags, residency->jobs, &texture->map, &texture->header)) {
+		texture->failed = true;
+		return;
+	}
+	//ӳĸһmipֱϴÿ
+	image_mip_chain_t chain;
+	memset(&chain, 0, sizeof(chain));
+	chain.data = (unsigned char*)texture->map.data;
+	chain.level_count = texture->header.level_count;
+	for (uint32_t i = 0; i < chain.level_count; i++) {
+		chain.levels[i].offset = (size_t)texture->header.level_offsets[i];
+		chain.levels[i].width = _level_size(texture->header.width, i);
+		chain.levels[i].height = _level_size(texture->header.height, i);
+		chain.size += _level_bytes(texture, i);
+	}
+	texture->texture = opengl_texture_create(&chain, 0);
+	texture->first_level = 0;
+	_residency_account(residency, texture, chain.size);
+	residency->stats.loads++;
+}
+
+static void _residency_evict(opengl_texture_residency_t* residency, opengl_texture_resident_t* texture) {
+	_residency_cancel_restore(residency, texture);
+	glDeleteTextures(1, &texture->texture);
+	texture->texture = 0;
+	_residency_account(residency, texture, 0);
+	residency->stats.evictions++;
+}
+
+//һ̧BASE_LEVELΪ0glTexImage2DͷһĴ洢öҲؽ
+static void _residency_drop_top_mip(opengl_texture_residency_t* residency, opengl_texture_resident_t* texture) {
+	uint32_t level = texture->first_level;
+	texture->first_level = level + 1;
+	glBindTexture(GL_TEXTURE_2D, texture->texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, texture->first_level);
+	glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glBindTexture(GL_TEXTURE_2D, 0);//ѡֹ޸
+	_residency_account(residency, texture, texture->bytes - _level_bytes(texture, level));
+	residency->stats.mip_drops++;
+}
+
+//һֻȵǰϸһ㣬𼶱
+static void _residency_request_restore(opengl_texture_residency_t* residency, opengl_texture_resident_t* texture) {
+	if (texture->restore || texture->first_level == 0) {
+		return;
+	}
+	uint32_t level = texture->first_level - 1;
+	size_t size = _level_bytes(texture, level);
+	//ͳԤĻȲһtrimֻѱÿ֡
+	if (residency->resident_bytes + size > residency->budget) {
+		return;
+	}
+	opengl_texture_restore_t* restore = new opengl_texture_restore_t();
+	job_counter_init(&restore->counter);
+	restore->level = level;
+	restore->source = texture->map.data + texture->header.level_offsets[level];
+	restore->size = size;
+	restore->pixels = NULL;
+	texture->restore = restore;
+	job_pool_submit(residency->jobs, _residency_restore_run, restore, 0, 1, &restore->counter);
+}
+
+static void _residency_trim(opengl_texture_residency_t* residency) {
+	while (residency->resident_bytes > residency->budget) {
+		opengl_texture_resident_t* victim = NULL;
+		for (uint32_t i = 0; i < residency->texture_count; i++) {
+			opengl_texture_resident_t* texture = &residency->textures[i];
+			if (texture->texture == 0 || texture->last_used >= residency->frame) {
+				continue;
+			}
+			if (victim == NULL || texture->last_used < victim->last_used) {
+				victim = texture;
+			}
+		}
+		if (victim == NULL) {
+			//ʣµĶһ֡ҪõģֻܳԤ
+			return;
+		}
+		uint32_t next = victim->first_level + 1;
+		bool droppable = next < victim->header.level_count &&
+			(_level_size(victim->header.width, next) >= OPENGL_TEXTURE_RESIDENCY_MIN_SIZE || _level_size(victim->header.height, next) >= OPENGL_TEXTURE_RESIDENCY_MIN_SIZE);
+		if (droppable) {
+			_residency_drop_top_mip(residency, victim);
+		}
+		else {
+			_residency_evict(residency, victim);
+		}
+	}
+}
+
+void opengl_texture_residency_init(opengl_texture_residency_t* residency, size_t budget, job_pool_t* jobs) {
+	memset(residency, 0, sizeof(*residency));
+	residency->budget = budget;
+	residency->jobs = jobs;
+	residency->frame = 1;
+}
+
+void opengl_texture_residency_destroy(opengl_texture_residency_t* residency) {
+	for (uint32_t i = 0; i < residency->texture_count; i++) {
+		opengl_texture_resident_t* texture = &residency->textures[i];
+		_residency_cancel_restore(residency, texture);
+		if (texture->texture) {
+			glDeleteTextures(1, &texture->texture);
+		}
+		if (texture->map.data) {
+			file_map_close(&texture->map);
+		}
+		free(texture->path);
+	}
+	free(residency->textures);
+	memset(residency, 0, sizeof(*residency));
+}
+
+void opengl_texture_residency_set_budget(opengl_texture_residency_t* residency, size_t budget) {
+	residency->budget = budget;
+	_residency_trim(residency);
+}
+
+uint32_t opengl_texture_residency_register(opengl_texture_residency_t* residency, const char* path, uint32_t flags) {
+	if (residency->texture_count == residency->texture_capacity) {
+		residency->texture_capacity = residency->texture_capacity ? residency->texture_capacity * 2 : 16;
+		residency->textures = (opengl_texture_resident_t*)realloc(residency->textures, residency->texture_capacity * sizeof(opengl_texture_resident_t));
+	}
+	opengl_texture_resident_t* texture = &residency->textures[residency->texture_count];
+	memset(texture, 0, sizeof(*texture));
+	size_t length = strlen(path);
+	texture->path = (char*)malloc(length + 1);
+	memcpy(texture->path, path, length + 1);
+	texture->flags = flags;
+	return residency->texture_count++;
+}
+
+void opengl_texture_residency_begin_frame(opengl_texture_residency_t* residency) {
+	residency->frame++;
+	for (uint32_t i = 0; i < residency->texture_count; i++) {
+		opengl_texture_resident_t* texture = &residency->textures[i];
+		opengl_texture_restore_t* restore = texture->restore;
+		if (restore == NULL || restore->counter.value.load(std::memory_order_acquire) != 0) {
+			continue;
+		}
+		//ȡڼֶmipĻһѾӲ
+		if (restore->pixels && restore->level + 1 == texture->first_level) {
+			glBindTexture(GL_TEXTURE_2D, texture->texture);
+			glTexImage2D(GL_TEXTURE_2D, restore->level, GL_RGBA8, _level_size(texture->header.width, restore->level), _level_size(texture->header.height, restore->level), 0,
+				GL_RGBA, GL_UNSIGNED_BYTE, restore->pixels);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, restore->level);
+			glBindTexture(GL_TEXTURE_2D, 0);//ѡֹ޸
+			texture->first_level = restore->level;
+			_residency_account(residency, texture, texture->bytes + restore->size);
+			residency->stats.mip_restores++;
+		}
+		free(restore->pixels);
+		delete restore;
+		texture->restore = NULL;
+	}
+}
+
+unsigned int opengl_texture_residency_acquire(opengl_texture_residency_t* residency, uint32_t id) {
+	if (id >= residency->texture_count) {
+		return 0;
+	}
+	opengl_texture_resident_t* texture = &residency->textures[id];
+	texture->last_used = residency->frame;
+	if (texture->failed) {
+		return 0;
+	}
+	if (texture->texture == 0) {
+		_residency_load(residency, texture);
+		_residency_trim(residency);
+	}
+	else if (texture->first_level > 0) {
+		_residency_request_restore(residency, texture);
+	}
+	return texture->texture;
+}
+
+void opengl_texture_residency_get_stats(const opengl_texture_residency_t* residency, opengl_texture_residency_stats_t* stats) {
+	*stats = residency->stats;
+	stats->budget = residency->budget;
+	stats->resident_bytes = residency->resident_bytes;
+	stats->texture_count = residency->texture_count;
+	stats->resident_count = 0;
+	stats->partial_count = 0;
+	for (uint32_t i = 0; i < residency->texture_count; i++) {
+		const opengl_texture_resident_t* texture = &residency->textures[i];
+		if (texture->texture) {
+			stats->resident_count++;
+			if (texture->first_level > 0) {
+				stats->partial_count++;
+			}
+		}
+	}
+}
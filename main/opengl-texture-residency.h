@@ -0,0 +1,63 @@
+_Pragma("once")
+
+#include <cstddef>
+#include <cstdint>
+#include "job-pool.h"
+#include "opengl-texture-stream.h"
+
+#define OPENGL_TEXTURE_RESIDENCY_INVALID		0xffffffffu
+#define OPENGL_TEXTURE_RESIDENCY_MIN_SIZE		32		//ߴ¾ٶmip
+#define OPENGL_TEXTURE_RESIDENCY_DEFAULT_BUDGET	(256u * 1024 * 1024)
+
+typedef struct opengl_texture_restore_s opengl_texture_restore_t;
+
+typedef struct opengl_texture_resident_s {
+	char* path;
+	uint32_t flags;			//IMAGE_MIP_*
+	unsigned int texture;	//0ʾԴ
+	bool failed;			//ʧܹ
+	file_map_t map;			//һμʱ򿪵.mipsļ¼غͲضmipٽ
+	opengl_texture_stream_header_t header;	//ֱʺͲ
+	uint32_t first_level;	//ΪԴ治㶪ĶmipҲǵǰGL_TEXTURE_BASE_LEVEL
+	opengl_texture_restore_t* restore;		//ڹ߳ȡһ㣬NULLʾû
+	size_t bytes;			//ǰԴеֽmip
+	uint64_t last_used;
+}opengl_texture_resident_t;
+
+typedef struct opengl_texture_residency_stats_s {
+	size_t budget;
+	size_t resident_bytes;
+	size_t peak_bytes;
+	uint32_t texture_count;
+	uint32_t resident_count;
+	uint32_t partial_count;	//mip
+	uint32_t loads;
+	uint32_t evictions;
+	uint32_t mip_drops;
+	uint32_t mip_restores;	//̨زϴĶmip
+}opengl_texture_residency_stats_t;
+
+//ʹõ˳ԤڹԴ棬ǰ֡ùᱻ
+typedef struct opengl_texture_residency_s {
+	opengl_texture_resident_t* textures;
+	uint32_t texture_count;
+	uint32_t texture_capacity;
+	size_t budget;
+	size_t resident_bytes;
+	uint64_t frame;
+	job_pool_t* jobs;
+	opengl_texture_residency_stats_t stats;
+}opengl_texture_residency_t;
+
+extern void opengl_texture_residency_init(opengl_texture_residency_t* residency, size_t budget, job_pool_t* jobs);
+extern void opengl_texture_residency_destroy(opengl_texture_residency_t* residency);
+extern void opengl_texture_residency_set_budget(opengl_texture_residency_t* residency, size_t budget);
+//ֻǼ·һacquireʱż
+extern uint32_t opengl_texture_residency_register(opengl_texture_residency_t* residency, const char* path, uint32_t flags);
+//ϴ̶߳õmip
+extern void opengl_texture_residency_begin_frame(opengl_texture_residency_t* residency);
+//GLʧܷ0Ҳԣֻеһκ֮ͬ
+//mipֱӷصͷֱʵİ汾Ԥʱڹ߳һһ
+//ؽÿ֡ǰҪacquire
+extern unsigned int opengl_texture_residency_acquire(opengl_texture_residency_t* residency, uint32_t id);
+extern void opengl_texture_residency_get_stats(const opengl_texture_residency_t* residency, opengl_texture_residency_stats_t* stats);
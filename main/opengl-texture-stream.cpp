@@ -0,0 +1,375 @@
+#include <glad/glad.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cfloat>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "opengl-texture-stream.h"
+#include "opengl-texture.h"
+
+#define STREAM_QUEUE_SIZE	256
+
+typedef struct _stream_job_s {
+	uint32_t texture;
+	uint32_t level;
+	const unsigned char* source;	//ļӳһλãӳdestroy֮ǰһֱЧ
+	size_t size;
+	unsigned char* pixels;			//̴̨߳ӳпأϴͷ
+}_stream_job_t;
+
+//̶СĻζУ˾һ֡
+typedef struct _stream_queue_s {
+	_stream_job_t jobs[STREAM_QUEUE_SIZE];
+	uint32_t head;
+	uint32_t count;
+}_stream_queue_t;
+
+struct opengl_texture_stream_loader_s {
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable wake;
+	bool quit;
+	_stream_queue_t requests;
+	_stream_queue_t completed;
+};
+
+static bool _stream_queue_push(_stream_queue_t* queue, const _stream_job_t* job) {
+	if (queue->count == STREAM_QUEUE_SIZE) {
+		return false;
+	}
+	queue->jobs[(queue->head + queue->count) % STREAM_QUEUE_SIZE] = *job;
+	queue->count++;
+	return true;
+}
+
+static bool _stream_queue_pop(_stream_queue_t* queue, _stream_job_t* job) {
+	if (queue->count == 0) {
+		return false;
+	}
+	*job = queue->jobs[queue->head];
+	queue->head = (queue->head + 1) % STREAM_QUEUE_SIZE;
+	queue->count--;
+	return true;
+}
+
+static int _level_size(int size, uint32_t level) {
+	size >>= level;
+	return size > 0 ? size : 1;
+}
+
+static size_t _level_bytes(const opengl_texture_stream_header_t* header, uint32_t level) {
+	return (size_t)_level_size(header->width, level) * _level_size(header->height, level) * 4;
+}
+
+//ֻ̨߳ҪĲļӳжȱҳʹIOGL߳
+static void _stream_loader_run(opengl_texture_stream_loader_t* loader) {
+	for (;;) {
+		_stream_job_t job;
+		{
+			std::unique_lock<std::mutex> lock(loader->mutex);
+			loader->wake.wait(lock, [&] { return loader->quit || loader->requests.count > 0; });
+			if (loader->quit) {
+				return;
+			}
+			_stream_queue_pop(&loader->requests, &job);
+		}
+		job.pixels = (unsigned char*)malloc(job.size);
+		memcpy(job.pixels, job.source, job.size);
+		{
+			//ʱ֤мһŵ
+			std::lock_guard<std::mutex> lock(loader->mutex);
+			_stream_queue_push(&loader->completed, &job);
+		}
+	}
+}
+
+static uint64_t _stream_align(uint64_t offset) {
+	return (offset + OPENGL_TEXTURE_STREAM_ALIGN - 1) & ~(uint64_t)(OPENGL_TEXTURE_STREAM_ALIGN - 1);
+}
+
+static void _stream_layout(opengl_texture_stream_header_t* header) {
+	uint64_t offset = _stream_align(sizeof(opengl_texture_stream_header_t));
+	memset(header->level_offsets, 0, sizeof(header->level_offsets));
+	for (uint32_t i = 0; i < header->level_count; i++) {
+		header->level_offsets[i] = offset;
+		offset = _stream_align(offset + _level_bytes(header, i));
+	}
+	header->file_size = offset;
+}
+
+bool opengl_texture_stream_write(const image_mip_chain_t* chain, const char* path, uint64_t source_hash, uint32_t flags) {
+	opengl_texture_stream_header_t header = {};
+	header.magic = OPENGL_TEXTURE_STREAM_MAGIC;
+	header.version = OPENGL_TEXTURE_STREAM_VERSION;
+	header.source_hash = source_hash;
+	header.flags = flags;
+	header.width = chain->levels[0].width;
+	header.height = chain->levels[0].height;
+	header.level_count = chain->level_count;
+	_stream_layout(&header);
+
+	//дʱļٸ;ʧ°ļ
+	char tmp_path[1024];
+	snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+	FILE* fp = fopen(tmp_path, "wb");
+	if (fp == NULL) {
+		printf("ERROR::TEXTURE_STREAM::WRITE_FAILED: %s\n", path);
+		return false;
+	}
+	static const unsigned char zeros[OPENGL_TEXTURE_STREAM_ALIGN] = {};
+	bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+	uint64_t pos = sizeof(header);
+	for (uint32_t i = 0; ok && i < chain->level_count; i++) {
+		size_t pad = (size_t)(header.level_offsets[i] - pos);
+		size_t size = _level_bytes(&header, i);
+		ok = fwrite(zeros, 1, pad, fp) == pad && fwrite(chain->data + chain->levels[i].offset, 1, size, fp) == size;
+		pos = header.level_offsets[i] + size;
+	}
+	if (ok && header.file_size > pos) {
+		size_t pad = (size_t)(header.file_size - pos);
+		ok = fwrite(zeros, 1, pad, fp) == pad;
+	}
+	ok = (fclose(fp) == 0) && ok;
+	if (ok) {
+		remove(path);
+		ok = rename(tmp_path, path) == 0;
+	}
+	if (!ok) {
+		remove(tmp_path);
+		printf("ERROR::TEXTURE_STREAM::WRITE_FAILED: %s\n", path);
+	}
+	return ok;
+}
+
+static bool _stream_file_open(file_map_t* map, opengl_texture_stream_header_t* header, const char* path, uint64_t source_hash, uint32_t flags) {
+	if (!file_map_open(map, path)) {
+		return false;
+	}
+	if (map->size >= sizeof(opengl_texture_stream_header_t)) {
+		memcpy(header, map->data, sizeof(*header));
+		opengl_texture_stream_header_t expected = *header;
+		if (expected.level_count <= IMAGE_MIP_MAX_LEVELS) {
+			_stream_layout(&expected);
+		}
+		if (header->magic == OPENGL_TEXTURE_STREAM_MAGIC
+			&& header->version == OPENGL_TEXTURE_STREAM_VERSION
+			&& header->source_hash == source_hash
+			&& header->flags == flags
+			&& header->level_count == image_mip_level_count(header->width, header->height)
+			&& memcmp(header, &expected, sizeof(expected)) == 0
+			&& header->file_size <= map->size) {
+			return true;
+		}
+	}
+	file_map_close(map);
+	return false;
+}
+
+bool opengl_texture_stream_map(const char* path, uint32_t flags, job_pool_t* jobs, file_map_t* map, opengl_texture_stream_header_t* header) {
+	uint64_t hash;
+	if (!file_hash(path, &hash)) {
+		printf("ERROR::TEXTURE_STREAM::OPEN_FAILED: %s\n", path);
+		return false;
+	}
+	char mips_path[1024];
+	snprintf(mips_path, sizeof(mips_path), "%s.mips", path);
+	if (_stream_file_open(map, header, mips_path, hash, flags)) {
+		return true;
+	}
+	image_mip_chain_t chain;
+	if (!opengl_texture_load_chain(path, flags, jobs, &chain)) {
+		return false;
+	}
+	bool ok = opengl_texture_stream_write(&chain, mips_path, hash, flags);
+	image_mip_chain_destroy(&chain);
+	if (!ok || !_stream_file_open(map, header, mips_path, hash, flags)) {
+		printf("ERROR::TEXTURE_STREAM::OPEN_FAILED: %s\n", mips_path);
+		return false;
+	}
+	return true;
+}
+
+void opengl_texture_stream_init(opengl_texture_stream_t* stream) {
+	memset(stream, 0, sizeof(*stream));
+	stream->loader = new opengl_texture_stream_loader_t();
+	stream->loader->quit = false;
+	stream->loader->requests.head = 0;
+	stream->loader->requests.count = 0;
+	stream->loader->completed.head = 0;
+	stream->loader->completed.count = 0;
+	stream->loader->thread = std::thread(_stream_loader_run, stream->loader);
+}
+
+void opengl_texture_stream_destroy(opengl_texture_stream_t* stream) {
+	if (stream->loader) {
+		{
+			std::lock_guard<std::mutex> lock(stream->loader->mutex);
+			stream->loader->quit = true;
+		}
+		stream->loader->wake.notify_one();
+		stream->loader->thread.join();
+		_stream_job_t job;
+		while (_stream_queue_pop(&stream->loader->completed, &job)) {
+			free(job.pixels);
+		}
+		delete stream->loader;
+	}
+	for (uint32_t i = 0; i < stream->texture_count; i++) {
+		if (stream->textures[i].texture) {
+			glDeleteTextures(1, &stream->textures[i].texture);
+		}
+		file_map_close(&stream->textures[i].map);
+	}
+	free(stream->textures);
+	memset(stream, 0, sizeof(*stream));
+}
+
+uint32_t opengl_texture_stream_open(opengl_texture_stream_t* stream, const char* path, uint32_t flags, job_pool_t* jobs) {
+	opengl_streamed_texture_t texture;
+	memset(&texture, 0, sizeof(texture));
+	if (!opengl_texture_stream_map(path, flags, jobs, &texture.map, &texture.header)) {
+		return OPENGL_TEXTURE_STREAM_INVALID;
+	}
+
+	//СڵTAIL_SIZEĲͬϴפ֤κʱжԲ
+	const opengl_texture_stream_header_t* header = &texture.header;
+	texture.tail_level = 0;
+	while (texture.tail_level + 1 < header->level_count
+		&& (_level_size(header->width, texture.tail_level) > OPENGL_TEXTURE_STREAM_TAIL_SIZE
+			|| _level_size(header->height, texture.tail_level) > OPENGL_TEXTURE_STREAM_TAIL_SIZE)) {
+		texture.tail_level++;
+	}
+	texture.base_level = texture.tail_level;
+	texture.wanted_level = texture.tail_level;
+	texture.pending_level = OPENGL_TEXTURE_STREAM_INVALID;
+
+	glGenTextures(1, &texture.texture);
+	glBindTexture(GL_TEXTURE_2D, texture.texture);
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	for (uint32_t i = texture.tail_level; i < header->level_count; i++) {
+		glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA8, _level_size(header->width, i), _level_size(header->height, i), 0, GL_RGBA, GL_UNSIGNED_BYTE,
+			texture.map.data + header->level_offsets[i]);
+		texture.bytes += _level_bytes(header, i);
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, texture.base_level);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, header->level_count - 1);
+	glBindTexture(GL_TEXTURE_2D, 0);//ѡֹ޸
+	stream->resident_bytes += texture.bytes;
+
+	if (stream->texture_count == stream->texture_capacity) {
+		stream->texture_capacity = stream->texture_capacity ? stream->texture_capacity * 2 : 16;
+		stream->textures = (opengl_streamed_texture_t*)realloc(stream->textures, stream->texture_capacity * sizeof(opengl_streamed_texture_t));
+	}
+	stream->textures[stream->texture_count] = texture;
+	return stream->texture_count++;
+}
+
+float opengl_texture_stream_footprint(float radius, float distance, float projection_scale) {
+	if (distance <= radius) {
+		return FLT_MAX;
+	}
+	return 2.0f * radius * projection_scale / distance;
+}
+
+void opengl_texture_stream_request(opengl_texture_stream_t* stream, uint32_t id, float screen_size) {
+	if (id >= stream->texture_count) {
+		return;
+	}
+	opengl_streamed_texture_t* texture = &stream->textures[id];
+	int size = texture->header.width > texture->header.height ? texture->header.width : texture->header.height;
+	//ĻһضӦlog2Ҫmip
+	uint32_t level = 0;
+	if (screen_size < (float)size) {
+		float lod = log2f((float)size / (screen_size > 1.0f ? screen_size : 1.0f));
+		level = (uint32_t)lod;
+	}
+	if (level > texture->tail_level) {
+		level = texture->tail_level;
+	}
+	if (level < texture->wanted_level) {
+		texture->wanted_level = level;
+	}
+}
+
+static void _stream_set_base_level(opengl_streamed_texture_t* texture, uint32_t level) {
+	texture->base_level = level;
+	glBindTexture(GL_TEXTURE_2D, texture->texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+}
+
+void opengl_texture_stream_update(opengl_texture_stream_t* stream) {
+	opengl_texture_stream_loader_t* loader = stream->loader;
+	_stream_job_t job;
+
+	//ϴ̨õĲ
+	for (uint32_t uploads = 0; uploads < OPENGL_TEXTURE_STREAM_MAX_UPLOADS; uploads++) {
+		{
+			std::lock_guard<std::mutex> lock(loader->mutex);
+			if (!_stream_queue_pop(&loader->completed, &job)) {
+				break;
+			}
+		}
+		opengl_streamed_texture_t* texture = &stream->textures[job.texture];
+		texture->pending_level = OPENGL_TEXTURE_STREAM_INVALID;
+		//ȡڼBASE_LEVELΪ˵ĻһѾӲ
+		if (job.level + 1 == texture->base_level) {
+			const opengl_texture_stream_header_t* header = &texture->header;
+			glBindTexture(GL_TEXTURE_2D, texture->texture);
+			glTexImage2D(GL_TEXTURE_2D, job.level, GL_RGBA8, _level_size(header->width, job.level), _level_size(header->height, job.level), 0,
+				GL_RGBA, GL_UNSIGNED_BYTE, job.pixels);
+			_stream_set_base_level(texture, job.level);
+			texture->bytes += _level_bytes(header, job.level);
+			stream->resident_bytes += _level_bytes(header, job.level);
+			stream->uploads++;
+		}
+		free(job.pixels);
+	}
+
+	bool requested = false;
+	for (uint32_t i = 0; i < stream->texture_count; i++) {
+		opengl_streamed_texture_t* texture = &stream->textures[i];
+		if (texture->wanted_level < texture->base_level && texture->pending_level == OPENGL_TEXTURE_STREAM_INVALID) {
+			//һֻȵǰϸһ㣬𼶱
+			job.texture = i;
+			job.level = texture->base_level - 1;
+			job.source = texture->map.data + texture->header.level_offsets[job.level];
+			job.size = _level_bytes(&texture->header, job.level);
+			job.pixels = NULL;
+			std::lock_guard<std::mutex> lock(loader->mutex);
+			if (loader->requests.count + loader->completed.count < STREAM_QUEUE_SIZE && _stream_queue_push(&loader->requests, &job)) {
+				texture->pending_level = job.level;
+				requested = true;
+			}
+		}
+		else if (texture->wanted_level > texture->base_level + 1) {
+			//һڱ߽ϷأΪ0glTexImage2DͷһĴ洢
+			uint32_t level = texture->wanted_level - 1;
+			for (uint32_t j = texture->base_level; j < level; j++) {
+				size_t bytes = _level_bytes(&texture->header, j);
+				_stream_set_base_level(texture, j + 1);
+				glTexImage2D(GL_TEXTURE_2D, j, GL_RGBA8, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+				texture->bytes -= bytes;
+				stream->resident_bytes -= bytes;
+				stream->drops++;
+			}
+		}
+		//һ֡ռ
+		texture->wanted_level = texture->tail_level;
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);//ѡֹ޸
+	if (requested) {
+		loader->wake.notify_one();
+	}
+}
+
+unsigned int opengl_texture_stream_texture(const opengl_texture_stream_t* stream, uint32_t id) {
+	return id < stream->texture_count ? stream->textures[id].texture : 0;
+}
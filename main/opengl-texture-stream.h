@@ -0,0 +1,66 @@
+_Pragma("once")
+
+#include <cstddef>
+#include <cstdint>
+#include "file-map.h"
+#include "image-mip.h"
+
+#define OPENGL_TEXTURE_STREAM_MAGIC			0x5350494d	//"MIPS"
+#define OPENGL_TEXTURE_STREAM_VERSION		1
+#define OPENGL_TEXTURE_STREAM_ALIGN			64
+#define OPENGL_TEXTURE_STREAM_TAIL_SIZE		64			//ߴmipפԴ
+#define OPENGL_TEXTURE_STREAM_MAX_UPLOADS	4			//ÿ֡ϴmip
+#define OPENGL_TEXTURE_STREAM_INVALID		0xffffffffu
+
+//.mipsļͷ֮󰴲RGBA8أÿһ㶼ԵѰַȡ
+typedef struct opengl_texture_stream_header_s {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t source_hash;
+	uint32_t flags;			//ʱõIMAGE_MIP_*
+	int32_t width;
+	int32_t height;
+	uint32_t level_count;
+	uint64_t level_offsets[IMAGE_MIP_MAX_LEVELS];
+	uint64_t file_size;
+}opengl_texture_stream_header_t;
+
+typedef struct opengl_streamed_texture_s {
+	file_map_t map;
+	opengl_texture_stream_header_t header;
+	unsigned int texture;
+	uint32_t tail_level;	//һ㿪ʼפ
+	uint32_t base_level;	//ǰGL_TEXTURE_BASE_LEVEL͵Ĳ㲻Դ
+	uint32_t wanted_level;	//һ֡ʹҪϸĲ
+	uint32_t pending_level;	//ں̨ȡĲ
+	size_t bytes;
+}opengl_streamed_texture_t;
+
+typedef struct opengl_texture_stream_loader_s opengl_texture_stream_loader_t;
+
+//ĻϵͶӰСÿҪmipϸĲں̶̨߳ȡϴٵBASE_LEVEL
+typedef struct opengl_texture_stream_s {
+	opengl_streamed_texture_t* textures;
+	uint32_t texture_count;
+	uint32_t texture_capacity;
+	opengl_texture_stream_loader_t* loader;
+	size_t resident_bytes;
+	uint32_t uploads;
+	uint32_t drops;
+}opengl_texture_stream_t;
+
+extern bool opengl_texture_stream_write(const image_mip_chain_t* chain, const char* path, uint64_t source_hash, uint32_t flags);
+//򿪲У<path>.mipsԴͼƬ仯ļʱɣɹmapһֱЧfile_map_close
+extern bool opengl_texture_stream_map(const char* path, uint32_t flags, job_pool_t* jobs, file_map_t* map, opengl_texture_stream_header_t* header);
+
+extern void opengl_texture_stream_init(opengl_texture_stream_t* stream);
+extern void opengl_texture_stream_destroy(opengl_texture_stream_t* stream);
+//<path>.mipsԴͼƬ仯ļʱɣر
+extern uint32_t opengl_texture_stream_open(opengl_texture_stream_t* stream, const char* path, uint32_t flags, job_pool_t* jobs);
+//İΧĻϵֱprojection_scale = viewport_height / (2 * tan(fovy / 2))
+extern float opengl_texture_stream_footprint(float radius, float distance, float projection_scale);
+//screen_sizeʹĻϵسߴ磬һι
+extern void opengl_texture_stream_request(opengl_texture_stream_t* stream, uint32_t id, float screen_size);
+//ϴ̨õĲ㣬µĶȡҪĲ㣬ÿ֡request֮һ
+extern void opengl_texture_stream_update(opengl_texture_stream_t* stream);
+extern unsigned int opengl_texture_stream_texture(const opengl_texture_stream_t* stream, uint32_t id);
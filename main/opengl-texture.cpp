@@ -0,0 +1,56 @@
+#include <glad/glad.h>
+#include <cstdio>
+#include "opengl-texture.h"
+#include "stb_image.h"
+
+void opengl_texture_upload_mips(const image_mip_chain_t* chain, uint32_t first_level) {
+	for (uint32_t i = first_level; i < chain->level_count; i++) {
+		const image_mip_level_t* level = &chain->levels[i];
+		glTexImage2D(GL_TEXTURE_2D, i - first_level, GL_RGBA8, level->width, level->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, chain->data + level->offset);
+	}
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, chain->level_count - 1 - first_level);
+}
+
+bool opengl_texture_load_chain(const char* path, uint32_t flags, job_pool_t* jobs, image_mip_chain_t* chain) {
+	//תŵmipһstb_imageֻ
+	stbi_set_flip_vertically_on_load(0);
+
+	int width, height, nrChannels;
+	unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
+	if (data == NULL) {
+		printf("ERROR::TEXTURE::LOAD_FAILED: %s\n", path);
+		return false;
+	}
+	bool ok = image_mip_chain_build(chain, data, width, height, nrChannels, flags, jobs);
+	stbi_image_free(data);
+	if (!ok) {
+		printf("ERROR::TEXTURE::MIP_FAILED: %s\n", path);
+	}
+	return ok;
+}
+
+unsigned int opengl_texture_create(const image_mip_chain_t* chain, uint32_t first_level) {
+	unsigned int texture;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	opengl_texture_upload_mips(chain, first_level);
+	glBindTexture(GL_TEXTURE_2D, 0);//ѡֹ޸
+	return texture;
+}
+
+unsigned int opengl_texture_load(const char* path, uint32_t flags, job_pool_t* jobs) {
+	image_mip_chain_t chain;
+	if (!opengl_texture_load_chain(path, flags, jobs, &chain)) {
+		return 0;
+	}
+	unsigned int texture = opengl_texture_create(&chain, 0);
+	image_mip_chain_destroy(&chain);
+	return texture;
+}
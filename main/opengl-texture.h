@@ -0,0 +1,12 @@
+_Pragma("once")
+
+#include "image-mip.h"
+
+//CPUɺõmipfirst_levelʼϴǰ󶨵GL_TEXTURE_2DglGenerateMipmap
+extern void opengl_texture_upload_mips(const image_mip_chain_t* chain, uint32_t first_level);
+//ͼƬmipchainҪimage_mip_chain_destroy
+extern bool opengl_texture_load_chain(const char* path, uint32_t flags, job_pool_t* jobs, image_mip_chain_t* chain);
+//chainfirst_levelΪĵ0
+extern unsigned int opengl_texture_create(const image_mip_chain_t* chain, uint32_t first_level);
+//ͼƬmipʧܷ0
+extern unsigned int opengl_texture_load(const char* path, uint32_t flags, job_pool_t* jobs);
@@ -0,0 +1,220 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "scene-graph.h"
+
+static void _scene_graph_reserve(scene_graph_t* graph, uint32_t capacity) {
+	if (capacity <= graph->capacity) {
+		return;
+	}
+	graph->parents = (uint32_t*)realloc(graph->parents, capacity * sizeof(uint32_t));
+	graph->subtree_ends = (uint32_t*)realloc(graph->subtree_ends, capacity * sizeof(uint32_t));
+	graph->locals = (glm::mat4*)realloc(graph->locals, capacity * sizeof(glm::mat4));
+	graph->worlds = (glm::mat4*)realloc(graph->worlds, capacity * sizeof(glm::mat4));
+	graph->dirty = (uint8_t*)realloc(graph->dirty, capacity * sizeof(uint8_t));
+	if (!graph->parents || !graph->subtree_ends || !graph->locals || !graph->worlds || !graph->dirty) {
+		printf("ERROR::SCENE_GRAPH::OUT_OF_MEMORY: %u\n", capacity);
+		abort();
+	}
+	graph->capacity = capacity;
+}
+
+static void _scene_graph_mark(scene_graph_t* graph, uint32_t node) {
+	if (graph->dirty[node]) {
+		return;
+	}
+	graph->dirty[node] = 1;
+	if (graph->dirty_count == graph->dirty_capacity) {
+		graph->dirty_capacity = graph->dirty_capacity ? graph->dirty_capacity * 2 : 64;
+		graph->dirty_nodes = (uint32_t*)realloc(graph->dirty_nodes, graph->dirty_capacity * sizeof(uint32_t));
+		graph->dirty_scratch = (uint32_t*)realloc(graph->dirty_scratch, graph->dirty_capacity * sizeof(uint32_t));
+	}
+	graph->dirty_nodes[graph->dirty_count++] = node;
+}
+
+//LSDÿ11λ±ĸλȫ0ʱǰdirty_nodes
+static void _scene_graph_sort_dirty(scene_graph_t* graph) {
+	uint32_t counts[1 << SCENE_GRAPH_SORT_BITS];
+	uint32_t* src = graph->dirty_nodes;
+	uint32_t* dst = graph->dirty_scratch;
+	for (uint32_t shift = 0; shift < 32 && ((graph->count - 1) >> shift) != 0; shift += SCENE_GRAPH_SORT_BITS) {
+		memset(counts, 0, sizeof(counts));
+		for (uint32_t i = 0; i < graph->dirty_count; i++) {
+			counts[(src[i] >> shift) & ((1 << SCENE_GRAPH_SORT_BITS) - 1)]++;
+		}
+		uint32_t offset = 0;
+		for (uint32_t d = 0; d < (1 << SCENE_GRAPH_SORT_BITS); d++) {
+			uint32_t count = counts[d];
+			counts[d] = offset;
+			offset += count;
+		}
+		for (uint32_t i = 0; i < graph->dirty_count; i++) {
+			dst[counts[(src[i] >> shift) & ((1 << SCENE_GRAPH_SORT_BITS) - 1)]++] = src[i];
+		}
+		uint32_t* tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+	graph->dirty_nodes = src;
+	graph->dirty_scratch = dst;
+}
+
+//ĸڵһǰ棬˳ɨһꣻĸڵ㲻һѾµ
+static void _scene_graph_update_range(scene_graph_t* graph, uint32_t begin, uint32_t end) {
+	for (uint32_t i = begin; i < end; i++) {
+		uint32_t parent = graph->parents[i];
+		if (parent == SCENE_GRAPH_NONE) {
+			graph->worlds[i] = graph->locals[i];
+		} else {
+			graph->worlds[i] = graph->worlds[parent] * graph->locals[i];
+		}
+	}
+}
+
+void scene_graph_init(scene_graph_t* graph, uint32_t capacity) {
+	memset(graph, 0, sizeof(*graph));
+	_scene_graph_reserve(graph, capacity > 0 ? capacity : 64);
+}
+
+void scene_graph_destroy(scene_graph_t* graph) {
+	free(graph->parents);
+	free(graph->subtree_ends);
+	free(graph->locals);
+	free(graph->worlds);
+	free(graph->dirty);
+	free(graph->dirty_nodes);
+	free(graph->dirty_scratch);
+	memset(graph, 0, sizeof(*graph));
+}
+
+uint32_t scene_graph_add(scene_graph_t* graph, uint32_t parent, const glm::mat4& local) {
+	if (parent != SCENE_GRAPH_NONE && parent >= graph->count) {
+		printf("ERROR::SCENE_GRAPH::INVALID_PARENT: %u\n", parent);
+		abort();
+	}
+	if (graph->count == graph->capacity) {
+		_scene_graph_reserve(graph, graph->capacity * 2);
+	}
+	uint32_t pos = parent == SCENE_GRAPH_NONE ? graph->count : graph->subtree_ends[parent];
+	uint32_t tail = graph->count - pos;
+	if (tail > 0) {
+		//嵽м䣺Ľڵƣָǵ±궼һ
+		memmove(&graph->parents[pos + 1], &graph->parents[pos], tail * sizeof(uint32_t));
+		memmove(&graph->subtree_ends[pos + 1], &graph->subtree_ends[pos], tail * sizeof(uint32_t));
+		memmove(&graph->locals[pos + 1], &graph->locals[pos], tail * sizeof(glm::mat4));
+		memmove(&graph->worlds[pos + 1], &graph->worlds[pos], tail * sizeof(glm::mat4));
+		memmove(&graph->dirty[pos + 1], &graph->dirty[pos], tail * sizeof(uint8_t));
+		for (uint32_t i = pos + 1; i <= graph->count; i++) {
+			if (graph->parents[i] != SCENE_GRAPH_NONE && graph->parents[i] >= pos) {
+				graph->parents[i]++;
+			}
+			graph->subtree_ends[i]++;
+		}
+		for (uint32_t i = 0; i < graph->dirty_count; i++) {
+			if (graph->dirty_nodes[i] >= pos) {
+				graph->dirty_nodes[i]++;
+			}
+		}
+	}
+	//֮ǰֻȵ
+	for (uint32_t a = parent; a != SCENE_GRAPH_NONE; a = graph->parents[a]) {
+		graph->subtree_ends[a]++;
+	}
+	graph->parents[pos] = parent;
+	graph->subtree_ends[pos] = pos + 1;
+	graph->locals[pos] = local;
+	graph->dirty[pos] = 0;
+	graph->count++;
+	_scene_graph_mark(graph, pos);
+	return pos;
+}
+
+void scene_graph_set_local(scene_graph_t* graph, uint32_t node, const glm::mat4& local) {
+	graph->locals[node] = local;
+	_scene_graph_mark(graph, node);
+}
+
+const glm::mat4& scene_graph_world(const scene_graph_t* graph, uint32_t node) {
+	return graph->worlds[node];
+}
+
+//ҳཻ±дdirty_nodesͬʱǣظĸ
+//һǰ棬һĽڵѾǣڵʱбʱ˳ɨǸ
+//cost˳һڵĿƣÿSCENE_GRAPH_ROOT_COSTbudgetʱأʣµɵ÷ʱ
+static uint32_t _scene_graph_collect_roots(scene_graph_t* graph, uint64_t budget, uint64_t* cost) {
+	uint32_t roots = 0;
+	*cost = 0;
+	if (graph->dirty_count > graph->count / SCENE_GRAPH_SCAN_RATIO) {
+		for (uint32_t i = 0; i < graph->count;) {
+			uint64_t word;
+			if (i + sizeof(word) <= graph->count) {
+				memcpy(&word, &graph->dirty[i], sizeof(word));
+				if (word == 0) {
+					i += sizeof(word);
+					continue;
+				}
+			}
+			if (!graph->dirty[i]) {
+				i++;
+				continue;
+			}
+			uint32_t end = graph->subtree_ends[i];
+			memset(&graph->dirty[i], 0, (end - i) * sizeof(uint8_t));
+			graph->dirty_nodes[roots++] = i;
+			*cost += end - i + SCENE_GRAPH_ROOT_COST;
+			if (*cost > budget) {
+				break;
+			}
+			i = end;
+		}
+		return roots;
+	}
+	_scene_graph_sort_dirty(graph);
+	uint32_t covered = 0;
+	for (uint32_t i = 0; i < graph->dirty_count; i++) {
+		uint32_t node = graph->dirty_nodes[i];
+		graph->dirty[node] = 0;
+		if (node < covered) {
+			continue;
+		}
+		covered = graph->subtree_ends[node];
+		graph->dirty_nodes[roots++] = node;
+		*cost += covered - node + SCENE_GRAPH_ROOT_COST;
+		if (*cost > budget) {
+			break;
+		}
+	}
+	return roots;
+}
+
+uint32_t scene_graph_update(scene_graph_t* graph) {
+	//ȵÿڵ㶼һֻԼƣĵĶҶʱ׼ȷֵԤʱ
+	//ĵڲڵʱֵʵʲ࣬ʵʳʱҸĹз
+	uint64_t budget = (uint64_t)graph->count * SCENE_GRAPH_PARTIAL_BUDGET / 100;
+	if ((uint64_t)graph->dirty_count * (1 + SCENE_GRAPH_ROOT_COST) > budget) {
+		scene_graph_update_all(graph);
+		return graph->count;
+	}
+	uint64_t cost;
+	uint32_t roots = _scene_graph_collect_roots(graph, budget, &cost);
+	if (cost > budget) {
+		scene_graph_update_all(graph);
+		return graph->count;
+	}
+	//±ǰ󣬷ڴֻǰ
+	uint32_t updated = 0;
+	for (uint32_t i = 0; i < roots; i++) {
+		uint32_t node = graph->dirty_nodes[i];
+		uint32_t end = graph->subtree_ends[node];
+		_scene_graph_update_range(graph, node, end);
+		updated += end - node;
+	}
+	graph->dirty_count = 0;
+	return updated;
+}
+
+void scene_graph_update_all(scene_graph_t* graph) {
+	_scene_graph_update_range(graph, 0, graph->count);
+	memset(graph->dirty, 0, graph->count * sizeof(uint8_t));
+	graph->dirty_count = 0;
+}
@@ -0,0 +1,37 @@
+_Pragma("once")
+
+#include <cstdint>
+#include <glm.hpp>
+
+#define SCENE_GRAPH_NONE				0xffffffffu		//ڵĸڵ
+#define SCENE_GRAPH_PARTIAL_BUDGET		75				//ƵĿٷֱʱΪ
+#define SCENE_GRAPH_ROOT_COST			12				//һĻȱʧ򣬰˳һڵĿƣscene-graph-bench813
+#define SCENE_GRAPH_SCAN_RATIO			64				//ڵ㳬1/64ʱɨǣڵб
+#define SCENE_GRAPH_SORT_BITS			11				//ÿ˵λ
+
+//ڵ㰴ȵУڵӽڵ֮ǰһڵһ[i, subtree_ends[i])
+//ʱֻڵûиĶһε
+typedef struct scene_graph_s {
+	uint32_t* parents;
+	uint32_t* subtree_ends;
+	glm::mat4* locals;
+	glm::mat4* worlds;			//УֱϴΪʵ
+	uint8_t* dirty;
+	uint32_t count;
+	uint32_t capacity;
+	uint32_t* dirty_nodes;		//֡ĹֲĽڵ㣬ظ
+	uint32_t* dirty_scratch;	//±dirty_nodesʱãͬ
+	uint32_t dirty_count;
+	uint32_t dirty_capacity;
+}scene_graph_t;
+
+extern void scene_graph_init(scene_graph_t* graph, uint32_t capacity);
+extern void scene_graph_destroy(scene_graph_t* graph);
+//ѽڵӵڵĩβ±ꣻ˳ʱ±겻䣬֮±һ
+extern uint32_t scene_graph_add(scene_graph_t* graph, uint32_t parent, const glm::mat4& local);
+extern void scene_graph_set_local(scene_graph_t* graph, uint32_t node, const glm::mat4& local);
+extern const glm::mat4& scene_graph_world(const scene_graph_t* graph, uint32_t node);
+//±ǰÿֻһ飬ĽڵƵĿӽʱ˻Ϊscene_graph_update_all
+extern uint32_t scene_graph_update(scene_graph_t* graph);
+//ǣ˳ȫڵ
+extern void scene_graph_update_all(scene_graph_t* graph);
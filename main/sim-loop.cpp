@@ -0,0 +1,161 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "sim-loop.h"
+
+#define SIM_SLOT_FRESH	0x4		//мȾûȡߵ¿
+
+typedef struct _sim_snapshot_s {
+	sim_state_t previous;
+	sim_state_t current;
+	double tick_time;	//currentӦʱ̣Ⱦݴ˼ֵϵ
+}_sim_snapshot_t;
+
+struct sim_loop_impl_s {
+	sim_step_fn step;
+	void* user;
+	double dt;
+	//ֻɲһ
+	sim_state_t previous;
+	sim_state_t current;
+	double tick_time;
+	std::atomic<uint64_t> ticks;
+	//壺дһͶһռһۣͨм۴ݣ˫ȴ
+	_sim_snapshot_t slots[3];
+	uint32_t back;
+	std::atomic<uint32_t> middle;
+	uint32_t front;
+	//
+	std::atomic<float> mouse_dx;
+	std::atomic<float> mouse_dy;
+	std::atomic<float> scroll;
+	std::atomic<uint32_t> moves;
+	std::thread thread;
+	std::atomic<bool> quit;
+};
+
+double sim_loop_now() {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void _sim_publish(sim_loop_impl_t* impl) {
+	_sim_snapshot_t* slot = &impl->slots[impl->back];
+	slot->previous = impl->previous;
+	slot->current = impl->current;
+	slot->tick_time = impl->tick_time;
+	impl->back = impl->middle.exchange(impl->back | SIM_SLOT_FRESH, std::memory_order_acq_rel) & 3;
+}
+
+//ִеڵĲһʱ
+static double _sim_catch_up(sim_loop_impl_t* impl, double now) {
+	uint32_t steps = 0;
+	while (impl->tick_time + impl->dt <= now) {
+		if (steps == SIM_LOOP_MAX_STEPS) {
+			//̫࣬׷ϣ¼ʱ
+			impl->tick_time = now;
+			break;
+		}
+		sim_input_t input;
+		input.mouse_dx = impl->mouse_dx.exchange(0.0f, std::memory_order_relaxed);
+		input.mouse_dy = impl->mouse_dy.exchange(0.0f, std::memory_order_relaxed);
+		input.scroll = impl->scroll.exchange(0.0f, std::memory_order_relaxed);
+		input.moves = impl->moves.load(std::memory_order_relaxed);
+
+		impl->previous = impl->current;
+		impl->step(impl->user, &impl->current, &input, (float)impl->dt);
+		impl->tick_time += impl->dt;
+		impl->ticks.fetch_add(1, std::memory_order_relaxed);
+		steps++;
+	}
+	if (steps) {
+		_sim_publish(impl);
+	}
+	return impl->tick_time + impl->dt;
+}
+
+static void _sim_thread(sim_loop_impl_t* impl) {
+	while (!impl->quit.load(std::memory_order_acquire)) {
+		double next = _sim_catch_up(impl, sim_loop_now());
+		std::this_thread::sleep_for(std::chrono::duration<double>(next - sim_loop_now()));
+	}
+}
+
+void sim_loop_create(sim_loop_t* loop, const sim_state_t* initial, double hz, bool threaded, sim_step_fn step, void* user) {
+	sim_loop_impl_t* impl = new sim_loop_impl_t();
+	impl->step = step;
+	impl->user = user;
+	impl->dt = 1.0 / hz;
+	impl->previous = *initial;
+	impl->current = *initial;
+	impl->tick_time = sim_loop_now();
+	impl->ticks.store(0);
+	for (int i = 0; i < 3; i++) {
+		impl->slots[i].previous = *initial;
+		impl->slots[i].current = *initial;
+		impl->slots[i].tick_time = impl->tick_time;
+	}
+	impl->back = 0;
+	impl->middle.store(1);
+	impl->front = 2;
+	impl->mouse_dx.store(0.0f);
+	impl->mouse_dy.store(0.0f);
+	impl->scroll.store(0.0f);
+	impl->moves.store(0);
+	impl->quit.store(false);
+
+	loop->impl = impl;
+	loop->dt = impl->dt;
+	loop->threaded = threaded;
+	if (threaded) {
+		impl->thread = std::thread(_sim_thread, impl);
+	}
+}
+
+void sim_loop_destroy(sim_loop_t* loop) {
+	if (loop->impl == NULL) {
+		return;
+	}
+	if (loop->threaded) {
+		loop->impl->quit.store(true, std::memory_order_release);
+		loop->impl->thread.join();
+	}
+	delete loop->impl;
+	loop->impl = NULL;
+}
+
+void sim_loop_add_input(sim_loop_t* loop, float mouse_dx, float mouse_dy, float scroll) {
+	loop->impl->mouse_dx.fetch_add(mouse_dx, std::memory_order_relaxed);
+	loop->impl->mouse_dy.fetch_add(mouse_dy, std::memory_order_relaxed);
+	loop->impl->scroll.fetch_add(scroll, std::memory_order_relaxed);
+}
+
+void sim_loop_set_moves(sim_loop_t* loop, uint32_t moves) {
+	loop->impl->moves.store(moves, std::memory_order_relaxed);
+}
+
+void sim_loop_sample(sim_loop_t* loop, sim_state_t* state) {
+	sim_loop_impl_t* impl = loop->impl;
+	double now = sim_loop_now();
+	if (!loop->threaded) {
+		_sim_catch_up(impl, now);
+	}
+	if (impl->middle.load(std::memory_order_relaxed) & SIM_SLOT_FRESH) {
+		impl->front = impl->middle.exchange(impl->front, std::memory_order_acq_rel) & 3;
+	}
+	const _sim_snapshot_t* snapshot = &impl->slots[impl->front];
+
+	//Ⱦģһpreviouscurrentֵ֮
+	float alpha = (float)((now - snapshot->tick_time) / impl->dt);
+	alpha = alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+	const sim_state_t* a = &snapshot->previous;
+	const sim_state_t* b = &snapshot->current;
+	state->camera_pos = glm::mix(a->camera_pos, b->camera_pos, alpha);
+	state->camera_yaw = glm::mix(a->camera_yaw, b->camera_yaw, alpha);
+	state->camera_pitch = glm::mix(a->camera_pitch, b->camera_pitch, alpha);
+	state->camera_zoom = glm::mix(a->camera_zoom, b->camera_zoom, alpha);
+	state->time = a->time + (b->time - a->time) * alpha;
+}
+
+uint64_t sim_loop_ticks(const sim_loop_t* loop) {
+	return loop->impl->ticks.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,45 @@
+_Pragma("once")
+
+#include <cstdint>
+#include <glm.hpp>
+
+#define SIM_LOOP_DEFAULT_HZ	120.0
+#define SIM_LOOP_MAX_STEPS	8		//һ׷ϵĲͶʱ䣬Խ׷Խ
+
+//ģȾ״̬Ⱦֵ֮
+typedef struct sim_state_s {
+	glm::vec3 camera_pos;
+	float camera_yaw;
+	float camera_pitch;
+	float camera_zoom;
+	double time;		//ģʱ䣬glfwGetTime
+}sim_state_t;
+
+//β֮ۼƵ
+typedef struct sim_input_s {
+	float mouse_dx;
+	float mouse_dy;
+	float scroll;
+	uint32_t moves;		//סƶiλӦopengl_camera_movement_tеĵi
+}sim_input_t;
+
+typedef void (*sim_step_fn)(void* user, sim_state_t* state, const sim_input_t* input, float dt);
+
+typedef struct sim_loop_impl_s sim_loop_impl_t;
+
+//̶ģ⣬ڵ߳У״̬ͨ彻Ⱦ
+typedef struct sim_loop_s {
+	sim_loop_impl_t* impl;
+	double dt;
+	bool threaded;
+}sim_loop_t;
+
+extern double sim_loop_now();
+extern void sim_loop_create(sim_loop_t* loop, const sim_state_t* initial, double hz, bool threaded, sim_step_fn step, void* user);
+extern void sim_loop_destroy(sim_loop_t* loop);
+//̵߳ã߳ģʽҲҪ
+extern void sim_loop_add_input(sim_loop_t* loop, float mouse_dx, float mouse_dy, float scroll);
+extern void sim_loop_set_moves(sim_loop_t* loop, uint32_t moves);
+//ȡֵ״̬Ⱦ߳ʱִеڵĲ
+extern void sim_loop_sample(sim_loop_t* loop, sim_state_t* state);
+extern uint64_t sim_loop_ticks(const sim_loop_t* loop);